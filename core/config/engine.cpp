@@ -453,6 +453,13 @@ String Engine::get_shader_cache_path() const {
 	return shader_cache_path;
 }
 
+void Engine::set_rendering_device_graph_capture_path(const String &p_path) {
+	rendering_device_graph_capture_path = p_path;
+}
+String Engine::get_rendering_device_graph_capture_path() const {
+	return rendering_device_graph_capture_path;
+}
+
 Engine *Engine::singleton = nullptr;
 
 Engine *Engine::get_singleton() {
@@ -97,6 +97,7 @@ private:
 
 	String write_movie_path;
 	String shader_cache_path;
+	String rendering_device_graph_capture_path;
 
 	static constexpr int SERVER_SYNC_FRAME_COUNT_WARNING = 5;
 	int server_syncs = 0;
@@ -200,6 +201,9 @@ public:
 	void set_shader_cache_path(const String &p_path);
 	String get_shader_cache_path() const;
 
+	void set_rendering_device_graph_capture_path(const String &p_path);
+	String get_rendering_device_graph_capture_path() const;
+
 	bool is_abort_on_gpu_errors_enabled() const;
 	bool is_validation_layers_enabled() const;
 	bool is_generate_spirv_debug_info_enabled() const;
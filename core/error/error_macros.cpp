@@ -117,8 +117,8 @@ void _err_print_error_asap(const String &p_error, ErrorHandlerType p_type) {
 		OS::get_singleton()->printerr("ERROR: %s\n", p_error.utf8().get_data());
 	} else {
 		// Fallback if errors happen before OS init or after it's destroyed.
-		const char *err_details = p_error.utf8().get_data();
-		fprintf(stderr, "ERROR: %s\n", err_details);
+		CharString err_details = p_error.utf8();
+		fprintf(stderr, "ERROR: %s\n", err_details.get_data());
 	}
 
 	_global_lock();
@@ -77,6 +77,12 @@ public:
 	virtual CompareLessFunc get_compare_less_func() const;
 
 	virtual uint32_t hash() const;
+
+	// Arguments are passed as const references, which can't bind to other kinds of reference parameters.
+	template <typename... P>
+	static constexpr bool can_call_typed() {
+		return (... && (!std::is_reference_v<P> || (std::is_lvalue_reference_v<P> && std::is_const_v<std::remove_reference_t<P>>)));
+	}
 };
 
 template <typename T, typename R, typename... P>
@@ -110,6 +116,21 @@ public:
 		}
 	}
 
+	virtual bool call_typed(const void *p_signature, const void **p_arguments) const {
+		if constexpr (can_call_typed<P...>()) {
+			if (p_signature == CallableTypedSignature<std::decay_t<P>...>::get() && ObjectDB::get_instance(ObjectID(data.object_id))) {
+				_call_typed(p_arguments, BuildIndexSequence<sizeof...(P)>{});
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template <size_t... Is>
+	void _call_typed(const void **p_arguments, IndexSequence<Is...>) const {
+		(data.instance->*data.method)(*(const std::decay_t<P> *)p_arguments[Is]...);
+	}
+
 	CallableCustomMethodPointer(T *p_instance, R (T::*p_method)(P...)) {
 		memset(&data, 0, sizeof(Data)); // Clear beforehand, may have padding bytes.
 		data.instance = p_instance;
@@ -180,6 +201,21 @@ public:
 		}
 	}
 
+	virtual bool call_typed(const void *p_signature, const void **p_arguments) const override {
+		if constexpr (can_call_typed<P...>()) {
+			if (p_signature == CallableTypedSignature<std::decay_t<P>...>::get() && ObjectDB::get_instance(ObjectID(data.object_id))) {
+				_call_typed(p_arguments, BuildIndexSequence<sizeof...(P)>{});
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template <size_t... Is>
+	void _call_typed(const void **p_arguments, IndexSequence<Is...>) const {
+		(data.instance->*data.method)(*(const std::decay_t<P> *)p_arguments[Is]...);
+	}
+
 	CallableCustomMethodPointerC(T *p_instance, R (T::*p_method)(P...) const) {
 		memset(&data, 0, sizeof(Data)); // Clear beforehand, may have padding bytes.
 		data.instance = p_instance;
@@ -35,6 +35,7 @@
 #include "core/config/engine.h"
 #include "core/io/resource_loader.h"
 #include "core/object/script_language.h"
+#include "core/templates/perfect_hash_map.h"
 #include "core/version.h"
 
 #define OBJTYPE_RLOCK RWLockRead _rw_lockr_(lock);
@@ -70,6 +71,126 @@ HashMap<StringName, ClassDB::ClassInfo> ClassDB::classes;
 HashMap<StringName, StringName> ClassDB::resource_base_extensions;
 HashMap<StringName, StringName> ClassDB::compat_classes;
 
+struct ClassDB::LookupTable {
+	// What runtime lookups need to know about a name, with inheritance already resolved.
+	struct Member {
+		enum Kind : uint8_t {
+			KIND_NONE,
+			KIND_PROPERTY,
+			KIND_CONSTANT,
+			KIND_METHOD,
+			KIND_SIGNAL,
+		};
+
+		MethodBind *method = nullptr; // Closest non-null method bind, for get_method().
+		const PropertySetGet *setget = nullptr; // Closest property, for set_property().
+		const int64_t *constant = nullptr;
+		Kind get_kind = KIND_NONE; // What get_property() returns, decided by the closest class with that name.
+		bool has_method = false;
+	};
+
+	uint32_t generation = 0;
+	bool is_valid = false; // False if the names couldn't be perfectly hashed.
+	PerfectHashMap<StringName, Member> members;
+};
+
+SafeNumeric<uint32_t> ClassDB::lookup_generation;
+Mutex ClassDB::lookup_mutex;
+LocalVector<ClassDB::LookupTable *> ClassDB::lookup_tables;
+
+void ClassDB::_invalidate_lookup_tables() {
+	lookup_generation.increment();
+
+	// Callers hold the class lock for writing, and tables are only read with it held for
+	// reading, so no lookup can still be using the tables freed here.
+	MutexLock lookup_lock(lookup_mutex);
+	if (lookup_tables.is_empty()) {
+		return;
+	}
+	for (KeyValue<StringName, ClassInfo> &E : classes) {
+		E.value.lookup_table.table.store(nullptr, std::memory_order_release);
+	}
+	for (LookupTable *table : lookup_tables) {
+		memdelete(table);
+	}
+	lookup_tables.clear();
+}
+
+_FORCE_INLINE_ const ClassDB::LookupTable *ClassDB::_get_lookup_table(ClassInfo *p_class_info) {
+	if (unlikely(!p_class_info)) {
+		return nullptr;
+	}
+	const LookupTable *table = p_class_info->lookup_table.table.load(std::memory_order_acquire);
+	if (likely(table && table->generation == lookup_generation.get())) {
+		return table->is_valid ? table : nullptr;
+	}
+	return _build_lookup_table(p_class_info);
+}
+
+const ClassDB::LookupTable *ClassDB::_build_lookup_table(ClassInfo *p_class_info) {
+	MutexLock lookup_lock(lookup_mutex);
+
+	const uint32_t generation = lookup_generation.get();
+	LookupTable *table = p_class_info->lookup_table.table.load(std::memory_order_acquire);
+	if (table && table->generation == generation) {
+		// Another thread built it meanwhile.
+		return table->is_valid ? table : nullptr;
+	}
+
+	// Walk from the class to its ancestors, in the same order as the lookups without a table.
+	HashMap<StringName, LookupTable::Member> members;
+	for (const ClassInfo *check = p_class_info; check; check = check->inherits_ptr) {
+		for (const KeyValue<StringName, PropertySetGet> &E : check->property_setget) {
+			LookupTable::Member &member = members[E.key];
+			if (!member.setget) {
+				member.setget = &E.value;
+			}
+			if (member.get_kind == LookupTable::Member::KIND_NONE) {
+				member.get_kind = LookupTable::Member::KIND_PROPERTY;
+			}
+		}
+		for (const KeyValue<StringName, int64_t> &E : check->constant_map) {
+			LookupTable::Member &member = members[E.key];
+			if (member.get_kind == LookupTable::Member::KIND_NONE) {
+				member.get_kind = LookupTable::Member::KIND_CONSTANT;
+				member.constant = &E.value;
+			}
+		}
+		for (const KeyValue<StringName, MethodBind *> &E : check->method_map) {
+			LookupTable::Member &member = members[E.key];
+			member.has_method = true;
+			if (!member.method) {
+				member.method = E.value;
+			}
+			if (member.get_kind == LookupTable::Member::KIND_NONE) {
+				member.get_kind = LookupTable::Member::KIND_METHOD;
+			}
+		}
+		for (const KeyValue<StringName, MethodInfo> &E : check->signal_map) {
+			LookupTable::Member &member = members[E.key];
+			if (member.get_kind == LookupTable::Member::KIND_NONE) {
+				member.get_kind = LookupTable::Member::KIND_SIGNAL;
+			}
+		}
+	}
+
+	LocalVector<PerfectHashMap<StringName, LookupTable::Member>::Element> elements;
+	elements.reserve(members.size());
+	for (const KeyValue<StringName, LookupTable::Member> &E : members) {
+		elements.push_back({ E.key, E.value });
+	}
+
+	table = memnew(LookupTable);
+	table->generation = generation;
+	table->is_valid = table->members.build(elements.ptr(), elements.size());
+
+	// Freed by the next change to the classes, see _invalidate_lookup_tables().
+	lookup_tables.push_back(table);
+	p_class_info->lookup_table.table.store(table, std::memory_order_release);
+
+	return table->is_valid ? table : nullptr;
+}
+
 #ifdef TOOLS_ENABLED
 HashMap<StringName, ObjectGDExtension> ClassDB::placeholder_extensions;
 
@@ -840,6 +961,7 @@ use_script:
 
 void ClassDB::_add_class2(const StringName &p_class, const StringName &p_inherits) {
 	OBJTYPE_WLOCK;
+	_invalidate_lookup_tables();
 
 	const StringName &name = p_class;
 
@@ -1042,8 +1164,20 @@ MethodBind *ClassDB::get_method(const StringName &p_class, const StringName &p_n
 
 	ClassInfo *type = classes.getptr(p_class);
 
+	const LookupTable *table = _get_lookup_table(type);
+	if (likely(table)) {
+		const LookupTable::Member *member = table->members.getptr(p_name);
+		return member ? member->method : nullptr;
+	}
+
+	return _get_method(type, p_name);
+}
+
+MethodBind *ClassDB::_get_method(const ClassInfo *p_class_info, const StringName &p_name) {
+	const ClassInfo *type = p_class_info;
+
 	while (type) {
-		MethodBind **method = type->method_map.getptr(p_name);
+		MethodBind *const *method = type->method_map.getptr(p_name);
 		if (method && *method) {
 			return *method;
 		}
@@ -1108,6 +1242,7 @@ MethodBind *ClassDB::get_method_with_compatibility(const StringName &p_class, co
 
 void ClassDB::bind_integer_constant(const StringName &p_class, const StringName &p_enum, const StringName &p_name, int64_t p_constant, bool p_is_bitfield) {
 	OBJTYPE_WLOCK;
+	_invalidate_lookup_tables();
 
 	ClassInfo *type = classes.getptr(p_class);
 
@@ -1342,6 +1477,7 @@ bool ClassDB::is_enum_bitfield(const StringName &p_class, const StringName &p_na
 
 void ClassDB::add_signal(const StringName &p_class, const MethodInfo &p_signal) {
 	OBJTYPE_WLOCK;
+	_invalidate_lookup_tables();
 
 	ClassInfo *type = classes.getptr(p_class);
 	ERR_FAIL_NULL(type);
@@ -1462,7 +1598,7 @@ void ClassDB::add_property(const StringName &p_class, const PropertyInfo &p_pinf
 
 	MethodBind *mb_set = nullptr;
 	if (p_setter) {
-		mb_set = get_method(p_class, p_setter);
+		mb_set = _get_method(type, p_setter);
 #ifdef DEBUG_METHODS_ENABLED
 
 		ERR_FAIL_NULL_MSG(mb_set, vformat("Invalid setter '%s::%s' for property '%s'.", p_class, p_setter, p_pinfo.name));
@@ -1474,7 +1610,7 @@ void ClassDB::add_property(const StringName &p_class, const PropertyInfo &p_pinf
 
 	MethodBind *mb_get = nullptr;
 	if (p_getter) {
-		mb_get = get_method(p_class, p_getter);
+		mb_get = _get_method(type, p_getter);
 #ifdef DEBUG_METHODS_ENABLED
 
 		ERR_FAIL_NULL_MSG(mb_get, vformat("Invalid getter '%s::%s' for property '%s'.", p_class, p_getter, p_pinfo.name));
@@ -1489,6 +1625,7 @@ void ClassDB::add_property(const StringName &p_class, const PropertyInfo &p_pinf
 #endif
 
 	OBJTYPE_WLOCK
+	_invalidate_lookup_tables();
 
 	type->property_list.push_back(p_pinfo);
 	type->property_map[p_pinfo.name] = p_pinfo;
@@ -1602,50 +1739,87 @@ bool ClassDB::get_property_info(const StringName &p_class, const StringName &p_p
 	return false;
 }
 
-bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid) {
-	ERR_FAIL_NULL_V(p_object, false);
+static void _set_property_setget(Object *p_object, const ClassDB::PropertySetGet *psg, const Variant &p_value, bool *r_valid) {
+	if (!psg->setter) {
+		if (r_valid) {
+			*r_valid = false;
+		}
+		return; // Do nothing.
+	}
 
-	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			if (!psg->setter) {
-				if (r_valid) {
-					*r_valid = false;
-				}
-				return true; //return true but do nothing
-			}
+	Callable::CallError ce;
 
-			Callable::CallError ce;
+	if (psg->index >= 0) {
+		Variant index = psg->index;
+		const Variant *arg[2] = { &index, &p_value };
+		//p_object->call(psg->setter,arg,2,ce);
+		if (psg->_setptr) {
+			psg->_setptr->call(p_object, arg, 2, ce);
+		} else {
+			p_object->callp(psg->setter, arg, 2, ce);
+		}
 
-			if (psg->index >= 0) {
-				Variant index = psg->index;
-				const Variant *arg[2] = { &index, &p_value };
-				//p_object->call(psg->setter,arg,2,ce);
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 2, ce);
-				} else {
-					p_object->callp(psg->setter, arg, 2, ce);
-				}
+	} else {
+		const Variant *arg[1] = { &p_value };
+		if (psg->_setptr) {
+			psg->_setptr->call(p_object, arg, 1, ce);
+		} else {
+			p_object->callp(psg->setter, arg, 1, ce);
+		}
+	}
 
-			} else {
-				const Variant *arg[1] = { &p_value };
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 1, ce);
-				} else {
-					p_object->callp(psg->setter, arg, 1, ce);
-				}
-			}
+	if (r_valid) {
+		*r_valid = ce.error == Callable::CallError::CALL_OK;
+	}
+}
 
-			if (r_valid) {
-				*r_valid = ce.error == Callable::CallError::CALL_OK;
-			}
+static void _get_property_setget(Object *p_object, const ClassDB::PropertySetGet *psg, Variant &r_value) {
+	if (!psg->getter) {
+		return; // Do nothing.
+	}
 
-			return true;
+	if (psg->index >= 0) {
+		Variant index = psg->index;
+		const Variant *arg[1] = { &index };
+		Callable::CallError ce;
+		const Variant value = p_object->callp(psg->getter, arg, 1, ce);
+		r_value = (ce.error == Callable::CallError::CALL_OK) ? value : Variant();
+
+	} else {
+		Callable::CallError ce;
+		if (psg->_getptr) {
+			r_value = psg->_getptr->call(p_object, nullptr, 0, ce);
+		} else {
+			const Variant value = p_object->callp(psg->getter, nullptr, 0, ce);
+			r_value = (ce.error == Callable::CallError::CALL_OK) ? value : Variant();
 		}
+	}
+}
 
-		check = check->inherits_ptr;
+bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid) {
+	ERR_FAIL_NULL_V(p_object, false);
+
+	const PropertySetGet *psg = nullptr;
+	{
+		// Only the lookup is locked, the setter may run any code.
+		OBJTYPE_RLOCK;
+
+		ClassInfo *type = classes.getptr(p_object->get_class_name());
+
+		const LookupTable *table = _get_lookup_table(type);
+		if (likely(table)) {
+			const LookupTable::Member *member = table->members.getptr(p_property);
+			psg = member ? member->setget : nullptr;
+		} else {
+			for (ClassInfo *check = type; check && !psg; check = check->inherits_ptr) {
+				psg = check->property_setget.getptr(p_property);
+			}
+		}
+	}
+
+	if (psg) {
+		_set_property_setget(p_object, psg, p_value, r_valid);
+		return true; // Even if there's no setter.
 	}
 
 	return false;
@@ -1654,51 +1828,66 @@ bool ClassDB::set_property(Object *p_object, const StringName &p_property, const
 bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value) {
 	ERR_FAIL_NULL_V(p_object, false);
 
-	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			if (!psg->getter) {
-				return true; //return true but do nothing
+	LookupTable::Member::Kind kind = LookupTable::Member::KIND_NONE;
+	const PropertySetGet *psg = nullptr;
+	int64_t constant = 0;
+	{
+		// Only the lookup is locked, the getter may run any code.
+		OBJTYPE_RLOCK;
+
+		ClassInfo *type = classes.getptr(p_object->get_class_name());
+
+		const LookupTable *table = _get_lookup_table(type);
+		if (likely(table)) {
+			const LookupTable::Member *member = table->members.getptr(p_property);
+			if (member) {
+				kind = member->get_kind;
+				psg = member->setget;
+				constant = member->constant ? *member->constant : 0;
 			}
+		} else {
+			for (ClassInfo *check = type; check; check = check->inherits_ptr) {
+				psg = check->property_setget.getptr(p_property);
+				if (psg) {
+					kind = LookupTable::Member::KIND_PROPERTY;
+					break;
+				}
+
+				const int64_t *c = check->constant_map.getptr(p_property); //constants count
+				if (c) {
+					kind = LookupTable::Member::KIND_CONSTANT;
+					constant = *c;
+					break;
+				}
 
-			if (psg->index >= 0) {
-				Variant index = psg->index;
-				const Variant *arg[1] = { &index };
-				Callable::CallError ce;
-				const Variant value = p_object->callp(psg->getter, arg, 1, ce);
-				r_value = (ce.error == Callable::CallError::CALL_OK) ? value : Variant();
+				if (check->method_map.has(p_property)) { //methods count
+					kind = LookupTable::Member::KIND_METHOD;
+					break;
+				}
 
-			} else {
-				Callable::CallError ce;
-				if (psg->_getptr) {
-					r_value = psg->_getptr->call(p_object, nullptr, 0, ce);
-				} else {
-					const Variant value = p_object->callp(psg->getter, nullptr, 0, ce);
-					r_value = (ce.error == Callable::CallError::CALL_OK) ? value : Variant();
+				if (check->signal_map.has(p_property)) { //signals count
+					kind = LookupTable::Member::KIND_SIGNAL;
+					break;
 				}
 			}
-			return true;
 		}
+	}
 
-		const int64_t *c = check->constant_map.getptr(p_property); //constants count
-		if (c) {
-			r_value = *c;
+	switch (kind) {
+		case LookupTable::Member::KIND_PROPERTY:
+			_get_property_setget(p_object, psg, r_value);
+			return true; // Even if there's no getter.
+		case LookupTable::Member::KIND_CONSTANT:
+			r_value = constant;
 			return true;
-		}
-
-		if (check->method_map.has(p_property)) { //methods count
+		case LookupTable::Member::KIND_METHOD:
 			r_value = Callable(p_object, p_property);
 			return true;
-		}
-
-		if (check->signal_map.has(p_property)) { //signals count
+		case LookupTable::Member::KIND_SIGNAL:
 			r_value = Signal(p_object, p_property);
 			return true;
-		}
-
-		check = check->inherits_ptr;
+		case LookupTable::Member::KIND_NONE:
+			break;
 	}
 
 	// The "free()" method is special, so we assume it exists and return a Callable.
@@ -1711,7 +1900,20 @@ bool ClassDB::get_property(Object *p_object, const StringName &p_property, Varia
 }
 
 int ClassDB::get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid) {
+	OBJTYPE_RLOCK;
+
 	ClassInfo *type = classes.getptr(p_class);
+
+	const LookupTable *table = _get_lookup_table(type);
+	if (likely(table)) {
+		const LookupTable::Member *member = table->members.getptr(p_property);
+		const bool found = member && member->setget;
+		if (r_is_valid) {
+			*r_is_valid = found;
+		}
+		return found ? member->setget->index : -1;
+	}
+
 	ClassInfo *check = type;
 	while (check) {
 		const PropertySetGet *psg = check->property_setget.getptr(p_property);
@@ -1811,8 +2013,23 @@ void ClassDB::set_method_flags(const StringName &p_class, const StringName &p_me
 }
 
 bool ClassDB::has_method(const StringName &p_class, const StringName &p_method, bool p_no_inheritance) {
+	OBJTYPE_RLOCK;
+
 	ClassInfo *type = classes.getptr(p_class);
-	ClassInfo *check = type;
+
+	if (!p_no_inheritance) {
+		const LookupTable *table = _get_lookup_table(type);
+		if (likely(table)) {
+			const LookupTable::Member *member = table->members.getptr(p_method);
+			return member && member->has_method;
+		}
+	}
+
+	return _has_method(type, p_method, p_no_inheritance);
+}
+
+bool ClassDB::_has_method(const ClassInfo *p_class_info, const StringName &p_method, bool p_no_inheritance) {
+	const ClassInfo *check = p_class_info;
 	while (check) {
 		if (check->method_map.has(p_method)) {
 			return true;
@@ -1867,6 +2084,7 @@ void ClassDB::_bind_compatibility(ClassInfo *type, MethodBind *p_method) {
 
 void ClassDB::_bind_method_custom(const StringName &p_class, MethodBind *p_method, bool p_compatibility) {
 	OBJTYPE_WLOCK;
+	_invalidate_lookup_tables();
 
 	StringName method_name = p_method->get_name();
 
@@ -1918,6 +2136,7 @@ MethodBind *ClassDB::_bind_vararg_method(MethodBind *p_bind, const StringName &p
 		ERR_FAIL_V_MSG(nullptr, vformat("Method already bound: '%s::%s'.", instance_type, p_name));
 	}
 	type->method_map[p_name] = bind;
+	_invalidate_lookup_tables();
 #ifdef DEBUG_METHODS_ENABLED
 	// FIXME: <reduz> set_return_type is no longer in MethodBind, so I guess it should be moved to vararg method bind
 	//bind->set_return_type("Variant");
@@ -1937,13 +2156,14 @@ MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, bool p_
 
 	OBJTYPE_WLOCK;
 	ERR_FAIL_NULL_V(p_bind, nullptr);
+	_invalidate_lookup_tables();
 	p_bind->set_name(mdname);
 
 	String instance_type = p_bind->get_instance_class();
 
 #ifdef DEBUG_ENABLED
 
-	ERR_FAIL_COND_V_MSG(!p_compatibility && has_method(instance_type, mdname), nullptr, vformat("Class '%s' already has a method '%s'.", String(instance_type), String(mdname)));
+	ERR_FAIL_COND_V_MSG(!p_compatibility && _has_method(classes.getptr(instance_type), mdname, false), nullptr, vformat("Class '%s' already has a method '%s'.", String(instance_type), String(mdname)));
 #endif
 
 	ClassInfo *type = classes.getptr(instance_type);
@@ -2258,6 +2478,7 @@ Variant ClassDB::class_get_default_property_value(const StringName &p_class, con
 
 void ClassDB::register_extension_class(ObjectGDExtension *p_extension) {
 	GLOBAL_LOCK_FUNCTION;
+	OBJTYPE_WLOCK;
 
 	ERR_FAIL_COND_MSG(classes.has(p_extension->class_name), vformat("Class already registered: '%s'.", String(p_extension->class_name)));
 	ERR_FAIL_COND_MSG(!classes.has(p_extension->parent_class_name), vformat("Parent class name for extension class not found: '%s'.", String(p_extension->parent_class_name)));
@@ -2302,9 +2523,12 @@ void ClassDB::register_extension_class(ObjectGDExtension *p_extension) {
 #endif
 
 	classes[p_extension->class_name] = c;
+	_invalidate_lookup_tables();
 }
 
 void ClassDB::unregister_extension_class(const StringName &p_class, bool p_free_method_binds) {
+	OBJTYPE_WLOCK;
+
 	ClassInfo *c = classes.getptr(p_class);
 	ERR_FAIL_NULL_MSG(c, vformat("Class '%s' does not exist.", String(p_class)));
 	if (p_free_method_binds) {
@@ -2313,6 +2537,7 @@ void ClassDB::unregister_extension_class(const StringName &p_class, bool p_free_
 		}
 	}
 	classes.erase(p_class);
+	_invalidate_lookup_tables();
 	default_values_cached.erase(p_class);
 	default_values.erase(p_class);
 #ifdef TOOLS_ENABLED
@@ -2368,6 +2593,10 @@ void ClassDB::cleanup() {
 	}
 
 	classes.clear();
+	for (LookupTable *table : lookup_tables) {
+		memdelete(table);
+	}
+	lookup_tables.reset();
 	resource_base_extensions.clear();
 	compat_classes.clear();
 	native_structs.clear();
@@ -100,6 +100,17 @@ public:
 		Variant::Type type;
 	};
 
+	struct LookupTable;
+
+	// Copying a ClassInfo doesn't copy its lookup table, it's built again when needed.
+	struct LookupTableRef {
+		std::atomic<LookupTable *> table{ nullptr };
+
+		LookupTableRef() {}
+		LookupTableRef(const LookupTableRef &) {}
+		LookupTableRef &operator=(const LookupTableRef &) { return *this; }
+	};
+
 	struct ClassInfo {
 		APIType api = API_NONE;
 		ClassInfo *inherits_ptr = nullptr;
@@ -131,6 +142,9 @@ public:
 		HashMap<StringName, PropertySetGet> property_setget;
 		HashMap<StringName, Vector<uint32_t>> virtual_methods_compat;
 
+		// Methods, properties, constants and signals of the class and its ancestors, for runtime lookups.
+		LookupTableRef lookup_table;
+
 		StringName inherits;
 		StringName name;
 		bool disabled = false;
@@ -200,6 +214,19 @@ private:
 
 	static bool _can_instantiate(ClassInfo *p_class_info);
 
+	// Lookup tables are rebuilt lazily after any change to the registered classes.
+	static SafeNumeric<uint32_t> lookup_generation;
+	static Mutex lookup_mutex;
+	static LocalVector<LookupTable *> lookup_tables;
+
+	static void _invalidate_lookup_tables();
+	static const LookupTable *_get_lookup_table(ClassInfo *p_class_info);
+	static const LookupTable *_build_lookup_table(ClassInfo *p_class_info);
+
+	// Walk the inheritance chain, for when there's no lookup table, or while registering classes.
+	static MethodBind *_get_method(const ClassInfo *p_class_info, const StringName &p_name);
+	static bool _has_method(const ClassInfo *p_class_info, const StringName &p_method, bool p_no_inheritance);
+
 public:
 	// DO NOT USE THIS!!!!!! NEEDS TO BE PUBLIC BUT DO NOT USE NO MATTER WHAT!!!
 	template <typename T>
@@ -35,6 +35,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
+#include "core/os/thread.h"
 
 #include <stdio.h>
 
@@ -60,6 +61,10 @@
 		mutex.unlock();                           \
 	}
 
+SafeNumeric<uint64_t> CallQueue::last_queue_id;
+thread_local CallQueue::ThreadBufferRef CallQueue::thread_buffer_refs[CallQueue::THREAD_BUFFER_REFS];
+thread_local uint32_t CallQueue::thread_buffer_next_ref = 0;
+
 void CallQueue::_add_page() {
 	if (pages_used == page_bytes.size()) {
 		pages.push_back(allocator->alloc());
@@ -69,6 +74,179 @@ void CallQueue::_add_page() {
 	pages_used++;
 }
 
+CallQueue::ThreadBufferRef::~ThreadBufferRef() {
+	if (buffer) {
+		_release_thread_buffer(buffer);
+	}
+}
+
+CallQueue::ThreadBuffer *CallQueue::_get_thread_buffer() {
+	for (ThreadBufferRef &ref : thread_buffer_refs) {
+		if (likely(ref.buffer && ref.queue_id == queue_id)) {
+			return ref.buffer;
+		}
+	}
+
+	ThreadBufferRef &ref = thread_buffer_refs[thread_buffer_next_ref];
+	thread_buffer_next_ref = (thread_buffer_next_ref + 1) % THREAD_BUFFER_REFS;
+	if (ref.buffer) {
+		// Left over from another queue, which keeps its own reference until the messages are flushed.
+		_release_thread_buffer(ref.buffer);
+	}
+
+	ThreadBuffer *buffer = memnew(ThreadBuffer);
+	buffer->refcount.init(2);
+	buffer->write_page = memnew(ThreadPage);
+	buffer->read_page = buffer->write_page;
+	buffer->page_count.set(1);
+
+	mutex.lock();
+	thread_buffers.push_back(buffer);
+	mutex.unlock();
+
+	ref.buffer = buffer;
+	ref.queue_id = queue_id;
+	return buffer;
+}
+
+void CallQueue::_release_thread_buffer(ThreadBuffer *p_buffer) {
+	if (!p_buffer->refcount.unref()) {
+		return;
+	}
+	// Messages were consumed or cleared by the queue before it released its reference.
+	ThreadPage *page = p_buffer->read_page;
+	while (page) {
+		ThreadPage *next = page->next.load(std::memory_order_acquire);
+		memdelete(page);
+		page = next;
+	}
+	memdelete(p_buffer);
+}
+
+CallQueue::Message *CallQueue::_peek_thread_buffer(ThreadBuffer *p_buffer) {
+	while (true) {
+		ThreadPage *page = p_buffer->read_page;
+		// Load next first: once it's set, the page's byte count is final.
+		ThreadPage *next = page->next.load(std::memory_order_acquire);
+		if (p_buffer->read_offset < page->bytes.get()) {
+			return (Message *)&page->data[p_buffer->read_offset];
+		}
+		if (!next) {
+			return nullptr;
+		}
+		// The pushing thread moved on to the next page and won't touch this one anymore.
+		p_buffer->read_page = next;
+		p_buffer->read_offset = 0;
+		p_buffer->page_count.decrement();
+		memdelete(page);
+	}
+}
+
+void CallQueue::_release_exited_thread_buffers() {
+	for (uint32_t i = 0; i < thread_buffers.size(); i++) {
+		ThreadBuffer *buffer = thread_buffers[i];
+		// Only the queue's reference is left once the thread has exited.
+		if (buffer->refcount.get() == 1 && !_peek_thread_buffer(buffer)) {
+			thread_buffers.remove_at_unordered(i);
+			i--;
+			_release_thread_buffer(buffer);
+		}
+	}
+}
+
+uint32_t CallQueue::_get_message_size(const Message *p_message) {
+	switch (p_message->type & FLAG_MASK) {
+		case TYPE_NOTIFICATION:
+			return sizeof(Message);
+		case TYPE_METHOD:
+			return sizeof(Message) + p_message->args;
+		default:
+			return sizeof(Message) + sizeof(Variant) * p_message->args;
+	}
+}
+
+void CallQueue::_destroy_message(Message *p_message) {
+	switch (p_message->type & FLAG_MASK) {
+		case TYPE_NOTIFICATION:
+			break;
+		case TYPE_METHOD: {
+			MethodCall *call = (MethodCall *)(p_message + 1);
+			call->destroy(call);
+		} break;
+		default: {
+			Variant *args = (Variant *)(p_message + 1);
+			for (int k = 0; k < p_message->args; k++) {
+				args[k].~Variant();
+			}
+		} break;
+	}
+
+	p_message->~Message();
+}
+
+uint8_t *CallQueue::_push_reserve(uint32_t p_room_needed, ThreadBuffer *&r_thread_buffer) {
+	if (use_thread_buffers && this != MessageQueue::thread_singleton && !Thread::is_main_thread()) {
+		ThreadBuffer *buffer = _get_thread_buffer();
+		ThreadPage *page = buffer->write_page;
+		uint32_t bytes = page->bytes.get();
+		if (bytes + p_room_needed > uint32_t(PAGE_SIZE_BYTES)) {
+			if (buffer->page_count.get() >= max_pages) {
+				return nullptr;
+			}
+			ThreadPage *new_page = memnew(ThreadPage);
+			buffer->page_count.increment();
+			page->next.store(new_page, std::memory_order_release);
+			buffer->write_page = new_page;
+			page = new_page;
+			bytes = 0;
+		}
+		r_thread_buffer = buffer;
+		return &page->data[bytes];
+	}
+
+	r_thread_buffer = nullptr;
+
+	LOCK_MUTEX;
+
+	_ensure_first_page();
+
+	if ((page_bytes[pages_used - 1] + p_room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (pages_used == max_pages) {
+			UNLOCK_MUTEX;
+			return nullptr;
+		}
+		_add_page();
+	}
+
+	return &pages[pages_used - 1]->data[page_bytes[pages_used - 1]];
+}
+
+void CallQueue::_push_commit(Message *p_message, uint32_t p_room_needed, ThreadBuffer *p_thread_buffer) {
+	if (use_thread_buffers) {
+		p_message->order = push_order.postincrement();
+	}
+
+	if (p_thread_buffer) {
+		// Publish the message to flush().
+		ThreadPage *page = p_thread_buffer->write_page;
+		page->bytes.set(page->bytes.get() + p_room_needed);
+		return;
+	}
+
+	page_bytes[pages_used - 1] += p_room_needed;
+
+	UNLOCK_MUTEX;
+}
+
+ObjectID CallQueue::_get_object_id(Object *p_object) {
+	return p_object->get_instance_id();
+}
+
+void CallQueue::_push_method_failed() {
+	fprintf(stderr, "Failed method call. Message queue out of memory. %s\n", error_text.utf8().get_data());
+	statistics();
+}
+
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
 	return push_callablep(Callable(p_id, p_method), p_args, p_argcount, p_show_error);
 }
@@ -90,24 +268,14 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
-	LOCK_MUTEX;
-
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	ThreadBuffer *thread_buffer = nullptr;
+	uint8_t *buffer_end = _push_reserve(room_needed, thread_buffer);
+	if (!buffer_end) {
+		fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
@@ -128,37 +296,26 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		*v = *p_args[i];
 	}
 
-	page_bytes[pages_used - 1] += room_needed;
-
-	UNLOCK_MUTEX;
+	_push_commit(msg, room_needed, thread_buffer);
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			String type;
-			if (ObjectDB::get_instance(p_id)) {
-				type = ObjectDB::get_instance(p_id)->get_class();
-			}
-			fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
+	ThreadBuffer *thread_buffer = nullptr;
+	uint8_t *buffer_end = _push_reserve(room_needed, thread_buffer);
+	if (!buffer_end) {
+		String type;
+		if (ObjectDB::get_instance(p_id)) {
+			type = ObjectDB::get_instance(p_id)->get_class();
 		}
-		_add_page();
+		fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
@@ -169,32 +326,23 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 	Variant *v = memnew_placement(buffer_end, Variant);
 	*v = p_value;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_push_commit(msg, room_needed, thread_buffer);
 
 	return OK;
 }
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	ThreadBuffer *thread_buffer = nullptr;
+	uint8_t *buffer_end = _push_reserve(room_needed, thread_buffer);
+	if (!buffer_end) {
+		fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 
 	msg->type = TYPE_NOTIFICATION;
@@ -202,8 +350,7 @@ Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	//msg->target;
 	msg->notification = p_notification;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_push_commit(msg, room_needed, thread_buffer);
 
 	return OK;
 }
@@ -228,7 +375,7 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 Error CallQueue::flush() {
 	LOCK_MUTEX;
 
-	if (pages.size() == 0) {
+	if (pages.size() == 0 && thread_buffers.is_empty()) {
 		// Never allocated
 		UNLOCK_MUTEX;
 		return OK; // Do nothing.
@@ -241,25 +388,46 @@ Error CallQueue::flush() {
 
 	flushing = true;
 
+	_ensure_first_page();
+
 	uint32_t i = 0;
 	uint32_t offset = 0;
 
-	while (i < pages_used && offset < page_bytes[i]) {
-		Page *page = pages[i];
-
+	while (true) {
 		//lock on each iteration, so a call can re-add itself to the message queue
 
-		Message *message = (Message *)&page->data[offset];
+		Message *message = nullptr;
+		if (i < pages_used && offset < page_bytes[i]) {
+			message = (Message *)&pages[i]->data[offset];
+		}
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
+		// Merge in messages from thread buffers in push order.
+		ThreadBuffer *from_thread_buffer = nullptr;
+		for (ThreadBuffer *buffer : thread_buffers) {
+			Message *staged = _peek_thread_buffer(buffer);
+			if (staged && (!message || int32_t(staged->order - message->order) < 0)) {
+				message = staged;
+				from_thread_buffer = buffer;
+			}
+		}
+
+		if (!message) {
+			break;
 		}
 
 		//pre-advance so this function is reentrant
-		offset += advance;
+		if (from_thread_buffer) {
+			from_thread_buffer->read_offset += _get_message_size(message);
+		} else {
+			offset += _get_message_size(message);
+		}
 
-		Object *target = message->callable.get_object();
+		Object *target = nullptr;
+		if ((message->type & FLAG_MASK) == TYPE_METHOD) {
+			target = ObjectDB::get_instance(((MethodCall *)(message + 1))->object_id);
+		} else {
+			target = message->callable.get_object();
+		}
 
 		UNLOCK_MUTEX;
 
@@ -281,19 +449,18 @@ Error CallQueue::flush() {
 					target->set(message->callable.get_method(), *arg);
 				}
 			} break;
+			case TYPE_METHOD: {
+				if (target) {
+					MethodCall *call = (MethodCall *)(message + 1);
+					call->invoke(target, call);
+				}
+			} break;
 		}
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
-			}
-		}
-
-		message->~Message();
+		_destroy_message(message);
 
 		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
+		if (!from_thread_buffer && offset == page_bytes[i]) {
 			i++;
 			offset = 0;
 		}
@@ -302,6 +469,8 @@ Error CallQueue::flush() {
 	page_bytes[0] = 0;
 	pages_used = 1;
 
+	_release_exited_thread_buffers();
+
 	flushing = false;
 	UNLOCK_MUTEX;
 	return OK;
@@ -310,6 +479,15 @@ Error CallQueue::flush() {
 void CallQueue::clear() {
 	LOCK_MUTEX;
 
+	for (ThreadBuffer *buffer : thread_buffers) {
+		Message *message = _peek_thread_buffer(buffer);
+		while (message) {
+			buffer->read_offset += _get_message_size(message);
+			_destroy_message(message);
+			message = _peek_thread_buffer(buffer);
+		}
+	}
+
 	if (pages.size() == 0) {
 		UNLOCK_MUTEX;
 		return; // Nothing to clear.
@@ -323,22 +501,8 @@ void CallQueue::clear() {
 			//lock on each iteration, so a call can re-add itself to the message queue
 
 			Message *message = (Message *)&page->data[offset];
-
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
-
-			message->~Message();
+			offset += _get_message_size(message);
+			_destroy_message(message);
 		}
 	}
 
@@ -354,6 +518,7 @@ void CallQueue::statistics() {
 	HashMap<int, int> notify_count;
 	HashMap<Callable, int> call_count;
 	int null_count = 0;
+	int method_count = 0;
 
 	for (uint32_t i = 0; i < pages_used; i++) {
 		uint32_t offset = 0;
@@ -364,12 +529,14 @@ void CallQueue::statistics() {
 
 			Message *message = (Message *)&page->data[offset];
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
+			uint32_t advance = _get_message_size(message);
 
-			Object *target = message->callable.get_object();
+			Object *target = nullptr;
+			if ((message->type & FLAG_MASK) == TYPE_METHOD) {
+				target = ObjectDB::get_instance(((MethodCall *)(message + 1))->object_id);
+			} else {
+				target = message->callable.get_object();
+			}
 
 			bool null_target = true;
 			switch (message->type & FLAG_MASK) {
@@ -404,6 +571,12 @@ void CallQueue::statistics() {
 						null_target = false;
 					}
 				} break;
+				case TYPE_METHOD: {
+					if (target) {
+						method_count++;
+						null_target = false;
+					}
+				} break;
 			}
 			if (null_target) {
 				// Object was deleted.
@@ -414,19 +587,19 @@ void CallQueue::statistics() {
 
 			offset += advance;
 
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
-
-			message->~Message();
+			_destroy_message(message);
 		}
 	}
 
+	uint32_t thread_pages = 0;
+	for (const ThreadBuffer *buffer : thread_buffers) {
+		thread_pages += buffer->page_count.get();
+	}
+
 	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used, pages_used * PAGE_SIZE_BYTES);
+	fprintf(stdout, "THREAD BUFFER PAGES: %d (%d bytes).\n", thread_pages, thread_pages * PAGE_SIZE_BYTES);
 	fprintf(stdout, "NULL count: %d.\n", null_count);
+	fprintf(stdout, "METHOD count: %d.\n", method_count);
 
 	for (const KeyValue<StringName, int> &E : set_count) {
 		fprintf(stdout, "SET %s: %d.\n", String(E.key).utf8().get_data(), E.value);
@@ -448,6 +621,16 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
+	LOCK_MUTEX;
+	for (const ThreadBuffer *buffer : thread_buffers) {
+		const ThreadPage *page = buffer->read_page;
+		if (buffer->read_offset < page->bytes.get() || page->next.load(std::memory_order_acquire)) {
+			UNLOCK_MUTEX;
+			return true;
+		}
+	}
+	UNLOCK_MUTEX;
+
 	if (pages_used == 0) {
 		return false;
 	}
@@ -459,7 +642,23 @@ bool CallQueue::has_messages() const {
 }
 
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	LOCK_MUTEX;
+	int usage = pages.size() * PAGE_SIZE_BYTES;
+	for (const ThreadBuffer *buffer : thread_buffers) {
+		usage += buffer->page_count.get() * PAGE_SIZE_BYTES;
+	}
+	UNLOCK_MUTEX;
+	return usage;
+}
+
+void CallQueue::set_use_thread_buffers(bool p_enable) {
+	LOCK_MUTEX;
+	// Messages are only ordered across thread buffers if they were all pushed with this enabled.
+	if (thread_buffers.is_empty() && (pages_used == 0 || (pages_used == 1 && page_bytes[0] == 0))) {
+		use_thread_buffers = p_enable;
+	}
+	UNLOCK_MUTEX;
+	ERR_FAIL_COND_MSG(use_thread_buffers != p_enable, "Thread buffers can't be toggled while the queue has messages.");
 }
 
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
@@ -472,10 +671,16 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 	}
 	max_pages = p_max_pages;
 	error_text = p_error_text;
+	queue_id = last_queue_id.increment();
 }
 
 CallQueue::~CallQueue() {
 	clear();
+	// Threads that are still running free their buffer once they exit.
+	for (ThreadBuffer *buffer : thread_buffers) {
+		_release_thread_buffer(buffer);
+	}
+	thread_buffers.clear();
 	// Let go of pages.
 	for (uint32_t i = 0; i < pages.size(); i++) {
 		allocator->free(pages[i]);
@@ -511,6 +716,8 @@ MessageQueue::MessageQueue() :
 				"Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_mb' in project settings.") {
 	ERR_FAIL_COND_MSG(main_singleton != nullptr, "A MessageQueue singleton already exists.");
 	main_singleton = this;
+	// Deferred calls from worker threads go to lock-free per-thread buffers.
+	use_thread_buffers = true;
 }
 
 MessageQueue::~MessageQueue() {
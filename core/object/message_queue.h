@@ -37,8 +37,12 @@
 #include "core/os/thread_safe.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
+#include <atomic>
+#include <type_traits>
+
 class Object;
 
 class CallQueue {
@@ -57,18 +61,26 @@ public:
 	// Needs to lock because there can be multiple of these allocators in several threads.
 	typedef PagedAllocator<Page, true> Allocator;
 
+	// Call queued by push_method(). It is stored as is, without a Callable or Variant arguments.
+	struct MethodCall {
+		ObjectID object_id;
+		void (*invoke)(Object *p_object, MethodCall *p_call) = nullptr;
+		void (*destroy)(MethodCall *p_call) = nullptr;
+	};
+
 private:
 	enum {
 		TYPE_CALL,
 		TYPE_NOTIFICATION,
 		TYPE_SET,
+		TYPE_METHOD,
 		TYPE_END, // End marker.
 		FLAG_NULL_IS_OK = 1 << 13,
 		FLAG_SHOW_ERROR = 1 << 14,
 		FLAG_MASK = FLAG_NULL_IS_OK - 1,
 	};
 
-	Mutex mutex;
+	mutable Mutex mutex;
 
 	Allocator *allocator = nullptr;
 	bool allocator_is_custom = false;
@@ -88,10 +100,108 @@ private:
 		int16_t type;
 		union {
 			int16_t notification;
-			int16_t args;
+			int16_t args; // Argument count, or size of the MethodCall for TYPE_METHOD.
 		};
+		uint32_t order = 0; // Push order, used to merge thread buffers on flush.
+	};
+
+	// With use_thread_buffers, threads other than the main one push into their own chain
+	// of pages instead of waiting on the mutex. Each chain has a single writer (its thread)
+	// and a single reader (flush()), and pages are handed over through atomics.
+	struct ThreadPage {
+		uint8_t data[PAGE_SIZE_BYTES];
+		SafeNumeric<uint32_t> bytes; // Bytes published by the pushing thread.
+		std::atomic<ThreadPage *> next = nullptr;
+	};
+
+	struct ThreadBuffer {
+		SafeRefCount refcount; // Held by the queue and by the pushing thread.
+		SafeNumeric<uint32_t> page_count;
+		ThreadPage *write_page = nullptr; // Pushing thread only.
+		ThreadPage *read_page = nullptr; // Flushing thread only.
+		uint32_t read_offset = 0; // Flushing thread only.
+	};
+
+	struct ThreadBufferRef {
+		ThreadBuffer *buffer = nullptr;
+		uint64_t queue_id = 0;
+		~ThreadBufferRef();
 	};
 
+	// A thread can stage messages for a few queues at once (e.g. the MessageQueue and a process group).
+	enum {
+		THREAD_BUFFER_REFS = 4
+	};
+
+	static SafeNumeric<uint64_t> last_queue_id;
+	static thread_local ThreadBufferRef thread_buffer_refs[THREAD_BUFFER_REFS];
+	static thread_local uint32_t thread_buffer_next_ref;
+
+	bool use_thread_buffers = false;
+	uint64_t queue_id = 0;
+	SafeNumeric<uint32_t> push_order;
+	LocalVector<ThreadBuffer *> thread_buffers;
+
+	ThreadBuffer *_get_thread_buffer();
+	static void _release_thread_buffer(ThreadBuffer *p_buffer);
+	Message *_peek_thread_buffer(ThreadBuffer *p_buffer);
+	void _release_exited_thread_buffers();
+
+	static uint32_t _get_message_size(const Message *p_message);
+	static void _destroy_message(Message *p_message);
+
+	// Returns where to construct a message of p_room_needed bytes, or nullptr if the queue is full.
+	// Unless it fails, it must be followed by _push_commit().
+	uint8_t *_push_reserve(uint32_t p_room_needed, ThreadBuffer *&r_thread_buffer);
+	void _push_commit(Message *p_message, uint32_t p_room_needed, ThreadBuffer *p_thread_buffer);
+
+	template <typename T>
+	struct MethodCall0 : public MethodCall {
+		void (T::*method)();
+
+		static void _invoke(Object *p_object, MethodCall *p_call) {
+			(static_cast<T *>(p_object)->*static_cast<MethodCall0 *>(p_call)->method)();
+		}
+	};
+
+	template <typename T, typename P>
+	struct MethodCall1 : public MethodCall {
+		void (T::*method)(P);
+		std::decay_t<P> arg;
+
+		static void _invoke(Object *p_object, MethodCall *p_call) {
+			MethodCall1 *call = static_cast<MethodCall1 *>(p_call);
+			(static_cast<T *>(p_object)->*call->method)(call->arg);
+		}
+	};
+
+	template <typename C>
+	static void _destroy_method_call(MethodCall *p_call) {
+		static_cast<C *>(p_call)->~C();
+	}
+
+	template <typename C>
+	C *_push_method_begin(Object *p_object, ThreadBuffer *&r_thread_buffer, Message *&r_message) {
+		static_assert(alignof(C) <= alignof(Message));
+		const uint32_t call_size = (sizeof(C) + alignof(Message) - 1) & ~uint32_t(alignof(Message) - 1);
+		uint8_t *buffer = _push_reserve(sizeof(Message) + call_size, r_thread_buffer);
+		if (!buffer) {
+			_push_method_failed();
+			return nullptr;
+		}
+		r_message = memnew_placement(buffer, Message);
+		r_message->type = TYPE_METHOD;
+		r_message->args = call_size;
+		C *call = memnew_placement(buffer + sizeof(Message), C);
+		call->object_id = _get_object_id(p_object);
+		call->invoke = &C::_invoke;
+		call->destroy = &_destroy_method_call<C>;
+		return call;
+	}
+
+	static ObjectID _get_object_id(Object *p_object);
+	void _push_method_failed();
+
 	_FORCE_INLINE_ void _ensure_first_page() {
 		if (unlikely(pages.is_empty())) {
 			pages.push_back(allocator->alloc());
@@ -146,6 +256,35 @@ public:
 	Error push_notification(Object *p_object, int p_notification);
 	Error push_set(Object *p_object, const StringName &p_prop, const Variant &p_value);
 
+	// Faster alternatives to deferring callable_mp() calls with no or one argument.
+	// They don't allocate a Callable nor box the argument into a Variant.
+	template <typename T>
+	Error push_method(T *p_object, void (T::*p_method)()) {
+		ThreadBuffer *thread_buffer = nullptr;
+		Message *message = nullptr;
+		MethodCall0<T> *call = _push_method_begin<MethodCall0<T>>(p_object, thread_buffer, message);
+		if (unlikely(!call)) {
+			return ERR_OUT_OF_MEMORY;
+		}
+		call->method = p_method;
+		_push_commit(message, sizeof(Message) + message->args, thread_buffer);
+		return OK;
+	}
+
+	template <typename T, typename P, typename A>
+	Error push_method(T *p_object, void (T::*p_method)(P), A &&p_arg) {
+		ThreadBuffer *thread_buffer = nullptr;
+		Message *message = nullptr;
+		MethodCall1<T, P> *call = _push_method_begin<MethodCall1<T, P>>(p_object, thread_buffer, message);
+		if (unlikely(!call)) {
+			return ERR_OUT_OF_MEMORY;
+		}
+		call->method = p_method;
+		call->arg = std::forward<A>(p_arg);
+		_push_commit(message, sizeof(Message) + message->args, thread_buffer);
+		return OK;
+	}
+
 	Error flush();
 	void clear();
 	void statistics();
@@ -155,6 +294,8 @@ public:
 	bool is_flushing() const;
 	int get_max_buffer_usage() const;
 
+	void set_use_thread_buffers(bool p_enable);
+
 	CallQueue(Allocator *p_custom_allocator = nullptr, uint32_t p_max_pages = 8192, const String &p_error_text = String());
 	virtual ~CallQueue();
 };
@@ -1166,6 +1166,23 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 }
 
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
+	return _emit_signalp(p_name, p_args, p_argcount);
+}
+
+void Object::SignalData::update_snapshot() {
+	snapshot.resize(slot_map.size());
+	SnapshotSlot *snapshot_slots = snapshot.ptrw();
+	uint32_t slot_count = 0;
+	has_one_shot = false;
+	for (const KeyValue<Callable, Slot> &slot_kv : slot_map) {
+		snapshot_slots[slot_count].callable = slot_kv.value.conn.callable;
+		snapshot_slots[slot_count].flags = slot_kv.value.conn.flags;
+		has_one_shot = has_one_shot || (slot_kv.value.conn.flags & CONNECT_ONE_SHOT);
+		++slot_count;
+	}
+}
+
+Error Object::_emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount, const void **p_typed_args, const void *p_signature, BoxSignalArgsFunc p_box_args) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
 	}
@@ -1186,30 +1203,24 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 	Ref<RefCounted> rc = Ref<RefCounted>(Object::cast_to<RefCounted>(this));
 
 	// Ensure that disconnecting the signal or even deleting the object
-	// will not affect the signal calling.
-	Callable *slot_callables = (Callable *)alloca(sizeof(Callable) * s->slot_map.size());
-	uint32_t *slot_flags = (uint32_t *)alloca(sizeof(uint32_t) * s->slot_map.size());
-	uint32_t slot_count = 0;
-
-	for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-		memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-		slot_flags[slot_count] = slot_kv.value.conn.flags;
-		++slot_count;
-	}
-
-	DEV_ASSERT(slot_count == s->slot_map.size());
+	// will not affect the signal calling. This only references the snapshot.
+	const Vector<SignalData::SnapshotSlot> slots = s->snapshot;
+	const SignalData::SnapshotSlot *slot_ptr = slots.ptr();
+	const uint32_t slot_count = slots.size();
 
 	// Disconnect all one-shot connections before emitting to prevent recursion.
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+	if (s->has_one_shot) {
+		for (uint32_t i = 0; i < slot_count; ++i) {
+			bool disconnect = slot_ptr[i].flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-		if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
-			// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
-			disconnect = false;
-		}
+			if (disconnect && (slot_ptr[i].flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+				// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
+				disconnect = false;
+			}
 #endif
-		if (disconnect) {
-			_disconnect(p_name, slot_callables[i]);
+			if (disconnect) {
+				_disconnect(p_name, slot_ptr[i].callable);
+			}
 		}
 	}
 
@@ -1217,15 +1228,39 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 
 	Error err = OK;
 
+	// Typed arguments are only converted to Variants if a connection needs them.
+	Variant *boxed_args = nullptr;
+	const Variant **boxed_argptrs = nullptr;
+
 	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
+		const Callable &callable = slot_ptr[i].callable;
+		const uint32_t &flags = slot_ptr[i].flags;
 
 		if (!callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
 			continue;
 		}
 
+		if (p_typed_args && !(flags & CONNECT_DEFERRED) && callable.is_custom()) {
+			_emitting = true;
+			bool called = callable.get_custom()->call_typed(p_signature, p_typed_args);
+			_emitting = false;
+			if (called) {
+				continue;
+			}
+		}
+
+		if (p_typed_args && !p_args) {
+			boxed_args = (Variant *)alloca(sizeof(Variant) * p_argcount);
+			boxed_argptrs = (const Variant **)alloca(sizeof(Variant *) * p_argcount);
+			for (int j = 0; j < p_argcount; j++) {
+				memnew_placement(&boxed_args[j], Variant);
+				boxed_argptrs[j] = &boxed_args[j];
+			}
+			p_box_args(p_typed_args, boxed_args);
+			p_args = boxed_argptrs;
+		}
+
 		const Variant **args = p_args;
 		int argc = p_argcount;
 
@@ -1255,8 +1290,10 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
+	if (boxed_args) {
+		for (int j = 0; j < p_argcount; j++) {
+			boxed_args[j].~Variant();
+		}
 	}
 
 	return err;
@@ -1472,6 +1509,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->update_snapshot();
 
 	return OK;
 }
@@ -1547,6 +1585,7 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->update_snapshot();
 
 	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
@@ -619,9 +619,21 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		struct SnapshotSlot {
+			Callable callable;
+			uint32_t flags = 0;
+		};
+
 		MethodInfo user;
 		HashMap<Callable, Slot, HashableHasher<Callable>> slot_map;
+		// Immutable copy of the connections, rebuilt whenever they change.
+		// Emitting only references it, so it doesn't allocate, doesn't write to the signal
+		// and isn't affected by connections changing from within the callbacks.
+		Vector<SnapshotSlot> snapshot;
+		bool has_one_shot = false;
 		bool removable = false;
+
+		void update_snapshot();
 	};
 
 	HashMap<StringName, SignalData> signal_map;
@@ -652,6 +664,18 @@ private:
 	bool _has_user_signal(const StringName &p_name) const;
 	void _remove_user_signal(const StringName &p_name);
 	Error _emit_signal(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+
+	typedef void (*BoxSignalArgsFunc)(const void **p_args, Variant *r_args);
+	template <typename... P, size_t... Is>
+	static void _box_signal_args_helper(const void **p_args, Variant *r_args, IndexSequence<Is...>) {
+		((r_args[Is] = Variant(*(const P *)p_args[Is])), ...);
+	}
+	template <typename... P>
+	static void _box_signal_args(const void **p_args, Variant *r_args) {
+		_box_signal_args_helper<P...>(p_args, r_args, BuildIndexSequence<sizeof...(P)>{});
+	}
+	// Either p_args, or p_typed_args with their signature and conversion to Variants, are given.
+	Error _emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount, const void **p_typed_args = nullptr, const void *p_signature = nullptr, BoxSignalArgsFunc p_box_args = nullptr);
 	TypedArray<Dictionary> _get_signal_list() const;
 	TypedArray<Dictionary> _get_signal_connection_list(const StringName &p_signal) const;
 	TypedArray<Dictionary> _get_incoming_connections() const;
@@ -935,6 +959,14 @@ public:
 		return emit_signalp(p_name, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args));
 	}
 
+	// Passes the arguments as is to connected method pointers with matching parameters,
+	// and only converts them to Variants for other kinds of connections.
+	template <typename... P>
+	Error emit_signal_typed(const StringName &p_name, const P &...p_args) {
+		const void *args[sizeof...(P) + 1] = { &p_args..., nullptr };
+		return _emit_signalp(p_name, nullptr, sizeof...(P), args, CallableTypedSignature<P...>::get(), &_box_signal_args<P...>);
+	}
+
 	MTVIRTUAL Error emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount);
 	MTVIRTUAL bool has_signal(const StringName &p_name) const;
 	MTVIRTUAL void get_signal_list(List<MethodInfo> *p_signals) const;
@@ -0,0 +1,205 @@
+/**************************************************************************/
+/*  frame_allocator.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_allocator.h"
+
+#include <string.h>
+
+SafeNumeric<uint64_t> FrameAllocator::frame;
+
+namespace {
+
+// Placed before each allocation, keeps blocks aligned like Memory does.
+struct alignas(16) AllocationHeader {
+	uint64_t size;
+	struct Arena *arena;
+};
+
+static_assert(sizeof(AllocationHeader) == 16);
+
+_FORCE_INLINE_ size_t allocation_size(size_t p_bytes) {
+	return sizeof(AllocationHeader) + ((p_bytes + 15) & ~size_t(15));
+}
+
+struct Arena {
+	uint8_t *block = nullptr;
+	size_t block_size = 0;
+	size_t offset = 0;
+	uint32_t live = 0;
+
+	// Full blocks that still have live allocations, freed once the arena is rewound.
+	LocalVector<uint8_t *> retired_blocks;
+	size_t retired_size = 0;
+
+	uint64_t frame = 0;
+	size_t frame_peak = 0;
+
+	FrameAllocator::Stats stats;
+
+	void set_block(size_t p_size) {
+		if (block) {
+			memfree(block);
+		}
+		block = (uint8_t *)memalloc(p_size);
+		block_size = p_size;
+		offset = 0;
+		stats.block_allocations++;
+	}
+
+	// Only called with no live allocations.
+	void rewind() {
+		const uint64_t current_frame = FrameAllocator::get_frame();
+		if (!retired_blocks.is_empty()) {
+			// Needed more than one block, replace them with one that fits everything.
+			const size_t needed = retired_size + block_size;
+			for (uint8_t *retired : retired_blocks) {
+				memfree(retired);
+			}
+			retired_blocks.clear();
+			retired_size = 0;
+			set_block(next_power_of_2(needed));
+		} else if (frame != current_frame) {
+			// Give back memory if the last frame used much less than what's reserved.
+			if (block_size > FrameAllocator::BLOCK_SIZE && frame_peak * 4 < block_size) {
+				set_block(MAX(FrameAllocator::BLOCK_SIZE, next_power_of_2(frame_peak * 2)));
+			}
+			frame_peak = 0;
+		}
+		frame = current_frame;
+		offset = 0;
+		stats.reserved = block_size;
+	}
+
+	void grow(size_t p_needed) {
+		if (live == 0) {
+			set_block(MAX(block_size * 2, MAX(FrameAllocator::BLOCK_SIZE, next_power_of_2(p_needed))));
+		} else {
+			retired_blocks.push_back(block);
+			retired_size += block_size;
+			block = nullptr;
+			set_block(MAX(block_size * 2, next_power_of_2(p_needed)));
+		}
+		stats.reserved = retired_size + block_size;
+	}
+
+	~Arena() {
+		for (uint8_t *retired : retired_blocks) {
+			memfree(retired);
+		}
+		if (block) {
+			memfree(block);
+		}
+	}
+};
+
+thread_local Arena arena;
+
+} // namespace
+
+void *FrameAllocator::alloc(size_t p_bytes) {
+	Arena &a = arena;
+	if (unlikely(a.live == 0 && (a.offset != 0 || a.frame != frame.get() || !a.retired_blocks.is_empty()))) {
+		a.rewind();
+	}
+
+	const size_t needed = allocation_size(p_bytes);
+	if (unlikely(a.offset + needed > a.block_size)) {
+		a.grow(needed);
+	}
+
+	AllocationHeader *header = (AllocationHeader *)(a.block + a.offset);
+	header->size = p_bytes;
+	header->arena = &a;
+	a.offset += needed;
+	a.live++;
+	a.stats.allocations++;
+	a.frame_peak = MAX(a.frame_peak, a.retired_size + a.offset);
+	return header + 1;
+}
+
+void *FrameAllocator::realloc(void *p_memory, size_t p_bytes) {
+	if (!p_memory) {
+		return alloc(p_bytes);
+	}
+	if (p_bytes == 0) {
+		free(p_memory);
+		return nullptr;
+	}
+
+	AllocationHeader *header = (AllocationHeader *)p_memory - 1;
+	Arena &a = arena;
+	ERR_FAIL_COND_V_MSG(header->arena != &a, nullptr, "Frame allocations must be reallocated by the thread that made them.");
+
+	// The last allocation can be resized in place.
+	uint8_t *end = (uint8_t *)header + allocation_size(header->size);
+	if (end == a.block + a.offset) {
+		const size_t offset = (uint8_t *)header - a.block;
+		if (offset + allocation_size(p_bytes) <= a.block_size) {
+			header->size = p_bytes;
+			a.offset = offset + allocation_size(p_bytes);
+			a.frame_peak = MAX(a.frame_peak, a.retired_size + a.offset);
+			return p_memory;
+		}
+	} else if (p_bytes <= header->size) {
+		return p_memory;
+	}
+
+	void *mem = alloc(p_bytes);
+	memcpy(mem, p_memory, MIN(p_bytes, size_t(header->size)));
+	free(p_memory);
+	return mem;
+}
+
+void FrameAllocator::free(void *p_memory) {
+	if (!p_memory) {
+		return;
+	}
+
+	AllocationHeader *header = (AllocationHeader *)p_memory - 1;
+	Arena &a = arena;
+	ERR_FAIL_COND_MSG(header->arena != &a, "Frame allocations must be freed by the thread that made them.");
+
+	// Freeing the last allocation makes its space reusable right away.
+	uint8_t *end = (uint8_t *)header + allocation_size(header->size);
+	if (end == a.block + a.offset) {
+		a.offset = (uint8_t *)header - a.block;
+	}
+	a.live--;
+}
+
+void FrameAllocator::end_frame() {
+	frame.increment();
+}
+
+FrameAllocator::Stats FrameAllocator::get_thread_stats() {
+	return arena.stats;
+}
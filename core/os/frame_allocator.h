@@ -0,0 +1,75 @@
+/**************************************************************************/
+/*  frame_allocator.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FRAME_ALLOCATOR_H
+#define FRAME_ALLOCATOR_H
+
+#include "core/templates/local_vector.h"
+
+// Bump allocator for temporaries that don't outlive the frame, with an arena
+// per thread. Allocating is a pointer increment and freeing only decrements a
+// counter; the arena is rewound once everything allocated from it is freed,
+// which for per-frame temporaries happens at least once per frame. Memory
+// taken by the arena during spikes is given back by end_frame().
+//
+// Blocks must be freed by the thread that allocated them, and must not be kept
+// in long-lived objects, as that keeps the arena from being rewound.
+//
+// Use it through FrameLocalVector for scratch arrays in per-frame code.
+class FrameAllocator {
+	static SafeNumeric<uint64_t> frame;
+
+public:
+	static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+	struct Stats {
+		uint64_t allocations = 0; // Allocations served by the arena.
+		uint64_t block_allocations = 0; // Blocks the arena requested from Memory.
+		uint64_t reserved = 0; // Size of the blocks currently owned by the arena.
+	};
+
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_bytes);
+	static void free(void *p_memory);
+
+	// Called by Main::iteration once per frame.
+	static void end_frame();
+	static uint64_t get_frame() { return frame.get(); }
+
+	// Statistics of the calling thread's arena.
+	static Stats get_thread_stats();
+};
+
+template <typename T, bool force_trivial = false>
+using FrameLocalVector = LocalVector<T, uint32_t, force_trivial, false, FrameAllocator>;
+
+#endif // FRAME_ALLOCATOR_H
@@ -34,9 +34,23 @@
 
 #include "core/templates/safe_refcount.h"
 
+#ifdef THREAD_CACHE_ALLOCATOR_ENABLED
+#include "core/os/thread_cache_allocator.h"
+#endif
+
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef THREAD_CACHE_ALLOCATOR_ENABLED
+#define _memory_malloc(m_size) ThreadCacheAllocator::alloc(m_size)
+#define _memory_realloc(m_mem, m_size) ThreadCacheAllocator::realloc(m_mem, m_size)
+#define _memory_free(m_mem) ThreadCacheAllocator::free(m_mem)
+#else
+#define _memory_malloc(m_size) malloc(m_size)
+#define _memory_realloc(m_mem, m_size) realloc(m_mem, m_size)
+#define _memory_free(m_mem) free(m_mem)
+#endif
+
 void *operator new(size_t p_size, const char *p_description) {
 	return Memory::alloc_static(p_size, false);
 }
@@ -62,9 +76,9 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 #ifdef DEBUG_ENABLED
 SafeNumeric<uint64_t> Memory::mem_usage;
 SafeNumeric<uint64_t> Memory::max_usage;
-#endif
 
-SafeNumeric<uint64_t> Memory::alloc_count;
+static thread_local uint64_t thread_alloc_count = 0;
+#endif
 
 void *Memory::alloc_aligned_static(size_t p_bytes, size_t p_alignment) {
 	DEV_ASSERT(is_power_of_2(p_alignment));
@@ -105,11 +119,13 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
-	void *mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+	void *mem = _memory_malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
 
 	ERR_FAIL_NULL_V(mem, nullptr);
 
-	alloc_count.increment();
+#ifdef DEBUG_ENABLED
+	thread_alloc_count++;
+#endif
 
 	if (prepad) {
 		uint8_t *s8 = (uint8_t *)mem;
@@ -140,6 +156,10 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
+#ifdef DEBUG_ENABLED
+	thread_alloc_count++;
+#endif
+
 	if (prepad) {
 		mem -= DATA_OFFSET;
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
@@ -154,12 +174,12 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 #endif
 
 		if (p_bytes == 0) {
-			free(mem);
+			_memory_free(mem);
 			return nullptr;
 		} else {
 			*s = p_bytes;
 
-			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
+			mem = (uint8_t *)_memory_realloc(mem, p_bytes + DATA_OFFSET);
 			ERR_FAIL_NULL_V(mem, nullptr);
 
 			s = (uint64_t *)(mem + SIZE_OFFSET);
@@ -169,7 +189,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 			return mem + DATA_OFFSET;
 		}
 	} else {
-		mem = (uint8_t *)realloc(mem, p_bytes);
+		mem = (uint8_t *)_memory_realloc(mem, p_bytes);
 
 		ERR_FAIL_COND_V(mem == nullptr && p_bytes > 0, nullptr);
 
@@ -188,8 +208,6 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
-	alloc_count.decrement();
-
 	if (prepad) {
 		mem -= DATA_OFFSET;
 
@@ -198,9 +216,9 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 		mem_usage.sub(*s);
 #endif
 
-		free(mem);
+		_memory_free(mem);
 	} else {
-		free(mem);
+		_memory_free(mem);
 	}
 }
 
@@ -224,6 +242,12 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+#ifdef DEBUG_ENABLED
+uint64_t Memory::get_thread_alloc_count() {
+	return thread_alloc_count;
+}
+#endif
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
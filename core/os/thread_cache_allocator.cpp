@@ -0,0 +1,447 @@
+/**************************************************************************/
+/*  thread_cache_allocator.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "thread_cache_allocator.h"
+
+#include "core/os/spin_lock.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+
+namespace {
+
+struct FreeBlock {
+	FreeBlock *next;
+};
+
+constexpr uint32_t SIZE_CLASS_COUNT = ThreadCacheAllocator::SIZE_CLASS_COUNT;
+constexpr size_t MAX_SMALL_SIZE = ThreadCacheAllocator::MAX_SMALL_SIZE;
+constexpr uint32_t CHUNK_SHIFT = ThreadCacheAllocator::CHUNK_SHIFT;
+constexpr size_t CHUNK_SIZE = ThreadCacheAllocator::CHUNK_SIZE;
+
+static_assert(ThreadCacheAllocator::get_size_class_size(SIZE_CLASS_COUNT - 1) == MAX_SMALL_SIZE);
+
+struct SizeClassTable {
+	uint8_t classes[MAX_SMALL_SIZE / 16] = {};
+
+	constexpr SizeClassTable() {
+		uint32_t size_class = 0;
+		for (uint32_t i = 0; i < MAX_SMALL_SIZE / 16; i++) {
+			while (ThreadCacheAllocator::get_size_class_size(size_class) < (i + 1) * 16) {
+				size_class++;
+			}
+			classes[i] = size_class;
+		}
+	}
+};
+
+constexpr SizeClassTable size_class_table;
+
+// Blocks moved between a thread cache and the central list at once. Keeps
+// about 32 KiB per transfer for small classes.
+constexpr uint32_t get_batch_size(uint32_t p_size_class) {
+	uint32_t batch = uint32_t((32 * 1024) / ThreadCacheAllocator::get_size_class_size(p_size_class));
+	return batch < 4 ? 4 : (batch > 64 ? 64 : batch);
+}
+
+// Maps chunk addresses to their size class + 1, 0 for memory that isn't a chunk.
+// Pointers outside the mapped address range are always passed through.
+constexpr uint32_t ADDRESS_BITS = sizeof(void *) == 8 ? 48 : 32;
+constexpr uint32_t PAGEMAP_BITS = ADDRESS_BITS - CHUNK_SHIFT;
+constexpr uint32_t LEAF_BITS = PAGEMAP_BITS / 2;
+constexpr uint32_t ROOT_BITS = PAGEMAP_BITS - LEAF_BITS;
+
+std::atomic<uint8_t *> pagemap[1 << ROOT_BITS];
+
+_FORCE_INLINE_ uint32_t pagemap_get(const void *p_memory) {
+	uintptr_t index = uintptr_t(p_memory) >> CHUNK_SHIFT;
+	if (unlikely(index >> PAGEMAP_BITS)) {
+		return 0;
+	}
+	const uint8_t *leaf = pagemap[index >> LEAF_BITS].load(std::memory_order_acquire);
+	if (!leaf) {
+		return 0;
+	}
+	return leaf[index & ((uintptr_t(1) << LEAF_BITS) - 1)];
+}
+
+// Blocks passed through to the system allocator (large blocks, and small ones
+// when no chunk can be allocated) are prefixed with their size, as realloc()
+// can't tell them apart otherwise. Keeps the alignment of max_align_t.
+constexpr size_t SYSTEM_HEADER_SIZE = 16;
+
+void *system_alloc(size_t p_bytes) {
+	if (unlikely(p_bytes > SIZE_MAX - SYSTEM_HEADER_SIZE)) {
+		return nullptr;
+	}
+	uint8_t *mem = (uint8_t *)malloc(p_bytes + SYSTEM_HEADER_SIZE);
+	if (!mem) {
+		return nullptr;
+	}
+	*(size_t *)mem = p_bytes;
+	return mem + SYSTEM_HEADER_SIZE;
+}
+
+void *system_realloc(void *p_memory, size_t p_bytes) {
+	if (unlikely(p_bytes > SIZE_MAX - SYSTEM_HEADER_SIZE)) {
+		return nullptr;
+	}
+	uint8_t *mem = (uint8_t *)::realloc((uint8_t *)p_memory - SYSTEM_HEADER_SIZE, p_bytes + SYSTEM_HEADER_SIZE);
+	if (!mem) {
+		return nullptr;
+	}
+	*(size_t *)mem = p_bytes;
+	return mem + SYSTEM_HEADER_SIZE;
+}
+
+_FORCE_INLINE_ void system_free(void *p_memory) {
+	::free((uint8_t *)p_memory - SYSTEM_HEADER_SIZE);
+}
+
+_FORCE_INLINE_ size_t system_get_size(const void *p_memory) {
+	return *(const size_t *)((const uint8_t *)p_memory - SYSTEM_HEADER_SIZE);
+}
+
+struct CentralList {
+	SpinLock lock;
+	FreeBlock *head = nullptr;
+	uint32_t count = 0;
+};
+
+CentralList central_lists[SIZE_CLASS_COUNT];
+
+// Chunks are carved out of regions, which are allocated from the system.
+constexpr uint32_t CHUNKS_PER_REGION = 16;
+
+SpinLock chunk_lock;
+uint8_t *region_next_chunk = nullptr;
+uint32_t region_chunks_left = 0;
+bool chunks_unavailable = false;
+
+std::atomic<uint64_t> stat_reserved;
+std::atomic<uint64_t> stat_central_free;
+std::atomic<uint64_t> stat_chunk_count;
+
+// Called with chunk_lock held.
+bool pagemap_set(const void *p_chunk, uint8_t p_value) {
+	uintptr_t index = uintptr_t(p_chunk) >> CHUNK_SHIFT;
+	if (index >> PAGEMAP_BITS) {
+		return false;
+	}
+	uint8_t *leaf = pagemap[index >> LEAF_BITS].load(std::memory_order_relaxed);
+	if (!leaf) {
+		leaf = (uint8_t *)calloc(size_t(1) << LEAF_BITS, 1);
+		if (!leaf) {
+			return false;
+		}
+		pagemap[index >> LEAF_BITS].store(leaf, std::memory_order_release);
+	}
+	leaf[index & ((uintptr_t(1) << LEAF_BITS) - 1)] = p_value;
+	return true;
+}
+
+uint8_t *allocate_chunk(uint32_t p_size_class) {
+	chunk_lock.lock();
+	if (chunks_unavailable) {
+		chunk_lock.unlock();
+		return nullptr;
+	}
+	if (region_chunks_left == 0) {
+		uint8_t *region = (uint8_t *)malloc(CHUNKS_PER_REGION * CHUNK_SIZE + CHUNK_SIZE - 1);
+		if (!region) {
+			chunk_lock.unlock();
+			return nullptr;
+		}
+		stat_reserved.fetch_add(CHUNKS_PER_REGION * CHUNK_SIZE + CHUNK_SIZE - 1, std::memory_order_relaxed);
+		region_next_chunk = (uint8_t *)((uintptr_t(region) + CHUNK_SIZE - 1) & ~uintptr_t(CHUNK_SIZE - 1));
+		region_chunks_left = CHUNKS_PER_REGION;
+	}
+
+	uint8_t *chunk = region_next_chunk;
+	if (!pagemap_set(chunk, p_size_class + 1)) {
+		// Address can't be mapped (e.g. tagged pointers), use the system allocator from now on.
+		chunks_unavailable = true;
+		chunk_lock.unlock();
+		return nullptr;
+	}
+	region_next_chunk += CHUNK_SIZE;
+	region_chunks_left--;
+	stat_chunk_count.fetch_add(1, std::memory_order_relaxed);
+	chunk_lock.unlock();
+	return chunk;
+}
+
+// Pops up to p_max blocks from the central list, carving a new chunk if it's empty.
+// Returns the number of blocks in r_list.
+uint32_t central_pop(uint32_t p_size_class, uint32_t p_max, FreeBlock *&r_list) {
+	CentralList &central = central_lists[p_size_class];
+	const size_t block_size = ThreadCacheAllocator::get_size_class_size(p_size_class);
+
+	central.lock.lock();
+	if (central.count > 0) {
+		FreeBlock *head = central.head;
+		FreeBlock *tail = head;
+		uint32_t count = 1;
+		while (count < p_max && tail->next) {
+			tail = tail->next;
+			count++;
+		}
+		central.head = tail->next;
+		central.count -= count;
+		central.lock.unlock();
+		tail->next = nullptr;
+		stat_central_free.fetch_sub(count * block_size, std::memory_order_relaxed);
+		r_list = head;
+		return count;
+	}
+	central.lock.unlock();
+
+	uint8_t *chunk = allocate_chunk(p_size_class);
+	if (!chunk) {
+		r_list = nullptr;
+		return 0;
+	}
+
+	// Link all blocks in the chunk, keep p_max of them and give the rest to the central list.
+	const uint32_t block_count = uint32_t(CHUNK_SIZE / block_size);
+	const uint32_t keep = block_count < p_max ? block_count : p_max;
+	for (uint32_t i = 0; i < block_count; i++) {
+		FreeBlock *block = (FreeBlock *)(chunk + i * block_size);
+		block->next = (i + 1 < block_count && i + 1 != keep) ? (FreeBlock *)(chunk + (i + 1) * block_size) : nullptr;
+	}
+	r_list = (FreeBlock *)chunk;
+
+	if (block_count > keep) {
+		FreeBlock *rest_head = (FreeBlock *)(chunk + keep * block_size);
+		FreeBlock *rest_tail = (FreeBlock *)(chunk + (block_count - 1) * block_size);
+		central.lock.lock();
+		rest_tail->next = central.head;
+		central.head = rest_head;
+		central.count += block_count - keep;
+		central.lock.unlock();
+		stat_central_free.fetch_add((block_count - keep) * block_size, std::memory_order_relaxed);
+	}
+	return keep;
+}
+
+void central_push(uint32_t p_size_class, FreeBlock *p_head, FreeBlock *p_tail, uint32_t p_count) {
+	CentralList &central = central_lists[p_size_class];
+	central.lock.lock();
+	p_tail->next = central.head;
+	central.head = p_head;
+	central.count += p_count;
+	central.lock.unlock();
+	stat_central_free.fetch_add(p_count * ThreadCacheAllocator::get_size_class_size(p_size_class), std::memory_order_relaxed);
+}
+
+enum ThreadCacheState : uint8_t {
+	THREAD_CACHE_UNUSED,
+	THREAD_CACHE_ACTIVE,
+	THREAD_CACHE_FINALIZED, // Thread is exiting, blocks go straight to the central lists.
+};
+
+// Trivially destructible so it stays usable while other thread locals are destroyed.
+struct ThreadCache {
+	FreeBlock *lists[SIZE_CLASS_COUNT];
+	uint32_t counts[SIZE_CLASS_COUNT];
+	ThreadCacheState state;
+};
+
+thread_local ThreadCache thread_cache;
+
+struct ThreadCacheFinalizer {
+	bool registered = false;
+
+	~ThreadCacheFinalizer() {
+		ThreadCacheAllocator::flush_thread_cache();
+		thread_cache.state = THREAD_CACHE_FINALIZED;
+	}
+};
+
+thread_local ThreadCacheFinalizer thread_cache_finalizer;
+
+void *alloc_slow(ThreadCache &p_cache, uint32_t p_size_class) {
+	if (p_cache.state == THREAD_CACHE_UNUSED) {
+		thread_cache_finalizer.registered = true;
+		p_cache.state = THREAD_CACHE_ACTIVE;
+	}
+
+	FreeBlock *list;
+	uint32_t count = central_pop(p_size_class, p_cache.state == THREAD_CACHE_ACTIVE ? get_batch_size(p_size_class) : 1, list);
+	if (count == 0) {
+		return system_alloc(ThreadCacheAllocator::get_size_class_size(p_size_class));
+	}
+	if (count > 1) {
+		p_cache.lists[p_size_class] = list->next;
+		p_cache.counts[p_size_class] = count - 1;
+	}
+	return list;
+}
+
+void free_slow(ThreadCache &p_cache, uint32_t p_size_class, FreeBlock *p_block) {
+	if (p_cache.state == THREAD_CACHE_UNUSED) {
+		thread_cache_finalizer.registered = true;
+		p_cache.state = THREAD_CACHE_ACTIVE;
+	} else if (p_cache.state == THREAD_CACHE_FINALIZED) {
+		central_push(p_size_class, p_block, p_block, 1);
+		return;
+	}
+
+	p_block->next = p_cache.lists[p_size_class];
+	p_cache.lists[p_size_class] = p_block;
+	p_cache.counts[p_size_class]++;
+
+	// Too many cached, hand a batch back so other threads can use them.
+	const uint32_t batch = get_batch_size(p_size_class);
+	if (p_cache.counts[p_size_class] > batch * 2) {
+		FreeBlock *head = p_cache.lists[p_size_class];
+		FreeBlock *tail = head;
+		for (uint32_t i = 1; i < batch; i++) {
+			tail = tail->next;
+		}
+		p_cache.lists[p_size_class] = tail->next;
+		p_cache.counts[p_size_class] -= batch;
+		central_push(p_size_class, head, tail, batch);
+	}
+}
+
+} // namespace
+
+uint32_t ThreadCacheAllocator::get_size_class(size_t p_bytes) {
+	return size_class_table.classes[(p_bytes - 1) >> 4];
+}
+
+void *ThreadCacheAllocator::alloc(size_t p_bytes) {
+	if (unlikely(p_bytes > MAX_SMALL_SIZE)) {
+		return system_alloc(p_bytes);
+	}
+	const uint32_t size_class = p_bytes ? size_class_table.classes[(p_bytes - 1) >> 4] : 0;
+
+	ThreadCache &cache = thread_cache;
+	FreeBlock *block = cache.lists[size_class];
+	if (likely(block)) {
+		cache.lists[size_class] = block->next;
+		cache.counts[size_class]--;
+		return block;
+	}
+	return alloc_slow(cache, size_class);
+}
+
+void ThreadCacheAllocator::free(void *p_memory) {
+	if (!p_memory) {
+		return;
+	}
+	const uint32_t entry = pagemap_get(p_memory);
+	if (entry == 0) {
+		system_free(p_memory);
+		return;
+	}
+	const uint32_t size_class = entry - 1;
+
+	ThreadCache &cache = thread_cache;
+	if (likely(cache.state == THREAD_CACHE_ACTIVE && cache.counts[size_class] < get_batch_size(size_class) * 2)) {
+		FreeBlock *block = (FreeBlock *)p_memory;
+		block->next = cache.lists[size_class];
+		cache.lists[size_class] = block;
+		cache.counts[size_class]++;
+		return;
+	}
+	free_slow(cache, size_class, (FreeBlock *)p_memory);
+}
+
+void *ThreadCacheAllocator::realloc(void *p_memory, size_t p_bytes) {
+	if (!p_memory) {
+		return alloc(p_bytes);
+	}
+	if (p_bytes == 0) {
+		free(p_memory);
+		return nullptr;
+	}
+
+	const uint32_t entry = pagemap_get(p_memory);
+	if (entry == 0) {
+		if (p_bytes > MAX_SMALL_SIZE) {
+			return system_realloc(p_memory, p_bytes);
+		}
+		// Not necessarily shrinking, small blocks fall back to the system allocator
+		// when no chunk is available.
+		const size_t old_size = system_get_size(p_memory);
+		void *mem = alloc(p_bytes);
+		if (mem) {
+			memcpy(mem, p_memory, p_bytes < old_size ? p_bytes : old_size);
+			system_free(p_memory);
+		}
+		return mem;
+	}
+
+	const size_t block_size = get_size_class_size(entry - 1);
+	if (p_bytes <= block_size && p_bytes > block_size / 2) {
+		return p_memory;
+	}
+	void *mem = alloc(p_bytes);
+	if (mem) {
+		memcpy(mem, p_memory, p_bytes < block_size ? p_bytes : block_size);
+		free(p_memory);
+	}
+	return mem;
+}
+
+size_t ThreadCacheAllocator::get_block_size(const void *p_memory) {
+	const uint32_t entry = pagemap_get(p_memory);
+	return entry ? get_size_class_size(entry - 1) : 0;
+}
+
+void ThreadCacheAllocator::flush_thread_cache() {
+	ThreadCache &cache = thread_cache;
+	for (uint32_t i = 0; i < SIZE_CLASS_COUNT; i++) {
+		FreeBlock *head = cache.lists[i];
+		if (!head) {
+			continue;
+		}
+		FreeBlock *tail = head;
+		while (tail->next) {
+			tail = tail->next;
+		}
+		central_push(i, head, tail, cache.counts[i]);
+		cache.lists[i] = nullptr;
+		cache.counts[i] = 0;
+	}
+}
+
+ThreadCacheAllocator::Stats ThreadCacheAllocator::get_stats() {
+	Stats stats;
+	stats.reserved = stat_reserved.load(std::memory_order_relaxed);
+	stats.central_free = stat_central_free.load(std::memory_order_relaxed);
+	stats.chunk_count = stat_chunk_count.load(std::memory_order_relaxed);
+	return stats;
+}
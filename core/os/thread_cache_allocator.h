@@ -0,0 +1,93 @@
+/**************************************************************************/
+/*  thread_cache_allocator.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef THREAD_CACHE_ALLOCATOR_H
+#define THREAD_CACHE_ALLOCATOR_H
+
+#include "core/typedefs.h"
+
+#include <stddef.h>
+
+// Allocator for small blocks that keeps a cache of free blocks per thread, so
+// most allocations and frees don't need a lock or an atomic operation.
+//
+// Blocks up to MAX_SMALL_SIZE are rounded up to one of SIZE_CLASS_COUNT size
+// classes and carved out of CHUNK_SIZE chunks, each holding blocks of a single
+// class. A thread takes blocks from its own cache, refilling it in batches
+// from a central free list per class, and returns them there in batches when
+// it's holding too many. Blocks freed by another thread go to that thread's
+// cache. Larger blocks are passed through to the system allocator.
+//
+// The size class of a block is found from its address, so small blocks don't
+// need a header. Chunks are never returned to the system. Blocks passed through
+// to the system allocator are prefixed with their size.
+//
+// Memory uses it for its allocations when built with
+// `thread_cache_allocator=yes` (THREAD_CACHE_ALLOCATOR_ENABLED).
+class ThreadCacheAllocator {
+public:
+	static constexpr size_t MAX_SMALL_SIZE = 8192;
+	static constexpr uint32_t SIZE_CLASS_COUNT = 32;
+	static constexpr uint32_t CHUNK_SHIFT = 16;
+	static constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_SHIFT;
+
+	struct Stats {
+		uint64_t reserved = 0; // Memory taken from the system for chunks.
+		uint64_t central_free = 0; // Free blocks in the central lists, not cached by any thread.
+		uint64_t chunk_count = 0;
+	};
+
+	// Sizes go up in steps of 16 bytes up to 128, then in four steps per power of two.
+	static constexpr size_t get_size_class_size(uint32_t p_size_class) {
+		if (p_size_class < 8) {
+			return (p_size_class + 1) * 16;
+		}
+		uint32_t q = (p_size_class - 8) / 4;
+		uint32_t r = (p_size_class - 8) % 4;
+		return (size_t(1) << (7 + q)) + (r + 1) * (size_t(1) << (5 + q));
+	}
+
+	// Returns the size class used for p_bytes, which must be in [1, MAX_SMALL_SIZE].
+	static uint32_t get_size_class(size_t p_bytes);
+
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_bytes);
+	static void free(void *p_memory);
+
+	// Returns the usable size of a block allocated by this allocator, 0 if it's a large block.
+	static size_t get_block_size(const void *p_memory);
+	// Returns the blocks cached by the calling thread to the central lists.
+	static void flush_thread_cache();
+	static Stats get_stats();
+};
+
+#endif // THREAD_CACHE_ALLOCATOR_H
@@ -0,0 +1,343 @@
+/**************************************************************************/
+/*  string_simd.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef STRING_SIMD_H
+#define STRING_SIMD_H
+
+#include "core/typedefs.h"
+
+#include <string.h>
+
+// Vectorized helpers for the hot loops of String conversions and searches.
+// Each function has an SSE2 (x86/x86_64) or NEON (ARM64) path, and a scalar
+// path used for the tail and on other platforms.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STRING_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define STRING_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__)
+#define STRING_SIMD_CTZ32(x) __builtin_ctz(x)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+static _FORCE_INLINE_ int __string_simd_ctz32(uint32_t x) {
+	unsigned long index;
+	_BitScanForward(&index, x);
+	return index;
+}
+#define STRING_SIMD_CTZ32(x) __string_simd_ctz32(x)
+#endif
+
+// Returns the length of the leading run of ASCII bytes (below 0x80) in p_src.
+// The run also ends at a NUL byte, and at '\r' if p_stop_at_cr is set.
+static _FORCE_INLINE_ int string_ascii_prefix_length(const char *p_src, int p_len, bool p_stop_at_cr = false) {
+	int i = 0;
+#if defined(STRING_SIMD_SSE2) && defined(STRING_SIMD_CTZ32)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i cr = _mm_set1_epi8(p_stop_at_cr ? '\r' : 0);
+	for (; i + 16 <= p_len; i += 16) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(p_src + i));
+		const __m128i stop = _mm_or_si128(_mm_cmpeq_epi8(v, zero), _mm_cmpeq_epi8(v, cr));
+		const uint32_t mask = uint32_t(_mm_movemask_epi8(_mm_or_si128(v, stop)));
+		if (mask) {
+			return i + STRING_SIMD_CTZ32(mask);
+		}
+	}
+#elif defined(STRING_SIMD_NEON)
+	const uint8x16_t high = vdupq_n_u8(0x80);
+	const uint8x16_t cr = vdupq_n_u8(p_stop_at_cr ? '\r' : 0);
+	for (; i + 16 <= p_len; i += 16) {
+		const uint8x16_t v = vld1q_u8((const uint8_t *)(p_src + i));
+		const uint8x16_t stop = vorrq_u8(vorrq_u8(vceqzq_u8(v), vceqq_u8(v, cr)), vcgeq_u8(v, high));
+		if (vmaxvq_u8(stop)) {
+			break; // Locate the exact position below.
+		}
+	}
+#endif
+	for (; i < p_len; i++) {
+		const uint8_t c = uint8_t(p_src[i]);
+		if (c >= 0x80 || c == 0 || (p_stop_at_cr && c == '\r')) {
+			break;
+		}
+	}
+	return i;
+}
+
+// Returns the length of the leading run of ASCII characters (below 0x80) in p_src.
+static _FORCE_INLINE_ int string_ascii_prefix_length(const char32_t *p_src, int p_len) {
+	int i = 0;
+#if defined(STRING_SIMD_SSE2)
+	const __m128i high = _mm_set1_epi32(~0x7f);
+	for (; i + 16 <= p_len; i += 16) {
+		const __m128i *src = (const __m128i *)(p_src + i);
+		const __m128i any = _mm_or_si128(_mm_or_si128(_mm_loadu_si128(src), _mm_loadu_si128(src + 1)), _mm_or_si128(_mm_loadu_si128(src + 2), _mm_loadu_si128(src + 3)));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(any, high), _mm_setzero_si128())) != 0xffff) {
+			break; // Locate the exact position below.
+		}
+	}
+#elif defined(STRING_SIMD_NEON)
+	for (; i + 16 <= p_len; i += 16) {
+		const uint32_t *src = (const uint32_t *)(p_src + i);
+		const uint32x4_t any = vorrq_u32(vorrq_u32(vld1q_u32(src), vld1q_u32(src + 4)), vorrq_u32(vld1q_u32(src + 8), vld1q_u32(src + 12)));
+		if (vmaxvq_u32(any) > 0x7f) {
+			break; // Locate the exact position below.
+		}
+	}
+#endif
+	for (; i < p_len; i++) {
+		if (uint32_t(p_src[i]) > 0x7f) {
+			break;
+		}
+	}
+	return i;
+}
+
+// Zero-extends p_len Latin-1 bytes from p_src into p_dst.
+static _FORCE_INLINE_ void string_widen_latin1(char32_t *p_dst, const char *p_src, int p_len) {
+	int i = 0;
+#if defined(STRING_SIMD_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 16 <= p_len; i += 16) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(p_src + i));
+		const __m128i lo = _mm_unpacklo_epi8(v, zero);
+		const __m128i hi = _mm_unpackhi_epi8(v, zero);
+		__m128i *dst = (__m128i *)(p_dst + i);
+		_mm_storeu_si128(dst, _mm_unpacklo_epi16(lo, zero));
+		_mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(lo, zero));
+		_mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(hi, zero));
+		_mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(hi, zero));
+	}
+#elif defined(STRING_SIMD_NEON)
+	for (; i + 16 <= p_len; i += 16) {
+		const uint8x16_t v = vld1q_u8((const uint8_t *)(p_src + i));
+		const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+		const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+		uint32_t *dst = (uint32_t *)(p_dst + i);
+		vst1q_u32(dst, vmovl_u16(vget_low_u16(lo)));
+		vst1q_u32(dst + 4, vmovl_u16(vget_high_u16(lo)));
+		vst1q_u32(dst + 8, vmovl_u16(vget_low_u16(hi)));
+		vst1q_u32(dst + 12, vmovl_u16(vget_high_u16(hi)));
+	}
+#endif
+	for (; i < p_len; i++) {
+		p_dst[i] = uint8_t(p_src[i]);
+	}
+}
+
+// Truncates p_len characters from p_src into bytes in p_dst. All characters must be below 0x100.
+static _FORCE_INLINE_ void string_narrow_latin1(char *p_dst, const char32_t *p_src, int p_len) {
+	int i = 0;
+#if defined(STRING_SIMD_SSE2)
+	for (; i + 16 <= p_len; i += 16) {
+		const __m128i *src = (const __m128i *)(p_src + i);
+		const __m128i lo = _mm_packs_epi32(_mm_loadu_si128(src), _mm_loadu_si128(src + 1));
+		const __m128i hi = _mm_packs_epi32(_mm_loadu_si128(src + 2), _mm_loadu_si128(src + 3));
+		_mm_storeu_si128((__m128i *)(p_dst + i), _mm_packus_epi16(lo, hi));
+	}
+#elif defined(STRING_SIMD_NEON)
+	for (; i + 16 <= p_len; i += 16) {
+		const uint32_t *src = (const uint32_t *)(p_src + i);
+		const uint16x8_t lo = vcombine_u16(vmovn_u32(vld1q_u32(src)), vmovn_u32(vld1q_u32(src + 4)));
+		const uint16x8_t hi = vcombine_u16(vmovn_u32(vld1q_u32(src + 8)), vmovn_u32(vld1q_u32(src + 12)));
+		vst1q_u8((uint8_t *)(p_dst + i), vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+	}
+#endif
+	for (; i < p_len; i++) {
+		p_dst[i] = char(p_src[i]);
+	}
+}
+
+// Returns the index of the first p_char in p_src at or after p_from, or -1.
+static _FORCE_INLINE_ int string_find_char(const char32_t *p_src, int p_len, char32_t p_char, int p_from = 0) {
+	int i = p_from;
+#if defined(STRING_SIMD_SSE2) && defined(STRING_SIMD_CTZ32)
+	const __m128i needle = _mm_set1_epi32(int(p_char));
+	for (; i + 4 <= p_len; i += 4) {
+		const uint32_t mask = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p_src + i)), needle)));
+		if (mask) {
+			return i + (STRING_SIMD_CTZ32(mask) >> 2);
+		}
+	}
+#elif defined(STRING_SIMD_NEON)
+	const uint32x4_t needle = vdupq_n_u32(uint32_t(p_char));
+	for (; i + 4 <= p_len; i += 4) {
+		if (vmaxvq_u32(vceqq_u32(vld1q_u32((const uint32_t *)(p_src + i)), needle))) {
+			break; // Locate the exact position below.
+		}
+	}
+#endif
+	for (; i < p_len; i++) {
+		if (p_src[i] == p_char) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Returns the index of the first occurrence of p_needle in p_src at or after p_from, or -1.
+// Candidates are filtered by comparing the first and last needle characters four positions at a time.
+static _FORCE_INLINE_ int string_find(const char32_t *p_src, int p_len, const char32_t *p_needle, int p_needle_len, int p_from = 0) {
+	if (p_needle_len <= 0) {
+		return -1;
+	}
+	const char32_t first = p_needle[0];
+	const char32_t last = p_needle[p_needle_len - 1];
+	const int middle_bytes = p_needle_len > 2 ? (p_needle_len - 2) * sizeof(char32_t) : 0;
+	const int end = p_len - p_needle_len; // Last position a match can start at.
+	int i = p_from;
+#if defined(STRING_SIMD_SSE2) && defined(STRING_SIMD_CTZ32)
+	const __m128i first_v = _mm_set1_epi32(int(first));
+	const __m128i last_v = _mm_set1_epi32(int(last));
+	for (; i + 3 <= end; i += 4) {
+		const __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p_src + i)), first_v);
+		const __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p_src + i + p_needle_len - 1)), last_v);
+		uint32_t mask = uint32_t(_mm_movemask_epi8(_mm_and_si128(a, b)));
+		while (mask) {
+			const int lane = STRING_SIMD_CTZ32(mask) >> 2;
+			if (memcmp(p_src + i + lane + 1, p_needle + 1, middle_bytes) == 0) {
+				return i + lane;
+			}
+			mask &= ~(0xfu << (lane * 4));
+		}
+	}
+#elif defined(STRING_SIMD_NEON)
+	const uint32x4_t first_v = vdupq_n_u32(uint32_t(first));
+	const uint32x4_t last_v = vdupq_n_u32(uint32_t(last));
+	for (; i + 3 <= end; i += 4) {
+		const uint32x4_t a = vceqq_u32(vld1q_u32((const uint32_t *)(p_src + i)), first_v);
+		const uint32x4_t b = vceqq_u32(vld1q_u32((const uint32_t *)(p_src + i + p_needle_len - 1)), last_v);
+		if (vmaxvq_u32(vandq_u32(a, b))) {
+			for (int lane = 0; lane < 4; lane++) {
+				if (p_src[i + lane] == first && p_src[i + lane + p_needle_len - 1] == last && memcmp(p_src + i + lane + 1, p_needle + 1, middle_bytes) == 0) {
+					return i + lane;
+				}
+			}
+		}
+	}
+#endif
+	for (; i <= end; i++) {
+		if (p_src[i] == first && p_src[i + p_needle_len - 1] == last && memcmp(p_src + i + 1, p_needle + 1, middle_bytes) == 0) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Returns the index of the first character at or after p_from that may lower-case to the ASCII
+// letter or symbol p_lower, or -1. Non-ASCII characters are always reported, as some of them
+// lower-case to ASCII (e.g. U+212A KELVIN SIGN), so callers must check candidates themselves.
+static _FORCE_INLINE_ int string_find_nocase_candidate(const char32_t *p_src, int p_len, char32_t p_lower, int p_from = 0) {
+	const char32_t upper = (p_lower >= 'a' && p_lower <= 'z') ? p_lower - ('a' - 'A') : p_lower;
+	int i = p_from;
+#if defined(STRING_SIMD_SSE2) && defined(STRING_SIMD_CTZ32)
+	const __m128i lower_v = _mm_set1_epi32(int(p_lower));
+	const __m128i upper_v = _mm_set1_epi32(int(upper));
+	const __m128i high = _mm_set1_epi32(~0x7f);
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 4 <= p_len; i += 4) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(p_src + i));
+		const __m128i non_ascii = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(v, high), zero), _mm_set1_epi32(-1));
+		const __m128i match = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(v, lower_v), _mm_cmpeq_epi32(v, upper_v)), non_ascii);
+		const uint32_t mask = uint32_t(_mm_movemask_epi8(match));
+		if (mask) {
+			return i + (STRING_SIMD_CTZ32(mask) >> 2);
+		}
+	}
+#elif defined(STRING_SIMD_NEON)
+	const uint32x4_t lower_v = vdupq_n_u32(uint32_t(p_lower));
+	const uint32x4_t upper_v = vdupq_n_u32(uint32_t(upper));
+	const uint32x4_t ascii_max = vdupq_n_u32(0x7f);
+	for (; i + 4 <= p_len; i += 4) {
+		const uint32x4_t v = vld1q_u32((const uint32_t *)(p_src + i));
+		const uint32x4_t match = vorrq_u32(vorrq_u32(vceqq_u32(v, lower_v), vceqq_u32(v, upper_v)), vcgtq_u32(v, ascii_max));
+		if (vmaxvq_u32(match)) {
+			break; // Locate the exact position below.
+		}
+	}
+#endif
+	for (; i < p_len; i++) {
+		const char32_t c = p_src[i];
+		if (c == p_lower || c == upper || uint32_t(c) > 0x7f) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Converts the leading run of ASCII characters in p_src to lower case (or upper case if p_upper
+// is set) into p_dst, and returns its length. The caller handles the character that ended the run.
+static _FORCE_INLINE_ int string_ascii_change_case(char32_t *p_dst, const char32_t *p_src, int p_len, bool p_upper) {
+	const char32_t from_first = p_upper ? 'a' : 'A';
+	const char32_t from_last = p_upper ? 'z' : 'Z';
+	int i = 0;
+#if defined(STRING_SIMD_SSE2)
+	const __m128i high = _mm_set1_epi32(~0x7f);
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i before_first = _mm_set1_epi32(int(from_first) - 1);
+	const __m128i after_last = _mm_set1_epi32(int(from_last) + 1);
+	const __m128i delta = _mm_set1_epi32(p_upper ? -('a' - 'A') : ('a' - 'A'));
+	for (; i + 4 <= p_len; i += 4) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(p_src + i));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(v, high), zero)) != 0xffff) {
+			break;
+		}
+		const __m128i in_range = _mm_and_si128(_mm_cmpgt_epi32(v, before_first), _mm_cmplt_epi32(v, after_last));
+		_mm_storeu_si128((__m128i *)(p_dst + i), _mm_add_epi32(v, _mm_and_si128(in_range, delta)));
+	}
+#elif defined(STRING_SIMD_NEON)
+	const uint32x4_t first_v = vdupq_n_u32(uint32_t(from_first));
+	const uint32x4_t last_v = vdupq_n_u32(uint32_t(from_last));
+	const uint32x4_t delta = vdupq_n_u32(p_upper ? uint32_t(-int32_t('a' - 'A')) : uint32_t('a' - 'A'));
+	for (; i + 4 <= p_len; i += 4) {
+		const uint32x4_t v = vld1q_u32((const uint32_t *)(p_src + i));
+		if (vmaxvq_u32(v) > 0x7f) {
+			break;
+		}
+		const uint32x4_t in_range = vandq_u32(vcgeq_u32(v, first_v), vcleq_u32(v, last_v));
+		vst1q_u32((uint32_t *)(p_dst + i), vaddq_u32(v, vandq_u32(in_range, delta)));
+	}
+#endif
+	for (; i < p_len; i++) {
+		const char32_t c = p_src[i];
+		if (uint32_t(c) > 0x7f) {
+			break;
+		}
+		p_dst[i] = (c >= from_first && c <= from_last) ? c + (p_upper ? -('a' - 'A') : ('a' - 'A')) : c;
+	}
+	return i;
+}
+
+#endif // STRING_SIMD_H
@@ -37,6 +37,7 @@
 #include "core/math/math_funcs.h"
 #include "core/object/object.h"
 #include "core/string/print_string.h"
+#include "core/string/string_simd.h"
 #include "core/string/string_name.h"
 #include "core/string/translation_server.h"
 #include "core/string/ucaps.h"
@@ -309,15 +310,9 @@ void String::parse_latin1(const StrRange<char> &p_cstr) {
 
 	resize(p_cstr.len + 1); // include 0
 
-	const char *src = p_cstr.c_str;
-	const char *end = src + p_cstr.len;
 	char32_t *dst = ptrw();
-
-	for (; src < end; ++src, ++dst) {
-		// If char is int8_t, a set sign bit will be reinterpreted as 256 - val implicitly.
-		*dst = static_cast<uint8_t>(*src);
-	}
-	*dst = 0;
+	string_widen_latin1(dst, p_cstr.c_str, p_cstr.len);
+	dst[p_cstr.len] = 0;
 }
 
 void String::parse_utf32(const StrRange<char32_t> &p_cstr) {
@@ -1562,16 +1557,21 @@ String String::to_upper() const {
 		return *this;
 	}
 
+	const int len = length();
 	String upper;
 	upper.resize(size());
 	const char32_t *old_ptr = ptr();
 	char32_t *upper_ptrw = upper.ptrw();
 
-	while (*old_ptr) {
-		*upper_ptrw++ = _find_upper(*old_ptr++);
+	for (int i = 0; i < len;) {
+		i += string_ascii_change_case(upper_ptrw + i, old_ptr + i, len - i, true);
+		if (i < len) {
+			upper_ptrw[i] = _find_upper(old_ptr[i]);
+			i++;
+		}
 	}
 
-	*upper_ptrw = 0;
+	upper_ptrw[len] = 0;
 
 	return upper;
 }
@@ -1581,16 +1581,21 @@ String String::to_lower() const {
 		return *this;
 	}
 
+	const int len = length();
 	String lower;
 	lower.resize(size());
 	const char32_t *old_ptr = ptr();
 	char32_t *lower_ptrw = lower.ptrw();
 
-	while (*old_ptr) {
-		*lower_ptrw++ = _find_lower(*old_ptr++);
+	for (int i = 0; i < len;) {
+		i += string_ascii_change_case(lower_ptrw + i, old_ptr + i, len - i, false);
+		if (i < len) {
+			lower_ptrw[i] = _find_lower(old_ptr[i]);
+			i++;
+		}
 	}
 
-	*lower_ptrw = 0;
+	lower_ptrw[len] = 0;
 
 	return lower;
 }
@@ -1910,7 +1915,10 @@ CharString String::ascii(bool p_allow_extended) const {
 	char *cs_ptrw = cs.ptrw();
 	const char32_t *this_ptr = ptr();
 
-	for (int i = 0; i < size(); i++) {
+	const int ascii_len = string_ascii_prefix_length(this_ptr, size());
+	string_narrow_latin1(cs_ptrw, this_ptr, ascii_len);
+
+	for (int i = ascii_len; i < size(); i++) {
 		char32_t c = this_ptr[i];
 		if ((c <= 0x7f) || (c <= 0xff && p_allow_extended)) {
 			cs_ptrw[i] = char(c);
@@ -1952,11 +1960,20 @@ Error String::parse_utf8(const char *p_utf8, int p_len, bool p_skip_cr) {
 		}
 	}
 
+	if (p_len < 0) {
+		p_len = strlen(p_utf8);
+	}
+
+	// Most text is plain ASCII, skip over it in bulk.
+	const int ascii_len = string_ascii_prefix_length(p_utf8, p_len, p_skip_cr);
+	cstr_size = ascii_len;
+	str_size = ascii_len;
+
 	bool decode_error = false;
 	bool decode_failed = false;
 	{
-		const char *ptrtmp = p_utf8;
-		const char *ptrtmp_limit = p_len >= 0 ? &p_utf8[p_len] : nullptr;
+		const char *ptrtmp = p_utf8 + ascii_len;
+		const char *ptrtmp_limit = &p_utf8[p_len];
 		int skip = 0;
 		uint8_t c_start = 0;
 		while (ptrtmp != ptrtmp_limit && *ptrtmp) {
@@ -2029,6 +2046,11 @@ Error String::parse_utf8(const char *p_utf8, int p_len, bool p_skip_cr) {
 	char32_t *dst = ptrw();
 	dst[str_size] = 0;
 
+	string_widen_latin1(dst, p_utf8, ascii_len);
+	dst += ascii_len;
+	p_utf8 += ascii_len;
+	cstr_size -= ascii_len;
+
 	int skip = 0;
 	uint32_t unichar = 0;
 	while (cstr_size) {
@@ -2117,8 +2139,9 @@ CharString String::utf8() const {
 	}
 
 	const char32_t *d = &operator[](0);
-	int fl = 0;
-	for (int i = 0; i < l; i++) {
+	const int ascii_len = string_ascii_prefix_length(d, l);
+	int fl = ascii_len;
+	for (int i = ascii_len; i < l; i++) {
 		uint32_t c = d[i];
 		if (c <= 0x7f) { // 7 bits.
 			fl += 1;
@@ -2148,9 +2171,12 @@ CharString String::utf8() const {
 	utf8s.resize(fl + 1);
 	uint8_t *cdst = (uint8_t *)utf8s.get_data();
 
+	string_narrow_latin1((char *)cdst, d, ascii_len);
+	cdst += ascii_len;
+
 #define APPEND_CHAR(m_c) *(cdst++) = m_c
 
-	for (int i = 0; i < l; i++) {
+	for (int i = ascii_len; i < l; i++) {
 		uint32_t c = d[i];
 
 		if (c <= 0x7f) { // 7 bits.
@@ -2873,6 +2899,22 @@ double String::to_float() const {
 	return built_in_strtod<char32_t>(get_data());
 }
 
+// djb2 over a known length, four characters at a time. Expanding the recurrence as
+// hash * 33^4 + c0 * 33^3 + c1 * 33^2 + c2 * 33 + c3 gives the same result as the
+// sequential form, but only one multiply-add per block depends on the running hash.
+template <typename T>
+static _FORCE_INLINE_ uint32_t _hash_djb2(const T *p_str, int p_len, uint32_t p_hash = 5381) {
+	int i = 0;
+	for (; i + 4 <= p_len; i += 4) {
+		const uint32_t block = uint32_t(p_str[i]) * (33u * 33u * 33u) + uint32_t(p_str[i + 1]) * (33u * 33u) + uint32_t(p_str[i + 2]) * 33u + uint32_t(p_str[i + 3]);
+		p_hash = p_hash * (33u * 33u * 33u * 33u) + block;
+	}
+	for (; i < p_len; i++) {
+		p_hash = ((p_hash << 5) + p_hash) + uint32_t(p_str[i]); /* hash * 33 + c */
+	}
+	return p_hash;
+}
+
 uint32_t String::hash(const char *p_cstr) {
 	// static_cast: avoid negative values on platforms where char is signed.
 	uint32_t hashv = 5381;
@@ -2887,13 +2929,8 @@ uint32_t String::hash(const char *p_cstr) {
 }
 
 uint32_t String::hash(const char *p_cstr, int p_len) {
-	uint32_t hashv = 5381;
-	for (int i = 0; i < p_len; i++) {
-		// static_cast: avoid negative values on platforms where char is signed.
-		hashv = ((hashv << 5) + hashv) + static_cast<uint8_t>(p_cstr[i]); /* hash * 33 + c */
-	}
-
-	return hashv;
+	// Read as unsigned: avoid negative values on platforms where char is signed.
+	return _hash_djb2(reinterpret_cast<const uint8_t *>(p_cstr), p_len);
 }
 
 uint32_t String::hash(const wchar_t *p_cstr, int p_len) {
@@ -2924,12 +2961,7 @@ uint32_t String::hash(const wchar_t *p_cstr) {
 }
 
 uint32_t String::hash(const char32_t *p_cstr, int p_len) {
-	uint32_t hashv = 5381;
-	for (int i = 0; i < p_len; i++) {
-		hashv = ((hashv << 5) + hashv) + p_cstr[i]; /* hash * 33 + c */
-	}
-
-	return hashv;
+	return _hash_djb2(p_cstr, p_len);
 }
 
 uint32_t String::hash(const char32_t *p_cstr) {
@@ -2946,17 +2978,9 @@ uint32_t String::hash(const char32_t *p_cstr) {
 
 uint32_t String::hash() const {
 	/* simple djb2 hashing */
-
-	const char32_t *chr = get_data();
-	uint32_t hashv = 5381;
-	uint32_t c = *chr++;
-
-	while (c) {
-		hashv = ((hashv << 5) + hashv) + c; /* hash * 33 + c */
-		c = *chr++;
-	}
-
-	return hashv;
+	// Stops at the first NUL, like the other hash() overloads and StringName, even if the string contains more characters.
+	const int len = string_find_char(ptr(), length(), 0);
+	return _hash_djb2(get_data(), len < 0 ? length() : len);
 }
 
 uint64_t String::hash64() const {
@@ -3115,31 +3139,7 @@ int String::find(const String &p_str, int p_from) const {
 		return find_char(p_str[0], p_from); // Optimize with single-char find.
 	}
 
-	const char32_t *src = get_data();
-	const char32_t *str = p_str.get_data();
-
-	for (int i = p_from; i <= (len - src_len); i++) {
-		bool found = true;
-		for (int j = 0; j < src_len; j++) {
-			int read_pos = i + j;
-
-			if (read_pos >= len) {
-				ERR_PRINT("read_pos>=len");
-				return -1;
-			}
-
-			if (src[read_pos] != str[j]) {
-				found = false;
-				break;
-			}
-		}
-
-		if (found) {
-			return i;
-		}
-	}
-
-	return -1;
+	return string_find(get_data(), len, p_str.get_data(), src_len, p_from);
 }
 
 int String::find(const char *p_str, int p_from) const {
@@ -3160,36 +3160,25 @@ int String::find(const char *p_str, int p_from) const {
 	}
 
 	const char32_t *src = get_data();
+	const int end = len - src_len;
 
-	if (src_len == 1) {
-		const char32_t needle = p_str[0];
-
-		for (int i = p_from; i < len; i++) {
-			if (src[i] == needle) {
-				return i;
-			}
+	for (int i = p_from; i <= end; i++) {
+		// Skip ahead to the next occurrence of the first character.
+		i = string_find_char(src, end + 1, (char32_t)p_str[0], i);
+		if (i < 0) {
+			return -1;
 		}
 
-	} else {
-		for (int i = p_from; i <= (len - src_len); i++) {
-			bool found = true;
-			for (int j = 0; j < src_len; j++) {
-				int read_pos = i + j;
-
-				if (read_pos >= len) {
-					ERR_PRINT("read_pos>=len");
-					return -1;
-				}
-
-				if (src[read_pos] != (char32_t)p_str[j]) {
-					found = false;
-					break;
-				}
+		bool found = true;
+		for (int j = 1; j < src_len; j++) {
+			if (src[i + j] != (char32_t)p_str[j]) {
+				found = false;
+				break;
 			}
+		}
 
-			if (found) {
-				return i;
-			}
+		if (found) {
+			return i;
 		}
 	}
 
@@ -3197,7 +3186,10 @@ int String::find(const char *p_str, int p_from) const {
 }
 
 int String::find_char(char32_t p_char, int p_from) const {
-	return _cowdata.find(p_char, p_from);
+	if (p_from < 0) {
+		return -1;
+	}
+	return string_find_char(ptr(), size(), p_char, p_from);
 }
 
 int String::findmk(const Vector<String> &p_keys, int p_from, int *r_key) const {
@@ -3267,21 +3259,22 @@ int String::findn(const String &p_str, int p_from) const {
 	}
 
 	const char32_t *srcd = get_data();
-
-	for (int i = p_from; i <= (length() - src_len); i++) {
-		bool found = true;
-		for (int j = 0; j < src_len; j++) {
-			int read_pos = i + j;
-
-			if (read_pos >= length()) {
-				ERR_PRINT("read_pos>=length()");
+	const char32_t *needle = p_str.get_data();
+	const char32_t first = _find_lower(needle[0]);
+	const int end = length() - src_len;
+
+	for (int i = p_from; i <= end; i++) {
+		if (uint32_t(first) <= 0x7f) {
+			// Skip ahead to the next character that may match the first one.
+			i = string_find_nocase_candidate(srcd, end + 1, first, i);
+			if (i < 0) {
 				return -1;
 			}
+		}
 
-			char32_t src = _find_lower(srcd[read_pos]);
-			char32_t dst = _find_lower(p_str[j]);
-
-			if (src != dst) {
+		bool found = true;
+		for (int j = 0; j < src_len; j++) {
+			if (_find_lower(srcd[i + j]) != _find_lower(needle[j])) {
 				found = false;
 				break;
 			}
@@ -3307,21 +3300,21 @@ int String::findn(const char *p_str, int p_from) const {
 	}
 
 	const char32_t *srcd = get_data();
-
-	for (int i = p_from; i <= (length() - src_len); i++) {
-		bool found = true;
-		for (int j = 0; j < src_len; j++) {
-			int read_pos = i + j;
-
-			if (read_pos >= length()) {
-				ERR_PRINT("read_pos>=length()");
+	const char32_t first = _find_lower(p_str[0]);
+	const int end = length() - src_len;
+
+	for (int i = p_from; i <= end; i++) {
+		if (uint32_t(first) <= 0x7f) {
+			// Skip ahead to the next character that may match the first one.
+			i = string_find_nocase_candidate(srcd, end + 1, first, i);
+			if (i < 0) {
 				return -1;
 			}
+		}
 
-			char32_t src = _find_lower(srcd[read_pos]);
-			char32_t dst = _find_lower(p_str[j]);
-
-			if (src != dst) {
+		bool found = true;
+		for (int j = 0; j < src_len; j++) {
+			if (_find_lower(srcd[i + j]) != _find_lower(p_str[j])) {
 				found = false;
 				break;
 			}
@@ -37,6 +37,7 @@
 
 #include "core/string/char_utils.h"
 #include "core/templates/cowdata.h"
+#include "core/templates/small_cow_data.h"
 #include "core/templates/vector.h"
 #include "core/typedefs.h"
 #include "core/variant/array.h"
@@ -128,22 +129,22 @@ struct StrRange {
 /*  CharProxy                                                            */
 /*************************************************************************/
 
-template <typename T>
+template <typename T, typename TData = CowData<T>>
 class CharProxy {
 	friend class Char16String;
 	friend class CharString;
 	friend class String;
 
 	const int _index;
-	CowData<T> &_cowdata;
+	TData &_cowdata;
 	static const T _null = 0;
 
-	_FORCE_INLINE_ CharProxy(const int &p_index, CowData<T> &p_cowdata) :
+	_FORCE_INLINE_ CharProxy(const int &p_index, TData &p_cowdata) :
 			_index(p_index),
 			_cowdata(p_cowdata) {}
 
 public:
-	_FORCE_INLINE_ CharProxy(const CharProxy<T> &p_other) :
+	_FORCE_INLINE_ CharProxy(const CharProxy<T, TData> &p_other) :
 			_index(p_other._index),
 			_cowdata(p_other._cowdata) {}
 
@@ -163,7 +164,7 @@ public:
 		_cowdata.set(_index, p_other);
 	}
 
-	_FORCE_INLINE_ void operator=(const CharProxy<T> &p_other) const {
+	_FORCE_INLINE_ void operator=(const CharProxy<T, TData> &p_other) const {
 		_cowdata.set(_index, p_other.operator T());
 	}
 };
@@ -173,7 +174,7 @@ public:
 /*************************************************************************/
 
 class Char16String {
-	CowData<char16_t> _cowdata;
+	SmallCowData<char16_t> _cowdata;
 	static const char16_t _null;
 
 public:
@@ -191,13 +192,14 @@ public:
 
 		return _cowdata.get(p_index);
 	}
-	_FORCE_INLINE_ CharProxy<char16_t> operator[](int p_index) { return CharProxy<char16_t>(p_index, _cowdata); }
+	_FORCE_INLINE_ CharProxy<char16_t, SmallCowData<char16_t>> operator[](int p_index) { return CharProxy<char16_t, SmallCowData<char16_t>>(p_index, _cowdata); }
 
 	_FORCE_INLINE_ Char16String() {}
-	_FORCE_INLINE_ Char16String(const Char16String &p_str) { _cowdata._ref(p_str._cowdata); }
+	_FORCE_INLINE_ Char16String(const Char16String &p_str) :
+			_cowdata(p_str._cowdata) {}
 	_FORCE_INLINE_ Char16String(Char16String &&p_str) :
 			_cowdata(std::move(p_str._cowdata)) {}
-	_FORCE_INLINE_ void operator=(const Char16String &p_str) { _cowdata._ref(p_str._cowdata); }
+	_FORCE_INLINE_ void operator=(const Char16String &p_str) { _cowdata = p_str._cowdata; }
 	_FORCE_INLINE_ void operator=(Char16String &&p_str) { _cowdata = std::move(p_str._cowdata); }
 	_FORCE_INLINE_ Char16String(const char16_t *p_cstr) { copy_from(p_cstr); }
 
@@ -218,7 +220,7 @@ protected:
 /*************************************************************************/
 
 class CharString {
-	CowData<char> _cowdata;
+	SmallCowData<char> _cowdata;
 	static const char _null;
 
 public:
@@ -236,13 +238,14 @@ public:
 
 		return _cowdata.get(p_index);
 	}
-	_FORCE_INLINE_ CharProxy<char> operator[](int p_index) { return CharProxy<char>(p_index, _cowdata); }
+	_FORCE_INLINE_ CharProxy<char, SmallCowData<char>> operator[](int p_index) { return CharProxy<char, SmallCowData<char>>(p_index, _cowdata); }
 
 	_FORCE_INLINE_ CharString() {}
-	_FORCE_INLINE_ CharString(const CharString &p_str) { _cowdata._ref(p_str._cowdata); }
+	_FORCE_INLINE_ CharString(const CharString &p_str) :
+			_cowdata(p_str._cowdata) {}
 	_FORCE_INLINE_ CharString(CharString &&p_str) :
 			_cowdata(std::move(p_str._cowdata)) {}
-	_FORCE_INLINE_ void operator=(const CharString &p_str) { _cowdata._ref(p_str._cowdata); }
+	_FORCE_INLINE_ void operator=(const CharString &p_str) { _cowdata = p_str._cowdata; }
 	_FORCE_INLINE_ void operator=(CharString &&p_str) { _cowdata = std::move(p_str._cowdata); }
 	_FORCE_INLINE_ CharString(const char *p_cstr) { copy_from(p_cstr); }
 
@@ -0,0 +1,594 @@
+/**************************************************************************/
+/*  ordered_hash_map.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef ORDERED_HASH_MAP_H
+#define ORDERED_HASH_MAP_H
+
+#include "core/templates/a_hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/sort_array.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/**
+ * A hash map that keeps its elements in insertion order, in dense arrays indexed by an
+ * open addressing table (see AHashMap). Iterating it is a linear walk through memory.
+ *
+ * Elements are stored in pages that double in size, so inserting never moves the existing
+ * ones, and pointers to them stay valid like with HashMap. Erasing leaves a hole, which keeps
+ * the order; once holes outnumber the elements, erase() compacts them, which moves elements.
+ *
+ * Use AHashMap if insertion order doesn't need to survive erasing elements.
+ */
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class OrderedHashMap {
+public:
+	// The first page holds 1 << FIRST_PAGE_SHIFT elements, and each following page twice as many as the last.
+	static constexpr uint32_t FIRST_PAGE_SHIFT = 2;
+	static constexpr uint32_t MIN_INDEX_CAPACITY = 8;
+	static constexpr uint32_t EMPTY_HASH = 0;
+
+private:
+	typedef KeyValue<TKey, TValue> MapKeyValue;
+
+	struct Element {
+		alignas(MapKeyValue) uint8_t data[sizeof(MapKeyValue)];
+		uint32_t hash; // EMPTY_HASH if the element was erased.
+
+		_FORCE_INLINE_ MapKeyValue &get() { return *reinterpret_cast<MapKeyValue *>(data); }
+		_FORCE_INLINE_ const MapKeyValue &get() const { return *reinterpret_cast<const MapKeyValue *>(data); }
+	};
+
+	LocalVector<Element *> pages;
+	HashMapData *index = nullptr;
+	uint32_t index_mask = 0; // Index capacity - 1, index capacity is a power of two.
+	uint32_t used = 0; // Elements in use, including erased ones.
+	uint32_t num_elements = 0;
+
+	static _FORCE_INLINE_ uint32_t _get_page(uint32_t p_pos) {
+		const uint32_t x = (p_pos >> FIRST_PAGE_SHIFT) + 1;
+#if defined(__GNUC__) || defined(__clang__)
+		return 31 - __builtin_clz(x);
+#elif defined(_MSC_VER)
+		unsigned long bit;
+		_BitScanReverse(&bit, x);
+		return bit;
+#else
+		uint32_t page = 0;
+		while (x >> (page + 1)) {
+			page++;
+		}
+		return page;
+#endif
+	}
+
+	static _FORCE_INLINE_ uint32_t _get_page_start(uint32_t p_page) {
+		return ((1u << p_page) - 1) << FIRST_PAGE_SHIFT;
+	}
+
+	_FORCE_INLINE_ Element &_get_element(uint32_t p_pos) const {
+		const uint32_t page = _get_page(p_pos);
+		return pages[page][p_pos - _get_page_start(page)];
+	}
+
+	static _FORCE_INLINE_ uint32_t _hash(const TKey &p_key) {
+		uint32_t hash = Hasher::hash(p_key);
+		if (unlikely(hash == EMPTY_HASH)) {
+			hash = EMPTY_HASH + 1;
+		}
+		return hash;
+	}
+
+	static _FORCE_INLINE_ uint32_t _get_probe_length(uint32_t p_index_pos, uint32_t p_hash, uint32_t p_mask) {
+		return (p_index_pos - (p_hash & p_mask) + p_mask + 1) & p_mask;
+	}
+
+	bool _lookup(const TKey &p_key, uint32_t p_hash, uint32_t &r_pos, uint32_t &r_index_pos) const {
+		if (unlikely(num_elements == 0)) {
+			return false;
+		}
+		uint32_t index_pos = p_hash & index_mask;
+		uint32_t distance = 0;
+		while (true) {
+			const HashMapData data = index[index_pos];
+			if (data.data == EMPTY_HASH) {
+				return false;
+			}
+			if (data.hash == p_hash && Comparator::compare(_get_element(data.hash_to_key).get().key, p_key)) {
+				r_pos = data.hash_to_key;
+				r_index_pos = index_pos;
+				return true;
+			}
+			if (distance > _get_probe_length(index_pos, data.hash, index_mask)) {
+				return false;
+			}
+			index_pos = (index_pos + 1) & index_mask;
+			distance++;
+		}
+	}
+
+	void _index_insert(uint32_t p_hash, uint32_t p_pos) {
+		HashMapData data;
+		data.hash = p_hash;
+		data.hash_to_key = p_pos;
+		uint32_t index_pos = p_hash & index_mask;
+		uint32_t distance = 0;
+		while (true) {
+			if (index[index_pos].data == EMPTY_HASH) {
+				index[index_pos] = data;
+				return;
+			}
+			// Robin Hood hashing, take the place of entries closer to their ideal position.
+			const uint32_t existing_distance = _get_probe_length(index_pos, index[index_pos].hash, index_mask);
+			if (existing_distance < distance) {
+				SWAP(data, index[index_pos]);
+				distance = existing_distance;
+			}
+			index_pos = (index_pos + 1) & index_mask;
+			distance++;
+		}
+	}
+
+	void _index_remove(uint32_t p_index_pos) {
+		// Backward shift deletion, no tombstones are needed.
+		uint32_t index_pos = p_index_pos;
+		uint32_t next_pos = (index_pos + 1) & index_mask;
+		while (index[next_pos].data != EMPTY_HASH && _get_probe_length(next_pos, index[next_pos].hash, index_mask) != 0) {
+			index[index_pos] = index[next_pos];
+			index_pos = next_pos;
+			next_pos = (next_pos + 1) & index_mask;
+		}
+		index[index_pos].data = EMPTY_HASH;
+	}
+
+	void _rebuild_index(uint32_t p_capacity) {
+		if (index) {
+			Memory::free_static(index);
+		}
+		index_mask = p_capacity - 1;
+		index = reinterpret_cast<HashMapData *>(Memory::alloc_static(sizeof(HashMapData) * p_capacity));
+		memset(index, EMPTY_HASH, sizeof(HashMapData) * p_capacity);
+		for (uint32_t i = 0; i < used; i++) {
+			const Element &element = _get_element(i);
+			if (element.hash != EMPTY_HASH) {
+				_index_insert(element.hash, i);
+			}
+		}
+	}
+
+	uint32_t _insert_element(const TKey &p_key, const TValue &p_value, uint32_t p_hash) {
+		// Keep the index at most 75% full.
+		if (unlikely(index == nullptr || (num_elements + 1) * 4 > (index_mask + 1) * 3)) {
+			_rebuild_index(index ? (index_mask + 1) * 2 : MIN_INDEX_CAPACITY);
+		}
+
+		const uint32_t pos = used;
+		const uint32_t page = _get_page(pos);
+		if (page == pages.size()) {
+			pages.push_back(reinterpret_cast<Element *>(Memory::alloc_static(sizeof(Element) << (page + FIRST_PAGE_SHIFT))));
+		}
+		Element &element = pages[page][pos - _get_page_start(page)];
+		memnew_placement(element.data, MapKeyValue(p_key, p_value));
+		element.hash = p_hash;
+		used++;
+		num_elements++;
+
+		_index_insert(p_hash, pos);
+		return pos;
+	}
+
+	// Moves the elements over the holes left by erased ones. Elements are relocated as plain memory, like CowData does.
+	void _compact() {
+		uint32_t to = 0;
+		for (uint32_t from = 0; from < used; from++) {
+			Element &element = _get_element(from);
+			if (element.hash == EMPTY_HASH) {
+				continue;
+			}
+			if (from != to) {
+				memcpy((void *)&_get_element(to), (const void *)&element, sizeof(Element));
+			}
+			to++;
+		}
+		used = to;
+		_release_unused_pages();
+		_rebuild_index(index_mask + 1);
+	}
+
+	void _release_unused_pages() {
+		const uint32_t page_count = used ? _get_page(used - 1) + 1 : 0;
+		while (pages.size() > page_count) {
+			Memory::free_static(pages[pages.size() - 1]);
+			pages.resize(pages.size() - 1);
+		}
+	}
+
+	void _destroy_elements() {
+		if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+			for (uint32_t i = 0; i < used; i++) {
+				Element &element = _get_element(i);
+				if (element.hash != EMPTY_HASH) {
+					element.get().~MapKeyValue();
+				}
+			}
+		}
+	}
+
+	uint32_t _get_next_pos(uint32_t p_pos) const {
+		uint32_t pos = p_pos + 1;
+		while (pos < used && _get_element(pos).hash == EMPTY_HASH) {
+			pos++;
+		}
+		return pos;
+	}
+
+	void _copy_from(const OrderedHashMap &p_other) {
+		for (const MapKeyValue &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+public:
+	/* Standard Godot Container API */
+
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+	_FORCE_INLINE_ bool is_empty() const { return num_elements == 0; }
+
+	void clear() {
+		_destroy_elements();
+		used = 0;
+		num_elements = 0;
+		_release_unused_pages();
+		if (index) {
+			memset(index, EMPTY_HASH, sizeof(HashMapData) * (index_mask + 1));
+		}
+	}
+
+	TValue &get(const TKey &p_key) {
+		TValue *value = getptr(p_key);
+		CRASH_COND_MSG(!value, "OrderedHashMap key not found.");
+		return *value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		const TValue *value = getptr(p_key);
+		CRASH_COND_MSG(!value, "OrderedHashMap key not found.");
+		return *value;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t pos = 0;
+		uint32_t index_pos = 0;
+		if (_lookup(p_key, _hash(p_key), pos, index_pos)) {
+			return &_get_element(pos).get().value;
+		}
+		return nullptr;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t pos = 0;
+		uint32_t index_pos = 0;
+		if (_lookup(p_key, _hash(p_key), pos, index_pos)) {
+			return &_get_element(pos).get().value;
+		}
+		return nullptr;
+	}
+
+	bool has(const TKey &p_key) const {
+		uint32_t pos = 0;
+		uint32_t index_pos = 0;
+		return _lookup(p_key, _hash(p_key), pos, index_pos);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t pos = 0;
+		uint32_t index_pos = 0;
+		if (!_lookup(p_key, _hash(p_key), pos, index_pos)) {
+			return false;
+		}
+
+		_index_remove(index_pos);
+		Element &element = _get_element(pos);
+		element.get().~MapKeyValue();
+		element.hash = EMPTY_HASH;
+		num_elements--;
+
+		if (pos == used - 1) {
+			// Trailing holes can simply be dropped.
+			while (used > 0 && _get_element(used - 1).hash == EMPTY_HASH) {
+				used--;
+			}
+			_release_unused_pages();
+		} else if (used - num_elements > num_elements && used - num_elements >= (1u << FIRST_PAGE_SHIFT)) {
+			_compact();
+		}
+		return true;
+	}
+
+	// Reserves space in the index for a number of elements, to avoid rehashing while adding them.
+	void reserve(uint32_t p_new_capacity) {
+		if (p_new_capacity == 0) {
+			return;
+		}
+		uint32_t capacity = MAX(MIN_INDEX_CAPACITY, next_power_of_2(p_new_capacity + p_new_capacity / 3 + 1));
+		if (capacity > index_mask + 1 || index == nullptr) {
+			_rebuild_index(capacity);
+		}
+	}
+
+	// Sorts the elements by key, keeping the order of the ones that compare equal.
+	template <typename C = KeyValueSort<TKey, TValue>>
+	void sort() {
+		if (num_elements < 2) {
+			return;
+		}
+
+		struct SortElement {
+			Element *element = nullptr;
+			uint32_t order = 0;
+		};
+		struct SortElementComparator {
+			C compare;
+			bool operator()(const SortElement &p_a, const SortElement &p_b) const {
+				if (compare(p_a.element->get(), p_b.element->get())) {
+					return true;
+				}
+				if (compare(p_b.element->get(), p_a.element->get())) {
+					return false;
+				}
+				return p_a.order < p_b.order;
+			}
+		};
+
+		LocalVector<SortElement> sorted;
+		sorted.resize(num_elements);
+		uint32_t count = 0;
+		for (uint32_t i = 0; i < used; i++) {
+			Element &element = _get_element(i);
+			if (element.hash != EMPTY_HASH) {
+				sorted[count].element = &element;
+				sorted[count].order = count;
+				count++;
+			}
+		}
+		SortArray<SortElement, SortElementComparator> sorter;
+		sorter.sort(sorted.ptr(), count);
+
+		Element *buffer = reinterpret_cast<Element *>(Memory::alloc_static(sizeof(Element) * count));
+		for (uint32_t i = 0; i < count; i++) {
+			memcpy((void *)&buffer[i], (const void *)sorted[i].element, sizeof(Element));
+		}
+		for (uint32_t i = 0; i < count; i++) {
+			memcpy((void *)&_get_element(i), (const void *)&buffer[i], sizeof(Element));
+		}
+		Memory::free_static(buffer);
+
+		used = count;
+		_release_unused_pages();
+		_rebuild_index(index_mask + 1);
+	}
+
+	/* Positions */
+
+	// Returns the element at p_position in iteration order. Constant time, unless elements were erased.
+	MapKeyValue *get_by_position(uint32_t p_position) {
+		return const_cast<MapKeyValue *>(const_cast<const OrderedHashMap *>(this)->get_by_position(p_position));
+	}
+
+	const MapKeyValue *get_by_position(uint32_t p_position) const {
+		if (p_position >= num_elements) {
+			return nullptr;
+		}
+		if (used == num_elements) {
+			return &_get_element(p_position).get();
+		}
+		uint32_t position = 0;
+		for (uint32_t i = 0; i < used; i++) {
+			const Element &element = _get_element(i);
+			if (element.hash != EMPTY_HASH) {
+				if (position == p_position) {
+					return &element.get();
+				}
+				position++;
+			}
+		}
+		return nullptr;
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const MapKeyValue &operator*() const {
+			return map->_get_element(pos).get();
+		}
+		_FORCE_INLINE_ const MapKeyValue *operator->() const {
+			return &map->_get_element(pos).get();
+		}
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			pos = map->_get_next_pos(pos);
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return pos == b.pos; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return pos != b.pos; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map && pos < map->used;
+		}
+
+		_FORCE_INLINE_ ConstIterator(const OrderedHashMap *p_map, uint32_t p_pos) {
+			map = p_map;
+			pos = p_pos;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+
+	private:
+		const OrderedHashMap *map = nullptr;
+		uint32_t pos = 0;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ MapKeyValue &operator*() const {
+			return map->_get_element(pos).get();
+		}
+		_FORCE_INLINE_ MapKeyValue *operator->() const {
+			return &map->_get_element(pos).get();
+		}
+		_FORCE_INLINE_ Iterator &operator++() {
+			pos = map->_get_next_pos(pos);
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return pos == b.pos; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return pos != b.pos; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map && pos < map->used;
+		}
+
+		_FORCE_INLINE_ Iterator(OrderedHashMap *p_map, uint32_t p_pos) {
+			map = p_map;
+			pos = p_pos;
+		}
+		_FORCE_INLINE_ Iterator() {}
+
+		operator ConstIterator() const {
+			return ConstIterator(map, pos);
+		}
+
+	private:
+		OrderedHashMap *map = nullptr;
+		uint32_t pos = 0;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(this, used && _get_element(0).hash == EMPTY_HASH ? _get_next_pos(0) : 0);
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(this, used);
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(this, used && _get_element(0).hash == EMPTY_HASH ? _get_next_pos(0) : 0);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(this, used);
+	}
+
+	Iterator find(const TKey &p_key) {
+		uint32_t pos = 0;
+		uint32_t index_pos = 0;
+		if (_lookup(p_key, _hash(p_key), pos, index_pos)) {
+			return Iterator(this, pos);
+		}
+		return end();
+	}
+
+	ConstIterator find(const TKey &p_key) const {
+		uint32_t pos = 0;
+		uint32_t index_pos = 0;
+		if (_lookup(p_key, _hash(p_key), pos, index_pos)) {
+			return ConstIterator(this, pos);
+		}
+		return end();
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		const TValue *value = getptr(p_key);
+		CRASH_COND(!value);
+		return *value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t pos = 0;
+		uint32_t index_pos = 0;
+		const uint32_t hash = _hash(p_key);
+		if (!_lookup(p_key, hash, pos, index_pos)) {
+			pos = _insert_element(p_key, TValue(), hash);
+		}
+		return _get_element(pos).get().value;
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t pos = 0;
+		uint32_t index_pos = 0;
+		const uint32_t hash = _hash(p_key);
+		if (_lookup(p_key, hash, pos, index_pos)) {
+			_get_element(pos).get().value = p_value;
+		} else {
+			pos = _insert_element(p_key, p_value, hash);
+		}
+		return Iterator(this, pos);
+	}
+
+	/* Constructors */
+
+	OrderedHashMap(const OrderedHashMap &p_other) {
+		reserve(p_other.num_elements);
+		_copy_from(p_other);
+	}
+
+	void operator=(const OrderedHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		clear();
+		reserve(p_other.num_elements);
+		_copy_from(p_other);
+	}
+
+	OrderedHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+
+	OrderedHashMap() {}
+
+	~OrderedHashMap() {
+		_destroy_elements();
+		for (Element *page : pages) {
+			Memory::free_static(page);
+		}
+		if (index) {
+			Memory::free_static(index);
+		}
+	}
+};
+
+#endif // ORDERED_HASH_MAP_H
@@ -0,0 +1,198 @@
+/**************************************************************************/
+/*  perfect_hash_map.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef PERFECT_HASH_MAP_H
+#define PERFECT_HASH_MAP_H
+
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+/**
+ * An immutable hash map for a set of keys known in advance, built with the "hash and displace"
+ * method: keys are grouped in small buckets, and each bucket gets a seed that sends all its keys
+ * to free slots. A lookup is one bucket read and one slot read, with no probing.
+ *
+ * Building fails if two keys have the same hash (which no seed can tell apart), so callers need
+ * a fallback; it can't happen with fewer than a few thousand keys in practice.
+ */
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class PerfectHashMap {
+public:
+	struct Element {
+		TKey key;
+		TValue value;
+	};
+
+	// Average number of keys per bucket, trades building speed for memory.
+	static constexpr uint32_t KEYS_PER_BUCKET = 4;
+	static constexpr uint32_t MAX_SEED_ATTEMPTS = 1 << 20;
+
+private:
+	LocalVector<Element> elements; // One per slot.
+	LocalVector<uint32_t> seeds; // One per bucket.
+	uint32_t bucket_mask = 0;
+
+	static _FORCE_INLINE_ uint32_t _get_slot(uint32_t p_hash, uint32_t p_seed, uint32_t p_slot_count) {
+		return uint32_t((uint64_t(hash_fmix32(hash_murmur3_one_32(p_hash, p_seed))) * p_slot_count) >> 32);
+	}
+
+public:
+	// Replaces the contents of the map. Returns false and leaves it empty if the keys can't be perfectly hashed.
+	bool build(const Element *p_elements, uint32_t p_count) {
+		clear();
+		if (p_count == 0) {
+			return true;
+		}
+
+		LocalVector<uint32_t> hashes;
+		hashes.resize(p_count);
+		for (uint32_t i = 0; i < p_count; i++) {
+			hashes[i] = Hasher::hash(p_elements[i].key);
+		}
+
+		{
+			LocalVector<uint32_t> sorted_hashes = hashes;
+			sorted_hashes.sort();
+			for (uint32_t i = 1; i < p_count; i++) {
+				if (sorted_hashes[i] == sorted_hashes[i - 1]) {
+					return false;
+				}
+			}
+		}
+
+		const uint32_t bucket_count = next_power_of_2(MAX(1u, p_count / KEYS_PER_BUCKET));
+		const uint32_t mask = bucket_count - 1;
+
+		// Group the keys by bucket.
+		LocalVector<uint32_t> bucket_start;
+		bucket_start.resize(bucket_count + 1);
+		memset(bucket_start.ptr(), 0, sizeof(uint32_t) * (bucket_count + 1));
+		for (uint32_t i = 0; i < p_count; i++) {
+			bucket_start[(hashes[i] & mask) + 1]++;
+		}
+		uint32_t max_bucket_size = 0;
+		for (uint32_t i = 0; i < bucket_count; i++) {
+			max_bucket_size = MAX(max_bucket_size, bucket_start[i + 1]);
+			bucket_start[i + 1] += bucket_start[i];
+		}
+		LocalVector<uint32_t> bucket_keys;
+		bucket_keys.resize(p_count);
+		{
+			LocalVector<uint32_t> fill = bucket_start;
+			for (uint32_t i = 0; i < p_count; i++) {
+				bucket_keys[fill[hashes[i] & mask]++] = i;
+			}
+		}
+
+		LocalVector<uint32_t> slot_keys;
+		slot_keys.resize(p_count);
+		for (uint32_t i = 0; i < p_count; i++) {
+			slot_keys[i] = UINT32_MAX;
+		}
+		LocalVector<uint32_t> bucket_seeds;
+		bucket_seeds.resize(bucket_count);
+		memset(bucket_seeds.ptr(), 0, sizeof(uint32_t) * bucket_count);
+
+		// Place the biggest buckets first, while most slots are free.
+		for (uint32_t size = max_bucket_size; size > 0; size--) {
+			for (uint32_t bucket = 0; bucket < bucket_count; bucket++) {
+				const uint32_t begin = bucket_start[bucket];
+				if (bucket_start[bucket + 1] - begin != size) {
+					continue;
+				}
+
+				bool placed = false;
+				for (uint32_t seed = 0; seed < MAX_SEED_ATTEMPTS && !placed; seed++) {
+					uint32_t i = 0;
+					for (; i < size; i++) {
+						const uint32_t key = bucket_keys[begin + i];
+						const uint32_t slot = _get_slot(hashes[key], seed, p_count);
+						if (slot_keys[slot] != UINT32_MAX) {
+							break;
+						}
+						slot_keys[slot] = key;
+					}
+					if (i == size) {
+						bucket_seeds[bucket] = seed;
+						placed = true;
+					} else {
+						// Undo the keys placed with this seed.
+						while (i > 0) {
+							i--;
+							slot_keys[_get_slot(hashes[bucket_keys[begin + i]], seed, p_count)] = UINT32_MAX;
+						}
+					}
+				}
+				if (!placed) {
+					return false;
+				}
+			}
+		}
+
+		elements.resize(p_count);
+		for (uint32_t i = 0; i < p_count; i++) {
+			elements[i] = p_elements[slot_keys[i]];
+		}
+		seeds = bucket_seeds;
+		bucket_mask = mask;
+		return true;
+	}
+
+	_FORCE_INLINE_ const TValue *getptr(const TKey &p_key) const {
+		if (unlikely(elements.is_empty())) {
+			return nullptr;
+		}
+		const uint32_t hash = Hasher::hash(p_key);
+		const Element &element = elements[_get_slot(hash, seeds[hash & bucket_mask], elements.size())];
+		return Comparator::compare(element.key, p_key) ? &element.value : nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		return getptr(p_key) != nullptr;
+	}
+
+	_FORCE_INLINE_ uint32_t size() const { return elements.size(); }
+	_FORCE_INLINE_ bool is_empty() const { return elements.is_empty(); }
+
+	// Elements in slot order.
+	_FORCE_INLINE_ const Element *get_elements() const { return elements.ptr(); }
+
+	void clear() {
+		elements.reset();
+		seeds.reset();
+		bucket_mask = 0;
+	}
+};
+
+#endif // PERFECT_HASH_MAP_H
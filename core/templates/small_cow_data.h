@@ -0,0 +1,134 @@
+/**************************************************************************/
+/*  small_cow_data.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SMALL_COW_DATA_H
+#define SMALL_COW_DATA_H
+
+#include "core/templates/cowdata.h"
+
+// CowData with an inline buffer for short contents. Buffers of up to
+// INLINE_SIZE elements are stored in the object itself, so creating, copying
+// and destroying them neither allocates nor touches a reference count. Longer
+// buffers are shared copy-on-write through CowData as usual.
+// Only meant for trivially copyable element types, like characters.
+template <typename T>
+class SmallCowData {
+	static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+	typedef typename CowData<T>::Size Size;
+
+	static constexpr Size INLINE_SIZE = 23 / sizeof(T);
+
+private:
+	CowData<T> _cowdata;
+	T _inline[INLINE_SIZE];
+	uint8_t _inline_size = 0; // Non-zero only when the contents live in _inline.
+
+	_FORCE_INLINE_ void _copy_from(const SmallCowData<T> &p_from) {
+		if (p_from._inline_size) {
+			_cowdata.clear();
+			memcpy(_inline, p_from._inline, p_from._inline_size * sizeof(T));
+		} else {
+			_cowdata = p_from._cowdata;
+		}
+		_inline_size = p_from._inline_size;
+	}
+
+public:
+	_FORCE_INLINE_ bool is_inline() const { return _inline_size != 0; }
+
+	_FORCE_INLINE_ T *ptrw() { return _inline_size ? _inline : _cowdata.ptrw(); }
+	_FORCE_INLINE_ const T *ptr() const { return _inline_size ? _inline : _cowdata.ptr(); }
+	_FORCE_INLINE_ Size size() const { return _inline_size ? Size(_inline_size) : _cowdata.size(); }
+	_FORCE_INLINE_ void clear() { resize(0); }
+	_FORCE_INLINE_ bool is_empty() const { return size() == 0; }
+
+	_FORCE_INLINE_ void set(Size p_index, const T &p_elem) {
+		ERR_FAIL_INDEX(p_index, size());
+		ptrw()[p_index] = p_elem;
+	}
+
+	_FORCE_INLINE_ const T &get(Size p_index) const {
+		CRASH_BAD_INDEX(p_index, size());
+		return ptr()[p_index];
+	}
+
+	Error resize(Size p_size) {
+		ERR_FAIL_COND_V(p_size < 0, ERR_INVALID_PARAMETER);
+
+		if (p_size <= INLINE_SIZE) {
+			if (!_inline_size && !_cowdata.is_empty()) {
+				memcpy(_inline, _cowdata.ptr(), MIN(p_size, _cowdata.size()) * sizeof(T));
+				_cowdata.clear();
+			}
+			_inline_size = uint8_t(p_size);
+			return OK;
+		}
+
+		if (_inline_size) {
+			Error err = _cowdata.resize(p_size);
+			ERR_FAIL_COND_V(err != OK, err);
+			memcpy(_cowdata.ptrw(), _inline, _inline_size * sizeof(T));
+			_inline_size = 0;
+			return OK;
+		}
+
+		return _cowdata.resize(p_size);
+	}
+
+	_FORCE_INLINE_ void operator=(const SmallCowData<T> &p_from) {
+		if (this != &p_from) {
+			_copy_from(p_from);
+		}
+	}
+	_FORCE_INLINE_ void operator=(SmallCowData<T> &&p_from) {
+		if (p_from._inline_size) {
+			_copy_from(p_from);
+		} else {
+			_cowdata = std::move(p_from._cowdata);
+			_inline_size = 0;
+		}
+	}
+
+	_FORCE_INLINE_ SmallCowData() {}
+	_FORCE_INLINE_ SmallCowData(const SmallCowData<T> &p_from) { _copy_from(p_from); }
+	_FORCE_INLINE_ SmallCowData(SmallCowData<T> &&p_from) {
+		if (p_from._inline_size) {
+			_copy_from(p_from);
+		} else {
+			_cowdata = std::move(p_from._cowdata);
+		}
+	}
+};
+
+#endif // SMALL_COW_DATA_H
@@ -0,0 +1,358 @@
+/**************************************************************************/
+/*  small_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+
+#ifndef SMALL_HASH_MAP_H
+#define SMALL_HASH_MAP_H
+
+#include "core/templates/hash_map.h"
+
+/**
+ * A hash map optimized for maps that usually hold a handful of elements.
+ *
+ * Up to SMALL_CAPACITY elements are kept in a single array and found with a linear search,
+ * which beats hashing when comparing keys is cheap (like StringName). Past that, the elements
+ * move to a HashMap, and move back once the map shrinks to half of SMALL_CAPACITY.
+ * Iteration follows the insertion order in both cases.
+ *
+ * Iterators are invalidated when the map switches between both storages, so don't insert or
+ * erase while iterating.
+ */
+template <typename TKey, typename TValue,
+		uint32_t SMALL_CAPACITY = 8,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class SmallHashMap {
+	static_assert(SMALL_CAPACITY >= 2);
+
+	typedef HashMap<TKey, TValue, Hasher, Comparator> Map;
+	typedef KeyValue<TKey, TValue> Element;
+
+	Element *small_elements = nullptr; // Allocated for SMALL_CAPACITY elements, on the first insertion.
+	uint32_t small_size = 0;
+	Map map;
+	bool use_map = false;
+
+	int32_t _small_find(const TKey &p_key) const {
+		for (uint32_t i = 0; i < small_size; i++) {
+			if (Comparator::compare(small_elements[i].key, p_key)) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	void _small_reset() {
+		for (uint32_t i = 0; i < small_size; i++) {
+			small_elements[i].~Element();
+		}
+		small_size = 0;
+		if (small_elements) {
+			Memory::free_static(small_elements);
+			small_elements = nullptr;
+		}
+	}
+
+	void _move_to_map() {
+		map.reserve(SMALL_CAPACITY * 2);
+		for (uint32_t i = 0; i < small_size; i++) {
+			map.insert(small_elements[i].key, small_elements[i].value);
+		}
+		_small_reset();
+		use_map = true;
+	}
+
+	void _move_to_small() {
+		small_elements = (Element *)Memory::alloc_static(sizeof(Element) * SMALL_CAPACITY);
+		for (const KeyValue<TKey, TValue> &E : map) {
+			memnew_placement(&small_elements[small_size++], Element(E.key, E.value));
+		}
+		map.clear();
+		use_map = false;
+	}
+
+public:
+	struct ConstIterator {
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> &operator*() const {
+			return E ? *E : *map_E;
+		}
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> *operator->() const { return E ? E : &(*map_E); }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			if (E) {
+				E = (E + 1 == small_end) ? nullptr : E + 1;
+			} else {
+				++map_E;
+			}
+			return *this;
+		}
+		_FORCE_INLINE_ ConstIterator &operator--() {
+			if (E) {
+				E = (E == small_begin) ? nullptr : E - 1;
+			} else {
+				--map_E;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return E == b.E && map_E == b.map_E; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return !(*this == b); }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return E != nullptr || bool(map_E);
+		}
+
+		_FORCE_INLINE_ ConstIterator(const KeyValue<TKey, TValue> *p_E, const KeyValue<TKey, TValue> *p_small_begin, const KeyValue<TKey, TValue> *p_small_end) :
+				E(p_E), small_begin(p_small_begin), small_end(p_small_end) {}
+		_FORCE_INLINE_ ConstIterator(const typename Map::ConstIterator &p_map_E) :
+				map_E(p_map_E) {}
+		_FORCE_INLINE_ ConstIterator() {}
+
+	private:
+		const KeyValue<TKey, TValue> *E = nullptr;
+		const KeyValue<TKey, TValue> *small_begin = nullptr;
+		const KeyValue<TKey, TValue> *small_end = nullptr;
+		typename Map::ConstIterator map_E;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ KeyValue<TKey, TValue> &operator*() const {
+			return E ? *E : *map_E;
+		}
+		_FORCE_INLINE_ KeyValue<TKey, TValue> *operator->() const { return E ? E : &(*map_E); }
+		_FORCE_INLINE_ Iterator &operator++() {
+			if (E) {
+				E = (E + 1 == small_end) ? nullptr : E + 1;
+			} else {
+				++map_E;
+			}
+			return *this;
+		}
+		_FORCE_INLINE_ Iterator &operator--() {
+			if (E) {
+				E = (E == small_begin) ? nullptr : E - 1;
+			} else {
+				--map_E;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return E == b.E && map_E == b.map_E; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return !(*this == b); }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return E != nullptr || bool(map_E);
+		}
+
+		_FORCE_INLINE_ Iterator(KeyValue<TKey, TValue> *p_E, KeyValue<TKey, TValue> *p_small_begin, KeyValue<TKey, TValue> *p_small_end) :
+				E(p_E), small_begin(p_small_begin), small_end(p_small_end) {}
+		_FORCE_INLINE_ Iterator(const typename Map::Iterator &p_map_E) :
+				map_E(p_map_E) {}
+		_FORCE_INLINE_ Iterator() {}
+
+		operator ConstIterator() const {
+			return E ? ConstIterator(E, small_begin, small_end) : ConstIterator(map_E);
+		}
+
+	private:
+		KeyValue<TKey, TValue> *E = nullptr;
+		KeyValue<TKey, TValue> *small_begin = nullptr;
+		KeyValue<TKey, TValue> *small_end = nullptr;
+		typename Map::Iterator map_E;
+	};
+
+	_FORCE_INLINE_ uint32_t size() const {
+		return use_map ? map.size() : small_size;
+	}
+
+	_FORCE_INLINE_ bool is_empty() const {
+		return size() == 0;
+	}
+
+	_FORCE_INLINE_ bool is_small() const {
+		return !use_map;
+	}
+
+	void clear() {
+		_small_reset();
+		map.clear();
+		use_map = false;
+	}
+
+	_FORCE_INLINE_ Iterator begin() {
+		if (use_map) {
+			return Iterator(map.begin());
+		}
+		return small_size ? Iterator(small_elements, small_elements, small_elements + small_size) : Iterator();
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator();
+	}
+	_FORCE_INLINE_ Iterator last() {
+		if (use_map) {
+			return Iterator(map.last());
+		}
+		return small_size ? Iterator(small_elements + small_size - 1, small_elements, small_elements + small_size) : Iterator();
+	}
+	Iterator find(const TKey &p_key) {
+		if (use_map) {
+			return Iterator(map.find(p_key));
+		}
+		int32_t idx = _small_find(p_key);
+		return idx >= 0 ? Iterator(small_elements + idx, small_elements, small_elements + small_size) : Iterator();
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		if (use_map) {
+			return ConstIterator(map.begin());
+		}
+		return small_size ? ConstIterator(small_elements, small_elements, small_elements + small_size) : ConstIterator();
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator();
+	}
+	_FORCE_INLINE_ ConstIterator last() const {
+		if (use_map) {
+			return ConstIterator(map.last());
+		}
+		return small_size ? ConstIterator(small_elements + small_size - 1, small_elements, small_elements + small_size) : ConstIterator();
+	}
+	ConstIterator find(const TKey &p_key) const {
+		if (use_map) {
+			return ConstIterator(map.find(p_key));
+		}
+		int32_t idx = _small_find(p_key);
+		return idx >= 0 ? ConstIterator(small_elements + idx, small_elements, small_elements + small_size) : ConstIterator();
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		if (use_map) {
+			return map.getptr(p_key);
+		}
+		int32_t idx = _small_find(p_key);
+		return idx >= 0 ? &small_elements[idx].value : nullptr;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		if (use_map) {
+			return map.getptr(p_key);
+		}
+		int32_t idx = _small_find(p_key);
+		return idx >= 0 ? &small_elements[idx].value : nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		return getptr(p_key) != nullptr;
+	}
+
+	// Inserts at the end, or replaces the value of an existing key in place.
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		if (!use_map) {
+			int32_t idx = _small_find(p_key);
+			if (idx >= 0) {
+				small_elements[idx].value = p_value;
+				return Iterator(small_elements + idx, small_elements, small_elements + small_size);
+			}
+			if (small_size < SMALL_CAPACITY) {
+				if (!small_elements) {
+					small_elements = (Element *)Memory::alloc_static(sizeof(Element) * SMALL_CAPACITY);
+				}
+				memnew_placement(&small_elements[small_size], Element(p_key, p_value));
+				small_size++;
+				return Iterator(small_elements + small_size - 1, small_elements, small_elements + small_size);
+			}
+			_move_to_map();
+		}
+		return Iterator(map.insert(p_key, p_value));
+	}
+
+	// Keeps the order of the other elements.
+	bool erase(const TKey &p_key) {
+		if (use_map) {
+			if (!map.erase(p_key)) {
+				return false;
+			}
+			if (map.size() <= SMALL_CAPACITY / 2) {
+				_move_to_small();
+			}
+			return true;
+		}
+
+		int32_t idx = _small_find(p_key);
+		if (idx < 0) {
+			return false;
+		}
+		small_elements[idx].~Element();
+		for (uint32_t i = idx + 1; i < small_size; i++) {
+			memnew_placement(&small_elements[i - 1], Element(small_elements[i]));
+			small_elements[i].~Element();
+		}
+		small_size--;
+		return true;
+	}
+
+	// Changes the key of an element, keeping its position. Fails if the new key is already used.
+	bool replace_key(const TKey &p_old_key, const TKey &p_new_key) {
+		if (use_map) {
+			return map.replace_key(p_old_key, p_new_key);
+		}
+		if (Comparator::compare(p_old_key, p_new_key)) {
+			return true;
+		}
+		ERR_FAIL_COND_V(_small_find(p_new_key) >= 0, false);
+		int32_t idx = _small_find(p_old_key);
+		ERR_FAIL_COND_V(idx < 0, false);
+		const_cast<TKey &>(small_elements[idx].key) = p_new_key;
+		return true;
+	}
+
+	SmallHashMap() {}
+
+	SmallHashMap(const SmallHashMap &p_other) {
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void operator=(const SmallHashMap &p_other) {
+		if (this == &p_other) {
+			return;
+		}
+		clear();
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	~SmallHashMap() {
+		_small_reset();
+	}
+};
+
+#endif // SMALL_HASH_MAP_H
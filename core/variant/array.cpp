@@ -35,18 +35,172 @@
 #include "container_type_validate.h"
 #include "core/math/math_funcs.h"
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
 #include "core/templates/hashfuncs.h"
 #include "core/templates/search_array.h"
 #include "core/templates/vector.h"
 #include "core/variant/callable.h"
 #include "core/variant/dictionary.h"
 #include "core/variant/variant.h"
+#include "core/variant/variant_internal.h"
+
+// Describes how elements of a value type are stored in the unboxed storage of a typed array.
+struct ArrayUnboxedType {
+	uint32_t size = 0;
+	void (*box)(const uint8_t *p_src, Variant &r_dst) = nullptr;
+	void (*unbox)(const Variant &p_src, uint8_t *r_dst) = nullptr;
+	void (*initialize)(uint8_t *r_dst) = nullptr;
+};
+
+// Elements are copied in and out of the storage with memcpy(), as the storage and the
+// buffers holding a single element aren't necessarily aligned for T (e.g. double in a float build).
+template <typename T>
+struct ArrayUnboxed {
+	static void box(const uint8_t *p_src, Variant &r_dst) {
+		T value;
+		memcpy(&value, p_src, sizeof(T));
+		r_dst = value;
+	}
+	static void unbox(const Variant &p_src, uint8_t *r_dst) { memcpy(r_dst, VariantGetInternalPtr<T>::get_ptr(&p_src), sizeof(T)); }
+	static void initialize(uint8_t *r_dst) {
+		const T value = T();
+		memcpy(r_dst, &value, sizeof(T));
+	}
+
+	static const ArrayUnboxedType *get_type() {
+		static_assert(std::is_trivially_destructible_v<T>);
+		static_assert(sizeof(T) <= sizeof(real_t) * 4);
+		static const ArrayUnboxedType type = { sizeof(T), &box, &unbox, &initialize };
+		return &type;
+	}
+};
+
+static const ArrayUnboxedType *_get_array_unboxed_type(Variant::Type p_type) {
+#ifdef MODULE_MONO_ENABLED
+	// The C# glue reads the elements from `ArrayPrivate::array` directly.
+	return nullptr;
+#else
+	switch (p_type) {
+		case Variant::BOOL:
+			return ArrayUnboxed<bool>::get_type();
+		case Variant::INT:
+			return ArrayUnboxed<int64_t>::get_type();
+		case Variant::FLOAT:
+			return ArrayUnboxed<double>::get_type();
+		case Variant::VECTOR2:
+			return ArrayUnboxed<Vector2>::get_type();
+		case Variant::VECTOR2I:
+			return ArrayUnboxed<Vector2i>::get_type();
+		case Variant::RECT2:
+			return ArrayUnboxed<Rect2>::get_type();
+		case Variant::RECT2I:
+			return ArrayUnboxed<Rect2i>::get_type();
+		case Variant::VECTOR3:
+			return ArrayUnboxed<Vector3>::get_type();
+		case Variant::VECTOR3I:
+			return ArrayUnboxed<Vector3i>::get_type();
+		case Variant::VECTOR4:
+			return ArrayUnboxed<Vector4>::get_type();
+		case Variant::VECTOR4I:
+			return ArrayUnboxed<Vector4i>::get_type();
+		case Variant::PLANE:
+			return ArrayUnboxed<Plane>::get_type();
+		case Variant::QUATERNION:
+			return ArrayUnboxed<Quaternion>::get_type();
+		case Variant::COLOR:
+			return ArrayUnboxed<Color>::get_type();
+		default:
+			return nullptr;
+	}
+#endif // MODULE_MONO_ENABLED
+}
+
+static BinaryMutex array_box_mutex;
 
 struct ArrayPrivate {
 	SafeRefCount refcount;
 	Vector<Variant> array;
 	Variant *read_only = nullptr; // If enabled, a pointer is used to a temporary value that is used to return read-only values.
 	ContainerTypeValidate typed;
+
+	// Arrays typed with a value type keep their elements unboxed while `is_unboxed` is set, and
+	// `array` is empty. Anything that needs Variant references to the elements boxes them first,
+	// and the array stays boxed until it's cleared.
+	const ArrayUnboxedType *unboxed_type = nullptr;
+	Vector<uint8_t> unboxed;
+	int unboxed_count = 0;
+	SafeFlag is_unboxed;
+
+	static constexpr int MAX_UNBOXED_SIZE = sizeof(real_t) * 4;
+
+	_FORCE_INLINE_ int get_size() const {
+		return is_unboxed.is_set() ? unboxed_count : array.size();
+	}
+
+	_FORCE_INLINE_ const uint8_t *unboxed_ptr(int p_idx) const {
+		return unboxed.ptr() + p_idx * unboxed_type->size;
+	}
+
+	_FORCE_INLINE_ uint8_t *unboxed_ptrw(int p_idx) {
+		return unboxed.ptrw() + p_idx * unboxed_type->size;
+	}
+
+	// Converts p_value to the element type and stores it in r_dst, returns false if it can't be stored.
+	_FORCE_INLINE_ bool unbox_value(const Variant &p_value, uint8_t *r_dst, const char *p_operation) const {
+		if (likely(p_value.get_type() == typed.type)) {
+			unboxed_type->unbox(p_value, r_dst);
+			return true;
+		}
+		Variant value = p_value;
+		if (!typed.validate(value, p_operation)) {
+			return false;
+		}
+		unboxed_type->unbox(value, r_dst);
+		return true;
+	}
+
+	void set_unboxed_count(int p_count) {
+		unboxed.resize(int64_t(p_count) * unboxed_type->size);
+		unboxed_count = p_count;
+	}
+
+	void reset_unboxed() {
+		array.clear();
+		unboxed.clear();
+		unboxed_count = 0;
+		is_unboxed.set();
+	}
+
+	// Can be called from const methods, even from several threads at once.
+	_FORCE_INLINE_ void box() const {
+		if (unlikely(is_unboxed.is_set())) {
+			const_cast<ArrayPrivate *>(this)->_box();
+		}
+	}
+
+	// Also releases the unboxed storage, as it won't be used again.
+	_FORCE_INLINE_ void box_for_write() {
+		if (unlikely(is_unboxed.is_set() || !unboxed.is_empty())) {
+			_box();
+			unboxed.clear();
+			unboxed_count = 0;
+		}
+	}
+
+	void _box() {
+		MutexLock lock(array_box_mutex);
+		if (!is_unboxed.is_set()) {
+			return;
+		}
+		Vector<Variant> boxed;
+		boxed.resize(unboxed_count);
+		Variant *dst = boxed.ptrw();
+		for (int i = 0; i < unboxed_count; i++) {
+			unboxed_type->box(unboxed_ptr(i), dst[i]);
+		}
+		array = boxed;
+		is_unboxed.clear();
+	}
 };
 
 void Array::_ref(const Array &p_from) const {
@@ -82,22 +236,27 @@ void Array::_unref() const {
 }
 
 Array::Iterator Array::begin() {
+	_p->box_for_write();
 	return Iterator(_p->array.ptrw(), _p->read_only);
 }
 
 Array::Iterator Array::end() {
+	_p->box_for_write();
 	return Iterator(_p->array.ptrw() + _p->array.size(), _p->read_only);
 }
 
 Array::ConstIterator Array::begin() const {
+	_p->box();
 	return ConstIterator(_p->array.ptr(), _p->read_only);
 }
 
 Array::ConstIterator Array::end() const {
+	_p->box();
 	return ConstIterator(_p->array.ptr() + _p->array.size(), _p->read_only);
 }
 
 Variant &Array::operator[](int p_idx) {
+	_p->box_for_write();
 	if (unlikely(_p->read_only)) {
 		*_p->read_only = _p->array[p_idx];
 		return *_p->read_only;
@@ -106,6 +265,7 @@ Variant &Array::operator[](int p_idx) {
 }
 
 const Variant &Array::operator[](int p_idx) const {
+	_p->box();
 	if (unlikely(_p->read_only)) {
 		*_p->read_only = _p->array[p_idx];
 		return *_p->read_only;
@@ -114,16 +274,20 @@ const Variant &Array::operator[](int p_idx) const {
 }
 
 int Array::size() const {
-	return _p->array.size();
+	return _p->get_size();
 }
 
 bool Array::is_empty() const {
-	return _p->array.is_empty();
+	return _p->get_size() == 0;
 }
 
 void Array::clear() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
-	_p->array.clear();
+	if (_p->unboxed_type) {
+		_p->reset_unboxed();
+	} else {
+		_p->array.clear();
+	}
 }
 
 bool Array::operator==(const Array &p_array) const {
@@ -139,6 +303,8 @@ bool Array::recursive_equal(const Array &p_array, int recursion_count) const {
 	if (_p == p_array._p) {
 		return true;
 	}
+	_p->box();
+	p_array._p->box();
 	const Vector<Variant> &a1 = _p->array;
 	const Vector<Variant> &a2 = p_array._p->array;
 	const int size = a1.size();
@@ -200,6 +366,7 @@ uint32_t Array::recursive_hash(int recursion_count) const {
 
 	uint32_t h = hash_murmur3_one_32(Variant::ARRAY);
 
+	_p->box();
 	recursion_count++;
 	for (int i = 0; i < _p->array.size(); i++) {
 		h = hash_murmur3_one_32(_p->array[i].recursive_hash(recursion_count), h);
@@ -218,11 +385,21 @@ void Array::assign(const Array &p_array) {
 	const ContainerTypeValidate &typed = _p->typed;
 	const ContainerTypeValidate &source_typed = p_array._p->typed;
 
+	if (_p->unboxed_type && p_array._p->is_unboxed.is_set() && typed == source_typed) {
+		_p->array.clear();
+		_p->unboxed = p_array._p->unboxed;
+		_p->unboxed_count = p_array._p->unboxed_count;
+		_p->is_unboxed.set();
+		return;
+	}
+
+	p_array._p->box();
+
 	if (typed == source_typed || typed.type == Variant::NIL || (source_typed.type == Variant::OBJECT && typed.can_reference(source_typed))) {
 		// from same to same or
 		// from anything to variants or
 		// from subclasses to base classes
-		_p->array = p_array._p->array;
+		_set_elements(p_array._p->array);
 		return;
 	}
 
@@ -238,7 +415,7 @@ void Array::assign(const Array &p_array) {
 				ERR_FAIL_MSG(vformat(R"(Unable to convert array index %d from "%s" to "%s".)", i, Variant::get_type_name(element.get_type()), Variant::get_type_name(typed.type)));
 			}
 		}
-		_p->array = p_array._p->array;
+		_set_elements(p_array._p->array);
 		return;
 	}
 	if (typed.type == Variant::OBJECT || source_typed.type == Variant::OBJECT) {
@@ -276,11 +453,34 @@ void Array::assign(const Array &p_array) {
 		ERR_FAIL_MSG(vformat(R"(Cannot assign contents of "Array[%s]" to "Array[%s]".)", Variant::get_type_name(source_typed.type), Variant::get_type_name(typed.type)));
 	}
 
-	_p->array = array;
+	_set_elements(array);
+}
+
+void Array::_set_elements(const Vector<Variant> &p_elements) {
+	if (!_p->unboxed_type) {
+		_p->array = p_elements;
+		return;
+	}
+	// Elements are known to be of the array type at this point. Keep a reference, they may come from this array.
+	const Vector<Variant> elements = p_elements;
+	_p->reset_unboxed();
+	_p->set_unboxed_count(elements.size());
+	for (int i = 0; i < elements.size(); i++) {
+		_p->unboxed_type->unbox(elements[i], _p->unboxed_ptrw(i));
+	}
 }
 
 void Array::push_back(const Variant &p_value) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	if (_p->is_unboxed.is_set()) {
+		uint8_t value[ArrayPrivate::MAX_UNBOXED_SIZE];
+		ERR_FAIL_COND(!_p->unbox_value(p_value, value, "push_back"));
+		const int count = _p->unboxed_count;
+		_p->set_unboxed_count(count + 1);
+		memcpy(_p->unboxed_ptrw(count), value, _p->unboxed_type->size);
+		return;
+	}
+	_p->box_for_write();
 	Variant value = p_value;
 	ERR_FAIL_COND(!_p->typed.validate(value, "push_back"));
 	_p->array.push_back(value);
@@ -289,6 +489,29 @@ void Array::push_back(const Variant &p_value) {
 void Array::append_array(const Array &p_array) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
 
+	if (_p->is_unboxed.is_set()) {
+		const int count = _p->unboxed_count;
+		const int source_count = p_array.size();
+		if (p_array._p->is_unboxed.is_set() && p_array._p->unboxed_type == _p->unboxed_type) {
+			_p->unboxed.append_array(p_array._p->unboxed);
+			_p->unboxed_count += source_count;
+			return;
+		}
+		Vector<uint8_t> validated_array;
+		validated_array.resize(source_count * _p->unboxed_type->size);
+		for (int i = 0; i < source_count; i++) {
+			Variant value;
+			p_array.get_value(i, value);
+			ERR_FAIL_COND(!_p->unbox_value(value, validated_array.ptrw() + i * _p->unboxed_type->size, "append_array"));
+		}
+		_p->unboxed.append_array(validated_array);
+		_p->unboxed_count = count + source_count;
+		return;
+	}
+
+	_p->box_for_write();
+	p_array._p->box();
+
 	Vector<Variant> validated_array = p_array._p->array;
 	for (int i = 0; i < validated_array.size(); ++i) {
 		ERR_FAIL_COND(!_p->typed.validate(validated_array.write[i], "append_array"));
@@ -299,6 +522,21 @@ void Array::append_array(const Array &p_array) {
 
 Error Array::resize(int p_new_size) {
 	ERR_FAIL_COND_V_MSG(_p->read_only, ERR_LOCKED, "Array is in read-only state.");
+	if (_p->is_unboxed.is_set()) {
+		ERR_FAIL_COND_V(p_new_size < 0, ERR_INVALID_PARAMETER);
+		const int old_size = _p->unboxed_count;
+		// Computed in 64 bits, as p_new_size elements can take more than 4 GiB.
+		Error err = _p->unboxed.resize(int64_t(p_new_size) * _p->unboxed_type->size);
+		if (err) {
+			return err;
+		}
+		_p->unboxed_count = p_new_size;
+		for (int i = old_size; i < p_new_size; i++) {
+			_p->unboxed_type->initialize(_p->unboxed_ptrw(i));
+		}
+		return OK;
+	}
+	_p->box_for_write();
 	Variant::Type &variant_type = _p->typed.type;
 	int old_size = _p->array.size();
 	Error err = _p->array.resize_zeroed(p_new_size);
@@ -312,6 +550,18 @@ Error Array::resize(int p_new_size) {
 
 Error Array::insert(int p_pos, const Variant &p_value) {
 	ERR_FAIL_COND_V_MSG(_p->read_only, ERR_LOCKED, "Array is in read-only state.");
+	if (_p->is_unboxed.is_set()) {
+		const int count = _p->unboxed_count;
+		ERR_FAIL_INDEX_V(p_pos, count + 1, ERR_INVALID_PARAMETER);
+		uint8_t value[ArrayPrivate::MAX_UNBOXED_SIZE];
+		ERR_FAIL_COND_V(!_p->unbox_value(p_value, value, "insert"), ERR_INVALID_PARAMETER);
+		const uint32_t element_size = _p->unboxed_type->size;
+		_p->set_unboxed_count(count + 1);
+		memmove(_p->unboxed_ptrw(p_pos + 1), _p->unboxed_ptrw(p_pos), (count - p_pos) * element_size);
+		memcpy(_p->unboxed_ptrw(p_pos), value, element_size);
+		return OK;
+	}
+	_p->box_for_write();
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed.validate(value, "insert"), ERR_INVALID_PARAMETER);
 	return _p->array.insert(p_pos, value);
@@ -319,6 +569,15 @@ Error Array::insert(int p_pos, const Variant &p_value) {
 
 void Array::fill(const Variant &p_value) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	if (_p->is_unboxed.is_set()) {
+		uint8_t value[ArrayPrivate::MAX_UNBOXED_SIZE];
+		ERR_FAIL_COND(!_p->unbox_value(p_value, value, "fill"));
+		for (int i = 0; i < _p->unboxed_count; i++) {
+			memcpy(_p->unboxed_ptrw(i), value, _p->unboxed_type->size);
+		}
+		return;
+	}
+	_p->box_for_write();
 	Variant value = p_value;
 	ERR_FAIL_COND(!_p->typed.validate(value, "fill"));
 	_p->array.fill(value);
@@ -326,28 +585,44 @@ void Array::fill(const Variant &p_value) {
 
 void Array::erase(const Variant &p_value) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	if (_p->is_unboxed.is_set()) {
+		Variant value = p_value;
+		ERR_FAIL_COND(!_p->typed.validate(value, "erase"));
+		int idx = _find_unboxed(value, 0);
+		if (idx >= 0) {
+			remove_at(idx);
+		}
+		return;
+	}
+	_p->box_for_write();
 	Variant value = p_value;
 	ERR_FAIL_COND(!_p->typed.validate(value, "erase"));
 	_p->array.erase(value);
 }
 
 Variant Array::front() const {
-	ERR_FAIL_COND_V_MSG(_p->array.is_empty(), Variant(), "Can't take value from empty array.");
-	return operator[](0);
+	ERR_FAIL_COND_V_MSG(is_empty(), Variant(), "Can't take value from empty array.");
+	Variant ret;
+	get_value(0, ret);
+	return ret;
 }
 
 Variant Array::back() const {
-	ERR_FAIL_COND_V_MSG(_p->array.is_empty(), Variant(), "Can't take value from empty array.");
-	return operator[](_p->array.size() - 1);
+	ERR_FAIL_COND_V_MSG(is_empty(), Variant(), "Can't take value from empty array.");
+	Variant ret;
+	get_value(size() - 1, ret);
+	return ret;
 }
 
 Variant Array::pick_random() const {
-	ERR_FAIL_COND_V_MSG(_p->array.is_empty(), Variant(), "Can't take value from empty array.");
-	return operator[](Math::rand() % _p->array.size());
+	ERR_FAIL_COND_V_MSG(is_empty(), Variant(), "Can't take value from empty array.");
+	Variant ret;
+	get_value(Math::rand() % size(), ret);
+	return ret;
 }
 
 int Array::find(const Variant &p_value, int p_from) const {
-	if (_p->array.size() == 0) {
+	if (size() == 0) {
 		return -1;
 	}
 	Variant value = p_value;
@@ -359,6 +634,10 @@ int Array::find(const Variant &p_value, int p_from) const {
 		return ret;
 	}
 
+	if (_p->is_unboxed.is_set()) {
+		return _find_unboxed(value, p_from);
+	}
+
 	for (int i = p_from; i < size(); i++) {
 		if (StringLikeVariantComparator::compare(_p->array[i], value)) {
 			ret = i;
@@ -376,6 +655,8 @@ int Array::find_custom(const Callable &p_callable, int p_from) const {
 		return ret;
 	}
 
+	_p->box();
+
 	const Variant *argptrs[1];
 
 	for (int i = p_from; i < size(); i++) {
@@ -398,12 +679,14 @@ int Array::find_custom(const Callable &p_callable, int p_from) const {
 }
 
 int Array::rfind(const Variant &p_value, int p_from) const {
-	if (_p->array.size() == 0) {
+	if (size() == 0) {
 		return -1;
 	}
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed.validate(value, "rfind"), -1);
 
+	_p->box();
+
 	if (p_from < 0) {
 		// Relative offset from the end
 		p_from = _p->array.size() + p_from;
@@ -423,10 +706,12 @@ int Array::rfind(const Variant &p_value, int p_from) const {
 }
 
 int Array::rfind_custom(const Callable &p_callable, int p_from) const {
-	if (_p->array.size() == 0) {
+	if (size() == 0) {
 		return -1;
 	}
 
+	_p->box();
+
 	if (p_from < 0) {
 		// Relative offset from the end.
 		p_from = _p->array.size() + p_from;
@@ -460,11 +745,21 @@ int Array::rfind_custom(const Callable &p_callable, int p_from) const {
 int Array::count(const Variant &p_value) const {
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed.validate(value, "count"), 0);
-	if (_p->array.size() == 0) {
+	if (size() == 0) {
 		return 0;
 	}
 
 	int amount = 0;
+	if (_p->is_unboxed.is_set()) {
+		Variant element;
+		for (int i = 0; i < _p->unboxed_count; i++) {
+			_p->unboxed_type->box(_p->unboxed_ptr(i), element);
+			if (element.hash_compare(value)) {
+				amount++;
+			}
+		}
+		return amount;
+	}
 	for (int i = 0; i < _p->array.size(); i++) {
 		if (StringLikeVariantComparator::compare(_p->array[i], value)) {
 			amount++;
@@ -483,11 +778,26 @@ bool Array::has(const Variant &p_value) const {
 
 void Array::remove_at(int p_pos) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	if (_p->is_unboxed.is_set()) {
+		const int count = _p->unboxed_count;
+		ERR_FAIL_INDEX(p_pos, count);
+		const uint32_t element_size = _p->unboxed_type->size;
+		uint8_t *data = _p->unboxed_ptrw(0);
+		memmove(data + p_pos * element_size, data + (p_pos + 1) * element_size, (count - p_pos - 1) * element_size);
+		_p->set_unboxed_count(count - 1);
+		return;
+	}
+	_p->box_for_write();
 	_p->array.remove_at(p_pos);
 }
 
 void Array::set(int p_idx, const Variant &p_value) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	if (_p->is_unboxed.is_set()) {
+		ERR_FAIL_INDEX(p_idx, _p->unboxed_count);
+		ERR_FAIL_COND(!_p->unbox_value(p_value, _p->unboxed_ptrw(p_idx), "set"));
+		return;
+	}
 	Variant value = p_value;
 	ERR_FAIL_COND(!_p->typed.validate(value, "set"));
 
@@ -498,6 +808,15 @@ const Variant &Array::get(int p_idx) const {
 	return operator[](p_idx);
 }
 
+void Array::get_value(int p_idx, Variant &r_value) const {
+	if (_p->is_unboxed.is_set()) {
+		CRASH_BAD_INDEX(p_idx, _p->unboxed_count);
+		_p->unboxed_type->box(_p->unboxed_ptr(p_idx), r_value);
+		return;
+	}
+	r_value = operator[](p_idx);
+}
+
 Array Array::duplicate(bool p_deep) const {
 	return recursive_duplicate(p_deep, 0);
 }
@@ -505,6 +824,7 @@ Array Array::duplicate(bool p_deep) const {
 Array Array::recursive_duplicate(bool p_deep, int recursion_count) const {
 	Array new_arr;
 	new_arr._p->typed = _p->typed;
+	new_arr._p->unboxed_type = _p->unboxed_type;
 
 	if (recursion_count > MAX_RECURSION) {
 		ERR_PRINT("Max recursion reached");
@@ -514,10 +834,18 @@ Array Array::recursive_duplicate(bool p_deep, int recursion_count) const {
 	if (p_deep) {
 		recursion_count++;
 		int element_count = size();
+		if (_p->is_unboxed.is_set()) {
+			// Value types have nothing to duplicate deeply.
+			return recursive_duplicate(false, recursion_count);
+		}
 		new_arr.resize(element_count);
 		for (int i = 0; i < element_count; i++) {
 			new_arr[i] = get(i).recursive_duplicate(true, recursion_count);
 		}
+	} else if (_p->is_unboxed.is_set()) {
+		new_arr._p->unboxed = _p->unboxed;
+		new_arr._p->unboxed_count = _p->unboxed_count;
+		new_arr._p->is_unboxed.set();
 	} else {
 		new_arr._p->array = _p->array;
 	}
@@ -528,6 +856,7 @@ Array Array::recursive_duplicate(bool p_deep, int recursion_count) const {
 Array Array::slice(int p_begin, int p_end, int p_step, bool p_deep) const {
 	Array result;
 	result._p->typed = _p->typed;
+	result._p->unboxed_type = _p->unboxed_type;
 
 	ERR_FAIL_COND_V_MSG(p_step == 0, result, "Slice step cannot be zero.");
 
@@ -564,6 +893,7 @@ Array Array::filter(const Callable &p_callable) const {
 	Array new_arr;
 	new_arr.resize(size());
 	new_arr._p->typed = _p->typed;
+	new_arr._p->unboxed_type = _p->unboxed_type;
 	int accepted_count = 0;
 
 	const Variant *argptrs[1];
@@ -692,16 +1022,19 @@ struct _ArrayVariantSort {
 
 void Array::sort() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	_p->box_for_write();
 	_p->array.sort_custom<_ArrayVariantSort>();
 }
 
 void Array::sort_custom(const Callable &p_callable) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	_p->box_for_write();
 	_p->array.sort_custom<CallableComparator, true>(p_callable);
 }
 
 void Array::shuffle() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	_p->box_for_write();
 	const int n = _p->array.size();
 	if (n < 2) {
 		return;
@@ -718,6 +1051,7 @@ void Array::shuffle() {
 int Array::bsearch(const Variant &p_value, bool p_before) const {
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed.validate(value, "binary search"), -1);
+	_p->box();
 	SearchArray<Variant, _ArrayVariantSort> avs;
 	return avs.bisect(_p->array.ptrw(), _p->array.size(), value, p_before);
 }
@@ -725,17 +1059,30 @@ int Array::bsearch(const Variant &p_value, bool p_before) const {
 int Array::bsearch_custom(const Variant &p_value, const Callable &p_callable, bool p_before) const {
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed.validate(value, "custom binary search"), -1);
+	_p->box();
 
 	return _p->array.bsearch_custom<CallableComparator>(value, p_before, p_callable);
 }
 
 void Array::reverse() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	_p->box_for_write();
 	_p->array.reverse();
 }
 
 void Array::push_front(const Variant &p_value) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	if (_p->is_unboxed.is_set()) {
+		uint8_t value[ArrayPrivate::MAX_UNBOXED_SIZE];
+		ERR_FAIL_COND(!_p->unbox_value(p_value, value, "push_front"));
+		const int count = _p->unboxed_count;
+		const uint32_t element_size = _p->unboxed_type->size;
+		_p->set_unboxed_count(count + 1);
+		memmove(_p->unboxed_ptrw(1), _p->unboxed_ptrw(0), count * element_size);
+		memcpy(_p->unboxed_ptrw(0), value, element_size);
+		return;
+	}
+	_p->box_for_write();
 	Variant value = p_value;
 	ERR_FAIL_COND(!_p->typed.validate(value, "push_front"));
 	_p->array.insert(0, value);
@@ -743,6 +1090,10 @@ void Array::push_front(const Variant &p_value) {
 
 Variant Array::pop_back() {
 	ERR_FAIL_COND_V_MSG(_p->read_only, Variant(), "Array is in read-only state.");
+	if (_p->is_unboxed.is_set()) {
+		return _pop_unboxed(_p->unboxed_count - 1);
+	}
+	_p->box_for_write();
 	if (!_p->array.is_empty()) {
 		const int n = _p->array.size() - 1;
 		const Variant ret = _p->array.get(n);
@@ -754,6 +1105,10 @@ Variant Array::pop_back() {
 
 Variant Array::pop_front() {
 	ERR_FAIL_COND_V_MSG(_p->read_only, Variant(), "Array is in read-only state.");
+	if (_p->is_unboxed.is_set()) {
+		return _pop_unboxed(0);
+	}
+	_p->box_for_write();
 	if (!_p->array.is_empty()) {
 		const Variant ret = _p->array.get(0);
 		_p->array.remove_at(0);
@@ -764,30 +1119,56 @@ Variant Array::pop_front() {
 
 Variant Array::pop_at(int p_pos) {
 	ERR_FAIL_COND_V_MSG(_p->read_only, Variant(), "Array is in read-only state.");
-	if (_p->array.is_empty()) {
+	if (is_empty()) {
 		// Return `null` without printing an error to mimic `pop_back()` and `pop_front()` behavior.
 		return Variant();
 	}
 
 	if (p_pos < 0) {
 		// Relative offset from the end
-		p_pos = _p->array.size() + p_pos;
+		p_pos = size() + p_pos;
 	}
 
 	ERR_FAIL_INDEX_V_MSG(
 			p_pos,
-			_p->array.size(),
+			size(),
 			Variant(),
 			vformat(
 					"The calculated index %s is out of bounds (the array has %s elements). Leaving the array untouched and returning `null`.",
 					p_pos,
-					_p->array.size()));
+					size()));
 
+	if (_p->is_unboxed.is_set()) {
+		return _pop_unboxed(p_pos);
+	}
+	_p->box_for_write();
 	const Variant ret = _p->array.get(p_pos);
 	_p->array.remove_at(p_pos);
 	return ret;
 }
 
+// p_value must be validated already.
+int Array::_find_unboxed(const Variant &p_value, int p_from) const {
+	Variant element;
+	for (int i = p_from; i < _p->unboxed_count; i++) {
+		_p->unboxed_type->box(_p->unboxed_ptr(i), element);
+		if (element.hash_compare(p_value)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+Variant Array::_pop_unboxed(int p_pos) {
+	if (_p->unboxed_count == 0) {
+		return Variant();
+	}
+	Variant ret;
+	_p->unboxed_type->box(_p->unboxed_ptr(p_pos), ret);
+	remove_at(p_pos);
+	return ret;
+}
+
 Variant Array::min() const {
 	Variant minval;
 	for (int i = 0; i < size(); i++) {
@@ -849,7 +1230,7 @@ void Array::set_typed(const ContainerType &p_element_type) {
 
 void Array::set_typed(uint32_t p_type, const StringName &p_class_name, const Variant &p_script) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
-	ERR_FAIL_COND_MSG(_p->array.size() > 0, "Type can only be set when array is empty.");
+	ERR_FAIL_COND_MSG(size() > 0, "Type can only be set when array is empty.");
 	ERR_FAIL_COND_MSG(_p->refcount.get() > 1, "Type can only be set when array has no more than one user.");
 	ERR_FAIL_COND_MSG(_p->typed.type != Variant::NIL, "Type can only be set once.");
 	ERR_FAIL_COND_MSG(p_class_name != StringName() && p_type != Variant::OBJECT, "Class names can only be set for type OBJECT");
@@ -860,6 +1241,11 @@ void Array::set_typed(uint32_t p_type, const StringName &p_class_name, const Var
 	_p->typed.class_name = p_class_name;
 	_p->typed.script = script;
 	_p->typed.where = "TypedArray";
+
+	_p->unboxed_type = _get_array_unboxed_type(_p->typed.type);
+	if (_p->unboxed_type) {
+		_p->reset_unboxed();
+	}
 }
 
 bool Array::is_typed() const {
@@ -882,6 +1268,10 @@ ContainerType Array::get_element_type() const {
 	return type;
 }
 
+bool Array::is_unboxed() const {
+	return _p->is_unboxed.is_set();
+}
+
 uint32_t Array::get_typed_builtin() const {
 	return _p->typed.type;
 }
@@ -902,6 +1292,7 @@ Array Array::create_read_only() {
 
 void Array::make_read_only() {
 	if (_p->read_only == nullptr) {
+		_p->box_for_write();
 		_p->read_only = memnew(Variant);
 	}
 }
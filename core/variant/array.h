@@ -41,12 +41,18 @@ class Callable;
 class StringName;
 class Variant;
 
+template <typename T>
+class Vector;
+
 struct ArrayPrivate;
 struct ContainerType;
 
 class Array {
 	mutable ArrayPrivate *_p;
 	void _unref() const;
+	void _set_elements(const Vector<Variant> &p_elements);
+	Variant _pop_unboxed(int p_pos);
+	int _find_unboxed(const Variant &p_value, int p_from) const;
 
 public:
 	struct ConstIterator {
@@ -120,6 +126,8 @@ public:
 
 	void set(int p_idx, const Variant &p_value);
 	const Variant &get(int p_idx) const;
+	// Unlike get(), doesn't need a reference to the element, so typed arrays don't have to box their elements.
+	void get_value(int p_idx, Variant &r_value) const;
 
 	int size() const;
 	bool is_empty() const;
@@ -194,6 +202,8 @@ public:
 	bool is_typed() const;
 	bool is_same_typed(const Array &p_other) const;
 	bool is_same_instance(const Array &p_other) const;
+	// Whether the elements are currently stored without Variant boxing, see set_typed().
+	bool is_unboxed() const;
 
 	ContainerType get_element_type() const;
 	uint32_t get_typed_builtin() const;
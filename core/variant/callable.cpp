@@ -484,6 +484,10 @@ int CallableCustom::get_unbound_arguments_count() const {
 	return 0;
 }
 
+bool CallableCustom::call_typed(const void *p_signature, const void **p_arguments) const {
+	return false;
+}
+
 CallableCustom::CallableCustom() {
 	ref_count.init();
 }
@@ -138,6 +138,15 @@ public:
 	~Callable();
 };
 
+// Identifies a list of parameter types, see CallableCustom::call_typed().
+template <typename... P>
+struct CallableTypedSignature {
+	static const void *get() {
+		static const char tag = 0;
+		return &tag;
+	}
+};
+
 class CallableCustom {
 	friend class Callable;
 	SafeRefCount ref_count;
@@ -162,6 +171,9 @@ public:
 	virtual int get_bound_arguments_count() const;
 	virtual void get_bound_arguments(Vector<Variant> &r_arguments) const;
 	virtual int get_unbound_arguments_count() const;
+	// Calls with arguments that are not Variants, if p_signature matches the parameters
+	// this callable expects. Returns false without calling otherwise.
+	virtual bool call_typed(const void *p_signature, const void **p_arguments) const;
 
 	CallableCustom();
 	virtual ~CallableCustom() {}
@@ -589,6 +589,8 @@ public:
 	virtual Variant shader_get_parameter_default(RID p_shader, const StringName &p_name) const override;
 
 	virtual RS::ShaderNativeSourceCode shader_get_native_source_code(RID p_shader) const override;
+	virtual bool shader_is_compiled(RID p_shader) const override { return true; }
+	virtual void shader_request_compiled_callback(RID p_shader, const Callable &p_callable) override { p_callable.call(); }
 
 	/* MATERIAL API */
 
@@ -108,6 +108,8 @@ public:
 		PIPELINE_COMPILATIONS_SURFACE,
 		PIPELINE_COMPILATIONS_DRAW,
 		PIPELINE_COMPILATIONS_SPECIALIZATION,
+		MEMORY_ALLOCATOR_RESERVED,
+		MEMORY_ALLOCATOR_FREE,
 		MONITOR_MAX
 	};
 
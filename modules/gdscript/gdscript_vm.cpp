@@ -3219,7 +3219,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				if (!array->is_empty()) {
 					GET_VARIANT_PTR(iterator, 2);
-					*iterator = array->get(0);
+					array->get_value(0, *iterator);
 
 					// Skip regular iterate.
 					ip += 5;
@@ -3563,7 +3563,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					ip = jumpto;
 				} else {
 					GET_VARIANT_PTR(iterator, 2);
-					*iterator = array->get(*idx);
+					array->get_value(*idx, *iterator);
 
 					ip += 5; // Loop again.
 				}
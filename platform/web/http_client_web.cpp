@@ -99,6 +99,9 @@ Error HTTPClientWeb::request(Method p_method, const String &p_url, const Vector<
 	Vector<const char *> c_strings;
 	for (int i = 0; i < p_headers.size(); i++) {
 		keeper.push_back(p_headers[i].utf8());
+	}
+	// Short strings are stored inline, so only take pointers once keeper stopped growing.
+	for (int i = 0; i < keeper.size(); i++) {
 		c_strings.push_back(keeper[i].get_data());
 	}
 	if (js_id) {
@@ -143,7 +143,7 @@ void Area2D::_body_enter_tree(ObjectID p_id) {
 	ERR_FAIL_COND(E->value.in_tree);
 
 	E->value.in_tree = true;
-	emit_signal(SceneStringName(body_entered), node);
+	emit_signal_typed(SceneStringName(body_entered), node);
 	for (int i = 0; i < E->value.shapes.size(); i++) {
 		emit_signal(SceneStringName(body_shape_entered), E->value.rid, node, E->value.shapes[i].body_shape, E->value.shapes[i].area_shape);
 	}
@@ -157,7 +157,7 @@ void Area2D::_body_exit_tree(ObjectID p_id) {
 	ERR_FAIL_COND(!E);
 	ERR_FAIL_COND(!E->value.in_tree);
 	E->value.in_tree = false;
-	emit_signal(SceneStringName(body_exited), node);
+	emit_signal_typed(SceneStringName(body_exited), node);
 	for (int i = 0; i < E->value.shapes.size(); i++) {
 		emit_signal(SceneStringName(body_shape_exited), E->value.rid, node, E->value.shapes[i].body_shape, E->value.shapes[i].area_shape);
 	}
@@ -204,7 +204,7 @@ void Area2D::_body_inout(int p_status, const RID &p_body, ObjectID p_instance, i
 				node->connect(SceneStringName(tree_entered), callable_mp(this, &Area2D::_body_enter_tree).bind(objid));
 				node->connect(SceneStringName(tree_exiting), callable_mp(this, &Area2D::_body_exit_tree).bind(objid));
 				if (E->value.in_tree) {
-					emit_signal(SceneStringName(body_entered), node);
+					emit_signal_typed(SceneStringName(body_entered), node);
 				}
 			}
 		}
@@ -254,7 +254,7 @@ void Area2D::_area_enter_tree(ObjectID p_id) {
 	ERR_FAIL_COND(E->value.in_tree);
 
 	E->value.in_tree = true;
-	emit_signal(SceneStringName(area_entered), node);
+	emit_signal_typed(SceneStringName(area_entered), node);
 	for (int i = 0; i < E->value.shapes.size(); i++) {
 		emit_signal(SceneStringName(area_shape_entered), E->value.rid, node, E->value.shapes[i].area_shape, E->value.shapes[i].self_shape);
 	}
@@ -268,7 +268,7 @@ void Area2D::_area_exit_tree(ObjectID p_id) {
 	ERR_FAIL_COND(!E);
 	ERR_FAIL_COND(!E->value.in_tree);
 	E->value.in_tree = false;
-	emit_signal(SceneStringName(area_exited), node);
+	emit_signal_typed(SceneStringName(area_exited), node);
 	for (int i = 0; i < E->value.shapes.size(); i++) {
 		emit_signal(SceneStringName(area_shape_exited), E->value.rid, node, E->value.shapes[i].area_shape, E->value.shapes[i].self_shape);
 	}
@@ -315,7 +315,7 @@ void Area2D::_area_inout(int p_status, const RID &p_area, ObjectID p_instance, i
 				node->connect(SceneStringName(tree_entered), callable_mp(this, &Area2D::_area_enter_tree).bind(objid));
 				node->connect(SceneStringName(tree_exiting), callable_mp(this, &Area2D::_area_exit_tree).bind(objid));
 				if (E->value.in_tree) {
-					emit_signal(SceneStringName(area_entered), node);
+					emit_signal_typed(SceneStringName(area_entered), node);
 				}
 			}
 		}
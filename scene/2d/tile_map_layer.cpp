@@ -246,7 +246,10 @@ void TileMapLayer::_rendering_update(bool p_force_cleanup) {
 		}
 
 		// Update all dirty quadrants.
+		// Their canvas items are freed here, their draw lists are then built (on worker threads if there are
+		// enough of them) and finally committed to the RenderingServer from this thread.
 		bool needs_set_not_interpolated = is_inside_tree() && get_tree()->is_physics_interpolation_enabled() && !is_physics_interpolated();
+		LocalVector<RenderingQuadrant *> quadrants_to_draw;
 		for (SelfList<RenderingQuadrant> *quadrant_list_element = dirty_rendering_quadrant_list.first(); quadrant_list_element;) {
 			SelfList<RenderingQuadrant> *next_quadrant_list_element = quadrant_list_element->next(); // "Hack" to clear the list while iterating.
 
@@ -263,103 +266,13 @@ void TileMapLayer::_rendering_update(bool p_force_cleanup) {
 			}
 
 			if (has_a_tile) {
-				// Process the quadrant.
-
-				// First, clear the quadrant's canvas items.
+				// Clear the quadrant's canvas items, they are recreated when committing the quadrant.
 				for (RID &ci : rendering_quadrant->canvas_items) {
 					rs->free(ci);
 				}
 				rendering_quadrant->canvas_items.clear();
 
-				// Sort the quadrant cells.
-				if (is_y_sort_enabled() && x_draw_order_reversed) {
-					rendering_quadrant->cells.sort_custom<CellDataYSortedXReversedComparator>();
-				} else {
-					rendering_quadrant->cells.sort();
-				}
-
-				// Those allow to group cell per material or z-index.
-				Ref<Material> prev_material;
-				int prev_z_index = 0;
-				RID prev_ci;
-
-				for (SelfList<CellData> *cell_data_quadrant_list_element = rendering_quadrant->cells.first(); cell_data_quadrant_list_element; cell_data_quadrant_list_element = cell_data_quadrant_list_element->next()) {
-					CellData &cell_data = *cell_data_quadrant_list_element->self();
-
-					TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(*tile_set->get_source(cell_data.cell.source_id));
-
-					// Get the tile data.
-					const TileData *tile_data;
-					if (cell_data.runtime_tile_data_cache) {
-						tile_data = cell_data.runtime_tile_data_cache;
-					} else {
-						tile_data = atlas_source->get_tile_data(cell_data.cell.get_atlas_coords(), cell_data.cell.alternative_tile);
-					}
-
-					Ref<Material> mat = tile_data->get_material();
-					int tile_z_index = tile_data->get_z_index();
-
-					// Quandrant pos.
-
-					// --- CanvasItems ---
-					RID ci;
-
-					// Check if the material or the z_index changed.
-					if (prev_ci == RID() || prev_material != mat || prev_z_index != tile_z_index) {
-						// If so, create a new CanvasItem.
-						ci = rs->canvas_item_create();
-						if (needs_set_not_interpolated) {
-							rs->canvas_item_set_interpolated(ci, false);
-						}
-						if (mat.is_valid()) {
-							rs->canvas_item_set_material(ci, mat->get_rid());
-						}
-						rs->canvas_item_set_parent(ci, get_canvas_item());
-						rs->canvas_item_set_use_parent_material(ci, mat.is_null());
-
-						Transform2D xform(0, rendering_quadrant->canvas_items_position);
-						rs->canvas_item_set_transform(ci, xform);
-
-						rs->canvas_item_set_light_mask(ci, get_light_mask());
-						rs->canvas_item_set_z_as_relative_to_parent(ci, true);
-						rs->canvas_item_set_z_index(ci, tile_z_index);
-
-						rs->canvas_item_set_default_texture_filter(ci, RS::CanvasItemTextureFilter(get_texture_filter_in_tree()));
-						rs->canvas_item_set_default_texture_repeat(ci, RS::CanvasItemTextureRepeat(get_texture_repeat_in_tree()));
-
-						rendering_quadrant->canvas_items.push_back(ci);
-
-						prev_ci = ci;
-						prev_material = mat;
-						prev_z_index = tile_z_index;
-
-					} else {
-						// Keep the same canvas_item to draw on.
-						ci = prev_ci;
-					}
-
-					const Vector2 local_tile_pos = tile_set->map_to_local(cell_data.coords);
-
-					// Random animation offset.
-					real_t random_animation_offset = 0.0;
-					if (atlas_source->get_tile_animation_mode(cell_data.cell.get_atlas_coords()) != TileSetAtlasSource::TILE_ANIMATION_MODE_DEFAULT) {
-						Array to_hash;
-						to_hash.push_back(local_tile_pos);
-						to_hash.push_back(get_instance_id()); // Use instance id as a random hash
-						random_animation_offset = RandomPCG(to_hash.hash()).randf();
-					}
-
-					// Drawing the tile in the canvas item.
-					draw_tile(ci, local_tile_pos - rendering_quadrant->canvas_items_position, tile_set, cell_data.cell.source_id, cell_data.cell.get_atlas_coords(), cell_data.cell.alternative_tile, -1, get_self_modulate(), tile_data, random_animation_offset);
-				}
-
-				// Reset physics interpolation for any recreated canvas items.
-				if (is_physics_interpolated_and_enabled() && is_visible_in_tree()) {
-					for (const RID &ci : rendering_quadrant->canvas_items) {
-						rs->canvas_item_reset_physics_interpolation(ci);
-					}
-				}
-
+				quadrants_to_draw.push_back(rendering_quadrant.ptr());
 			} else {
 				// Free the quadrant.
 				for (const RID &ci : rendering_quadrant->canvas_items) {
@@ -374,6 +287,23 @@ void TileMapLayer::_rendering_update(bool p_force_cleanup) {
 			quadrant_list_element = next_quadrant_list_element;
 		}
 
+		RenderingQuadrantsPrepare prepare;
+		prepare.rendering_quadrants = quadrants_to_draw.ptr();
+		prepare.y_sort_x_draw_order_reversed = is_y_sort_enabled() && x_draw_order_reversed;
+		prepare.instance_id = get_instance_id();
+		if (quadrants_to_draw.size() >= RENDERING_PARALLEL_QUADRANTS_MIN) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &TileMapLayer::_rendering_quadrants_prepare_thread, (const RenderingQuadrantsPrepare *)&prepare, quadrants_to_draw.size(), -1, true, SNAME("TileMapLayerPrepareQuadrants"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (RenderingQuadrant *rendering_quadrant : quadrants_to_draw) {
+				_rendering_quadrant_prepare(rendering_quadrant, prepare);
+			}
+		}
+
+		for (RenderingQuadrant *rendering_quadrant : quadrants_to_draw) {
+			_rendering_quadrant_commit(rendering_quadrant, needs_set_not_interpolated);
+		}
+
 		dirty_rendering_quadrant_list.clear();
 
 		// Reset the drawing indices.
@@ -557,6 +487,120 @@ void TileMapLayer::_rendering_quadrants_update_cell(CellData &r_cell_data, SelfL
 	}
 }
 
+void TileMapLayer::_rendering_quadrant_prepare(RenderingQuadrant *p_rendering_quadrant, const RenderingQuadrantsPrepare &p_prepare) const {
+	// This may run on a worker thread, so it must not call into the RenderingServer nor
+	// use the node getters. Each quadrant only touches its own cells list and prepared data.
+	if (p_prepare.y_sort_x_draw_order_reversed) {
+		p_rendering_quadrant->cells.sort_custom<CellDataYSortedXReversedComparator>();
+	} else {
+		p_rendering_quadrant->cells.sort();
+	}
+
+	LocalVector<RenderingQuadrant::CanvasItemBatch> &batches = p_rendering_quadrant->prepared_batches;
+	LocalVector<RenderingQuadrant::DrawCommand> &draw_commands = p_rendering_quadrant->prepared_draw_commands;
+	batches.clear();
+	draw_commands.clear();
+
+	for (SelfList<CellData> *cell_data_quadrant_list_element = p_rendering_quadrant->cells.first(); cell_data_quadrant_list_element; cell_data_quadrant_list_element = cell_data_quadrant_list_element->next()) {
+		const CellData &cell_data = *cell_data_quadrant_list_element->self();
+
+		TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(*tile_set->get_source(cell_data.cell.source_id));
+
+		// Get the tile data.
+		const TileData *tile_data;
+		if (cell_data.runtime_tile_data_cache) {
+			tile_data = cell_data.runtime_tile_data_cache;
+		} else {
+			tile_data = atlas_source->get_tile_data(cell_data.cell.get_atlas_coords(), cell_data.cell.alternative_tile);
+		}
+
+		// Start a new batch if the material or the z_index changed.
+		Ref<Material> mat = tile_data->get_material();
+		int tile_z_index = tile_data->get_z_index();
+		if (batches.is_empty() || batches[batches.size() - 1].material != mat || batches[batches.size() - 1].z_index != tile_z_index) {
+			RenderingQuadrant::CanvasItemBatch batch;
+			batch.material = mat;
+			batch.z_index = tile_z_index;
+			batches.push_back(batch);
+		}
+
+		const Vector2 local_tile_pos = tile_set->map_to_local(cell_data.coords);
+
+		// Random animation offset.
+		real_t random_animation_offset = 0.0;
+		if (atlas_source->get_tile_animation_mode(cell_data.cell.get_atlas_coords()) != TileSetAtlasSource::TILE_ANIMATION_MODE_DEFAULT) {
+			Array to_hash;
+			to_hash.push_back(local_tile_pos);
+			to_hash.push_back(p_prepare.instance_id); // Use instance id as a random hash
+			random_animation_offset = RandomPCG(to_hash.hash()).randf();
+		}
+
+		RenderingQuadrant::DrawCommand draw_command;
+		draw_command.tile_data = tile_data;
+		draw_command.source_id = cell_data.cell.source_id;
+		draw_command.atlas_coords = cell_data.cell.get_atlas_coords();
+		draw_command.alternative_tile = cell_data.cell.alternative_tile;
+		draw_command.position = local_tile_pos - p_rendering_quadrant->canvas_items_position;
+		draw_command.animation_offset = random_animation_offset;
+		draw_command.batch = batches.size() - 1;
+		draw_commands.push_back(draw_command);
+	}
+}
+
+void TileMapLayer::_rendering_quadrants_prepare_thread(uint32_t p_index, const RenderingQuadrantsPrepare *p_prepare) {
+	_rendering_quadrant_prepare(p_prepare->rendering_quadrants[p_index], *p_prepare);
+}
+
+void TileMapLayer::_rendering_quadrant_commit(RenderingQuadrant *p_rendering_quadrant, bool p_needs_set_not_interpolated) {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	// Create one canvas item per batch.
+	LocalVector<RID> batch_canvas_items;
+	batch_canvas_items.resize(p_rendering_quadrant->prepared_batches.size());
+	for (uint32_t i = 0; i < p_rendering_quadrant->prepared_batches.size(); i++) {
+		const RenderingQuadrant::CanvasItemBatch &batch = p_rendering_quadrant->prepared_batches[i];
+
+		RID ci = rs->canvas_item_create();
+		if (p_needs_set_not_interpolated) {
+			rs->canvas_item_set_interpolated(ci, false);
+		}
+		if (batch.material.is_valid()) {
+			rs->canvas_item_set_material(ci, batch.material->get_rid());
+		}
+		rs->canvas_item_set_parent(ci, get_canvas_item());
+		rs->canvas_item_set_use_parent_material(ci, batch.material.is_null());
+
+		Transform2D xform(0, p_rendering_quadrant->canvas_items_position);
+		rs->canvas_item_set_transform(ci, xform);
+
+		rs->canvas_item_set_light_mask(ci, get_light_mask());
+		rs->canvas_item_set_z_as_relative_to_parent(ci, true);
+		rs->canvas_item_set_z_index(ci, batch.z_index);
+
+		rs->canvas_item_set_default_texture_filter(ci, RS::CanvasItemTextureFilter(get_texture_filter_in_tree()));
+		rs->canvas_item_set_default_texture_repeat(ci, RS::CanvasItemTextureRepeat(get_texture_repeat_in_tree()));
+
+		p_rendering_quadrant->canvas_items.push_back(ci);
+		batch_canvas_items[i] = ci;
+	}
+
+	// Draw the tiles in their canvas items.
+	const Color self_modulate = get_self_modulate();
+	for (const RenderingQuadrant::DrawCommand &draw_command : p_rendering_quadrant->prepared_draw_commands) {
+		draw_tile(batch_canvas_items[draw_command.batch], draw_command.position, tile_set, draw_command.source_id, draw_command.atlas_coords, draw_command.alternative_tile, -1, self_modulate, draw_command.tile_data, draw_command.animation_offset);
+	}
+
+	// Reset physics interpolation for any recreated canvas items.
+	if (is_physics_interpolated_and_enabled() && is_visible_in_tree()) {
+		for (const RID &ci : p_rendering_quadrant->canvas_items) {
+			rs->canvas_item_reset_physics_interpolation(ci);
+		}
+	}
+
+	p_rendering_quadrant->prepared_batches.reset();
+	p_rendering_quadrant->prepared_draw_commands.reset();
+}
+
 void TileMapLayer::_rendering_occluders_clear_cell(CellData &r_cell_data) {
 	RenderingServer *rs = RenderingServer::get_singleton();
 
@@ -1798,6 +1842,10 @@ void TileMapLayer::_notification(int p_what) {
 			dirty.flags[DIRTY_FLAGS_LAYER_VISIBILITY] = true;
 			_queue_internal_update();
 		} break;
+
+		case NOTIFICATION_INTERNAL_PROCESS: {
+			_streaming_update(false);
+		} break;
 	}
 
 	_rendering_notification(p_what);
@@ -1809,6 +1857,7 @@ void TileMapLayer::_bind_methods() {
 	// --- Cells manipulation ---
 	// Generic cells manipulations and access.
 	ClassDB::bind_method(D_METHOD("set_cell", "coords", "source_id", "atlas_coords", "alternative_tile"), &TileMapLayer::set_cell, DEFVAL(TileSet::INVALID_SOURCE), DEFVAL(TileSetSource::INVALID_ATLAS_COORDS), DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("set_cells_batch", "coords", "source_ids", "atlas_coords", "alternative_tiles"), &TileMapLayer::set_cells_batch, DEFVAL(PackedInt32Array()));
 	ClassDB::bind_method(D_METHOD("erase_cell", "coords"), &TileMapLayer::erase_cell);
 	ClassDB::bind_method(D_METHOD("fix_invalid_tiles"), &TileMapLayer::fix_invalid_tiles);
 	ClassDB::bind_method(D_METHOD("clear"), &TileMapLayer::clear);
@@ -1842,6 +1891,18 @@ void TileMapLayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("update_internals"), &TileMapLayer::update_internals);
 	ClassDB::bind_method(D_METHOD("notify_runtime_tile_data_update"), &TileMapLayer::notify_runtime_tile_data_update);
 
+	// --- Streaming ---
+	ClassDB::bind_method(D_METHOD("save_streaming_file", "path", "chunk_size"), &TileMapLayer::save_streaming_file, DEFVAL(64));
+	ClassDB::bind_method(D_METHOD("start_streaming", "path"), &TileMapLayer::start_streaming);
+	ClassDB::bind_method(D_METHOD("stop_streaming"), &TileMapLayer::stop_streaming);
+	ClassDB::bind_method(D_METHOD("is_streaming"), &TileMapLayer::is_streaming);
+	ClassDB::bind_method(D_METHOD("flush_streaming"), &TileMapLayer::flush_streaming);
+	ClassDB::bind_method(D_METHOD("set_streaming_focus_points", "points"), &TileMapLayer::set_streaming_focus_points);
+	ClassDB::bind_method(D_METHOD("get_streaming_focus_points"), &TileMapLayer::get_streaming_focus_points);
+	ClassDB::bind_method(D_METHOD("set_streaming_radius", "radius"), &TileMapLayer::set_streaming_radius);
+	ClassDB::bind_method(D_METHOD("get_streaming_radius"), &TileMapLayer::get_streaming_radius);
+	ClassDB::bind_method(D_METHOD("get_streaming_loaded_chunk_count"), &TileMapLayer::get_streaming_loaded_chunk_count);
+
 	// --- Shortcuts to methods defined in TileSet ---
 	ClassDB::bind_method(D_METHOD("map_pattern", "position_in_tilemap", "coords_in_pattern", "pattern"), &TileMapLayer::map_pattern);
 	ClassDB::bind_method(D_METHOD("get_surrounding_cells", "coords"), &TileMapLayer::get_surrounding_cells);
@@ -1903,6 +1964,8 @@ void TileMapLayer::_bind_methods() {
 	ADD_GROUP("Navigation", "");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "navigation_enabled"), "set_navigation_enabled", "is_navigation_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "navigation_visibility_mode", PROPERTY_HINT_ENUM, "Default,Force Show,Force Hide"), "set_navigation_visibility_mode", "get_navigation_visibility_mode");
+	ADD_GROUP("Streaming", "streaming_");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "streaming_radius", PROPERTY_HINT_RANGE, "0,16,1,or_greater"), "set_streaming_radius", "get_streaming_radius");
 
 	ADD_SIGNAL(MethodInfo(CoreStringName(changed)));
 
@@ -2364,9 +2427,30 @@ void TileMapLayer::draw_tile(RID p_canvas_item, const Vector2 &p_position, const
 	}
 }
 
-void TileMapLayer::set_cell(const Vector2i &p_coords, int p_source_id, const Vector2i &p_atlas_coords, int p_alternative_tile) {
+static Vector2i _coords_to_streaming_chunk(const Vector2i &p_coords, int p_chunk_size) {
+	// Rounding down, instead of simply rounding towards zero (truncating).
+	return Vector2i(
+			p_coords.x >= 0 ? p_coords.x / p_chunk_size : (p_coords.x - (p_chunk_size - 1)) / p_chunk_size,
+			p_coords.y >= 0 ? p_coords.y / p_chunk_size : (p_coords.y - (p_chunk_size - 1)) / p_chunk_size);
+}
+
+// Streamed cells are stored with unsigned 16-bit fields. They hold any cell of the layer,
+// as long as its values are not negative.
+static_assert(sizeof(TileMapCell) == 4 * sizeof(int16_t));
+
+static bool _is_cell_streamable(const TileMapCell &p_cell) {
+	return p_cell.source_id >= 0 && p_cell.coord_x >= 0 && p_cell.coord_y >= 0 && p_cell.alternative_tile >= 0;
+}
+
+bool TileMapLayer::_set_cell_no_update(const Vector2i &p_coords, int p_source_id, const Vector2i &p_atlas_coords, int p_alternative_tile) {
 	// Set the current cell tile (using integer position).
 	Vector2i pk(p_coords);
+
+	// The chunk's cells must be in the layer before they are modified by the user, or loading it would overwrite them.
+	if (streaming_chunk_size > 0 && !streaming_applying) {
+		_streaming_load_chunk_for_edit(_coords_to_streaming_chunk(pk, streaming_chunk_size));
+	}
+
 	HashMap<Vector2i, CellData>::Iterator E = tile_map_layer_data.find(pk);
 
 	int source_id = p_source_id;
@@ -2382,7 +2466,7 @@ void TileMapLayer::set_cell(const Vector2i &p_coords, int p_source_id, const Vec
 
 	if (!E) {
 		if (source_id == TileSet::INVALID_SOURCE) {
-			return; // Nothing to do, the tile is already empty.
+			return false; // Nothing to do, the tile is already empty.
 		}
 
 		// Insert a new cell in the tile map.
@@ -2391,7 +2475,7 @@ void TileMapLayer::set_cell(const Vector2i &p_coords, int p_source_id, const Vec
 		E = tile_map_layer_data.insert(pk, new_cell_data);
 	} else {
 		if (E->value.cell.source_id == source_id && E->value.cell.get_atlas_coords() == atlas_coords && E->value.cell.alternative_tile == alternative_tile) {
-			return; // Nothing changed.
+			return false; // Nothing changed.
 		}
 	}
 
@@ -2404,9 +2488,43 @@ void TileMapLayer::set_cell(const Vector2i &p_coords, int p_source_id, const Vec
 	if (!E->value.dirty_list_element.in_list()) {
 		dirty.cell_list.add(&(E->value.dirty_list_element));
 	}
-	_queue_internal_update();
 
-	used_rect_cache_dirty = true;
+	// Keep track of the streamed chunks modified by the user.
+	if (streaming_chunk_size > 0 && !streaming_applying) {
+		streaming_chunks[_coords_to_streaming_chunk(pk, streaming_chunk_size)].modified = true;
+	}
+	return true;
+}
+
+void TileMapLayer::set_cell(const Vector2i &p_coords, int p_source_id, const Vector2i &p_atlas_coords, int p_alternative_tile) {
+	if (_set_cell_no_update(p_coords, p_source_id, p_atlas_coords, p_alternative_tile)) {
+		_queue_internal_update();
+		used_rect_cache_dirty = true;
+	}
+}
+
+void TileMapLayer::set_cells_batch(const PackedVector2Array &p_coords, const PackedInt32Array &p_source_ids, const PackedVector2Array &p_atlas_coords, const PackedInt32Array &p_alternative_tiles) {
+	int count = p_coords.size();
+	ERR_FAIL_COND_MSG(p_source_ids.size() != count, "The source_ids array must have the same size as the coords array.");
+	ERR_FAIL_COND_MSG(p_atlas_coords.size() != count, "The atlas_coords array must have the same size as the coords array.");
+	ERR_FAIL_COND_MSG(!p_alternative_tiles.is_empty() && p_alternative_tiles.size() != count, "The alternative_tiles array must be empty or have the same size as the coords array.");
+
+	const Vector2 *coords_ptr = p_coords.ptr();
+	const int32_t *source_ids_ptr = p_source_ids.ptr();
+	const Vector2 *atlas_coords_ptr = p_atlas_coords.ptr();
+	const int32_t *alternative_tiles_ptr = p_alternative_tiles.is_empty() ? nullptr : p_alternative_tiles.ptr();
+
+	tile_map_layer_data.reserve(tile_map_layer_data.size() + count);
+
+	bool changed = false;
+	for (int i = 0; i < count; i++) {
+		changed |= _set_cell_no_update(Vector2i(coords_ptr[i]), source_ids_ptr[i], Vector2i(atlas_coords_ptr[i]), alternative_tiles_ptr ? alternative_tiles_ptr[i] : 0);
+	}
+
+	if (changed) {
+		_queue_internal_update();
+		used_rect_cache_dirty = true;
+	}
 }
 
 void TileMapLayer::erase_cell(const Vector2i &p_coords) {
@@ -2719,6 +2837,346 @@ void TileMapLayer::notify_runtime_tile_data_update() {
 	emit_signal(CoreStringName(changed));
 }
 
+void TileMapLayer::_streaming_load_chunk(StreamingChunk *p_chunk) {
+	// Runs on a worker thread. Only the chunk's loaded_cells are written.
+	p_chunk->loaded_cells.resize(p_chunk->file_cell_count * STREAMING_CELL_SIZE);
+
+	MutexLock lock(streaming_file_mutex);
+	streaming_file->seek(p_chunk->file_offset);
+	uint64_t read = streaming_file->get_buffer(p_chunk->loaded_cells.ptrw(), p_chunk->loaded_cells.size());
+	if (read != (uint64_t)p_chunk->loaded_cells.size()) {
+		p_chunk->loaded_cells.clear();
+		ERR_FAIL_MSG(vformat("Corrupted tile map streaming file: chunk at offset %d is truncated.", p_chunk->file_offset));
+	}
+}
+
+void TileMapLayer::_streaming_apply_chunk(const Vector2i &p_chunk_coords, const Vector<uint8_t> &p_cells) {
+	const Vector2i origin = p_chunk_coords * streaming_chunk_size;
+	const uint8_t *ptr = p_cells.ptr();
+	int cell_count = p_cells.size() / STREAMING_CELL_SIZE;
+
+	bool changed = false;
+	streaming_applying = true;
+	for (int i = 0; i < cell_count; i++) {
+		const uint8_t *cell_data_ptr = &ptr[i * STREAMING_CELL_SIZE];
+		Vector2i coords = origin + Vector2i(decode_uint16(&cell_data_ptr[0]), decode_uint16(&cell_data_ptr[2]));
+		Vector2i atlas_coords = Vector2i(decode_uint16(&cell_data_ptr[6]), decode_uint16(&cell_data_ptr[8]));
+		changed |= _set_cell_no_update(coords, decode_uint16(&cell_data_ptr[4]), atlas_coords, decode_uint16(&cell_data_ptr[10]));
+	}
+	streaming_applying = false;
+
+	if (changed) {
+		_queue_internal_update();
+		used_rect_cache_dirty = true;
+	}
+}
+
+Vector<uint8_t> TileMapLayer::_streaming_encode_chunk(const Vector2i &p_chunk_coords) const {
+	const Vector2i origin = p_chunk_coords * streaming_chunk_size;
+
+	Vector<uint8_t> cells;
+	for (int y = 0; y < streaming_chunk_size; y++) {
+		for (int x = 0; x < streaming_chunk_size; x++) {
+			HashMap<Vector2i, CellData>::ConstIterator E = tile_map_layer_data.find(origin + Vector2i(x, y));
+			if (!E || E->value.cell.source_id == TileSet::INVALID_SOURCE) {
+				continue;
+			}
+			ERR_CONTINUE_MSG(!_is_cell_streamable(E->value.cell), vformat("Cannot keep the modified cell %s in memory: its source ID, atlas coordinates and alternative tile can't be negative.", origin + Vector2i(x, y)));
+			int index = cells.size();
+			cells.resize(index + STREAMING_CELL_SIZE);
+			uint8_t *cell_data_ptr = &cells.ptrw()[index];
+			encode_uint16((uint16_t)x, &cell_data_ptr[0]);
+			encode_uint16((uint16_t)y, &cell_data_ptr[2]);
+			encode_uint16(E->value.cell.source_id, &cell_data_ptr[4]);
+			encode_uint16(E->value.cell.coord_x, &cell_data_ptr[6]);
+			encode_uint16(E->value.cell.coord_y, &cell_data_ptr[8]);
+			encode_uint16(E->value.cell.alternative_tile, &cell_data_ptr[10]);
+		}
+	}
+	return cells;
+}
+
+void TileMapLayer::_streaming_unload_chunk(const Vector2i &p_chunk_coords, StreamingChunk &r_chunk) {
+	// Keep the user's modifications in memory, the file is never written to.
+	if (r_chunk.modified) {
+		r_chunk.cells = _streaming_encode_chunk(p_chunk_coords);
+		r_chunk.has_cells = true;
+		r_chunk.modified = false;
+	}
+
+	const Vector2i origin = p_chunk_coords * streaming_chunk_size;
+	bool changed = false;
+	streaming_applying = true;
+	for (int y = 0; y < streaming_chunk_size; y++) {
+		for (int x = 0; x < streaming_chunk_size; x++) {
+			changed |= _set_cell_no_update(origin + Vector2i(x, y), TileSet::INVALID_SOURCE, TileSetSource::INVALID_ATLAS_COORDS, TileSetSource::INVALID_TILE_ALTERNATIVE);
+		}
+	}
+	streaming_applying = false;
+	r_chunk.state = StreamingChunk::STATE_UNLOADED;
+
+	if (changed) {
+		_queue_internal_update();
+		used_rect_cache_dirty = true;
+	}
+}
+
+void TileMapLayer::_streaming_load_chunk_for_edit(const Vector2i &p_chunk_coords) {
+	HashMap<Vector2i, StreamingChunk>::Iterator chunk_it = streaming_chunks.find(p_chunk_coords);
+	if (!chunk_it) {
+		// A chunk that is not in the file, it only exists in memory.
+		streaming_chunks.insert(p_chunk_coords, StreamingChunk())->value.state = StreamingChunk::STATE_LOADED;
+		streaming_loaded_chunks.push_back(p_chunk_coords);
+		return;
+	}
+
+	StreamingChunk &chunk = chunk_it->value;
+	switch (chunk.state) {
+		case StreamingChunk::STATE_LOADED: {
+		} break;
+		case StreamingChunk::STATE_LOADING: {
+			// Apply the pending load now, the edit goes on top of it.
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(chunk.load_task);
+			chunk.load_task = WorkerThreadPool::INVALID_TASK_ID;
+			chunk.state = StreamingChunk::STATE_LOADED;
+			_streaming_apply_chunk(p_chunk_coords, chunk.loaded_cells);
+			chunk.loaded_cells.clear();
+			streaming_loading_chunks.erase(p_chunk_coords);
+			streaming_loaded_chunks.push_back(p_chunk_coords);
+		} break;
+		case StreamingChunk::STATE_UNLOADED: {
+			// Load it synchronously. It's unloaded again by the next update if it's out of range,
+			// keeping the edit in memory.
+			chunk.state = StreamingChunk::STATE_LOADED;
+			if (chunk.has_cells) {
+				_streaming_apply_chunk(p_chunk_coords, chunk.cells);
+			} else {
+				_streaming_load_chunk(&chunk);
+				_streaming_apply_chunk(p_chunk_coords, chunk.loaded_cells);
+				chunk.loaded_cells.clear();
+			}
+			streaming_loaded_chunks.push_back(p_chunk_coords);
+		} break;
+	}
+}
+
+void TileMapLayer::_streaming_update(bool p_wait) {
+	if (streaming_chunk_size <= 0 || tile_set.is_null()) {
+		return;
+	}
+
+	// List the chunks the focus points are in.
+	LocalVector<Vector2i> focus_chunks;
+	for (const Vector2 &point : streaming_focus_points) {
+		Vector2i chunk_coords = _coords_to_streaming_chunk(local_to_map(point), streaming_chunk_size);
+		if (!focus_chunks.has(chunk_coords)) {
+			focus_chunks.push_back(chunk_coords);
+		}
+	}
+
+	// Unload the chunks that went out of range. Chunks are kept one chunk further than they are loaded,
+	// so a focus point moving back and forth over a chunk border does not reload them every time.
+	for (uint32_t i = 0; i < streaming_loaded_chunks.size();) {
+		const Vector2i chunk_coords = streaming_loaded_chunks[i];
+		bool in_range = false;
+		for (const Vector2i &focus_chunk : focus_chunks) {
+			Vector2i distance = (chunk_coords - focus_chunk).abs();
+			if (MAX(distance.x, distance.y) <= streaming_radius + 1) {
+				in_range = true;
+				break;
+			}
+		}
+		if (in_range) {
+			i++;
+		} else {
+			_streaming_unload_chunk(chunk_coords, streaming_chunks[chunk_coords]);
+			streaming_loaded_chunks.remove_at_unordered(i);
+		}
+	}
+
+	// Start loading the chunks in range.
+	for (const Vector2i &focus_chunk : focus_chunks) {
+		for (int y = focus_chunk.y - streaming_radius; y <= focus_chunk.y + streaming_radius; y++) {
+			for (int x = focus_chunk.x - streaming_radius; x <= focus_chunk.x + streaming_radius; x++) {
+				const Vector2i chunk_coords(x, y);
+				HashMap<Vector2i, StreamingChunk>::Iterator chunk_it = streaming_chunks.find(chunk_coords);
+				if (!chunk_it || chunk_it->value.state != StreamingChunk::STATE_UNLOADED) {
+					continue;
+				}
+				StreamingChunk &chunk = chunk_it->value;
+				if (chunk.has_cells) {
+					// Modified chunks are already in memory.
+					chunk.state = StreamingChunk::STATE_LOADED;
+					_streaming_apply_chunk(chunk_coords, chunk.cells);
+					streaming_loaded_chunks.push_back(chunk_coords);
+				} else {
+					chunk.state = StreamingChunk::STATE_LOADING;
+					chunk.load_task = WorkerThreadPool::get_singleton()->add_template_task(this, &TileMapLayer::_streaming_load_chunk, &chunk, false, SNAME("TileMapLayerStreamChunk"));
+					streaming_loading_chunks.push_back(chunk_coords);
+				}
+			}
+		}
+	}
+
+	// Apply the chunks that finished loading.
+	for (uint32_t i = 0; i < streaming_loading_chunks.size();) {
+		const Vector2i chunk_coords = streaming_loading_chunks[i];
+		StreamingChunk &chunk = streaming_chunks[chunk_coords];
+		if (!p_wait && !WorkerThreadPool::get_singleton()->is_task_completed(chunk.load_task)) {
+			i++;
+			continue;
+		}
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(chunk.load_task);
+		chunk.load_task = WorkerThreadPool::INVALID_TASK_ID;
+		chunk.state = StreamingChunk::STATE_LOADED;
+		_streaming_apply_chunk(chunk_coords, chunk.loaded_cells);
+		chunk.loaded_cells.clear();
+		streaming_loading_chunks.remove_at_unordered(i);
+		streaming_loaded_chunks.push_back(chunk_coords);
+	}
+}
+
+Error TileMapLayer::save_streaming_file(const String &p_path, int p_chunk_size) const {
+	ERR_FAIL_COND_V_MSG(is_streaming(), ERR_BUSY, "Cannot save a streaming file while streaming. Call stop_streaming() first.");
+	ERR_FAIL_COND_V_MSG(p_chunk_size < 1 || p_chunk_size > STREAMING_CHUNK_SIZE_MAX, ERR_INVALID_PARAMETER, vformat("The chunk size must be between 1 and %d.", STREAMING_CHUNK_SIZE_MAX));
+
+	// Group the cells per chunk.
+	HashMap<Vector2i, LocalVector<const CellData *>> chunk_cells;
+	for (const KeyValue<Vector2i, CellData> &kv : tile_map_layer_data) {
+		if (kv.value.cell.source_id != TileSet::INVALID_SOURCE) {
+			ERR_FAIL_COND_V_MSG(!_is_cell_streamable(kv.value.cell), ERR_INVALID_DATA, vformat("Cannot save cell %s to a streaming file: its source ID, atlas coordinates and alternative tile can't be negative.", kv.key));
+			chunk_cells[_coords_to_streaming_chunk(kv.key, p_chunk_size)].push_back(&kv.value);
+		}
+	}
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Cannot open tile map streaming file '%s' for writing.", p_path));
+
+	// Header.
+	f->store_buffer((const uint8_t *)"RTMS", 4);
+	f->store_32(STREAMING_FILE_VERSION);
+	f->store_32(p_chunk_size);
+	f->store_32(chunk_cells.size());
+
+	// Chunks index.
+	uint64_t offset = STREAMING_HEADER_SIZE + (uint64_t)chunk_cells.size() * STREAMING_INDEX_ENTRY_SIZE;
+	for (const KeyValue<Vector2i, LocalVector<const CellData *>> &kv : chunk_cells) {
+		f->store_32((uint32_t)kv.key.x);
+		f->store_32((uint32_t)kv.key.y);
+		f->store_64(offset);
+		f->store_32(kv.value.size());
+		offset += (uint64_t)kv.value.size() * STREAMING_CELL_SIZE;
+	}
+
+	// Chunks cells, with coordinates relative to their chunk.
+	Vector<uint8_t> buffer;
+	for (const KeyValue<Vector2i, LocalVector<const CellData *>> &kv : chunk_cells) {
+		const Vector2i origin = kv.key * p_chunk_size;
+		buffer.resize(kv.value.size() * STREAMING_CELL_SIZE);
+		uint8_t *ptr = buffer.ptrw();
+		for (uint32_t i = 0; i < kv.value.size(); i++) {
+			const CellData &cell_data = *kv.value[i];
+			uint8_t *cell_data_ptr = &ptr[i * STREAMING_CELL_SIZE];
+			encode_uint16((uint16_t)(cell_data.coords.x - origin.x), &cell_data_ptr[0]);
+			encode_uint16((uint16_t)(cell_data.coords.y - origin.y), &cell_data_ptr[2]);
+			encode_uint16(cell_data.cell.source_id, &cell_data_ptr[4]);
+			encode_uint16(cell_data.cell.coord_x, &cell_data_ptr[6]);
+			encode_uint16(cell_data.cell.coord_y, &cell_data_ptr[8]);
+			encode_uint16(cell_data.cell.alternative_tile, &cell_data_ptr[10]);
+		}
+		f->store_buffer(buffer);
+	}
+
+	return OK;
+}
+
+Error TileMapLayer::start_streaming(const String &p_path) {
+	ERR_FAIL_COND_V_MSG(is_streaming(), ERR_BUSY, "This layer is already streaming. Call stop_streaming() first.");
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Cannot open tile map streaming file '%s'.", p_path));
+
+	uint8_t magic[4];
+	f->get_buffer(magic, 4);
+	ERR_FAIL_COND_V_MSG(magic[0] != 'R' || magic[1] != 'T' || magic[2] != 'M' || magic[3] != 'S', ERR_FILE_UNRECOGNIZED, vformat("'%s' is not a tile map streaming file.", p_path));
+	uint32_t version = f->get_32();
+	ERR_FAIL_COND_V_MSG(version != STREAMING_FILE_VERSION, ERR_FILE_UNRECOGNIZED, vformat("Unsupported tile map streaming file version: %d.", version));
+	uint32_t chunk_size = f->get_32();
+	ERR_FAIL_COND_V_MSG(chunk_size < 1 || chunk_size > STREAMING_CHUNK_SIZE_MAX, ERR_FILE_CORRUPT, vformat("Corrupted tile map streaming file: invalid chunk size %d.", chunk_size));
+	uint32_t chunk_count = f->get_32();
+
+	// Only the index is read now, the cells are read when their chunk gets in range.
+	HashMap<Vector2i, StreamingChunk> chunks;
+	chunks.reserve(chunk_count);
+	for (uint32_t i = 0; i < chunk_count; i++) {
+		Vector2i chunk_coords;
+		chunk_coords.x = (int32_t)f->get_32();
+		chunk_coords.y = (int32_t)f->get_32();
+		StreamingChunk chunk;
+		chunk.file_offset = f->get_64();
+		chunk.file_cell_count = f->get_32();
+		chunks.insert(chunk_coords, chunk);
+	}
+	ERR_FAIL_COND_V_MSG(f->eof_reached(), ERR_FILE_CORRUPT, "Corrupted tile map streaming file: the chunks index is truncated.");
+
+	// Streamed cells replace the current ones.
+	clear();
+
+	streaming_file = f;
+	streaming_chunk_size = chunk_size;
+	streaming_chunks = chunks;
+	set_process_internal(true);
+
+	return OK;
+}
+
+void TileMapLayer::stop_streaming() {
+	if (!is_streaming()) {
+		return;
+	}
+
+	for (const Vector2i &chunk_coords : streaming_loading_chunks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(streaming_chunks[chunk_coords].load_task);
+	}
+	streaming_loading_chunks.clear();
+	streaming_loaded_chunks.clear();
+	streaming_chunks.clear();
+	streaming_file.unref();
+	streaming_chunk_size = 0;
+	set_process_internal(false);
+}
+
+bool TileMapLayer::is_streaming() const {
+	return streaming_chunk_size > 0;
+}
+
+void TileMapLayer::flush_streaming() {
+	_streaming_update(true);
+}
+
+void TileMapLayer::set_streaming_focus_points(const PackedVector2Array &p_points) {
+	streaming_focus_points = p_points;
+}
+
+PackedVector2Array TileMapLayer::get_streaming_focus_points() const {
+	return streaming_focus_points;
+}
+
+void TileMapLayer::set_streaming_radius(int p_radius) {
+	ERR_FAIL_COND(p_radius < 0);
+	streaming_radius = p_radius;
+}
+
+int TileMapLayer::get_streaming_radius() const {
+	return streaming_radius;
+}
+
+int TileMapLayer::get_streaming_loaded_chunk_count() const {
+	return streaming_loaded_chunks.size();
+}
+
 Vector2i TileMapLayer::map_pattern(const Vector2i &p_position_in_tilemap, const Vector2i &p_coords_in_pattern, Ref<TileMapPattern> p_pattern) {
 	ERR_FAIL_COND_V(tile_set.is_null(), Vector2i());
 	return tile_set->map_pattern(p_position_in_tilemap, p_coords_in_pattern, p_pattern);
@@ -3184,6 +3642,7 @@ TileMapLayer::TileMapLayer() {
 }
 
 TileMapLayer::~TileMapLayer() {
+	stop_streaming();
 	clear();
 	_internal_update(true);
 }
@@ -33,6 +33,8 @@
 #ifndef TILE_MAP_LAYER_H
 #define TILE_MAP_LAYER_H
 
+#include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
 #include "scene/resources/2d/tile_set.h"
 
 class NavigationMeshSourceGeometryData2D;
@@ -206,11 +208,31 @@ public:
 		}
 	};
 
+	// Cells sharing a material and z-index are drawn in the same canvas item.
+	struct CanvasItemBatch {
+		Ref<Material> material;
+		int z_index = 0;
+	};
+
+	struct DrawCommand {
+		const TileData *tile_data = nullptr;
+		int source_id = TileSet::INVALID_SOURCE;
+		Vector2i atlas_coords;
+		int alternative_tile = 0;
+		Vector2 position;
+		real_t animation_offset = 0.0;
+		uint32_t batch = 0;
+	};
+
 	Vector2i quadrant_coords;
 	SelfList<CellData>::List cells;
 	List<RID> canvas_items;
 	Vector2 canvas_items_position;
 
+	// Built when the quadrant is redrawn, possibly on a worker thread, then consumed on the main thread.
+	LocalVector<CanvasItemBatch> prepared_batches;
+	LocalVector<DrawCommand> prepared_draw_commands;
+
 	SelfList<RenderingQuadrant> dirty_quadrant_list_element;
 
 	RenderingQuadrant() :
@@ -224,6 +246,7 @@ public:
 
 class TileMapLayer : public Node2D {
 	GDCLASS(TileMapLayer, Node2D);
+	friend class TestTileMapLayerInternalsAccessor;
 
 public:
 	enum HighlightMode {
@@ -301,6 +324,44 @@ private:
 	// Internal.
 	bool pending_update = false;
 
+	// Streaming.
+	enum {
+		STREAMING_FILE_VERSION = 1,
+		STREAMING_HEADER_SIZE = 16,
+		STREAMING_INDEX_ENTRY_SIZE = 20,
+		STREAMING_CELL_SIZE = 12,
+		STREAMING_CHUNK_SIZE_MAX = 1024,
+	};
+
+	struct StreamingChunk {
+		enum State {
+			STATE_UNLOADED,
+			STATE_LOADING,
+			STATE_LOADED,
+		};
+
+		State state = STATE_UNLOADED;
+		uint64_t file_offset = 0;
+		uint32_t file_cell_count = 0;
+		WorkerThreadPool::TaskID load_task = WorkerThreadPool::INVALID_TASK_ID;
+		Vector<uint8_t> loaded_cells; // Written by the load task.
+
+		// Compact cells of a chunk modified while it was loaded. Once set, they are used instead of the file.
+		Vector<uint8_t> cells;
+		bool has_cells = false;
+		bool modified = false;
+	};
+
+	Ref<FileAccess> streaming_file;
+	Mutex streaming_file_mutex;
+	int streaming_chunk_size = 0; // Zero when not streaming.
+	int streaming_radius = 2;
+	PackedVector2Array streaming_focus_points;
+	HashMap<Vector2i, StreamingChunk> streaming_chunks;
+	LocalVector<Vector2i> streaming_loading_chunks;
+	LocalVector<Vector2i> streaming_loaded_chunks;
+	bool streaming_applying = false; // Cells set while loading or unloading a chunk don't mark it as modified.
+
 	// For keeping compatibility with TileMap.
 	TileMap *tile_map_node = nullptr;
 	int layer_index_in_tile_map_node = -1;
@@ -335,11 +396,25 @@ private:
 	void _debug_quadrants_update_cell(CellData &r_cell_data, SelfList<DebugQuadrant>::List &r_dirty_debug_quadrant_list);
 #endif // DEBUG_ENABLED
 
+	enum {
+		RENDERING_PARALLEL_QUADRANTS_MIN = 8, // Below this, preparing the quadrants on the calling thread is cheaper.
+	};
+
 	HashMap<Vector2i, Ref<RenderingQuadrant>> rendering_quadrant_map;
 	bool _rendering_was_cleaned_up = false;
 	void _rendering_update(bool p_force_cleanup);
 	void _rendering_notification(int p_what);
 	void _rendering_quadrants_update_cell(CellData &r_cell_data, SelfList<RenderingQuadrant>::List &r_dirty_rendering_quadrant_list);
+	// The node properties used to prepare quadrants, read on the calling thread since the
+	// getters can't be used from worker threads.
+	struct RenderingQuadrantsPrepare {
+		RenderingQuadrant **rendering_quadrants = nullptr;
+		bool y_sort_x_draw_order_reversed = false;
+		ObjectID instance_id;
+	};
+	void _rendering_quadrant_prepare(RenderingQuadrant *p_rendering_quadrant, const RenderingQuadrantsPrepare &p_prepare) const;
+	void _rendering_quadrants_prepare_thread(uint32_t p_index, const RenderingQuadrantsPrepare *p_prepare);
+	void _rendering_quadrant_commit(RenderingQuadrant *p_rendering_quadrant, bool p_needs_set_not_interpolated);
 	void _rendering_occluders_clear_cell(CellData &r_cell_data);
 	void _rendering_occluders_update_cell(CellData &r_cell_data);
 #ifdef DEBUG_ENABLED
@@ -380,6 +455,15 @@ private:
 
 	void _tile_set_changed();
 
+	bool _set_cell_no_update(const Vector2i &p_coords, int p_source_id, const Vector2i &p_atlas_coords, int p_alternative_tile);
+
+	void _streaming_load_chunk(StreamingChunk *p_chunk);
+	void _streaming_apply_chunk(const Vector2i &p_chunk_coords, const Vector<uint8_t> &p_cells);
+	Vector<uint8_t> _streaming_encode_chunk(const Vector2i &p_chunk_coords) const;
+	void _streaming_unload_chunk(const Vector2i &p_chunk_coords, StreamingChunk &r_chunk);
+	void _streaming_load_chunk_for_edit(const Vector2i &p_chunk_coords);
+	void _streaming_update(bool p_wait);
+
 	void _renamed();
 	void _update_notify_local_transform();
 
@@ -432,6 +516,7 @@ public:
 	// --- Cells manipulation ---
 	// Generic cells manipulations and data access.
 	void set_cell(const Vector2i &p_coords, int p_source_id = TileSet::INVALID_SOURCE, const Vector2i &p_atlas_coords = TileSetSource::INVALID_ATLAS_COORDS, int p_alternative_tile = 0);
+	void set_cells_batch(const PackedVector2Array &p_coords, const PackedInt32Array &p_source_ids, const PackedVector2Array &p_atlas_coords, const PackedInt32Array &p_alternative_tiles = PackedInt32Array());
 	void erase_cell(const Vector2i &p_coords);
 	void fix_invalid_tiles();
 	void clear();
@@ -468,6 +553,18 @@ public:
 	GDVIRTUAL2(_tile_data_runtime_update, Vector2i, TileData *);
 	GDVIRTUAL2(_update_cells, TypedArray<Vector2i>, bool);
 
+	// --- Streaming ---
+	Error save_streaming_file(const String &p_path, int p_chunk_size = 64) const;
+	Error start_streaming(const String &p_path);
+	void stop_streaming();
+	bool is_streaming() const;
+	void flush_streaming();
+	void set_streaming_focus_points(const PackedVector2Array &p_points);
+	PackedVector2Array get_streaming_focus_points() const;
+	void set_streaming_radius(int p_radius);
+	int get_streaming_radius() const;
+	int get_streaming_loaded_chunk_count() const;
+
 	// --- Shortcuts to methods defined in TileSet ---
 	Vector2i map_pattern(const Vector2i &p_position_in_tilemap, const Vector2i &p_coords_in_pattern, Ref<TileMapPattern> p_pattern);
 	TypedArray<Vector2i> get_surrounding_cells(const Vector2i &p_coords);
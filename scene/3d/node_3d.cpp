@@ -121,10 +121,11 @@ void Node3D::_propagate_transform_changed(Node3D *p_origin) {
 #else
 	if (data.notify_transform && !data.ignore_notification && !xform_change.in_list()) {
 #endif
-		if (likely(is_accessible_from_caller_thread())) {
+		if (likely(is_accessible_from_caller_thread() && !is_parallel_processing())) {
 			get_tree()->xform_change_list.add(&xform_change);
 		} else {
 			// This should very rarely happen, but if it does at least make sure the notification is received eventually.
+			// Parallel workers also take this path, as they would add to the list at the same time.
 			callable_mp(this, &Node3D::_propagate_transform_changed_deferred).call_deferred();
 		}
 	}
@@ -33,6 +33,7 @@
 #include "skeleton_3d.h"
 #include "skeleton_3d.compat.inc"
 
+#include "core/object/worker_thread_pool.h"
 #include "scene/3d/skeleton_modifier_3d.h"
 #ifndef DISABLE_DEPRECATED
 #include "scene/3d/physical_bone_simulator_3d.h"
@@ -336,6 +337,12 @@ void Skeleton3D::_notification(int p_what) {
 		} break;
 #endif // TOOLS_ENABLED
 		case NOTIFICATION_UPDATE_SKELETON: {
+			// The first skeleton updated on the main thread updates the global poses of the others too.
+			// Skeletons that are all in sub-thread groups are left to flush_dirty_skeletons().
+			if (!is_group_processing()) {
+				_update_dirty_skeletons();
+			}
+
 			// Update bone transforms to apply unprocessed poses.
 			force_update_all_dirty_bones();
 
@@ -345,6 +352,7 @@ void Skeleton3D::_notification(int p_what) {
 			int len = bones.size();
 
 			thread_local LocalVector<bool> bone_global_pose_dirty_backup;
+			thread_local LocalVector<Transform3D> bone_global_poses_backup;
 
 			// Process modifiers.
 
@@ -356,7 +364,8 @@ void Skeleton3D::_notification(int p_what) {
 				for (uint32_t i = 0; i < bones.size(); i++) {
 					bones_backup[i].save(bonesptr[i]);
 				}
-				// Store dirty flags for global bone poses.
+				// Store global bone poses and their dirty flags.
+				bone_global_poses_backup = bone_global_poses;
 				bone_global_pose_dirty_backup = bone_global_pose_dirty;
 
 				_process_modifiers();
@@ -424,7 +433,7 @@ void Skeleton3D::_notification(int p_what) {
 				for (uint32_t i = 0; i < bind_count; i++) {
 					uint32_t bone_index = E->skin_bone_indices_ptrs[i];
 					ERR_CONTINUE(bone_index >= (uint32_t)len);
-					rs->skeleton_bone_set_transform(skeleton, i, bonesptr[bone_index].global_pose * skin->get_bind_pose(i));
+					rs->skeleton_bone_set_transform(skeleton, i, bone_global_poses[bone_index] * skin->get_bind_pose(i));
 				}
 			}
 
@@ -433,8 +442,11 @@ void Skeleton3D::_notification(int p_what) {
 				for (uint32_t i = 0; i < bones.size(); i++) {
 					bones_backup[i].restore(bones[i]);
 				}
-				// Restore dirty flags for global bone poses.
+				// Restore global bone poses and their dirty flags.
+				bone_global_poses = bone_global_poses_backup;
 				bone_global_pose_dirty = bone_global_pose_dirty_backup;
+				bone_global_pose_dirty_begin = 0;
+				bone_global_pose_dirty_end = bones.size();
 			}
 
 			updating = false;
@@ -480,6 +492,7 @@ void Skeleton3D::_make_modifiers_dirty() {
 void Skeleton3D::_update_bones_nested_set() const {
 	nested_set_offset_to_bone_index.resize(bones.size());
 	bone_global_pose_dirty.resize(bones.size());
+	bone_global_poses.resize(bones.size());
 	_make_bone_global_poses_dirty();
 
 	int offset = 0;
@@ -510,6 +523,8 @@ void Skeleton3D::_make_bone_global_poses_dirty() const {
 	for (uint32_t i = 0; i < bone_global_pose_dirty.size(); i++) {
 		bone_global_pose_dirty[i] = true;
 	}
+	bone_global_pose_dirty_begin = 0;
+	bone_global_pose_dirty_end = bone_global_pose_dirty.size();
 }
 
 void Skeleton3D::_make_bone_global_pose_subtree_dirty(int p_bone) const {
@@ -529,6 +544,13 @@ void Skeleton3D::_make_bone_global_pose_subtree_dirty(int p_bone) const {
 	for (int i = span_offset; i < span_end; i++) {
 		bone_global_pose_dirty[i] = true;
 	}
+	if (bone_global_pose_dirty_begin == bone_global_pose_dirty_end) {
+		bone_global_pose_dirty_begin = span_offset;
+		bone_global_pose_dirty_end = span_end;
+	} else {
+		bone_global_pose_dirty_begin = MIN(bone_global_pose_dirty_begin, span_offset);
+		bone_global_pose_dirty_end = MAX(bone_global_pose_dirty_end, span_end);
+	}
 }
 
 void Skeleton3D::_update_bone_global_pose(int p_bone) const {
@@ -552,7 +574,7 @@ void Skeleton3D::_update_bone_global_pose(int p_bone) const {
 		int offset = bones[bone].nested_set_offset;
 		// Stop searching when global pose is not dirty.
 		if (!bone_global_pose_dirty[offset]) {
-			global_pose = bones[bone].global_pose;
+			global_pose = bone_global_poses[bone];
 			break;
 		}
 
@@ -573,7 +595,7 @@ void Skeleton3D::_update_bone_global_pose(int p_bone) const {
 		}
 #endif // _DISABLE_DEPRECATED
 
-		bone.global_pose = global_pose;
+		bone_global_poses[bone_idx] = global_pose;
 		bone_global_pose_dirty[bone.nested_set_offset] = false;
 	}
 }
@@ -582,7 +604,7 @@ Transform3D Skeleton3D::get_bone_global_pose(int p_bone) const {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX_V(p_bone, bone_size, Transform3D());
 	_update_bone_global_pose(p_bone);
-	return bones[p_bone].global_pose;
+	return bone_global_poses[p_bone];
 }
 
 void Skeleton3D::set_bone_global_pose(int p_bone, const Transform3D &p_pose) {
@@ -939,6 +961,7 @@ void Skeleton3D::_make_dirty() {
 		return;
 	}
 	dirty = true;
+	_queue_dirty_skeleton();
 	_update_deferred();
 }
 
@@ -1069,9 +1092,7 @@ void Skeleton3D::force_update_all_bone_transforms() {
 
 void Skeleton3D::_force_update_all_bone_transforms() const {
 	_update_process_order();
-	for (int i = 0; i < parentless_bones.size(); i++) {
-		_force_update_bone_children_transforms(parentless_bones[i]);
-	}
+	_update_dirty_bone_global_poses(0, bones.size());
 	if (rest_dirty) {
 		rest_dirty = false;
 		const_cast<Skeleton3D *>(this)->emit_signal(SNAME("rest_updated"));
@@ -1093,10 +1114,29 @@ void Skeleton3D::_force_update_bone_children_transforms(int p_bone_idx) const {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX(p_bone_idx, bone_size);
 
+	_update_process_order();
+
+	// Only the subtree of the bone in the nested set, which depends on the global pose of the parent.
+	const Bone &bone = bones[p_bone_idx];
+	if (bone.parent >= 0) {
+		_update_bone_global_pose(bone.parent);
+	}
+	_update_dirty_bone_global_poses(bone.nested_set_offset, bone.nested_set_offset + bone.nested_set_span);
+}
+
+void Skeleton3D::_update_dirty_bone_global_poses(int p_begin, int p_end) const {
+	// Nothing outside the dirty range needs to be visited.
+	const int begin = MAX(p_begin, bone_global_pose_dirty_begin);
+	const int end = MIN(p_end, bone_global_pose_dirty_end);
+	if (begin >= end) {
+		return;
+	}
+
 	Bone *bonesptr = bones.ptr();
+	Transform3D *global_posesptr = bone_global_poses.ptr();
 
 	// Loop through nested set.
-	for (int offset = 0; offset < bone_size; offset++) {
+	for (int offset = begin; offset < end; offset++) {
 		if (!bone_global_pose_dirty[offset]) {
 			continue;
 		}
@@ -1104,21 +1144,22 @@ void Skeleton3D::_force_update_bone_children_transforms(int p_bone_idx) const {
 		int current_bone_idx = nested_set_offset_to_bone_index[offset];
 		Bone &b = bonesptr[current_bone_idx];
 		bool bone_enabled = b.enabled && !show_rest_only;
+		Transform3D &global_pose = global_posesptr[current_bone_idx];
 
 		if (bone_enabled) {
 			b.update_pose_cache();
 			Transform3D pose = b.pose_cache;
 
 			if (b.parent >= 0) {
-				b.global_pose = bonesptr[b.parent].global_pose * pose;
+				global_pose = global_posesptr[b.parent] * pose;
 			} else {
-				b.global_pose = pose;
+				global_pose = pose;
 			}
 		} else {
 			if (b.parent >= 0) {
-				b.global_pose = bonesptr[b.parent].global_pose * b.rest;
+				global_pose = global_posesptr[b.parent] * b.rest;
 			} else {
-				b.global_pose = b.rest;
+				global_pose = b.rest;
 			}
 		}
 		if (rest_dirty) {
@@ -1141,7 +1182,7 @@ void Skeleton3D::_force_update_bone_children_transforms(int p_bone_idx) const {
 			}
 		}
 		if (b.global_pose_override_amount >= CMP_EPSILON) {
-			b.global_pose = b.global_pose.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
+			global_pose = global_pose.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
 		}
 		if (b.global_pose_override_reset) {
 			b.global_pose_override_amount = 0.0;
@@ -1150,6 +1191,79 @@ void Skeleton3D::_force_update_bone_children_transforms(int p_bone_idx) const {
 
 		bone_global_pose_dirty[offset] = false;
 	}
+
+	// The whole dirty range is only clean once it was entirely visited.
+	if (begin == bone_global_pose_dirty_begin && end == bone_global_pose_dirty_end) {
+		bone_global_pose_dirty_begin = 0;
+		bone_global_pose_dirty_end = 0;
+	} else if (begin == bone_global_pose_dirty_begin) {
+		bone_global_pose_dirty_begin = end;
+	} else if (end == bone_global_pose_dirty_end) {
+		bone_global_pose_dirty_end = begin;
+	}
+}
+
+BinaryMutex Skeleton3D::dirty_skeletons_mutex;
+LocalVector<ObjectID> Skeleton3D::dirty_skeletons;
+
+void Skeleton3D::_queue_dirty_skeleton() {
+	if (!is_inside_tree()) {
+		return;
+	}
+	// Skeletons processed in a sub-thread group may be posed from a worker thread.
+	MutexLock lock(dirty_skeletons_mutex);
+	if (dirty_skeleton_queued) {
+		return;
+	}
+	dirty_skeleton_queued = true;
+	dirty_skeletons.push_back(get_instance_id());
+}
+
+void Skeleton3D::_update_dirty_skeleton_task(void *p_userdata, uint32_t p_index) {
+	const Skeleton3D *skeleton = (static_cast<const Skeleton3D **>(p_userdata))[p_index];
+	skeleton->_update_dirty_bone_global_poses(0, skeleton->bones.size());
+}
+
+void Skeleton3D::_update_dirty_skeletons() {
+	LocalVector<ObjectID> queue;
+	{
+		MutexLock lock(dirty_skeletons_mutex);
+		if (dirty_skeletons.is_empty()) {
+			return;
+		}
+		queue = dirty_skeletons;
+		dirty_skeletons.clear();
+		for (const ObjectID &id : queue) {
+			Skeleton3D *skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(id));
+			if (skeleton) {
+				skeleton->dirty_skeleton_queued = false;
+			}
+		}
+	}
+
+	// Only the global poses are updated here. Each skeleton still emits its signals and runs its modifiers in its own notification.
+	LocalVector<const Skeleton3D *> batch;
+	int bone_count = 0;
+	for (const ObjectID &id : queue) {
+		const Skeleton3D *skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(id));
+		// Rebuilding the process order emits a signal, so leave those skeletons to update themselves.
+		if (!skeleton || !skeleton->dirty || skeleton->process_order_dirty) {
+			continue;
+		}
+		batch.push_back(skeleton);
+		bone_count += skeleton->bone_global_pose_dirty_end - skeleton->bone_global_pose_dirty_begin;
+	}
+
+	if (batch.size() > 1 && bone_count >= PARALLEL_UPDATE_MIN_BONES) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&Skeleton3D::_update_dirty_skeleton_task, batch.ptr(), batch.size(), -1, true, SNAME("Skeleton3DUpdateBones"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+}
+
+void Skeleton3D::flush_dirty_skeletons() {
+	// Skeletons only updated in sub-thread groups never drain the queue themselves,
+	// this keeps it from growing with the IDs of freed skeletons.
+	_update_dirty_skeletons();
 }
 
 void Skeleton3D::_find_modifiers() {
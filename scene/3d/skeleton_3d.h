@@ -67,6 +67,7 @@ public:
 
 class Skeleton3D : public Node3D {
 	GDCLASS(Skeleton3D, Node3D);
+	friend class TestSkeleton3DInternalsAccessor;
 
 #ifdef TOOLS_ENABLED
 	bool saving = false;
@@ -112,7 +113,6 @@ private:
 		Vector3 pose_position;
 		Quaternion pose_rotation;
 		Vector3 pose_scale = Vector3(1, 1, 1);
-		Transform3D global_pose;
 		int nested_set_offset = 0; // Offset in nested set of bone hierarchy.
 		int nested_set_span = 0; // Subtree span in nested set of bone hierarchy.
 
@@ -139,14 +139,12 @@ private:
 		Vector3 pose_position;
 		Quaternion pose_rotation;
 		Vector3 pose_scale = Vector3(1, 1, 1);
-		Transform3D global_pose;
 
 		void save(const Bone &p_bone) {
 			pose_cache = p_bone.pose_cache;
 			pose_position = p_bone.pose_position;
 			pose_rotation = p_bone.pose_rotation;
 			pose_scale = p_bone.pose_scale;
-			global_pose = p_bone.global_pose;
 		}
 
 		void restore(Bone &r_bone) {
@@ -154,7 +152,6 @@ private:
 			r_bone.pose_position = pose_position;
 			r_bone.pose_rotation = pose_rotation;
 			r_bone.pose_scale = pose_scale;
-			r_bone.global_pose = global_pose;
 		}
 	};
 
@@ -193,11 +190,24 @@ private:
 	// Global bone pose calculation.
 	mutable LocalVector<int> nested_set_offset_to_bone_index; // Map from Bone::nested_set_offset to bone index.
 	mutable LocalVector<bool> bone_global_pose_dirty; // Indexable with Bone::nested_set_offset.
+	mutable LocalVector<Transform3D> bone_global_poses; // Indexable with bone index. Kept out of Bone so updating them only touches the transforms.
+	mutable int bone_global_pose_dirty_begin = 0; // Range of nested set offsets containing all dirty global poses.
+	mutable int bone_global_pose_dirty_end = 0;
 	void _update_bones_nested_set() const;
 	int _update_bone_nested_set(int p_bone, int p_offset) const;
 	void _make_bone_global_poses_dirty() const;
 	void _make_bone_global_pose_subtree_dirty(int p_bone) const;
 	void _update_bone_global_pose(int p_bone) const;
+	void _update_dirty_bone_global_poses(int p_begin, int p_end) const;
+
+	// Global bone poses of many skeletons are updated together on the WorkerThreadPool.
+	static const int PARALLEL_UPDATE_MIN_BONES = 512;
+	static BinaryMutex dirty_skeletons_mutex;
+	static LocalVector<ObjectID> dirty_skeletons;
+	bool dirty_skeleton_queued = false;
+	void _queue_dirty_skeleton();
+	static void _update_dirty_skeletons();
+	static void _update_dirty_skeleton_task(void *p_userdata, uint32_t p_index);
 
 #ifndef DISABLE_DEPRECATED
 	void _add_bone_bind_compat_88791(const String &p_name);
@@ -288,6 +298,7 @@ public:
 
 	void force_update_all_dirty_bones();
 	void _force_update_all_dirty_bones() const;
+	static void flush_dirty_skeletons(); // Called by the SceneTree once all nodes have been processed.
 	void force_update_all_bone_transforms();
 	void _force_update_all_bone_transforms() const;
 	void force_update_bone_children_transforms(int bone_idx);
@@ -35,8 +35,11 @@
 
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
+#include "core/object/message_queue.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/string_name.h"
 #include "scene/2d/audio_stream_player_2d.h"
+#include "scene/2d/visible_on_screen_notifier_2d.h"
 #include "scene/animation/animation_player.h"
 #include "scene/audio/audio_stream_player.h"
 #include "scene/resources/animation.h"
@@ -45,9 +48,12 @@
 
 #ifndef _3D_DISABLED
 #include "scene/3d/audio_stream_player_3d.h"
+#include "scene/3d/camera_3d.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/node_3d.h"
 #include "scene/3d/skeleton_3d.h"
+#include "scene/3d/visible_on_screen_notifier_3d.h"
+#include "scene/main/viewport.h"
 #endif // _3D_DISABLED
 
 #ifdef TOOLS_ENABLED
@@ -527,6 +533,80 @@ AnimationMixer::AnimationCallbackModeDiscrete AnimationMixer::get_callback_mode_
 	return callback_mode_discrete;
 }
 
+void AnimationMixer::set_use_parallel_blending(bool p_enabled) {
+	use_parallel_blending = p_enabled;
+}
+
+bool AnimationMixer::is_using_parallel_blending() const {
+	return use_parallel_blending;
+}
+
+void AnimationMixer::set_lod_enabled(bool p_enabled) {
+	lod_enabled = p_enabled;
+	lod_level = 0;
+	lod_divisor = 1;
+	lod_frame = 0;
+	lod_delta = 0.0;
+	lod_interpolating = false;
+}
+
+bool AnimationMixer::is_lod_enabled() const {
+	return lod_enabled;
+}
+
+void AnimationMixer::set_lod_update_divisor(int p_divisor) {
+	ERR_FAIL_COND(p_divisor < 1 || p_divisor > LOD_MAX_UPDATE_DIVISOR);
+	lod_update_divisor = p_divisor;
+}
+
+int AnimationMixer::get_lod_update_divisor() const {
+	return lod_update_divisor;
+}
+
+void AnimationMixer::set_lod_distances(const PackedFloat32Array &p_distances) {
+	lod_distances = p_distances;
+}
+
+PackedFloat32Array AnimationMixer::get_lod_distances() const {
+	return lod_distances;
+}
+
+void AnimationMixer::set_lod_visibility_notifier(const NodePath &p_path) {
+	lod_visibility_notifier = p_path;
+}
+
+NodePath AnimationMixer::get_lod_visibility_notifier() const {
+	return lod_visibility_notifier;
+}
+
+void AnimationMixer::set_lod_weight_threshold(float p_threshold) {
+	lod_weight_threshold = p_threshold;
+}
+
+float AnimationMixer::get_lod_weight_threshold() const {
+	return lod_weight_threshold;
+}
+
+void AnimationMixer::set_lod_bone_depth_limit(int p_depth) {
+	lod_bone_depth_limit = p_depth;
+}
+
+int AnimationMixer::get_lod_bone_depth_limit() const {
+	return lod_bone_depth_limit;
+}
+
+void AnimationMixer::set_lod_interpolate(bool p_enabled) {
+	lod_interpolate = p_enabled;
+}
+
+bool AnimationMixer::is_lod_interpolating() const {
+	return lod_interpolate;
+}
+
+int AnimationMixer::get_lod_level() const {
+	return lod_level;
+}
+
 void AnimationMixer::set_audio_max_polyphony(int p_audio_max_polyphony) {
 	ERR_FAIL_COND(p_audio_max_polyphony < 0 || p_audio_max_polyphony > 128);
 	audio_max_polyphony = p_audio_max_polyphony;
@@ -578,6 +658,11 @@ void AnimationMixer::_clear_caches() {
 	}
 	track_cache.clear();
 	animation_track_num_to_track_cache.clear();
+	animation_track_cursors.clear();
+#ifndef _3D_DISABLED
+	pose_tracks.clear();
+	pose_buffer.resize(0);
+#endif // _3D_DISABLED
 	cache_valid = false;
 	capture_cache.clear();
 
@@ -620,6 +705,7 @@ void AnimationMixer::_create_track_num_to_track_cache_for_animation(Ref<Animatio
 	const Vector<Animation::Track *> &tracks = p_animation->get_tracks();
 
 	track_num_to_track_cache.resize(tracks.size());
+	animation_track_cursors[p_animation].resize(tracks.size());
 	for (int i = 0; i < tracks.size(); i++) {
 		TrackCache **track_ptr = track_cache.getptr(tracks[i]->thash);
 		if (track_ptr == nullptr) {
@@ -781,6 +867,9 @@ bool AnimationMixer::_update_caches() {
 							if (bone_idx != -1) {
 								has_rest = true;
 								track_xform->bone_idx = bone_idx;
+								for (int parent = sk->get_bone_parent(bone_idx); parent >= 0; parent = sk->get_bone_parent(parent)) {
+									track_xform->bone_depth++;
+								}
 								Transform3D rest = sk->get_bone_rest(bone_idx);
 								track_xform->init_loc = rest.origin;
 								track_xform->init_rot = rest.basis.get_rotation_quaternion();
@@ -967,6 +1056,7 @@ bool AnimationMixer::_update_caches() {
 	}
 
 	animation_track_num_to_track_cache.clear();
+	animation_track_cursors.clear();
 	for (const StringName &E : sname_list) {
 		Ref<Animation> anim = get_animation(E);
 		_create_track_num_to_track_cache_for_animation(anim);
@@ -974,11 +1064,38 @@ bool AnimationMixer::_update_caches() {
 
 	track_count = idx;
 
+#ifndef _3D_DISABLED
+	_update_pose_buffer();
+#endif // _3D_DISABLED
+
 	cache_valid = true;
 
 	return true;
 }
 
+#ifndef _3D_DISABLED
+void AnimationMixer::_update_pose_buffer() {
+	pose_tracks.clear();
+	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
+		if (K.value->type != Animation::TYPE_POSITION_3D) {
+			continue;
+		}
+		TrackCacheTransform *t = static_cast<TrackCacheTransform *>(K.value);
+		if (t->skeleton_id.is_valid() && t->bone_idx >= 0) {
+			t->pose_slot = pose_tracks.size();
+			pose_tracks.push_back(t);
+		} else {
+			t->pose_slot = -1;
+		}
+	}
+
+	pose_buffer.resize(pose_tracks.size());
+	for (uint32_t i = 0; i < pose_tracks.size(); i++) {
+		pose_buffer.set_init(i, pose_tracks[i]->init_loc, pose_tracks[i]->init_rot, pose_tracks[i]->init_scale);
+	}
+}
+#endif // _3D_DISABLED
+
 /* -------------------------------------------- */
 /* -- Blending processor ---------------------- */
 /* -------------------------------------------- */
@@ -996,6 +1113,254 @@ void AnimationMixer::_process_animation(double p_delta, bool p_update_only) {
 	clear_animation_instances();
 }
 
+/* -------------------------------------------- */
+/* -- Parallel blending ----------------------- */
+/* -------------------------------------------- */
+
+BinaryMutex AnimationMixer::parallel_blending_mutex;
+LocalVector<ObjectID> AnimationMixer::parallel_blending_queue;
+
+void AnimationMixer::_queue_parallel_blending(double p_delta) {
+	// Mixers processed in a sub-thread group may be queued from a worker thread.
+	MutexLock lock(parallel_blending_mutex);
+	if (parallel_blending_queued) {
+		parallel_blending_delta += p_delta;
+		return;
+	}
+	parallel_blending_queued = true;
+	parallel_blending_delta = p_delta;
+	parallel_blending_queue.push_back(get_instance_id());
+}
+
+bool AnimationMixer::_can_blend_process_in_thread() {
+	// Scripted post processing must run on the main thread.
+	if (GDVIRTUAL_IS_OVERRIDDEN(_post_process_key_value)) {
+		return false;
+	}
+	// Tracks which have side effects (calling methods, setting discrete values, starting playbacks) must run on the main thread.
+	for (const AnimationInstance &ai : animation_instances) {
+		const Ref<Animation> &a = ai.animation_data.animation;
+		const Vector<Animation::Track *> tracks = a->get_tracks();
+		for (int i = 0; i < tracks.size(); i++) {
+			const Animation::Track *animation_track = tracks[i];
+			if (!animation_track->enabled) {
+				continue;
+			}
+			switch (animation_track->type) {
+				case Animation::TYPE_VALUE: {
+					if (a->value_track_get_update_mode(i) == Animation::UPDATE_DISCRETE && callback_mode_discrete != ANIMATION_CALLBACK_MODE_DISCRETE_FORCE_CONTINUOUS) {
+						return false;
+					}
+				} break;
+				case Animation::TYPE_METHOD:
+				case Animation::TYPE_AUDIO:
+				case Animation::TYPE_ANIMATION: {
+					return false;
+				} break;
+				default: {
+				} break;
+			}
+		}
+	}
+	return true;
+}
+
+void AnimationMixer::_parallel_blend_process(void *p_userdata, uint32_t p_index) {
+	AnimationMixer *mixer = (static_cast<AnimationMixer **>(p_userdata))[p_index];
+	mixer->_blend_process(mixer->parallel_blending_delta);
+}
+
+void AnimationMixer::flush_parallel_blending() {
+	LocalVector<ObjectID> queue;
+	{
+		MutexLock lock(parallel_blending_mutex);
+		if (parallel_blending_queue.is_empty()) {
+			return;
+		}
+		queue = parallel_blending_queue;
+		parallel_blending_queue.clear();
+	}
+
+	// Mixers are looked up by ID on every pass, since the signals emitted while applying may free other mixers.
+
+	// Prepare the caches and weights on the main thread, since subclasses advance their playback and state machines here.
+	LocalVector<AnimationMixer *> threaded;
+	for (const ObjectID &id : queue) {
+		AnimationMixer *mixer = Object::cast_to<AnimationMixer>(ObjectDB::get_instance(id));
+		if (!mixer) {
+			continue;
+		}
+		mixer->parallel_blending_queued = false;
+		mixer->parallel_blending_ready = false;
+		if (!mixer->active || !mixer->is_inside_tree()) {
+			continue;
+		}
+		mixer->_blend_init();
+		if (mixer->_blend_pre_process(mixer->parallel_blending_delta, mixer->track_count, mixer->track_map)) {
+			mixer->_blend_capture(mixer->parallel_blending_delta);
+			mixer->_blend_calc_total_weight();
+			mixer->parallel_blending_ready = true;
+			mixer->parallel_blending_in_thread = mixer->_can_blend_process_in_thread();
+			if (mixer->parallel_blending_in_thread) {
+				mixer->is_GDVIRTUAL_CALL_post_process_key_value = false;
+				threaded.push_back(mixer);
+			}
+		}
+	}
+
+	// Sample and blend into the track caches. Each mixer only writes to its own caches.
+	if (threaded.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&AnimationMixer::_parallel_blend_process, threaded.ptr(), threaded.size(), -1, true, SNAME("AnimationMixerBlend"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (threaded.size() == 1) {
+		_parallel_blend_process(threaded.ptr(), 0);
+	}
+	for (const ObjectID &id : queue) {
+		AnimationMixer *mixer = Object::cast_to<AnimationMixer>(ObjectDB::get_instance(id));
+		if (mixer && mixer->parallel_blending_ready && !mixer->parallel_blending_in_thread) {
+			mixer->_blend_process(mixer->parallel_blending_delta);
+		}
+	}
+
+	// Apply the results in queue order.
+	for (const ObjectID &id : queue) {
+		AnimationMixer *mixer = Object::cast_to<AnimationMixer>(ObjectDB::get_instance(id));
+		if (!mixer) {
+			continue;
+		}
+		if (mixer->parallel_blending_ready) {
+			mixer->parallel_blending_ready = false;
+			mixer->_blend_apply();
+			mixer->_blend_post_process();
+			mixer->emit_signal(SNAME("mixer_applied"));
+		}
+		mixer->clear_animation_instances();
+	}
+}
+
+/* -------------------------------------------- */
+/* -- Level of detail ------------------------- */
+/* -------------------------------------------- */
+
+int AnimationMixer::_calc_lod_level() const {
+	if (!lod_visibility_notifier.is_empty()) {
+		Node *notifier = get_node_or_null(lod_visibility_notifier);
+		bool visible = true;
+		if (VisibleOnScreenNotifier2D *notifier_2d = Object::cast_to<VisibleOnScreenNotifier2D>(notifier)) {
+			visible = notifier_2d->is_on_screen();
+		}
+#ifndef _3D_DISABLED
+		if (VisibleOnScreenNotifier3D *notifier_3d = Object::cast_to<VisibleOnScreenNotifier3D>(notifier)) {
+			visible = notifier_3d->is_on_screen();
+		}
+#endif // _3D_DISABLED
+		if (!visible) {
+			return lod_distances.size() + 1;
+		}
+	}
+
+	int level = 0;
+#ifndef _3D_DISABLED
+	if (!lod_distances.is_empty()) {
+		real_t distance;
+		if (is_current_thread_safe_for_nodes()) {
+			distance = _get_lod_camera_distance();
+		} else {
+			// The camera and the root node may be processed by other threads, so their global
+			// transforms can't be read here. Use the distance measured on the main thread after
+			// the previous update, and request it again for the next one.
+			distance = lod_camera_distance.get();
+			if (!lod_camera_distance_queued.is_set()) {
+				lod_camera_distance_queued.set();
+				MessageQueue::get_main_singleton()->push_callable(callable_mp(const_cast<AnimationMixer *>(this), &AnimationMixer::_update_lod_camera_distance));
+			}
+		}
+		if (distance >= 0) {
+			for (const float lod_distance : lod_distances) {
+				if (distance > lod_distance) {
+					level++;
+				}
+			}
+		}
+	}
+#endif // _3D_DISABLED
+	return level;
+}
+
+real_t AnimationMixer::_get_lod_camera_distance() const {
+#ifndef _3D_DISABLED
+	if (is_inside_tree()) {
+		Camera3D *camera = get_viewport()->get_camera_3d();
+		Node3D *root_3d = Object::cast_to<Node3D>(get_node_or_null(root_node));
+		if (camera && root_3d) {
+			return camera->get_global_position().distance_to(root_3d->get_global_position());
+		}
+	}
+#endif // _3D_DISABLED
+	return -1.0;
+}
+
+void AnimationMixer::_update_lod_camera_distance() {
+	lod_camera_distance_queued.clear();
+	lod_camera_distance.set(_get_lod_camera_distance());
+}
+
+bool AnimationMixer::_lod_process(double p_delta, double &r_delta) {
+	lod_delta += p_delta;
+	lod_frame++;
+	if (lod_frame < lod_divisor) {
+#ifndef _3D_DISABLED
+		if (lod_interpolating) {
+			_apply_lod_interpolation();
+		}
+#endif // _3D_DISABLED
+		return false;
+	}
+
+	r_delta = lod_delta;
+	lod_delta = 0.0;
+	lod_frame = 0;
+	lod_level = _calc_lod_level();
+	lod_divisor = MIN(lod_update_divisor << MIN(lod_level, 6), (int)LOD_MAX_UPDATE_DIVISOR);
+	lod_interpolating = lod_interpolate && lod_divisor > 1;
+	return true;
+}
+
+bool AnimationMixer::_is_track_lod_culled(const TrackCache *p_track) const {
+	if (lod_level == 0 || lod_bone_depth_limit < 0 || p_track->type != Animation::TYPE_POSITION_3D) {
+		return false;
+	}
+	const TrackCacheTransform *t = static_cast<const TrackCacheTransform *>(p_track);
+	return t->bone_idx >= 0 && t->bone_depth > lod_bone_depth_limit;
+}
+
+#ifndef _3D_DISABLED
+void AnimationMixer::_apply_lod_interpolation_to(TrackCacheTransform *p_track, Skeleton3D *p_skeleton) {
+	const real_t c = real_t(lod_frame + 1) / lod_divisor;
+	if (p_track->loc_used) {
+		p_skeleton->set_bone_pose_position(p_track->bone_idx, p_track->lod_from_loc.lerp(p_track->loc, c));
+	}
+	if (p_track->rot_used) {
+		p_skeleton->set_bone_pose_rotation(p_track->bone_idx, p_track->lod_from_rot.slerp(p_track->rot, c));
+	}
+	if (p_track->scale_used) {
+		p_skeleton->set_bone_pose_scale(p_track->bone_idx, p_track->lod_from_scale.lerp(p_track->scale, c));
+	}
+}
+
+void AnimationMixer::_apply_lod_interpolation() {
+	for (TrackCacheTransform *t : pose_tracks) {
+		if (!t->lod_applied) {
+			continue;
+		}
+		Skeleton3D *t_skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(t->skeleton_id));
+		if (t_skeleton) {
+			_apply_lod_interpolation_to(t, t_skeleton);
+		}
+	}
+}
+#endif // _3D_DISABLED
+
 Variant AnimationMixer::_post_process_key_value(const Ref<Animation> &p_anim, int p_track, Variant &p_value, ObjectID p_object_id, int p_object_sub_idx) {
 #ifndef _3D_DISABLED
 	switch (p_anim->track_get_type(p_track)) {
@@ -1058,6 +1423,7 @@ void AnimationMixer::_blend_init() {
 				t->loc = t->init_loc;
 				t->rot = t->init_rot;
 				t->scale = t->init_scale;
+				t->lod_applied = false;
 			} break;
 			case Animation::TYPE_BLEND_SHAPE: {
 				TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
@@ -1081,6 +1447,10 @@ void AnimationMixer::_blend_init() {
 			} break;
 		}
 	}
+
+#ifndef _3D_DISABLED
+	pose_buffer.reset();
+#endif // _3D_DISABLED
 }
 
 bool AnimationMixer::_blend_pre_process(double p_delta, int p_track_count, const AHashMap<NodePath, int> &p_track_map) {
@@ -1104,6 +1474,7 @@ void AnimationMixer::blend_capture(double p_delta) {
 	if (Animation::is_less_or_equal_approx(capture_cache.remain, 0)) {
 		if (capture_cache.animation.is_valid()) {
 			animation_track_num_to_track_cache.erase(capture_cache.animation);
+			animation_track_cursors.erase(capture_cache.animation);
 		}
 		capture_cache.clear();
 		return;
@@ -1137,6 +1508,7 @@ void AnimationMixer::_blend_calc_total_weight() {
 		real_t weight = ai.playback_info.weight;
 		const real_t *track_weights_ptr = ai.playback_info.track_weights.ptr();
 		int track_weights_count = ai.playback_info.track_weights.size();
+		bool lod_skip_pose = lod_level > 0 && weight < lod_weight_threshold; // Low weight animations don't affect the pose at lower levels of detail.
 		ERR_CONTINUE_EDMSG(!animation_track_num_to_track_cache.has(a), "No animation in cache.");
 		LocalVector<TrackCache *> &track_num_to_track_cache = animation_track_num_to_track_cache[a];
 		thread_local HashSet<Animation::TypeHash, HashHasher> processed_hashes;
@@ -1156,6 +1528,9 @@ void AnimationMixer::_blend_calc_total_weight() {
 				// Or, there is the case different track type with same path; These can be distinguished by hash. So don't add the weight doubly.
 				continue;
 			}
+			if ((lod_skip_pose && _is_lod_pose_track(animation_track->type)) || _is_track_lod_culled(track)) {
+				continue;
+			}
 			int blend_idx = track->blend_idx;
 			ERR_CONTINUE(blend_idx < 0 || blend_idx >= track_count);
 			real_t blend = blend_idx < track_weights_count ? track_weights_ptr[blend_idx] * weight : weight;
@@ -1184,11 +1559,13 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 		int track_weights_count = ai.playback_info.track_weights.size();
 		bool backward = signbit(delta); // This flag is used by the root motion calculates or detecting the end of audio stream.
 		bool seeked_backward = signbit(p_delta);
+		bool lod_skip_pose = lod_level > 0 && weight < lod_weight_threshold;
 #ifndef _3D_DISABLED
 		bool calc_root = !seeked || is_external_seeking;
 #endif // _3D_DISABLED
 		ERR_CONTINUE_EDMSG(!animation_track_num_to_track_cache.has(a), "No animation in cache.");
 		LocalVector<TrackCache *> &track_num_to_track_cache = animation_track_num_to_track_cache[a];
+		LocalVector<Animation::TrackCursor> &track_cursors = animation_track_cursors[a];
 		const Vector<Animation::Track *> tracks = a->get_tracks();
 		Animation::Track *const *tracks_ptr = tracks.ptr();
 		real_t a_length = a->get_length();
@@ -1202,6 +1579,9 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 			if (track == nullptr) {
 				continue; // No path, but avoid error spamming.
 			}
+			if ((lod_skip_pose && _is_lod_pose_track(animation_track->type)) || _is_track_lod_culled(track)) {
+				continue;
+			}
 			int blend_idx = track->blend_idx;
 			ERR_CONTINUE(blend_idx < 0 || blend_idx >= track_count);
 			real_t blend = blend_idx < track_weights_count ? track_weights_ptr[blend_idx] * weight : weight;
@@ -1350,12 +1730,16 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 loc;
-						Error err = a->try_position_track_interpolate(i, time, &loc);
+						Error err = a->try_position_track_interpolate(i, time, &loc, false, &track_cursors[i]);
 						if (err != OK) {
 							continue;
 						}
 						loc = post_process_key_value(a, i, loc, t->object_id, t->bone_idx);
-						t->loc += (loc - t->init_loc) * blend;
+						if (t->pose_slot >= 0) {
+							pose_buffer.add_position_sample(t->pose_slot, loc, blend);
+						} else {
+							t->loc += (loc - t->init_loc) * blend;
+						}
 					}
 #endif // _3D_DISABLED
 				} break;
@@ -1438,12 +1822,16 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Quaternion rot;
-						Error err = a->try_rotation_track_interpolate(i, time, &rot);
+						Error err = a->try_rotation_track_interpolate(i, time, &rot, false, &track_cursors[i]);
 						if (err != OK) {
 							continue;
 						}
 						rot = post_process_key_value(a, i, rot, t->object_id, t->bone_idx);
-						t->rot = (t->rot * Quaternion().slerp(t->init_rot.inverse() * rot, blend)).normalized();
+						if (t->pose_slot >= 0) {
+							pose_buffer.add_rotation_sample(t->pose_slot, rot, blend);
+						} else {
+							t->rot = (t->rot * Quaternion().slerp(t->init_rot.inverse() * rot, blend)).normalized();
+						}
 					}
 #endif // _3D_DISABLED
 				} break;
@@ -1526,12 +1914,16 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 scale;
-						Error err = a->try_scale_track_interpolate(i, time, &scale);
+						Error err = a->try_scale_track_interpolate(i, time, &scale, false, &track_cursors[i]);
 						if (err != OK) {
 							continue;
 						}
 						scale = post_process_key_value(a, i, scale, t->object_id, t->bone_idx);
-						t->scale += (scale - t->init_scale) * blend;
+						if (t->pose_slot >= 0) {
+							pose_buffer.add_scale_sample(t->pose_slot, scale, blend);
+						} else {
+							t->scale += (scale - t->init_scale) * blend;
+						}
 					}
 #endif // _3D_DISABLED
 				} break;
@@ -1542,7 +1934,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
 					float value;
-					Error err = a->try_blend_shape_track_interpolate(i, time, &value);
+					Error err = a->try_blend_shape_track_interpolate(i, time, &value, false, &track_cursors[i]);
 					//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 					if (err != OK) {
 						continue;
@@ -1846,7 +2238,19 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 				} break;
 			}
 		}
+#ifndef _3D_DISABLED
+		// Blend the skeleton bone samples of this animation all at once.
+		pose_buffer.accumulate();
+#endif // _3D_DISABLED
+	}
+#ifndef _3D_DISABLED
+	for (uint32_t i = 0; i < pose_tracks.size(); i++) {
+		TrackCacheTransform *t = pose_tracks[i];
+		t->loc = pose_buffer.get_position(i);
+		t->rot = pose_buffer.get_rotation(i);
+		t->scale = pose_buffer.get_scale(i);
 	}
+#endif // _3D_DISABLED
 	is_GDVIRTUAL_CALL_post_process_key_value = true;
 }
 
@@ -1855,7 +2259,7 @@ void AnimationMixer::_blend_apply() {
 	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
 		TrackCache *track = K.value;
 		bool is_zero_amount = Math::is_zero_approx(track->total_weight);
-		if (!deterministic && is_zero_amount) {
+		if ((!deterministic && is_zero_amount) || _is_track_lod_culled(track)) {
 			continue;
 		}
 		switch (track->type) {
@@ -1875,14 +2279,23 @@ void AnimationMixer::_blend_apply() {
 					if (!t_skeleton) {
 						return;
 					}
-					if (t->loc_used) {
-						t_skeleton->set_bone_pose_position(t->bone_idx, t->loc);
-					}
-					if (t->rot_used) {
-						t_skeleton->set_bone_pose_rotation(t->bone_idx, t->rot);
-					}
-					if (t->scale_used) {
-						t_skeleton->set_bone_pose_scale(t->bone_idx, t->scale);
+					if (lod_interpolating && t->pose_slot >= 0) {
+						// Move from the current pose to the new one over the frames until the next update.
+						t->lod_from_loc = t_skeleton->get_bone_pose_position(t->bone_idx);
+						t->lod_from_rot = t_skeleton->get_bone_pose_rotation(t->bone_idx);
+						t->lod_from_scale = t_skeleton->get_bone_pose_scale(t->bone_idx);
+						t->lod_applied = true;
+						_apply_lod_interpolation_to(t, t_skeleton);
+					} else {
+						if (t->loc_used) {
+							t_skeleton->set_bone_pose_position(t->bone_idx, t->loc);
+						}
+						if (t->rot_used) {
+							t_skeleton->set_bone_pose_rotation(t->bone_idx, t->rot);
+						}
+						if (t->scale_used) {
+							t_skeleton->set_bone_pose_scale(t->bone_idx, t->scale);
+						}
 					}
 
 				} else if (!t->skeleton_id.is_valid()) {
@@ -2303,6 +2716,7 @@ void AnimationMixer::capture(const StringName &p_name, double p_duration, Tween:
 	capture_cache.ease_type = p_ease_type;
 	if (capture_cache.animation.is_valid()) {
 		animation_track_num_to_track_cache.erase(capture_cache.animation);
+		animation_track_cursors.erase(capture_cache.animation);
 	}
 	capture_cache.animation.instantiate();
 
@@ -2340,6 +2754,18 @@ void AnimationMixer::_node_removed(Node *p_node) {
 	_clear_caches();
 }
 
+void AnimationMixer::_process_frame(double p_delta) {
+	double delta = p_delta;
+	if (lod_enabled && !_lod_process(p_delta, delta)) {
+		return;
+	}
+	if (use_parallel_blending) {
+		_queue_parallel_blending(delta);
+	} else {
+		_process_animation(delta);
+	}
+}
+
 void AnimationMixer::_notification(int p_what) {
 	switch (p_what) {
 		case NOTIFICATION_ENTER_TREE: {
@@ -2352,13 +2778,13 @@ void AnimationMixer::_notification(int p_what) {
 
 		case NOTIFICATION_INTERNAL_PROCESS: {
 			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_IDLE) {
-				_process_animation(get_process_delta_time());
+				_process_frame(get_process_delta_time());
 			}
 		} break;
 
 		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
 			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS) {
-				_process_animation(get_physics_process_delta_time());
+				_process_frame(get_physics_process_delta_time());
 			}
 		} break;
 
@@ -2422,6 +2848,25 @@ void AnimationMixer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_callback_mode_discrete", "mode"), &AnimationMixer::set_callback_mode_discrete);
 	ClassDB::bind_method(D_METHOD("get_callback_mode_discrete"), &AnimationMixer::get_callback_mode_discrete);
 
+	ClassDB::bind_method(D_METHOD("set_use_parallel_blending", "enabled"), &AnimationMixer::set_use_parallel_blending);
+	ClassDB::bind_method(D_METHOD("is_using_parallel_blending"), &AnimationMixer::is_using_parallel_blending);
+
+	ClassDB::bind_method(D_METHOD("set_lod_enabled", "enabled"), &AnimationMixer::set_lod_enabled);
+	ClassDB::bind_method(D_METHOD("is_lod_enabled"), &AnimationMixer::is_lod_enabled);
+	ClassDB::bind_method(D_METHOD("set_lod_update_divisor", "divisor"), &AnimationMixer::set_lod_update_divisor);
+	ClassDB::bind_method(D_METHOD("get_lod_update_divisor"), &AnimationMixer::get_lod_update_divisor);
+	ClassDB::bind_method(D_METHOD("set_lod_distances", "distances"), &AnimationMixer::set_lod_distances);
+	ClassDB::bind_method(D_METHOD("get_lod_distances"), &AnimationMixer::get_lod_distances);
+	ClassDB::bind_method(D_METHOD("set_lod_visibility_notifier", "path"), &AnimationMixer::set_lod_visibility_notifier);
+	ClassDB::bind_method(D_METHOD("get_lod_visibility_notifier"), &AnimationMixer::get_lod_visibility_notifier);
+	ClassDB::bind_method(D_METHOD("set_lod_weight_threshold", "threshold"), &AnimationMixer::set_lod_weight_threshold);
+	ClassDB::bind_method(D_METHOD("get_lod_weight_threshold"), &AnimationMixer::get_lod_weight_threshold);
+	ClassDB::bind_method(D_METHOD("set_lod_bone_depth_limit", "depth"), &AnimationMixer::set_lod_bone_depth_limit);
+	ClassDB::bind_method(D_METHOD("get_lod_bone_depth_limit"), &AnimationMixer::get_lod_bone_depth_limit);
+	ClassDB::bind_method(D_METHOD("set_lod_interpolate", "enabled"), &AnimationMixer::set_lod_interpolate);
+	ClassDB::bind_method(D_METHOD("is_lod_interpolating"), &AnimationMixer::is_lod_interpolating);
+	ClassDB::bind_method(D_METHOD("get_lod_level"), &AnimationMixer::get_lod_level);
+
 	/* ---- Audio ---- */
 	ClassDB::bind_method(D_METHOD("set_audio_max_polyphony", "max_polyphony"), &AnimationMixer::set_audio_max_polyphony);
 	ClassDB::bind_method(D_METHOD("get_audio_max_polyphony"), &AnimationMixer::get_audio_max_polyphony);
@@ -2467,6 +2912,16 @@ void AnimationMixer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "callback_mode_process", PROPERTY_HINT_ENUM, "Physics,Idle,Manual"), "set_callback_mode_process", "get_callback_mode_process");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "callback_mode_method", PROPERTY_HINT_ENUM, "Deferred,Immediate"), "set_callback_mode_method", "get_callback_mode_method");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "callback_mode_discrete", PROPERTY_HINT_ENUM, "Dominant,Recessive,Force Continuous"), "set_callback_mode_discrete", "get_callback_mode_discrete");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_parallel_blending"), "set_use_parallel_blending", "is_using_parallel_blending");
+
+	ADD_GROUP("LOD", "lod_");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "lod_enabled"), "set_lod_enabled", "is_lod_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_update_divisor", PROPERTY_HINT_RANGE, "1,64,1"), "set_lod_update_divisor", "get_lod_update_divisor");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_FLOAT32_ARRAY, "lod_distances", PROPERTY_HINT_NONE, "suffix:m"), "set_lod_distances", "get_lod_distances");
+	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "lod_visibility_notifier", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "VisibleOnScreenNotifier2D,VisibleOnScreenNotifier3D"), "set_lod_visibility_notifier", "get_lod_visibility_notifier");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_weight_threshold", PROPERTY_HINT_RANGE, "0,1,0.001"), "set_lod_weight_threshold", "get_lod_weight_threshold");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_bone_depth_limit", PROPERTY_HINT_RANGE, "-1,64,1"), "set_lod_bone_depth_limit", "get_lod_bone_depth_limit");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "lod_interpolate"), "set_lod_interpolate", "is_lod_interpolating");
 
 	BIND_ENUM_CONSTANT(ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS);
 	BIND_ENUM_CONSTANT(ANIMATION_CALLBACK_MODE_PROCESS_IDLE);
@@ -34,6 +34,7 @@
 #define ANIMATION_MIXER_H
 
 #include "core/templates/a_hash_map.h"
+#include "scene/animation/animation_pose_buffer.h"
 #include "scene/animation/tween.h"
 #include "scene/main/node.h"
 #include "scene/resources/animation.h"
@@ -41,6 +42,7 @@
 #include "scene/resources/audio_stream_polyphonic.h"
 
 class AnimatedValuesBackup;
+class Skeleton3D;
 
 class AnimationMixer : public Node {
 	GDCLASS(AnimationMixer, Node);
@@ -140,6 +142,49 @@ protected:
 	bool active = true;
 
 	void _set_process(bool p_process, bool p_force = false);
+	void _process_frame(double p_delta); // Processes the mixer from the internal (physics) process notification.
+
+	/* ---- Parallel blending ---- */
+	bool use_parallel_blending = false;
+	bool parallel_blending_queued = false;
+	bool parallel_blending_ready = false;
+	bool parallel_blending_in_thread = false;
+	double parallel_blending_delta = 0.0;
+
+	static BinaryMutex parallel_blending_mutex;
+	static LocalVector<ObjectID> parallel_blending_queue;
+
+	void _queue_parallel_blending(double p_delta);
+	bool _can_blend_process_in_thread();
+	static void _parallel_blend_process(void *p_userdata, uint32_t p_index);
+
+	/* ---- Level of detail ---- */
+	static constexpr int LOD_MAX_UPDATE_DIVISOR = 64;
+
+	bool lod_enabled = false;
+	int lod_update_divisor = 1;
+	PackedFloat32Array lod_distances;
+	NodePath lod_visibility_notifier;
+	float lod_weight_threshold = 0.05;
+	int lod_bone_depth_limit = -1;
+	bool lod_interpolate = true;
+
+	int lod_level = 0;
+	int lod_divisor = 1;
+	int lod_frame = 0; // Frames since the last update.
+	double lod_delta = 0.0; // Time accumulated by the skipped frames.
+	bool lod_interpolating = false;
+	// Distance to the camera measured on the main thread, for mixers processed in a sub-thread group. Negative if unknown.
+	mutable SafeNumeric<float> lod_camera_distance{ -1.0f };
+	mutable SafeFlag lod_camera_distance_queued;
+
+	real_t _get_lod_camera_distance() const;
+	void _update_lod_camera_distance();
+	int _calc_lod_level() const;
+	bool _lod_process(double p_delta, double &r_delta); // Returns true if the mixer must update this frame.
+	_FORCE_INLINE_ bool _is_lod_pose_track(Animation::TrackType p_type) const {
+		return p_type == Animation::TYPE_POSITION_3D || p_type == Animation::TYPE_ROTATION_3D || p_type == Animation::TYPE_SCALE_3D || p_type == Animation::TYPE_BLEND_SHAPE || p_type == Animation::TYPE_BEZIER;
+	}
 
 	/* ---- Caches for blending ---- */
 	bool cache_valid = false;
@@ -171,6 +216,8 @@ protected:
 		ObjectID skeleton_id;
 #endif // _3D_DISABLED
 		int bone_idx = -1;
+		int bone_depth = 0; // Number of ancestors of the bone, used to skip minor bones at lower levels of detail.
+		int pose_slot = -1; // Index in the pose buffer, for skeleton bones.
 		bool loc_used = false;
 		bool rot_used = false;
 		bool scale_used = false;
@@ -180,6 +227,11 @@ protected:
 		Vector3 loc;
 		Quaternion rot;
 		Vector3 scale;
+		// Pose applied before the last update, when interpolating between updates.
+		Vector3 lod_from_loc;
+		Quaternion lod_from_rot;
+		Vector3 lod_from_scale;
+		bool lod_applied = false;
 
 		TrackCacheTransform(const TrackCacheTransform &p_other) :
 				TrackCache(p_other),
@@ -187,6 +239,7 @@ protected:
 				skeleton_id(p_other.skeleton_id),
 #endif
 				bone_idx(p_other.bone_idx),
+				bone_depth(p_other.bone_depth),
 				loc_used(p_other.loc_used),
 				rot_used(p_other.rot_used),
 				scale_used(p_other.scale_used),
@@ -314,6 +367,17 @@ protected:
 	RootMotionCache root_motion_cache;
 	AHashMap<Animation::TypeHash, TrackCache *, HashHasher> track_cache;
 	AHashMap<Ref<Animation>, LocalVector<TrackCache *>> animation_track_num_to_track_cache;
+	AHashMap<Ref<Animation>, LocalVector<Animation::TrackCursor>> animation_track_cursors; // Speeds up sampling the animations played forward.
+
+#ifndef _3D_DISABLED
+	// Skeleton bone transforms are blended through the pose buffer instead of their track caches.
+	AnimationPoseBuffer pose_buffer;
+	LocalVector<TrackCacheTransform *> pose_tracks;
+	void _update_pose_buffer();
+	void _apply_lod_interpolation_to(TrackCacheTransform *p_track, Skeleton3D *p_skeleton);
+	void _apply_lod_interpolation();
+#endif // _3D_DISABLED
+	bool _is_track_lod_culled(const TrackCache *p_track) const;
 	HashSet<TrackCache *> playing_caches;
 	Vector<Node *> playing_audio_stream_players;
 
@@ -442,6 +506,33 @@ public:
 	void set_callback_mode_discrete(AnimationCallbackModeDiscrete p_mode);
 	AnimationCallbackModeDiscrete get_callback_mode_discrete() const;
 
+	void set_use_parallel_blending(bool p_enabled);
+	bool is_using_parallel_blending() const;
+
+	/* ---- Level of detail ---- */
+	void set_lod_enabled(bool p_enabled);
+	bool is_lod_enabled() const;
+
+	void set_lod_update_divisor(int p_divisor);
+	int get_lod_update_divisor() const;
+
+	void set_lod_distances(const PackedFloat32Array &p_distances);
+	PackedFloat32Array get_lod_distances() const;
+
+	void set_lod_visibility_notifier(const NodePath &p_path);
+	NodePath get_lod_visibility_notifier() const;
+
+	void set_lod_weight_threshold(float p_threshold);
+	float get_lod_weight_threshold() const;
+
+	void set_lod_bone_depth_limit(int p_depth);
+	int get_lod_bone_depth_limit() const;
+
+	void set_lod_interpolate(bool p_enabled);
+	bool is_lod_interpolating() const;
+
+	int get_lod_level() const;
+
 	/* ---- Audio ---- */
 	void set_audio_max_polyphony(int p_audio_max_polyphony);
 	int get_audio_max_polyphony() const;
@@ -467,6 +558,8 @@ public:
 	virtual void advance(double p_time);
 	virtual void clear_caches(); // Must be called by hand if an animation was modified after added.
 
+	static void flush_parallel_blending(); // Called by the SceneTree once all nodes have been processed.
+
 	/* ---- Capture feature ---- */
 	void capture(const StringName &p_name, double p_duration, Tween::TransitionType p_trans_type = Tween::TRANS_LINEAR, Tween::EaseType p_ease_type = Tween::EASE_IN);
 
@@ -0,0 +1,234 @@
+/**************************************************************************/
+/*  animation_pose_buffer.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "animation_pose_buffer.h"
+
+void AnimationPoseBuffer::blend_vectors(real_t *const *p_pose, const real_t *const *p_samples, const real_t *const *p_init, const real_t *p_weights, uint32_t p_begin, uint32_t p_end) {
+	// Same as `pose += (sample - init) * weight` for each slot, done one component at a time.
+	for (int c = 0; c < 3; c++) {
+		real_t *__restrict pose = p_pose[c];
+		const real_t *__restrict sample = p_samples[c];
+		const real_t *__restrict init = p_init[c];
+		for (uint32_t i = p_begin; i < p_end; i++) {
+			real_t delta = (sample[i] - init[i]) * p_weights[i];
+			pose[i] += p_weights[i] != 0 ? delta : (real_t)0;
+		}
+	}
+}
+
+void AnimationPoseBuffer::blend_rotations(real_t *const *p_pose, const real_t *const *p_samples, const real_t *const *p_init_inv, const real_t *p_weights, uint32_t p_begin, uint32_t p_end) {
+	// Same as `pose = (pose * Quaternion().slerp(init.inverse() * sample, weight)).normalized()` for each slot.
+	real_t *__restrict px = p_pose[0];
+	real_t *__restrict py = p_pose[1];
+	real_t *__restrict pz = p_pose[2];
+	real_t *__restrict pw = p_pose[3];
+	const real_t *__restrict sx = p_samples[0];
+	const real_t *__restrict sy = p_samples[1];
+	const real_t *__restrict sz = p_samples[2];
+	const real_t *__restrict sw = p_samples[3];
+	const real_t *__restrict ix = p_init_inv[0];
+	const real_t *__restrict iy = p_init_inv[1];
+	const real_t *__restrict iz = p_init_inv[2];
+	const real_t *__restrict iw = p_init_inv[3];
+
+	for (uint32_t i = p_begin; i < p_end; i++) {
+		const real_t weight = p_weights[i];
+
+		// Rotation relative to the initial one.
+		const real_t rx = iw[i] * sx[i] + ix[i] * sw[i] + iy[i] * sz[i] - iz[i] * sy[i];
+		const real_t ry = iw[i] * sy[i] + iy[i] * sw[i] + iz[i] * sx[i] - ix[i] * sz[i];
+		const real_t rz = iw[i] * sz[i] + iz[i] * sw[i] + ix[i] * sy[i] - iy[i] * sx[i];
+		const real_t rw = iw[i] * sw[i] - ix[i] * sx[i] - iy[i] * sy[i] - iz[i] * sz[i];
+
+		// Slerp from the identity, whose dot product with the relative rotation is its w component.
+		const real_t sign = rw < 0 ? (real_t)-1 : (real_t)1;
+		const real_t cosom = MIN(rw * sign, (real_t)1);
+		const real_t omega = Math::acos(cosom);
+		const real_t sinom = 1.0f / Math::sin(omega);
+		const bool linear = (1.0f - cosom) <= CMP_EPSILON; // Near-parallel quaternions.
+		const real_t scale0 = linear ? 1.0f - weight : Math::sin((1.0f - weight) * omega) * sinom;
+		const real_t scale1 = (linear ? weight : Math::sin(weight * omega) * sinom) * sign;
+		const real_t qx = scale1 * rx;
+		const real_t qy = scale1 * ry;
+		const real_t qz = scale1 * rz;
+		const real_t qw = scale0 + scale1 * rw;
+
+		// Apply to the pose and normalize.
+		const real_t nx = pw[i] * qx + px[i] * qw + py[i] * qz - pz[i] * qy;
+		const real_t ny = pw[i] * qy + py[i] * qw + pz[i] * qx - px[i] * qz;
+		const real_t nz = pw[i] * qz + pz[i] * qw + px[i] * qy - py[i] * qx;
+		const real_t nw = pw[i] * qw - px[i] * qx - py[i] * qy - pz[i] * qz;
+		const real_t inv_length = 1.0f / Math::sqrt(nx * nx + ny * ny + nz * nz + nw * nw);
+
+		const bool blend = weight != 0;
+		px[i] = blend ? nx * inv_length : px[i];
+		py[i] = blend ? ny * inv_length : py[i];
+		pz[i] = blend ? nz * inv_length : pz[i];
+		pw[i] = blend ? nw * inv_length : pw[i];
+	}
+}
+
+static void _resize_zeroed(LocalVector<real_t> &r_lanes, uint32_t p_size) {
+	r_lanes.resize(p_size);
+	memset(r_lanes.ptr(), 0, sizeof(real_t) * p_size);
+}
+
+void AnimationPoseBuffer::resize(uint32_t p_size) {
+	size = p_size;
+	for (int c = 0; c < 3; c++) {
+		_resize_zeroed(init_position[c], p_size);
+		_resize_zeroed(init_scale[c], p_size);
+		_resize_zeroed(position[c], p_size);
+		_resize_zeroed(scale[c], p_size);
+		_resize_zeroed(position_sample[c], p_size);
+		_resize_zeroed(scale_sample[c], p_size);
+	}
+	for (int c = 0; c < 4; c++) {
+		_resize_zeroed(init_rotation_inv[c], p_size);
+		_resize_zeroed(rotation[c], p_size);
+		_resize_zeroed(rotation_sample[c], p_size);
+	}
+	for (int i = 0; i < CHANNEL_MAX; i++) {
+		_resize_zeroed(weights[i], p_size);
+		sampled_begin[i] = 0;
+		sampled_end[i] = 0;
+	}
+}
+
+void AnimationPoseBuffer::set_init(uint32_t p_slot, const Vector3 &p_position, const Quaternion &p_rotation, const Vector3 &p_scale) {
+	ERR_FAIL_UNSIGNED_INDEX(p_slot, size);
+	const Quaternion rotation_inv = p_rotation.inverse();
+	for (int c = 0; c < 3; c++) {
+		init_position[c][p_slot] = p_position[c];
+		init_scale[c][p_slot] = p_scale[c];
+	}
+	for (int c = 0; c < 4; c++) {
+		init_rotation_inv[c][p_slot] = rotation_inv.components[c];
+	}
+}
+
+void AnimationPoseBuffer::reset() {
+	if (size == 0) {
+		return;
+	}
+	for (int c = 0; c < 3; c++) {
+		memcpy(position[c].ptr(), init_position[c].ptr(), sizeof(real_t) * size);
+		memcpy(scale[c].ptr(), init_scale[c].ptr(), sizeof(real_t) * size);
+	}
+	// The initial rotation is the inverse of the stored one.
+	for (int c = 0; c < 3; c++) {
+		real_t *dst = rotation[c].ptr();
+		const real_t *src = init_rotation_inv[c].ptr();
+		for (uint32_t i = 0; i < size; i++) {
+			dst[i] = -src[i];
+		}
+	}
+	memcpy(rotation[3].ptr(), init_rotation_inv[3].ptr(), sizeof(real_t) * size);
+	for (int i = 0; i < CHANNEL_MAX; i++) {
+		memset(weights[i].ptr(), 0, sizeof(real_t) * size);
+		sampled_begin[i] = 0;
+		sampled_end[i] = 0;
+	}
+}
+
+void AnimationPoseBuffer::add_position_sample(uint32_t p_slot, const Vector3 &p_position, real_t p_weight) {
+	ERR_FAIL_UNSIGNED_INDEX(p_slot, size);
+	if (weights[CHANNEL_POSITION][p_slot] != 0) {
+		// Several tracks of the same animation animate this slot, blend the previous one first.
+		_accumulate(CHANNEL_POSITION, p_slot, p_slot + 1);
+	}
+	for (int c = 0; c < 3; c++) {
+		position_sample[c][p_slot] = p_position[c];
+	}
+	weights[CHANNEL_POSITION][p_slot] = p_weight;
+	_mark_sampled(CHANNEL_POSITION, p_slot);
+}
+
+void AnimationPoseBuffer::add_rotation_sample(uint32_t p_slot, const Quaternion &p_rotation, real_t p_weight) {
+	ERR_FAIL_UNSIGNED_INDEX(p_slot, size);
+	if (weights[CHANNEL_ROTATION][p_slot] != 0) {
+		_accumulate(CHANNEL_ROTATION, p_slot, p_slot + 1);
+	}
+	for (int c = 0; c < 4; c++) {
+		rotation_sample[c][p_slot] = p_rotation.components[c];
+	}
+	weights[CHANNEL_ROTATION][p_slot] = p_weight;
+	_mark_sampled(CHANNEL_ROTATION, p_slot);
+}
+
+void AnimationPoseBuffer::add_scale_sample(uint32_t p_slot, const Vector3 &p_scale, real_t p_weight) {
+	ERR_FAIL_UNSIGNED_INDEX(p_slot, size);
+	if (weights[CHANNEL_SCALE][p_slot] != 0) {
+		_accumulate(CHANNEL_SCALE, p_slot, p_slot + 1);
+	}
+	for (int c = 0; c < 3; c++) {
+		scale_sample[c][p_slot] = p_scale[c];
+	}
+	weights[CHANNEL_SCALE][p_slot] = p_weight;
+	_mark_sampled(CHANNEL_SCALE, p_slot);
+}
+
+void AnimationPoseBuffer::_accumulate(Channel p_channel, uint32_t p_begin, uint32_t p_end) {
+	switch (p_channel) {
+		case CHANNEL_POSITION: {
+			real_t *pose[3] = { position[0].ptr(), position[1].ptr(), position[2].ptr() };
+			const real_t *samples[3] = { position_sample[0].ptr(), position_sample[1].ptr(), position_sample[2].ptr() };
+			const real_t *init[3] = { init_position[0].ptr(), init_position[1].ptr(), init_position[2].ptr() };
+			blend_vectors(pose, samples, init, weights[CHANNEL_POSITION].ptr(), p_begin, p_end);
+		} break;
+		case CHANNEL_ROTATION: {
+			real_t *pose[4] = { rotation[0].ptr(), rotation[1].ptr(), rotation[2].ptr(), rotation[3].ptr() };
+			const real_t *samples[4] = { rotation_sample[0].ptr(), rotation_sample[1].ptr(), rotation_sample[2].ptr(), rotation_sample[3].ptr() };
+			const real_t *init_inv[4] = { init_rotation_inv[0].ptr(), init_rotation_inv[1].ptr(), init_rotation_inv[2].ptr(), init_rotation_inv[3].ptr() };
+			blend_rotations(pose, samples, init_inv, weights[CHANNEL_ROTATION].ptr(), p_begin, p_end);
+		} break;
+		case CHANNEL_SCALE: {
+			real_t *pose[3] = { scale[0].ptr(), scale[1].ptr(), scale[2].ptr() };
+			const real_t *samples[3] = { scale_sample[0].ptr(), scale_sample[1].ptr(), scale_sample[2].ptr() };
+			const real_t *init[3] = { init_scale[0].ptr(), init_scale[1].ptr(), init_scale[2].ptr() };
+			blend_vectors(pose, samples, init, weights[CHANNEL_SCALE].ptr(), p_begin, p_end);
+		} break;
+		default: {
+		} break;
+	}
+	memset(weights[p_channel].ptr() + p_begin, 0, sizeof(real_t) * (p_end - p_begin));
+}
+
+void AnimationPoseBuffer::accumulate() {
+	for (int i = 0; i < CHANNEL_MAX; i++) {
+		if (sampled_begin[i] < sampled_end[i]) {
+			_accumulate(Channel(i), sampled_begin[i], sampled_end[i]);
+		}
+		sampled_begin[i] = 0;
+		sampled_end[i] = 0;
+	}
+}
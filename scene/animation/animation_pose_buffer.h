@@ -0,0 +1,117 @@
+/**************************************************************************/
+/*  animation_pose_buffer.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef ANIMATION_POSE_BUFFER_H
+#define ANIMATION_POSE_BUFFER_H
+
+#include "core/math/quaternion.h"
+#include "core/math/vector3.h"
+#include "core/templates/local_vector.h"
+
+// Pose of the skeleton bones animated by an AnimationMixer, stored as one array
+// per component (SoA) and indexed by slot, so that blending the samples of an
+// animation into the pose runs as a loop over all bones at once that the
+// compiler can vectorize, instead of branching on the track type per track.
+class AnimationPoseBuffer {
+public:
+	enum Channel {
+		CHANNEL_POSITION,
+		CHANNEL_ROTATION,
+		CHANNEL_SCALE,
+		CHANNEL_MAX,
+	};
+
+private:
+	uint32_t size = 0;
+
+	// Initial values the samples are blended relative to. Rotations are stored inverted.
+	LocalVector<real_t> init_position[3];
+	LocalVector<real_t> init_rotation_inv[4];
+	LocalVector<real_t> init_scale[3];
+
+	// Blended pose.
+	LocalVector<real_t> position[3];
+	LocalVector<real_t> rotation[4];
+	LocalVector<real_t> scale[3];
+
+	// Samples of the animation being blended, and their weights (zero for slots without a sample).
+	LocalVector<real_t> position_sample[3];
+	LocalVector<real_t> rotation_sample[4];
+	LocalVector<real_t> scale_sample[3];
+	LocalVector<real_t> weights[CHANNEL_MAX];
+
+	// Range of slots with a sample, per channel.
+	uint32_t sampled_begin[CHANNEL_MAX] = {};
+	uint32_t sampled_end[CHANNEL_MAX] = {};
+
+	_FORCE_INLINE_ void _mark_sampled(Channel p_channel, uint32_t p_slot) {
+		if (sampled_begin[p_channel] >= sampled_end[p_channel]) {
+			sampled_begin[p_channel] = p_slot;
+			sampled_end[p_channel] = p_slot + 1;
+		} else {
+			sampled_begin[p_channel] = MIN(sampled_begin[p_channel], p_slot);
+			sampled_end[p_channel] = MAX(sampled_end[p_channel], p_slot + 1);
+		}
+	}
+
+	void _accumulate(Channel p_channel, uint32_t p_begin, uint32_t p_end);
+
+public:
+	static void blend_vectors(real_t *const *p_pose, const real_t *const *p_samples, const real_t *const *p_init, const real_t *p_weights, uint32_t p_begin, uint32_t p_end);
+	static void blend_rotations(real_t *const *p_pose, const real_t *const *p_samples, const real_t *const *p_init_inv, const real_t *p_weights, uint32_t p_begin, uint32_t p_end);
+
+	void resize(uint32_t p_size);
+	_FORCE_INLINE_ uint32_t get_size() const { return size; }
+	void set_init(uint32_t p_slot, const Vector3 &p_position, const Quaternion &p_rotation, const Vector3 &p_scale);
+
+	// Starts a new blend from the initial values.
+	void reset();
+
+	void add_position_sample(uint32_t p_slot, const Vector3 &p_position, real_t p_weight);
+	void add_rotation_sample(uint32_t p_slot, const Quaternion &p_rotation, real_t p_weight);
+	void add_scale_sample(uint32_t p_slot, const Vector3 &p_scale, real_t p_weight);
+
+	// Blends the samples added since the last call into the pose, in the same way as AnimationMixer blends a single transform track.
+	void accumulate();
+
+	_FORCE_INLINE_ Vector3 get_position(uint32_t p_slot) const {
+		return Vector3(position[0][p_slot], position[1][p_slot], position[2][p_slot]);
+	}
+	_FORCE_INLINE_ Quaternion get_rotation(uint32_t p_slot) const {
+		return Quaternion(rotation[0][p_slot], rotation[1][p_slot], rotation[2][p_slot], rotation[3][p_slot]);
+	}
+	_FORCE_INLINE_ Vector3 get_scale(uint32_t p_slot) const {
+		return Vector3(scale[0][p_slot], scale[1][p_slot], scale[2][p_slot]);
+	}
+};
+
+#endif // ANIMATION_POSE_BUFFER_H
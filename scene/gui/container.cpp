@@ -138,7 +138,7 @@ void Container::queue_sort() {
 		return;
 	}
 
-	callable_mp(this, &Container::_sort_children).call_deferred();
+	MessageQueue::get_singleton()->push_method(this, &Container::_sort_children);
 	pending_sort = true;
 }
 
@@ -1033,10 +1033,11 @@ void CanvasItem::_notify_transform(CanvasItem *p_node) {
 	if (p_node->notify_transform && !p_node->xform_change.in_list()) {
 		if (!p_node->block_transform_notify) {
 			if (p_node->is_inside_tree()) {
-				if (is_accessible_from_caller_thread()) {
+				if (is_accessible_from_caller_thread() && !is_parallel_processing()) {
 					get_tree()->xform_change_list.add(&p_node->xform_change);
 				} else {
 					// Should be rare, but still needs to be handled.
+					// Parallel workers also take this path, as they would add to the list at the same time.
 					callable_mp(p_node, &CanvasItem::_notify_transform_deferred).call_deferred();
 				}
 			}
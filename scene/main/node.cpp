@@ -50,6 +50,7 @@
 int Node::orphan_node_count = 0;
 
 thread_local Node *Node::current_process_thread_group = nullptr;
+thread_local void *Node::current_parallel_process_group = nullptr;
 
 void Node::_notification(int p_notification) {
 	switch (p_notification) {
@@ -364,7 +365,7 @@ void Node::_propagate_after_exit_tree() {
 
 	data.blocked++;
 
-	for (HashMap<StringName, Node *>::Iterator I = data.children.last(); I; --I) {
+	for (SmallHashMap<StringName, Node *>::Iterator I = data.children.last(); I; --I) {
 		I->value->_propagate_after_exit_tree();
 	}
 
@@ -384,7 +385,7 @@ void Node::_propagate_exit_tree() {
 #endif
 	data.blocked++;
 
-	for (HashMap<StringName, Node *>::Iterator I = data.children.last(); I; --I) {
+	for (SmallHashMap<StringName, Node *>::Iterator I = data.children.last(); I; --I) {
 		I->value->_propagate_exit_tree();
 	}
 
@@ -581,6 +582,7 @@ void Node::_physics_interpolated_changed() {}
 
 void Node::set_physics_process(bool p_process) {
 	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
 	if (data.physics_process == p_process) {
 		return;
 	}
@@ -607,6 +609,7 @@ bool Node::is_physics_processing() const {
 
 void Node::set_physics_process_internal(bool p_process_internal) {
 	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
 	if (data.physics_process_internal == p_process_internal) {
 		return;
 	}
@@ -633,6 +636,7 @@ bool Node::is_physics_processing_internal() const {
 
 void Node::set_process_mode(ProcessMode p_mode) {
 	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
 	if (data.process_mode == p_mode) {
 		return;
 	}
@@ -986,6 +990,7 @@ double Node::get_process_delta_time() const {
 
 void Node::set_process(bool p_process) {
 	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
 	if (data.process == p_process) {
 		return;
 	}
@@ -1012,6 +1017,7 @@ bool Node::is_processing() const {
 
 void Node::set_process_internal(bool p_process_internal) {
 	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
 	if (data.process_internal == p_process_internal) {
 		return;
 	}
@@ -1092,6 +1098,7 @@ bool Node::is_processing_internal() const {
 
 void Node::set_process_thread_group_order(int p_order) {
 	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
 	if (data.process_thread_group_order == p_order) {
 		return;
 	}
@@ -1112,6 +1119,7 @@ int Node::get_process_thread_group_order() const {
 
 void Node::set_process_priority(int p_priority) {
 	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
 	if (data.process_priority == p_priority) {
 		return;
 	}
@@ -1138,6 +1146,7 @@ int Node::get_process_priority() const {
 
 void Node::set_physics_process_priority(int p_priority) {
 	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
 	if (data.physics_process_priority == p_priority) {
 		return;
 	}
@@ -1203,6 +1212,7 @@ Node::ProcessThreadGroup Node::get_process_thread_group() const {
 
 void Node::set_process_thread_messages(BitField<ProcessThreadMessages> p_flags) {
 	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
 	if (data.process_thread_messages == p_flags) {
 		return;
 	}
@@ -1214,8 +1224,19 @@ BitField<Node::ProcessThreadMessages> Node::get_process_thread_messages() const
 	return data.process_thread_messages;
 }
 
+void Node::set_process_thread_parallel(bool p_enable) {
+	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
+	data.process_thread_parallel = p_enable;
+}
+
+bool Node::is_process_thread_parallel() const {
+	return data.process_thread_parallel;
+}
+
 void Node::set_process_input(bool p_enable) {
 	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
 	if (p_enable == data.input) {
 		return;
 	}
@@ -1238,6 +1259,7 @@ bool Node::is_processing_input() const {
 
 void Node::set_process_shortcut_input(bool p_enable) {
 	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
 	if (p_enable == data.shortcut_input) {
 		return;
 	}
@@ -1259,6 +1281,7 @@ bool Node::is_processing_shortcut_input() const {
 
 void Node::set_process_unhandled_input(bool p_enable) {
 	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
 	if (p_enable == data.unhandled_input) {
 		return;
 	}
@@ -1280,6 +1303,7 @@ bool Node::is_processing_unhandled_input() const {
 
 void Node::set_process_unhandled_key_input(bool p_enable) {
 	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
 	if (p_enable == data.unhandled_key_input) {
 		return;
 	}
@@ -1301,6 +1325,7 @@ bool Node::is_processing_unhandled_key_input() const {
 
 void Node::set_process_unhandled_picking_input(bool p_enable) {
 	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
 	if (p_enable == data.unhandled_picking_input) {
 		return;
 	}
@@ -2011,6 +2036,7 @@ TypedArray<Node> Node::find_children(const String &p_pattern, const String &p_ty
 
 void Node::reparent(Node *p_parent, bool p_keep_global_transform) {
 	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
 	ERR_FAIL_NULL(p_parent);
 	ERR_FAIL_NULL_MSG(data.parent, "Node needs a parent to be reparented.");
 
@@ -2427,6 +2453,7 @@ bool Node::is_in_group(const StringName &p_identifier) const {
 
 void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
 	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
 	ERR_FAIL_COND(!p_identifier.operator String().length());
 
 	if (data.grouped.has(p_identifier)) {
@@ -2451,6 +2478,7 @@ void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
 
 void Node::remove_from_group(const StringName &p_identifier) {
 	ERR_THREAD_GUARD
+	ERR_PARALLEL_PROCESS_GUARD
 	HashMap<StringName, GroupData>::Iterator E = data.grouped.find(p_identifier);
 
 	if (!E) {
@@ -2547,7 +2575,7 @@ String Node::get_tree_string() {
 void Node::_propagate_reverse_notification(int p_notification) {
 	data.blocked++;
 
-	for (HashMap<StringName, Node *>::Iterator I = data.children.last(); I; --I) {
+	for (SmallHashMap<StringName, Node *>::Iterator I = data.children.last(); I; --I) {
 		I->value->_propagate_reverse_notification(p_notification);
 	}
 
@@ -3407,6 +3435,7 @@ void Node::print_orphan_nodes() {
 }
 
 void Node::queue_free() {
+	ERR_PARALLEL_PROCESS_GUARD
 	// There are users which instantiate multiple scene trees for their games.
 	// Use the node's own tree to handle its deletion when relevant.
 	if (is_inside_tree()) {
@@ -3751,6 +3780,9 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_process_thread_messages", "flags"), &Node::set_process_thread_messages);
 	ClassDB::bind_method(D_METHOD("get_process_thread_messages"), &Node::get_process_thread_messages);
 
+	ClassDB::bind_method(D_METHOD("set_process_thread_parallel", "enable"), &Node::set_process_thread_parallel);
+	ClassDB::bind_method(D_METHOD("is_process_thread_parallel"), &Node::is_process_thread_parallel);
+
 	ClassDB::bind_method(D_METHOD("set_process_thread_group_order", "order"), &Node::set_process_thread_group_order);
 	ClassDB::bind_method(D_METHOD("get_process_thread_group_order"), &Node::get_process_thread_group_order);
 
@@ -3961,6 +3993,7 @@ void Node::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group", PROPERTY_HINT_ENUM, "Inherit,Main Thread,Sub Thread"), "set_process_thread_group", "get_process_thread_group");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group_order"), "set_process_thread_group_order", "get_process_thread_group_order");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_messages", PROPERTY_HINT_FLAGS, "Process,Physics Process"), "set_process_thread_messages", "get_process_thread_messages");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "process_thread_parallel"), "set_process_thread_parallel", "is_process_thread_parallel");
 
 	ADD_GROUP("Physics Interpolation", "physics_interpolation_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "physics_interpolation_mode", PROPERTY_HINT_ENUM, "Inherit,On,Off"), "set_physics_interpolation_mode", "get_physics_interpolation_mode");
@@ -4011,6 +4044,7 @@ Node::Node() {
 
 	data.physics_process_internal = false;
 	data.process_internal = false;
+	data.process_thread_parallel = false;
 
 	data.input = false;
 	data.shortcut_input = false;
@@ -34,6 +34,7 @@
 #define NODE_H
 
 #include "core/string/node_path.h"
+#include "core/templates/small_hash_map.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/scene_tree.h"
 #include "scene/scene_string_names.h"
@@ -166,7 +167,7 @@ private:
 
 		Node *parent = nullptr;
 		Node *owner = nullptr;
-		HashMap<StringName, Node *> children;
+		SmallHashMap<StringName, Node *> children;
 		mutable bool children_cache_dirty = true;
 		mutable LocalVector<Node *> children_cache;
 		HashMap<StringName, Node *> owned_unique_nodes;
@@ -216,6 +217,8 @@ private:
 		bool physics_process_internal : 1;
 		bool process_internal : 1;
 
+		bool process_thread_parallel : 1;
+
 		bool input : 1;
 		bool shortcut_input : 1;
 		bool unhandled_input : 1;
@@ -329,6 +332,7 @@ private:
 	void _add_tree_to_process_thread_group(Node *p_owner);
 
 	static thread_local Node *current_process_thread_group;
+	static thread_local void *current_parallel_process_group;
 
 	Variant _call_deferred_thread_group_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	Variant _call_thread_safe_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
@@ -631,8 +635,9 @@ public:
 		if (current_process_thread_group == nullptr) {
 			// No thread processing.
 			// Only accessible if node is outside the scene tree
-			// or access will happen from a node-safe thread.
-			return !data.inside_tree || is_current_thread_safe_for_nodes();
+			// or access will happen from a node-safe thread,
+			// or from a worker processing the group of the node in parallel.
+			return !data.inside_tree || is_current_thread_safe_for_nodes() || (current_parallel_process_group && current_parallel_process_group == data.process_group);
 		} else {
 			// Thread processing.
 			return current_process_thread_group == data.process_thread_group_owner;
@@ -644,7 +649,7 @@ public:
 			// No thread processing.
 			// Only accessible if node is outside the scene tree
 			// or access will happen from a node-safe thread.
-			return is_current_thread_safe_for_nodes() || unlikely(!data.inside_tree);
+			return is_current_thread_safe_for_nodes() || unlikely(!data.inside_tree) || current_parallel_process_group;
 		} else {
 			// Thread processing.
 			return true;
@@ -652,10 +657,14 @@ public:
 	}
 
 	_FORCE_INLINE_ static bool is_group_processing() { return current_process_thread_group; }
+	_FORCE_INLINE_ static bool is_parallel_processing() { return current_parallel_process_group; }
 
 	void set_process_thread_messages(BitField<ProcessThreadMessages> p_flags);
 	BitField<ProcessThreadMessages> get_process_thread_messages() const;
 
+	void set_process_thread_parallel(bool p_enable);
+	bool is_process_thread_parallel() const;
+
 	Node *duplicate(int p_flags = DUPLICATE_GROUPS | DUPLICATE_SIGNALS | DUPLICATE_SCRIPTS) const;
 #ifdef TOOLS_ENABLED
 	Node *duplicate_from_editor(HashMap<const Node *, Node *> &r_duplimap) const;
@@ -862,6 +871,7 @@ Error Node::rpc_id(int p_peer_id, const StringName &p_method, VarArgs... p_args)
 #define ERR_MAIN_THREAD_GUARD_V(m_ret) ERR_FAIL_COND_V_MSG(is_inside_tree() && !is_current_thread_safe_for_nodes(), (m_ret), vformat("This function in this node (%s) can only be accessed from the main thread. Use call_deferred() instead.", get_description()));
 #define ERR_READ_THREAD_GUARD ERR_FAIL_COND_MSG(!is_readable_from_caller_thread(), vformat("This function in this node (%s) can only be accessed from either the main thread or a thread group. Use call_deferred() instead.", get_description()));
 #define ERR_READ_THREAD_GUARD_V(m_ret) ERR_FAIL_COND_V_MSG(!is_readable_from_caller_thread(), (m_ret), vformat("This function in this node (%s) can only be accessed from either the main thread or a thread group. Use call_deferred() instead.", get_description()));
+#define ERR_PARALLEL_PROCESS_GUARD ERR_FAIL_COND_MSG(is_parallel_processing(), vformat("This function in this node (%s) can't be called while nodes are processed in parallel. Use call_deferred() instead.", get_description()));
 #else
 #define ERR_THREAD_GUARD
 #define ERR_THREAD_GUARD_V(m_ret)
@@ -869,6 +879,7 @@ Error Node::rpc_id(int p_peer_id, const StringName &p_method, VarArgs... p_args)
 #define ERR_MAIN_THREAD_GUARD_V(m_ret)
 #define ERR_READ_THREAD_GUARD
 #define ERR_READ_THREAD_GUARD_V(m_ret)
+#define ERR_PARALLEL_PROCESS_GUARD
 #endif
 
 // Add these macro to your class's 'get_configuration_warnings' function to have warnings show up in the scene tree inspector.
@@ -1037,34 +1037,98 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 
 	for (uint32_t i = 0; i < node_count; i++) {
 		Node *n = nodes_ptr[i];
-		if (nodes_removed_on_group_call.has(n)) {
-			// Node may have been removed during process, skip it.
-			// Keep in mind removals can only happen on the main thread.
-			continue;
+		if (n->data.process_thread_parallel && !node_threading_disabled) {
+			// Find the nodes which may be processed at the same time as this one. They must keep the priority order with the others.
+			int priority = p_physics ? n->data.physics_process_priority : n->data.process_priority;
+			uint32_t end = i + 1;
+			while (end < node_count && nodes_ptr[end]->data.process_thread_parallel && (p_physics ? nodes_ptr[end]->data.physics_process_priority : nodes_ptr[end]->data.process_priority) == priority) {
+				end++;
+			}
+			if (end - i >= PARALLEL_PROCESS_MIN_NODES) {
+				_process_nodes_parallel(p_group, nodes_ptr + i, end - i, p_physics);
+				i = end - 1;
+				continue;
+			}
 		}
 
-		if (!n->can_process() || !n->is_inside_tree()) {
-			continue;
+		_process_node(n, p_physics);
+	}
+
+	p_group->call_queue.flush(); // Flush messages also after processing (for potential deferred calls).
+}
+
+void SceneTree::_process_node(Node *p_node, bool p_physics) {
+	if (nodes_removed_on_group_call.has(p_node)) {
+		// Node may have been removed during process, skip it.
+		// Keep in mind removals can only happen on the main thread.
+		return;
+	}
+
+	if (!p_node->can_process() || !p_node->is_inside_tree()) {
+		return;
+	}
+
+	if (p_physics) {
+		if (p_node->is_physics_processing_internal()) {
+			p_node->notification(Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
 		}
+		if (p_node->is_physics_processing()) {
+			p_node->notification(Node::NOTIFICATION_PHYSICS_PROCESS);
+		}
+	} else {
+		if (p_node->is_processing_internal()) {
+			p_node->notification(Node::NOTIFICATION_INTERNAL_PROCESS);
+		}
+		if (p_node->is_processing()) {
+			p_node->notification(Node::NOTIFICATION_PROCESS);
+		}
+	}
+}
 
-		if (p_physics) {
-			if (n->is_physics_processing_internal()) {
-				n->notification(Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
-			}
-			if (n->is_physics_processing()) {
-				n->notification(Node::NOTIFICATION_PHYSICS_PROCESS);
-			}
-		} else {
-			if (n->is_processing_internal()) {
-				n->notification(Node::NOTIFICATION_INTERNAL_PROCESS);
-			}
-			if (n->is_processing()) {
-				n->notification(Node::NOTIFICATION_PROCESS);
-			}
+void SceneTree::_process_nodes_parallel(ProcessGroup *p_group, Node **p_nodes, uint32_t p_node_count, bool p_physics) {
+	ParallelProcess process;
+	process.nodes = p_nodes;
+	process.node_count = p_node_count;
+	process.physics = p_physics;
+	process.group = p_group;
+	process.thread_group = Node::current_process_thread_group;
+
+	uint32_t chunk_count = (p_node_count + PARALLEL_PROCESS_CHUNK_SIZE - 1) / PARALLEL_PROCESS_CHUNK_SIZE;
+
+	if (WorkerThreadPool::get_thread_index() != -1) {
+		// Sub-thread groups are already processed by a group task. Waiting for a nested group
+		// task would block this pool thread without running other tasks, so process inline.
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			_process_nodes_parallel_thread(i, &process);
 		}
+		return;
 	}
 
-	p_group->call_queue.flush(); // Flush messages also after processing (for potential deferred calls).
+	WorkerThreadPool::GroupID id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_process_nodes_parallel_thread, &process, chunk_count, -1, true, SNAME("ProcessNodesParallel"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(id);
+}
+
+void SceneTree::_process_nodes_parallel_thread(uint32_t p_chunk, ParallelProcess *p_process) {
+	// Workers access the nodes of the group like the thread processing it would, but can't
+	// modify the tree nor the process lists (see ERR_PARALLEL_PROCESS_GUARD), as other
+	// workers process the same group at the same time.
+	// Deferred calls are staged in per-thread buffers of the message queues.
+	Node *thread_group_backup = Node::current_process_thread_group;
+	void *parallel_process_group_backup = Node::current_parallel_process_group;
+	bool thread_safe_for_nodes_backup = is_current_thread_safe_for_nodes();
+	Node::current_process_thread_group = p_process->thread_group;
+	Node::current_parallel_process_group = p_process->group;
+	set_current_thread_safe_for_nodes(false);
+
+	uint32_t from = p_chunk * PARALLEL_PROCESS_CHUNK_SIZE;
+	uint32_t to = MIN(from + PARALLEL_PROCESS_CHUNK_SIZE, p_process->node_count);
+	for (uint32_t i = from; i < to; i++) {
+		_process_node(p_process->nodes[i], p_process->physics);
+	}
+
+	Node::current_process_thread_group = thread_group_backup;
+	Node::current_parallel_process_group = parallel_process_group_backup;
+	set_current_thread_safe_for_nodes(thread_safe_for_nodes_backup);
 }
 
 void SceneTree::_process_groups_thread(uint32_t p_index, bool p_physics) {
@@ -1220,6 +1284,7 @@ void SceneTree::_add_process_group(Node *p_node) {
 	ERR_FAIL_NULL(p_node);
 
 	ProcessGroup *pg = memnew(ProcessGroup);
+	pg->call_queue.set_use_thread_buffers(true); // For nodes processed in parallel.
 
 	pg->owner = p_node;
 	p_node->data.process_group = pg;
@@ -2003,6 +2068,7 @@ SceneTree::SceneTree() {
 #endif
 
 	process_groups.push_back(&default_process_group);
+	default_process_group.call_queue.set_use_thread_buffers(true);
 }
 
 SceneTree::~SceneTree() {
@@ -227,6 +227,23 @@ private:
 	void remove_from_group(const StringName &p_group, Node *p_node);
 	void make_group_changed(const StringName &p_group);
 
+	// Consecutive nodes set to Node::process_thread_parallel are processed in chunks on the WorkerThreadPool.
+	enum {
+		PARALLEL_PROCESS_MIN_NODES = 16,
+		PARALLEL_PROCESS_CHUNK_SIZE = 64,
+	};
+
+	struct ParallelProcess {
+		Node **nodes = nullptr;
+		uint32_t node_count = 0;
+		bool physics = false;
+		ProcessGroup *group = nullptr;
+		Node *thread_group = nullptr; // Context of the thread processing the group, applied to the workers.
+	};
+
+	void _process_node(Node *p_node, bool p_physics);
+	void _process_nodes_parallel(ProcessGroup *p_group, Node **p_nodes, uint32_t p_node_count, bool p_physics);
+	void _process_nodes_parallel_thread(uint32_t p_chunk, ParallelProcess *p_process);
 	void _process_group(ProcessGroup *p_group, bool p_physics);
 	void _process_groups_thread(uint32_t p_index, bool p_physics);
 	void _process(bool p_physics);
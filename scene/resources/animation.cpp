@@ -1185,7 +1185,7 @@ Error Animation::position_track_get_key(int p_track, int p_key, Vector3 *r_posit
 	return OK;
 }
 
-Error Animation::try_position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward) const {
+Error Animation::try_position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward, TrackCursor *p_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_POSITION_3D, ERR_INVALID_PARAMETER);
@@ -1193,7 +1193,7 @@ Error Animation::try_position_track_interpolate(int p_track, double p_time, Vect
 	PositionTrack *tt = static_cast<PositionTrack *>(t);
 
 	if (tt->compressed_track >= 0) {
-		if (_pos_scale_interpolate_compressed(tt->compressed_track, p_time, *r_interpolation)) {
+		if (_pos_scale_interpolate_compressed(tt->compressed_track, p_time, *r_interpolation, p_cursor)) {
 			return OK;
 		} else {
 			return ERR_UNAVAILABLE;
@@ -1202,7 +1202,7 @@ Error Animation::try_position_track_interpolate(int p_track, double p_time, Vect
 
 	bool ok = false;
 
-	Vector3 tk = _interpolate(tt->positions, p_time, tt->interpolation, tt->loop_wrap, &ok, p_backward);
+	Vector3 tk = _interpolate(tt->positions, p_time, tt->interpolation, tt->loop_wrap, &ok, p_backward, p_cursor);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -1265,7 +1265,7 @@ Error Animation::rotation_track_get_key(int p_track, int p_key, Quaternion *r_ro
 	return OK;
 }
 
-Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, bool p_backward) const {
+Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, bool p_backward, TrackCursor *p_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_ROTATION_3D, ERR_INVALID_PARAMETER);
@@ -1273,7 +1273,7 @@ Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quat
 	RotationTrack *rt = static_cast<RotationTrack *>(t);
 
 	if (rt->compressed_track >= 0) {
-		if (_rotation_interpolate_compressed(rt->compressed_track, p_time, *r_interpolation)) {
+		if (_rotation_interpolate_compressed(rt->compressed_track, p_time, *r_interpolation, p_cursor)) {
 			return OK;
 		} else {
 			return ERR_UNAVAILABLE;
@@ -1282,7 +1282,7 @@ Error Animation::try_rotation_track_interpolate(int p_track, double p_time, Quat
 
 	bool ok = false;
 
-	Quaternion tk = _interpolate(rt->rotations, p_time, rt->interpolation, rt->loop_wrap, &ok, p_backward);
+	Quaternion tk = _interpolate(rt->rotations, p_time, rt->interpolation, rt->loop_wrap, &ok, p_backward, p_cursor);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -1345,7 +1345,7 @@ Error Animation::scale_track_get_key(int p_track, int p_key, Vector3 *r_scale) c
 	return OK;
 }
 
-Error Animation::try_scale_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward) const {
+Error Animation::try_scale_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, bool p_backward, TrackCursor *p_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_SCALE_3D, ERR_INVALID_PARAMETER);
@@ -1353,7 +1353,7 @@ Error Animation::try_scale_track_interpolate(int p_track, double p_time, Vector3
 	ScaleTrack *st = static_cast<ScaleTrack *>(t);
 
 	if (st->compressed_track >= 0) {
-		if (_pos_scale_interpolate_compressed(st->compressed_track, p_time, *r_interpolation)) {
+		if (_pos_scale_interpolate_compressed(st->compressed_track, p_time, *r_interpolation, p_cursor)) {
 			return OK;
 		} else {
 			return ERR_UNAVAILABLE;
@@ -1362,7 +1362,7 @@ Error Animation::try_scale_track_interpolate(int p_track, double p_time, Vector3
 
 	bool ok = false;
 
-	Vector3 tk = _interpolate(st->scales, p_time, st->interpolation, st->loop_wrap, &ok, p_backward);
+	Vector3 tk = _interpolate(st->scales, p_time, st->interpolation, st->loop_wrap, &ok, p_backward, p_cursor);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -1425,7 +1425,7 @@ Error Animation::blend_shape_track_get_key(int p_track, int p_key, float *r_blen
 	return OK;
 }
 
-Error Animation::try_blend_shape_track_interpolate(int p_track, double p_time, float *r_interpolation, bool p_backward) const {
+Error Animation::try_blend_shape_track_interpolate(int p_track, double p_time, float *r_interpolation, bool p_backward, TrackCursor *p_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_BLEND_SHAPE, ERR_INVALID_PARAMETER);
@@ -1433,7 +1433,7 @@ Error Animation::try_blend_shape_track_interpolate(int p_track, double p_time, f
 	BlendShapeTrack *bst = static_cast<BlendShapeTrack *>(t);
 
 	if (bst->compressed_track >= 0) {
-		if (_blend_shape_interpolate_compressed(bst->compressed_track, p_time, *r_interpolation)) {
+		if (_blend_shape_interpolate_compressed(bst->compressed_track, p_time, *r_interpolation, p_cursor)) {
 			return OK;
 		} else {
 			return ERR_UNAVAILABLE;
@@ -1442,7 +1442,7 @@ Error Animation::try_blend_shape_track_interpolate(int p_track, double p_time, f
 
 	bool ok = false;
 
-	float tk = _interpolate(bst->blend_shapes, p_time, bst->interpolation, bst->loop_wrap, &ok, p_backward);
+	float tk = _interpolate(bst->blend_shapes, p_time, bst->interpolation, bst->loop_wrap, &ok, p_backward, p_cursor);
 
 	if (!ok) {
 		return ERR_UNAVAILABLE;
@@ -2452,6 +2452,39 @@ int Animation::_find(const Vector<K> &p_keys, double p_time, bool p_backward, bo
 	return middle;
 }
 
+template <typename K>
+int Animation::_find_from_cursor(const Vector<K> &p_keys, double p_time, bool p_backward, TrackCursor *p_cursor) const {
+	// Same result as _find(), but first tries the key found last time and the few keys after it.
+	const int len = p_keys.size();
+	const K *keys = p_keys.ptr();
+	int idx = p_cursor->key;
+	if (len > 0) {
+		for (int step = 0; step < 4; step++) {
+			// Going forward, the key found is the last one not after p_time (-1 if none).
+			// Going backward, it is the first one not before p_time (len if none).
+			int before = p_backward ? idx - 1 : idx;
+			int after = before + 1;
+			if (before < -1 || before >= len) {
+				break;
+			}
+			bool before_ok = before < 0 || keys[before].time < p_time || Math::is_equal_approx(p_time, (double)keys[before].time);
+			bool after_ok = after >= len || keys[after].time > p_time || Math::is_equal_approx(p_time, (double)keys[after].time);
+			if (before_ok && after_ok) {
+				if (p_backward ? (before >= 0 && Math::is_equal_approx(p_time, (double)keys[before].time)) : (after < len && Math::is_equal_approx(p_time, (double)keys[after].time))) {
+					idx = p_backward ? before : after; // A key at p_time is always the one found.
+				}
+				p_cursor->key = idx;
+				return idx;
+			}
+			idx += before_ok ? 1 : -1;
+		}
+	}
+
+	idx = _find(p_keys, p_time, p_backward);
+	p_cursor->key = idx;
+	return idx;
+}
+
 // Linear interpolation for anytype.
 
 Vector3 Animation::_interpolate(const Vector3 &p_a, const Vector3 &p_b, real_t p_c) const {
@@ -2521,8 +2554,13 @@ Variant Animation::_cubic_interpolate_angle_in_time(const Variant &p_pre_a, cons
 }
 
 template <typename T>
-T Animation::_interpolate(const Vector<TKey<T>> &p_keys, double p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, bool p_backward) const {
-	int len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+T Animation::_interpolate(const Vector<TKey<T>> &p_keys, double p_time, InterpolationType p_interp, bool p_loop_wrap, bool *p_ok, bool p_backward, TrackCursor *p_cursor) const {
+	int len;
+	if (!p_keys.is_empty() && p_keys[p_keys.size() - 1].time < length) {
+		len = p_keys.size(); // All keys are inside the animation.
+	} else {
+		len = _find(p_keys, length) + 1; // try to find last key (there may be more past the end)
+	}
 
 	if (len <= 0) {
 		// (-1 or -2 returned originally) (plus one above)
@@ -2539,7 +2577,7 @@ T Animation::_interpolate(const Vector<TKey<T>> &p_keys, double p_time, Interpol
 		return p_keys[0].value;
 	}
 
-	int idx = _find(p_keys, p_time, p_backward);
+	int idx = p_cursor ? _find_from_cursor(p_keys, p_time, p_backward, p_cursor) : _find(p_keys, p_time, p_backward);
 
 	ERR_FAIL_COND_V(idx == -2, T());
 	int maxi = len - 1;
@@ -5212,13 +5250,13 @@ void Animation::compress(uint32_t p_page_size, uint32_t p_fps, float p_split_tol
 #endif
 }
 
-bool Animation::_rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret) const {
+bool Animation::_rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret, TrackCursor *p_cursor) const {
 	Vector3i current;
 	Vector3i next;
 	double time_current;
 	double time_next;
 
-	if (!_fetch_compressed<3>(p_compressed_track, p_time, current, time_current, next, time_next)) {
+	if (!_fetch_compressed<3>(p_compressed_track, p_time, current, time_current, next, time_next, nullptr, p_cursor)) {
 		return false; //some sort of problem
 	}
 
@@ -5236,13 +5274,13 @@ bool Animation::_rotation_interpolate_compressed(uint32_t p_compressed_track, do
 	return true;
 }
 
-bool Animation::_pos_scale_interpolate_compressed(uint32_t p_compressed_track, double p_time, Vector3 &r_ret) const {
+bool Animation::_pos_scale_interpolate_compressed(uint32_t p_compressed_track, double p_time, Vector3 &r_ret, TrackCursor *p_cursor) const {
 	Vector3i current;
 	Vector3i next;
 	double time_current;
 	double time_next;
 
-	if (!_fetch_compressed<3>(p_compressed_track, p_time, current, time_current, next, time_next)) {
+	if (!_fetch_compressed<3>(p_compressed_track, p_time, current, time_current, next, time_next, nullptr, p_cursor)) {
 		return false; //some sort of problem
 	}
 
@@ -5259,13 +5297,13 @@ bool Animation::_pos_scale_interpolate_compressed(uint32_t p_compressed_track, d
 
 	return true;
 }
-bool Animation::_blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret) const {
+bool Animation::_blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret, TrackCursor *p_cursor) const {
 	Vector3i current;
 	Vector3i next;
 	double time_current;
 	double time_next;
 
-	if (!_fetch_compressed<1>(p_compressed_track, p_time, current, time_current, next, time_next)) {
+	if (!_fetch_compressed<1>(p_compressed_track, p_time, current, time_current, next, time_next, nullptr, p_cursor)) {
 		return false; //some sort of problem
 	}
 
@@ -5284,18 +5322,30 @@ bool Animation::_blend_shape_interpolate_compressed(uint32_t p_compressed_track,
 }
 
 template <uint32_t COMPONENTS>
-bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index) const {
+bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index, TrackCursor *p_cursor) const {
 	ERR_FAIL_COND_V(!compression.enabled, false);
 	ERR_FAIL_UNSIGNED_INDEX_V(p_compressed_track, compression.bounds.size(), false);
 	p_time = CLAMP(p_time, 0, length);
 	if (key_index) {
 		*key_index = 0;
+		p_cursor = nullptr; // Counting keys needs all the previous ones.
+	}
+	if (p_cursor && p_cursor->compressed_track != int32_t(p_compressed_track)) {
+		p_cursor->compressed_track = p_compressed_track;
+		p_cursor->page = -1;
+		p_cursor->packet = -1;
+		p_cursor->decoded = 0;
 	}
 
 	double frame_to_sec = 1.0 / double(compression.fps);
 
 	int32_t page_index = -1;
-	for (uint32_t i = 0; i < compression.pages.size(); i++) {
+	uint32_t first_page = 0;
+	if (p_cursor && p_cursor->page >= 0 && uint32_t(p_cursor->page) < compression.pages.size() && compression.pages[p_cursor->page].time_offset <= p_time) {
+		first_page = p_cursor->page; // Pages are sorted by time, so the search can start from the last page found.
+		page_index = p_cursor->page;
+	}
+	for (uint32_t i = first_page; i < compression.pages.size(); i++) {
 		if (compression.pages[i].time_offset > p_time) {
 			break;
 		}
@@ -5314,8 +5364,28 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Ve
 	int32_t packet_idx = 0;
 	double packet_time = double(time_keys[0]) * frame_to_sec + page_base_time;
 	uint32_t base_frame = time_keys[0];
+	uint32_t first_packet = 1;
+
+	if (p_cursor) {
+		if (p_cursor->page != page_index || p_cursor->page_data != page_data) {
+			p_cursor->page = page_index;
+			p_cursor->page_data = page_data;
+			p_cursor->packet = -1;
+			p_cursor->decoded = 0;
+		} else if (p_cursor->packet > 0 && uint32_t(p_cursor->packet) < time_key_count) {
+			// Time keys are sorted too, so start from the last one found if it is not after p_time.
+			uint32_t f = time_keys[p_cursor->packet * 2 + 0];
+			double frame_time = double(f) * frame_to_sec + page_base_time;
+			if (frame_time <= p_time) {
+				packet_idx = p_cursor->packet;
+				packet_time = frame_time;
+				base_frame = f;
+				first_packet = packet_idx + 1;
+			}
+		}
+	}
 
-	for (uint32_t i = 1; i < time_key_count; i++) {
+	for (uint32_t i = first_packet; i < time_key_count; i++) {
 		uint32_t f = time_keys[i * 2 + 0];
 		double frame_time = double(f) * frame_to_sec + page_base_time;
 
@@ -5332,6 +5402,11 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Ve
 		base_frame = f;
 	}
 
+	if (p_cursor && p_cursor->packet != packet_idx) {
+		p_cursor->packet = packet_idx;
+		p_cursor->decoded = 0;
+	}
+
 	const uint8_t *data_keys_base = (const uint8_t *)&page_data[indices[p_compressed_track * 3 + 2]];
 
 	uint16_t time_key_data = time_keys[packet_idx * 2 + 1];
@@ -5364,7 +5439,26 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Ve
 
 			buffer.src_data = (const uint8_t *)&data_key[COMPONENTS + 1];
 
-			for (uint32_t i = 1; i < data_count; i++) {
+			uint32_t first_key = 1;
+			if (p_cursor && p_cursor->packet == packet_idx && p_cursor->decoded > 0 && p_cursor->decoded < data_count && p_cursor->decoded_time <= p_time) {
+				// Keys in a packet are delta encoded, so continue decoding after the last key decoded, instead of from the first one.
+				base_frame = p_cursor->decoded_frame;
+				packet_time = p_cursor->decoded_time;
+				for (uint32_t j = 0; j < COMPONENTS; j++) {
+					decode[j] = p_cursor->decoded_value[j];
+					decode_next[j] = p_cursor->decoded_value[j];
+				}
+				buffer.buffer = p_cursor->decoder_buffer;
+				buffer.used = p_cursor->decoder_used;
+				buffer.src_data = p_cursor->decoder_src;
+				first_key = p_cursor->decoded + 1;
+			}
+
+			uint32_t decoded = 0;
+			uint32_t decoded_frame = 0;
+			AnimationCompressionBufferBitsRead decoded_buffer;
+
+			for (uint32_t i = first_key; i < data_count; i++) {
 				uint32_t frame_delta = buffer.read(frame_bit_width);
 				base_frame += frame_delta;
 
@@ -5396,6 +5490,22 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Ve
 				if (key_index) {
 					(*key_index)++;
 				}
+
+				decoded = i;
+				decoded_frame = base_frame;
+				decoded_buffer = buffer;
+			}
+
+			if (p_cursor && decoded > 0) {
+				p_cursor->decoded = decoded;
+				p_cursor->decoded_frame = decoded_frame;
+				p_cursor->decoded_time = packet_time;
+				for (uint32_t j = 0; j < COMPONENTS; j++) {
+					p_cursor->decoded_value[j] = decode[j];
+				}
+				p_cursor->decoder_buffer = decoded_buffer.buffer;
+				p_cursor->decoder_used = decoded_buffer.used;
+				p_cursor->decoder_src = decoded_buffer.src_data;
 			}
 		}
 
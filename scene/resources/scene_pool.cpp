@@ -0,0 +1,237 @@
+/**************************************************************************/
+/*  scene_pool.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+
+#include "scene_pool.h"
+
+#include "scene/main/node.h"
+
+Node *ScenePool::_instantiate() {
+	Node *instance = scene->instantiate();
+	ERR_FAIL_NULL_V_MSG(instance, nullptr, vformat("Failed to instantiate the pooled scene '%s'.", scene->get_path()));
+	if (!defaults_captured) {
+		_capture_defaults(instance);
+	}
+	return instance;
+}
+
+void ScenePool::_capture_defaults(Node *p_instance) {
+	// Only the nodes created by the scene are reset, the stored properties of the other ones belong to their own scene.
+	Ref<SceneState> state = scene->get_state();
+	defaults.clear();
+	for (int i = 0; i < state->get_node_count(); i++) {
+		NodeDefaults node_defaults;
+		node_defaults.path = state->get_node_path(i);
+		Node *node = p_instance->get_node_or_null(node_defaults.path);
+		if (!node) {
+			continue;
+		}
+
+		List<PropertyInfo> properties;
+		node->get_property_list(&properties);
+		for (const PropertyInfo &E : properties) {
+			// Setting the script again would recreate the script instance.
+			if (!(E.usage & PROPERTY_USAGE_STORAGE) || E.name == CoreStringName(script)) {
+				continue;
+			}
+			Variant value = node->get(E.name);
+			if (value.get_type() == Variant::ARRAY || value.get_type() == Variant::DICTIONARY) {
+				value = value.duplicate(true);
+			}
+			node_defaults.properties.push_back(Pair<StringName, Variant>(E.name, value));
+		}
+		defaults.push_back(node_defaults);
+	}
+	defaults_captured = true;
+}
+
+void ScenePool::_reset_instance(Node *p_instance) const {
+	for (const NodeDefaults &node_defaults : defaults) {
+		Node *node = p_instance->get_node_or_null(node_defaults.path);
+		if (!node) {
+			continue;
+		}
+		for (const Pair<StringName, Variant> &property : node_defaults.properties) {
+			if (property.second.get_type() == Variant::ARRAY || property.second.get_type() == Variant::DICTIONARY) {
+				// Containers are shared by reference, don't let the instance modify the defaults.
+				node->set(property.first, property.second.duplicate(true));
+			} else {
+				node->set(property.first, property.second);
+			}
+		}
+	}
+}
+
+void ScenePool::_prune_acquired() {
+	// Instances freed instead of being released are forgotten here.
+	LocalVector<ObjectID> freed;
+	for (const ObjectID &id : acquired) {
+		if (!ObjectDB::get_instance(id)) {
+			freed.push_back(id);
+		}
+	}
+	for (const ObjectID &id : freed) {
+		acquired.erase(id);
+	}
+	acquired_prune_size = MAX(64u, acquired.size() * 2);
+}
+
+void ScenePool::set_scene(const Ref<PackedScene> &p_scene) {
+	if (scene == p_scene) {
+		return;
+	}
+	clear();
+	acquired.clear();
+	defaults.clear();
+	defaults_captured = false;
+	scene = p_scene;
+	emit_changed();
+}
+
+Ref<PackedScene> ScenePool::get_scene() const {
+	return scene;
+}
+
+void ScenePool::set_capacity(int p_capacity) {
+	ERR_FAIL_COND(p_capacity < 0);
+	capacity = p_capacity;
+	while ((int)available.size() > capacity) {
+		memdelete(available[available.size() - 1]);
+		available.remove_at(available.size() - 1);
+	}
+	emit_changed();
+}
+
+int ScenePool::get_capacity() const {
+	return capacity;
+}
+
+void ScenePool::fill() {
+	ERR_FAIL_COND_MSG(scene.is_null(), "No scene is set to the pool.");
+	while ((int)available.size() < capacity) {
+		Node *instance = _instantiate();
+		ERR_FAIL_NULL(instance);
+		available.push_back(instance);
+	}
+}
+
+Node *ScenePool::acquire() {
+	ERR_FAIL_COND_V_MSG(scene.is_null(), nullptr, "No scene is set to the pool.");
+
+	Node *instance = nullptr;
+	if (available.is_empty()) {
+		instance = _instantiate();
+		ERR_FAIL_NULL_V(instance, nullptr);
+		miss_count++;
+	} else {
+		instance = available[available.size() - 1];
+		available.remove_at(available.size() - 1);
+		hit_count++;
+	}
+
+	if (acquired.size() >= acquired_prune_size) {
+		_prune_acquired();
+	}
+	acquired.insert(instance->get_instance_id());
+	return instance;
+}
+
+void ScenePool::release(Node *p_node) {
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(!acquired.erase(p_node->get_instance_id()), vformat("Node '%s' was not acquired from this pool.", p_node->get_name()));
+	// It will be freed at the end of the frame, it can't be reused.
+	ERR_FAIL_COND_MSG(p_node->is_queued_for_deletion(), vformat("Node '%s' can't be released, it's queued for deletion.", p_node->get_name()));
+
+	Node *parent = p_node->get_parent();
+	if (parent) {
+		parent->remove_child(p_node);
+		if (unlikely(p_node->get_parent())) {
+			// The parent is busy, or this isn't the main thread. Keep it acquired so it can be released later.
+			acquired.insert(p_node->get_instance_id());
+			ERR_FAIL_MSG(vformat("Node '%s' can't be released, it couldn't be removed from its parent. Consider using `release.call_deferred(node)` instead.", p_node->get_name()));
+		}
+	}
+
+	if ((int)available.size() >= capacity) {
+		memdelete(p_node);
+		return;
+	}
+
+	_reset_instance(p_node);
+	available.push_back(p_node);
+}
+
+void ScenePool::clear() {
+	for (Node *instance : available) {
+		memdelete(instance);
+	}
+	available.clear();
+}
+
+int ScenePool::get_available_count() const {
+	return available.size();
+}
+
+uint64_t ScenePool::get_hit_count() const {
+	return hit_count;
+}
+
+uint64_t ScenePool::get_miss_count() const {
+	return miss_count;
+}
+
+void ScenePool::reset_metrics() {
+	hit_count = 0;
+	miss_count = 0;
+}
+
+void ScenePool::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_scene", "scene"), &ScenePool::set_scene);
+	ClassDB::bind_method(D_METHOD("get_scene"), &ScenePool::get_scene);
+	ClassDB::bind_method(D_METHOD("set_capacity", "capacity"), &ScenePool::set_capacity);
+	ClassDB::bind_method(D_METHOD("get_capacity"), &ScenePool::get_capacity);
+
+	ClassDB::bind_method(D_METHOD("fill"), &ScenePool::fill);
+	ClassDB::bind_method(D_METHOD("acquire"), &ScenePool::acquire);
+	ClassDB::bind_method(D_METHOD("release", "node"), &ScenePool::release);
+	ClassDB::bind_method(D_METHOD("clear"), &ScenePool::clear);
+
+	ClassDB::bind_method(D_METHOD("get_available_count"), &ScenePool::get_available_count);
+	ClassDB::bind_method(D_METHOD("get_hit_count"), &ScenePool::get_hit_count);
+	ClassDB::bind_method(D_METHOD("get_miss_count"), &ScenePool::get_miss_count);
+	ClassDB::bind_method(D_METHOD("reset_metrics"), &ScenePool::reset_metrics);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "scene", PROPERTY_HINT_RESOURCE_TYPE, "PackedScene"), "set_scene", "get_scene");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "capacity", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"), "set_capacity", "get_capacity");
+}
+
+ScenePool::~ScenePool() {
+	clear();
+}
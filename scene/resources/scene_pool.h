@@ -0,0 +1,89 @@
+/**************************************************************************/
+/*  scene_pool.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+
+#ifndef SCENE_POOL_H
+#define SCENE_POOL_H
+
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+#include "scene/resources/packed_scene.h"
+
+class ScenePool : public Resource {
+	GDCLASS(ScenePool, Resource);
+
+	// Values of the stored properties of a node of the scene, as they are right after instantiation.
+	struct NodeDefaults {
+		NodePath path;
+		LocalVector<Pair<StringName, Variant>> properties;
+	};
+
+	Ref<PackedScene> scene;
+	int capacity = 16;
+
+	LocalVector<Node *> available;
+	HashSet<ObjectID> acquired; // Instances that can be released back to the pool.
+	uint32_t acquired_prune_size = 64;
+	LocalVector<NodeDefaults> defaults;
+	bool defaults_captured = false;
+
+	uint64_t hit_count = 0;
+	uint64_t miss_count = 0;
+
+	Node *_instantiate();
+	void _capture_defaults(Node *p_instance);
+	void _reset_instance(Node *p_instance) const;
+	void _prune_acquired();
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_scene(const Ref<PackedScene> &p_scene);
+	Ref<PackedScene> get_scene() const;
+	void set_capacity(int p_capacity);
+	int get_capacity() const;
+
+	void fill();
+	Node *acquire();
+	void release(Node *p_node);
+	void clear();
+
+	int get_available_count() const;
+	uint64_t get_hit_count() const;
+	uint64_t get_miss_count() const;
+	void reset_metrics();
+
+	ScenePool() {}
+	~ScenePool();
+};
+
+#endif // SCENE_POOL_H
@@ -104,6 +104,8 @@ public:
 	virtual Variant shader_get_parameter_default(RID p_material, const StringName &p_param) const override { return Variant(); }
 
 	virtual RS::ShaderNativeSourceCode shader_get_native_source_code(RID p_shader) const override { return RS::ShaderNativeSourceCode(); }
+	virtual bool shader_is_compiled(RID p_shader) const override { return true; }
+	virtual void shader_request_compiled_callback(RID p_shader, const Callable &p_callable) override { p_callable.call(); }
 
 	/* MATERIAL API */
 
@@ -274,6 +274,7 @@ public:
 		}
 
 		virtual void set_code(const String &p_Code);
+		virtual bool is_set_code_thread_safe() const { return true; }
 
 		virtual bool is_animated() const;
 		virtual bool casts_shadows() const;
@@ -143,9 +143,10 @@ void SceneShaderForwardMobile::ShaderData::set_code(const String &p_code) {
 
 	actions.uniforms = &uniforms;
 
-	MutexLock lock(SceneShaderForwardMobile::singleton_mutex);
+	// The compiler is thread-safe, only the shader versions need the lock.
 	Error err = SceneShaderForwardMobile::singleton->compiler.compile(RS::SHADER_SPATIAL, code, &actions, path, gen_code);
 
+	MutexLock lock(SceneShaderForwardMobile::singleton_mutex);
 	if (err != OK) {
 		if (version.is_valid()) {
 			SceneShaderForwardMobile::singleton->shader.version_free(version);
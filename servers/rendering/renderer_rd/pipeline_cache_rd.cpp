@@ -33,15 +33,14 @@
 #include "pipeline_cache_rd.h"
 
 #include "core/os/memory.h"
+#include "servers/rendering/renderer_rd/pipeline_manifest_rd.h"
 
-RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+RID PipelineCacheRD::_create_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
 	RD::PipelineMultisampleState multisample_state_version = multisample_state;
 	multisample_state_version.sample_count = RD::get_singleton()->framebuffer_format_get_texture_samples(p_framebuffer_format_id, p_render_pass);
 
-	bool wireframe = p_wireframe;
-
 	RD::PipelineRasterizationState raster_state_version = rasterization_state;
-	raster_state_version.wireframe = wireframe;
+	raster_state_version.wireframe = p_wireframe;
 
 	Vector<RD::PipelineSpecializationConstant> specialization_constants = base_specialization_constants;
 
@@ -59,21 +58,202 @@ RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD
 		bool_index++;
 	}
 
-	RID pipeline = RD::get_singleton()->render_pipeline_create(shader, p_framebuffer_format_id, p_vertex_format_id, render_primitive, raster_state_version, multisample_state_version, depth_stencil_state, blend_state, dynamic_state_flags, p_render_pass, specialization_constants);
+	return RD::get_singleton()->render_pipeline_create(shader, p_framebuffer_format_id, p_vertex_format_id, render_primitive, raster_state_version, multisample_state_version, depth_stencil_state, blend_state, dynamic_state_flags, p_render_pass, specialization_constants);
+}
+
+RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	RID pipeline = _create_pipeline(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
 	ERR_FAIL_COND_V(pipeline.is_null(), RID());
 	versions = static_cast<Version *>(memrealloc(versions, sizeof(Version) * (version_count + 1)));
 	versions[version_count].framebuffer_id = p_framebuffer_format_id;
 	versions[version_count].vertex_id = p_vertex_format_id;
-	versions[version_count].wireframe = wireframe;
+	versions[version_count].wireframe = p_wireframe;
 	versions[version_count].pipeline = pipeline;
 	versions[version_count].render_pass = p_render_pass;
 	versions[version_count].bool_specializations = p_bool_specializations;
 	version_count++;
+
+	if (manifest_key != 0) {
+		_record_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+	}
 	return pipeline;
 }
 
+void PipelineCacheRD::_record_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	PipelineManifestRD *manifest = PipelineManifestRD::get_singleton();
+	if (!manifest) {
+		return;
+	}
+
+	PipelineManifestRD::Entry entry;
+	if (!RD::get_singleton()->framebuffer_format_get_description(p_framebuffer_format_id, entry.attachments, entry.passes, entry.view_count)) {
+		return;
+	}
+	entry.samples = RD::get_singleton()->framebuffer_format_get_texture_samples(p_framebuffer_format_id, 0);
+	entry.has_vertex_format = p_vertex_format_id != RD::INVALID_ID;
+	if (entry.has_vertex_format) {
+		entry.vertex_attributes = RD::get_singleton()->vertex_format_get_description(p_vertex_format_id);
+	}
+	entry.render_pass = p_render_pass;
+	entry.wireframe = p_wireframe;
+	entry.bool_specializations = p_bool_specializations;
+	manifest->record(manifest_key, entry);
+}
+
+uint64_t PipelineCacheRD::_compute_manifest_key() const {
+	uint64_t h = RD::get_singleton()->shader_get_binary_hash(shader);
+	if (h == 0) {
+		return 0;
+	}
+
+	h = hash_djb2_one_64(render_primitive, h);
+
+	h = hash_djb2_one_64(rasterization_state.enable_depth_clamp, h);
+	h = hash_djb2_one_64(rasterization_state.discard_primitives, h);
+	h = hash_djb2_one_64(rasterization_state.wireframe, h);
+	h = hash_djb2_one_64(rasterization_state.cull_mode, h);
+	h = hash_djb2_one_64(rasterization_state.front_face, h);
+	h = hash_djb2_one_64(rasterization_state.depth_bias_enabled, h);
+	h = hash_djb2_one_float_64(rasterization_state.depth_bias_constant_factor, h);
+	h = hash_djb2_one_float_64(rasterization_state.depth_bias_clamp, h);
+	h = hash_djb2_one_float_64(rasterization_state.depth_bias_slope_factor, h);
+	h = hash_djb2_one_float_64(rasterization_state.line_width, h);
+	h = hash_djb2_one_64(rasterization_state.patch_control_points, h);
+
+	h = hash_djb2_one_64(multisample_state.sample_count, h);
+	h = hash_djb2_one_64(multisample_state.enable_sample_shading, h);
+	h = hash_djb2_one_float_64(multisample_state.min_sample_shading, h);
+	for (uint32_t mask : multisample_state.sample_mask) {
+		h = hash_djb2_one_64(mask, h);
+	}
+	h = hash_djb2_one_64(multisample_state.enable_alpha_to_coverage, h);
+	h = hash_djb2_one_64(multisample_state.enable_alpha_to_one, h);
+
+	h = hash_djb2_one_64(depth_stencil_state.enable_depth_test, h);
+	h = hash_djb2_one_64(depth_stencil_state.enable_depth_write, h);
+	h = hash_djb2_one_64(depth_stencil_state.depth_compare_operator, h);
+	h = hash_djb2_one_64(depth_stencil_state.enable_depth_range, h);
+	h = hash_djb2_one_float_64(depth_stencil_state.depth_range_min, h);
+	h = hash_djb2_one_float_64(depth_stencil_state.depth_range_max, h);
+	h = hash_djb2_one_64(depth_stencil_state.enable_stencil, h);
+	const RD::PipelineDepthStencilState::StencilOperationState *stencil_ops[2] = { &depth_stencil_state.front_op, &depth_stencil_state.back_op };
+	for (const RD::PipelineDepthStencilState::StencilOperationState *op : stencil_ops) {
+		h = hash_djb2_one_64(op->fail, h);
+		h = hash_djb2_one_64(op->pass, h);
+		h = hash_djb2_one_64(op->depth_fail, h);
+		h = hash_djb2_one_64(op->compare, h);
+		h = hash_djb2_one_64(op->compare_mask, h);
+		h = hash_djb2_one_64(op->write_mask, h);
+		h = hash_djb2_one_64(op->reference, h);
+	}
+
+	h = hash_djb2_one_64(blend_state.enable_logic_op, h);
+	h = hash_djb2_one_64(blend_state.logic_op, h);
+	for (const RD::PipelineColorBlendState::Attachment &attachment : blend_state.attachments) {
+		h = hash_djb2_one_64(attachment.enable_blend, h);
+		h = hash_djb2_one_64(attachment.src_color_blend_factor, h);
+		h = hash_djb2_one_64(attachment.dst_color_blend_factor, h);
+		h = hash_djb2_one_64(attachment.color_blend_op, h);
+		h = hash_djb2_one_64(attachment.src_alpha_blend_factor, h);
+		h = hash_djb2_one_64(attachment.dst_alpha_blend_factor, h);
+		h = hash_djb2_one_64(attachment.alpha_blend_op, h);
+		h = hash_djb2_one_64(attachment.write_r, h);
+		h = hash_djb2_one_64(attachment.write_g, h);
+		h = hash_djb2_one_64(attachment.write_b, h);
+		h = hash_djb2_one_64(attachment.write_a, h);
+	}
+	h = hash_djb2_one_float_64(blend_state.blend_constant.r, h);
+	h = hash_djb2_one_float_64(blend_state.blend_constant.g, h);
+	h = hash_djb2_one_float_64(blend_state.blend_constant.b, h);
+	h = hash_djb2_one_float_64(blend_state.blend_constant.a, h);
+
+	h = hash_djb2_one_64(dynamic_state_flags, h);
+
+	for (const RD::PipelineSpecializationConstant &sc : base_specialization_constants) {
+		h = hash_djb2_one_64(sc.type, h);
+		h = hash_djb2_one_64(sc.constant_id, h);
+		h = hash_djb2_one_64(sc.int_value, h);
+	}
+
+	// 0 means "not recorded".
+	return h != 0 ? h : 1;
+}
+
+void PipelineCacheRD::_precompile_version(uint32_t p_index, const PrecompileVersion *p_versions) {
+	const PrecompileVersion &version = p_versions[p_index];
+	RID pipeline = _create_pipeline(version.vertex_id, version.framebuffer_id, version.wireframe, version.render_pass, version.bool_specializations);
+	if (pipeline.is_null()) {
+		return;
+	}
+
+	spin_lock.lock();
+	for (uint32_t i = 0; i < version_count; i++) {
+		if (versions[i].vertex_id == version.vertex_id && versions[i].framebuffer_id == version.framebuffer_id && versions[i].wireframe == version.wireframe && versions[i].render_pass == version.render_pass && versions[i].bool_specializations == version.bool_specializations) {
+			// Was requested for drawing while we were compiling it.
+			spin_lock.unlock();
+			RD::get_singleton()->free(pipeline);
+			return;
+		}
+	}
+	versions = static_cast<Version *>(memrealloc(versions, sizeof(Version) * (version_count + 1)));
+	versions[version_count].framebuffer_id = version.framebuffer_id;
+	versions[version_count].vertex_id = version.vertex_id;
+	versions[version_count].wireframe = version.wireframe;
+	versions[version_count].pipeline = pipeline;
+	versions[version_count].render_pass = version.render_pass;
+	versions[version_count].bool_specializations = version.bool_specializations;
+	version_count++;
+	spin_lock.unlock();
+}
+
+void PipelineCacheRD::_precompile() {
+	PipelineManifestRD *manifest = PipelineManifestRD::get_singleton();
+	manifest_key = manifest ? _compute_manifest_key() : 0;
+	if (manifest_key == 0) {
+		return;
+	}
+
+	Vector<PipelineManifestRD::Entry> entries = manifest->get_entries(manifest_key);
+	if (entries.is_empty()) {
+		return;
+	}
+
+	// Format IDs are only valid for this session, so create them again from their description.
+	RD *rd = RD::get_singleton();
+	for (const PipelineManifestRD::Entry &entry : entries) {
+		PrecompileVersion version;
+		version.vertex_id = entry.has_vertex_format ? rd->vertex_format_create(entry.vertex_attributes) : RD::INVALID_ID;
+		if (entry.attachments.is_empty()) {
+			version.framebuffer_id = rd->framebuffer_format_create_empty(entry.samples);
+		} else {
+			version.framebuffer_id = rd->framebuffer_format_create_multipass(entry.attachments, entry.passes, entry.view_count);
+		}
+		if (version.framebuffer_id == RD::INVALID_ID || (entry.has_vertex_format && version.vertex_id == RD::INVALID_ID)) {
+			continue;
+		}
+		version.render_pass = entry.render_pass;
+		version.wireframe = entry.wireframe;
+		version.bool_specializations = entry.bool_specializations;
+		precompile_versions.push_back(version);
+	}
+
+	if (!precompile_versions.is_empty()) {
+		precompile_group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &PipelineCacheRD::_precompile_version, (const PrecompileVersion *)precompile_versions.ptr(), precompile_versions.size(), -1, false, SNAME("PipelineCacheRDPrecompile"));
+	}
+}
+
+void PipelineCacheRD::_precompile_wait() {
+	if (precompile_group != -1) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(precompile_group);
+		precompile_group = -1;
+	}
+	precompile_versions.clear();
+}
+
 void PipelineCacheRD::_clear() {
 	// TODO: Clear should probably recompile all the variants already compiled instead to avoid stalls? Needs discussion.
+	_precompile_wait();
+	manifest_key = 0;
 	if (versions) {
 		for (uint32_t i = 0; i < version_count; i++) {
 			//shader may be gone, so this may not be valid
@@ -98,10 +278,12 @@ void PipelineCacheRD::setup(RID p_shader, RD::RenderPrimitive p_primitive, const
 	blend_state = p_blend_state;
 	dynamic_state_flags = p_dynamic_state_flags;
 	base_specialization_constants = p_base_specialization_constants;
+	_precompile();
 }
 void PipelineCacheRD::update_specialization_constants(const Vector<RD::PipelineSpecializationConstant> &p_base_specialization_constants) {
-	base_specialization_constants = p_base_specialization_constants;
 	_clear();
+	base_specialization_constants = p_base_specialization_constants;
+	_precompile();
 }
 
 void PipelineCacheRD::update_shader(RID p_shader) {
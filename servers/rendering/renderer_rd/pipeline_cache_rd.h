@@ -33,7 +33,9 @@
 #ifndef PIPELINE_CACHE_RD_H
 #define PIPELINE_CACHE_RD_H
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/spin_lock.h"
+#include "core/templates/local_vector.h"
 #include "servers/rendering/rendering_device.h"
 
 class PipelineCacheRD {
@@ -61,7 +63,29 @@ class PipelineCacheRD {
 	Version *versions = nullptr;
 	uint32_t version_count;
 
+	// Identifies the shader and fixed state in the pipeline manifest, 0 if not recorded.
+	uint64_t manifest_key = 0;
+
+	// Versions recorded by a previous session, created on worker threads after setup.
+	struct PrecompileVersion {
+		RD::VertexFormatID vertex_id;
+		RD::FramebufferFormatID framebuffer_id;
+		uint32_t render_pass;
+		bool wireframe;
+		uint32_t bool_specializations;
+	};
+
+	LocalVector<PrecompileVersion> precompile_versions;
+	WorkerThreadPool::GroupID precompile_group = -1;
+
+	RID _create_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations);
 	RID _generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations = 0);
+	void _record_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations);
+
+	uint64_t _compute_manifest_key() const;
+	void _precompile_version(uint32_t p_index, const PrecompileVersion *p_versions);
+	void _precompile();
+	void _precompile_wait();
 
 	void _clear();
 
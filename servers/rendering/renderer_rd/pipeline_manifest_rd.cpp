@@ -0,0 +1,335 @@
+/**************************************************************************/
+/*  pipeline_manifest_rd.cpp                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "pipeline_manifest_rd.h"
+
+#include "core/io/file_access.h"
+
+static const char *pipeline_manifest_header = "GDPM";
+
+PipelineManifestRD *PipelineManifestRD::singleton = nullptr;
+
+uint32_t PipelineManifestRD::Entry::hash() const {
+	uint32_t h = hash_murmur3_one_32(has_vertex_format);
+	for (const RD::VertexAttribute &attribute : vertex_attributes) {
+		h = hash_murmur3_one_32(attribute.location, h);
+		h = hash_murmur3_one_32(attribute.offset, h);
+		h = hash_murmur3_one_32(attribute.format, h);
+		h = hash_murmur3_one_32(attribute.stride, h);
+		h = hash_murmur3_one_32(attribute.frequency, h);
+	}
+	for (const RD::AttachmentFormat &attachment : attachments) {
+		h = hash_murmur3_one_32(attachment.format, h);
+		h = hash_murmur3_one_32(attachment.samples, h);
+		h = hash_murmur3_one_32(attachment.usage_flags, h);
+	}
+	for (const RD::FramebufferPass &pass : passes) {
+		for (int32_t attachment : pass.color_attachments) {
+			h = hash_murmur3_one_32(attachment, h);
+		}
+		h = hash_murmur3_one_32(0xFFFFFFFF, h); // Separate the attachment lists.
+		for (int32_t attachment : pass.input_attachments) {
+			h = hash_murmur3_one_32(attachment, h);
+		}
+		h = hash_murmur3_one_32(0xFFFFFFFF, h);
+		for (int32_t attachment : pass.resolve_attachments) {
+			h = hash_murmur3_one_32(attachment, h);
+		}
+		h = hash_murmur3_one_32(0xFFFFFFFF, h);
+		for (int32_t attachment : pass.preserve_attachments) {
+			h = hash_murmur3_one_32(attachment, h);
+		}
+		h = hash_murmur3_one_32(pass.depth_attachment, h);
+		h = hash_murmur3_one_32(pass.vrs_attachment, h);
+	}
+	h = hash_murmur3_one_32(view_count, h);
+	h = hash_murmur3_one_32(samples, h);
+	h = hash_murmur3_one_32(render_pass, h);
+	h = hash_murmur3_one_32(wireframe, h);
+	h = hash_murmur3_one_32(bool_specializations, h);
+	return hash_fmix32(h);
+}
+
+static bool _vertex_attributes_equal(const Vector<RD::VertexAttribute> &p_a, const Vector<RD::VertexAttribute> &p_b) {
+	if (p_a.size() != p_b.size()) {
+		return false;
+	}
+	for (int i = 0; i < p_a.size(); i++) {
+		const RD::VertexAttribute &a = p_a[i];
+		const RD::VertexAttribute &b = p_b[i];
+		if (a.location != b.location || a.offset != b.offset || a.format != b.format || a.stride != b.stride || a.frequency != b.frequency) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool _attachments_equal(const Vector<RD::AttachmentFormat> &p_a, const Vector<RD::AttachmentFormat> &p_b) {
+	if (p_a.size() != p_b.size()) {
+		return false;
+	}
+	for (int i = 0; i < p_a.size(); i++) {
+		if (p_a[i].format != p_b[i].format || p_a[i].samples != p_b[i].samples || p_a[i].usage_flags != p_b[i].usage_flags) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool _passes_equal(const Vector<RD::FramebufferPass> &p_a, const Vector<RD::FramebufferPass> &p_b) {
+	if (p_a.size() != p_b.size()) {
+		return false;
+	}
+	for (int i = 0; i < p_a.size(); i++) {
+		const RD::FramebufferPass &a = p_a[i];
+		const RD::FramebufferPass &b = p_b[i];
+		if (a.color_attachments != b.color_attachments || a.input_attachments != b.input_attachments || a.resolve_attachments != b.resolve_attachments || a.preserve_attachments != b.preserve_attachments || a.depth_attachment != b.depth_attachment || a.vrs_attachment != b.vrs_attachment) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool PipelineManifestRD::Entry::operator==(const Entry &p_entry) const {
+	return has_vertex_format == p_entry.has_vertex_format && view_count == p_entry.view_count && samples == p_entry.samples && render_pass == p_entry.render_pass && wireframe == p_entry.wireframe && bool_specializations == p_entry.bool_specializations && _vertex_attributes_equal(vertex_attributes, p_entry.vertex_attributes) && _attachments_equal(attachments, p_entry.attachments) && _passes_equal(passes, p_entry.passes);
+}
+
+void PipelineManifestRD::record(uint64_t p_key, const Entry &p_entry) {
+	MutexLock lock(mutex);
+	used_keys.insert(p_key);
+	LocalVector<Entry> &key_entries = entries[p_key];
+	for (const Entry &entry : key_entries) {
+		if (entry == p_entry) {
+			return;
+		}
+	}
+	key_entries.push_back(p_entry);
+	dirty = true;
+}
+
+Vector<PipelineManifestRD::Entry> PipelineManifestRD::get_entries(uint64_t p_key) {
+	MutexLock lock(mutex);
+	used_keys.insert(p_key);
+	Vector<Entry> result;
+	const LocalVector<Entry> *key_entries = entries.getptr(p_key);
+	if (key_entries) {
+		for (const Entry &entry : *key_entries) {
+			result.push_back(entry);
+		}
+	}
+	return result;
+}
+
+uint32_t PipelineManifestRD::get_entry_count() const {
+	MutexLock lock(mutex);
+	uint32_t count = 0;
+	for (const KeyValue<uint64_t, LocalVector<Entry>> &E : entries) {
+		count += E.value.size();
+	}
+	return count;
+}
+
+bool PipelineManifestRD::is_dirty() const {
+	MutexLock lock(mutex);
+	return dirty;
+}
+
+void PipelineManifestRD::clear() {
+	MutexLock lock(mutex);
+	entries.clear();
+	unused_sessions.clear();
+	used_keys.clear();
+	dirty = false;
+}
+
+static void _store_int32_vector(const Ref<FileAccess> &p_file, const Vector<int32_t> &p_vector) {
+	p_file->store_32(p_vector.size());
+	for (int32_t value : p_vector) {
+		p_file->store_32(uint32_t(value));
+	}
+}
+
+static Vector<int32_t> _get_int32_vector(const Ref<FileAccess> &p_file) {
+	Vector<int32_t> vector;
+	uint32_t size = p_file->get_32();
+	for (uint32_t i = 0; i < size && !p_file->eof_reached(); i++) {
+		vector.push_back(int32_t(p_file->get_32()));
+	}
+	return vector;
+}
+
+Error PipelineManifestRD::load(const String &p_path) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	if (f.is_null()) {
+		return ERR_FILE_CANT_OPEN;
+	}
+
+	char header[5] = { 0, 0, 0, 0, 0 };
+	f->get_buffer((uint8_t *)header, 4);
+	ERR_FAIL_COND_V_MSG(header != String(pipeline_manifest_header), ERR_FILE_UNRECOGNIZED, "Invalid pipeline manifest: " + p_path);
+	if (f->get_32() != FORMAT_VERSION) {
+		// Written by another version, it will be recreated.
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	HashMap<uint64_t, LocalVector<Entry>> loaded_entries;
+	HashMap<uint64_t, uint32_t> loaded_unused_sessions;
+	uint32_t key_count = f->get_32();
+	for (uint32_t i = 0; i < key_count && !f->eof_reached(); i++) {
+		uint64_t key = f->get_64();
+		loaded_unused_sessions[key] = f->get_32();
+		LocalVector<Entry> &key_entries = loaded_entries[key];
+		uint32_t entry_count = f->get_32();
+		for (uint32_t j = 0; j < entry_count && !f->eof_reached(); j++) {
+			Entry entry;
+			entry.has_vertex_format = f->get_8();
+			uint32_t attribute_count = f->get_32();
+			for (uint32_t k = 0; k < attribute_count && !f->eof_reached(); k++) {
+				RD::VertexAttribute attribute;
+				attribute.location = f->get_32();
+				attribute.offset = f->get_32();
+				attribute.format = RD::DataFormat(f->get_32());
+				attribute.stride = f->get_32();
+				attribute.frequency = RD::VertexFrequency(f->get_32());
+				entry.vertex_attributes.push_back(attribute);
+			}
+			uint32_t attachment_count = f->get_32();
+			for (uint32_t k = 0; k < attachment_count && !f->eof_reached(); k++) {
+				RD::AttachmentFormat attachment;
+				attachment.format = RD::DataFormat(f->get_32());
+				attachment.samples = RD::TextureSamples(f->get_32());
+				attachment.usage_flags = f->get_32();
+				entry.attachments.push_back(attachment);
+			}
+			uint32_t pass_count = f->get_32();
+			for (uint32_t k = 0; k < pass_count && !f->eof_reached(); k++) {
+				RD::FramebufferPass pass;
+				pass.color_attachments = _get_int32_vector(f);
+				pass.input_attachments = _get_int32_vector(f);
+				pass.resolve_attachments = _get_int32_vector(f);
+				pass.preserve_attachments = _get_int32_vector(f);
+				pass.depth_attachment = int32_t(f->get_32());
+				pass.vrs_attachment = int32_t(f->get_32());
+				entry.passes.push_back(pass);
+			}
+			entry.view_count = f->get_32();
+			entry.samples = RD::TextureSamples(f->get_32());
+			entry.render_pass = f->get_32();
+			entry.wireframe = f->get_8();
+			entry.bool_specializations = f->get_32();
+			key_entries.push_back(entry);
+		}
+	}
+
+	ERR_FAIL_COND_V_MSG(f->eof_reached(), ERR_FILE_CORRUPT, "Truncated pipeline manifest: " + p_path);
+
+	MutexLock lock(mutex);
+	entries = loaded_entries;
+	unused_sessions = loaded_unused_sessions;
+	dirty = false;
+	return OK;
+}
+
+Error PipelineManifestRD::save(const String &p_path) {
+	MutexLock lock(mutex);
+
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_FILE_CANT_WRITE, "Can't write pipeline manifest: " + p_path);
+
+	// Keys this session didn't use age by one session. Old ones most likely
+	// belong to shaders that were edited or removed since, so they're dropped.
+	LocalVector<uint64_t> pruned_keys;
+	for (const KeyValue<uint64_t, LocalVector<Entry>> &E : entries) {
+		if (!used_keys.has(E.key)) {
+			const uint32_t *sessions = unused_sessions.getptr(E.key);
+			if (sessions && *sessions >= MAX_UNUSED_SESSIONS) {
+				pruned_keys.push_back(E.key);
+			}
+		}
+	}
+	for (uint64_t key : pruned_keys) {
+		entries.erase(key);
+		unused_sessions.erase(key);
+	}
+
+	f->store_buffer((const uint8_t *)pipeline_manifest_header, 4);
+	f->store_32(FORMAT_VERSION);
+	f->store_32(entries.size());
+	for (const KeyValue<uint64_t, LocalVector<Entry>> &E : entries) {
+		f->store_64(E.key);
+		const uint32_t *sessions = unused_sessions.getptr(E.key);
+		f->store_32(used_keys.has(E.key) || !sessions ? 0 : *sessions + 1);
+		f->store_32(E.value.size());
+		for (const Entry &entry : E.value) {
+			f->store_8(entry.has_vertex_format);
+			f->store_32(entry.vertex_attributes.size());
+			for (const RD::VertexAttribute &attribute : entry.vertex_attributes) {
+				f->store_32(attribute.location);
+				f->store_32(attribute.offset);
+				f->store_32(attribute.format);
+				f->store_32(attribute.stride);
+				f->store_32(attribute.frequency);
+			}
+			f->store_32(entry.attachments.size());
+			for (const RD::AttachmentFormat &attachment : entry.attachments) {
+				f->store_32(attachment.format);
+				f->store_32(attachment.samples);
+				f->store_32(attachment.usage_flags);
+			}
+			f->store_32(entry.passes.size());
+			for (const RD::FramebufferPass &pass : entry.passes) {
+				_store_int32_vector(f, pass.color_attachments);
+				_store_int32_vector(f, pass.input_attachments);
+				_store_int32_vector(f, pass.resolve_attachments);
+				_store_int32_vector(f, pass.preserve_attachments);
+				f->store_32(uint32_t(pass.depth_attachment));
+				f->store_32(uint32_t(pass.vrs_attachment));
+			}
+			f->store_32(entry.view_count);
+			f->store_32(entry.samples);
+			f->store_32(entry.render_pass);
+			f->store_8(entry.wireframe);
+			f->store_32(entry.bool_specializations);
+		}
+	}
+
+	dirty = false;
+	return OK;
+}
+
+PipelineManifestRD::PipelineManifestRD() {
+	singleton = this;
+}
+
+PipelineManifestRD::~PipelineManifestRD() {
+	singleton = nullptr;
+}
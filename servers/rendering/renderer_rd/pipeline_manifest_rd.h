@@ -0,0 +1,96 @@
+/**************************************************************************/
+/*  pipeline_manifest_rd.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef PIPELINE_MANIFEST_RD_H
+#define PIPELINE_MANIFEST_RD_H
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "servers/rendering/rendering_device.h"
+
+// Records which pipeline variants PipelineCacheRD had to create during a
+// session, so the next session can create them on worker threads as soon as
+// the cache is set up instead of when they're first drawn with.
+// Formats are stored by description since their IDs don't persist.
+// Keys that stay unused for more than MAX_UNUSED_SESSIONS saved sessions are
+// dropped, so variants of edited or removed shaders don't accumulate.
+class PipelineManifestRD {
+public:
+	struct Entry {
+		bool has_vertex_format = false;
+		Vector<RD::VertexAttribute> vertex_attributes;
+		Vector<RD::AttachmentFormat> attachments;
+		Vector<RD::FramebufferPass> passes;
+		uint32_t view_count = 1;
+		RD::TextureSamples samples = RD::TEXTURE_SAMPLES_1; // Only used by empty framebuffer formats.
+		uint32_t render_pass = 0;
+		bool wireframe = false;
+		uint32_t bool_specializations = 0;
+
+		uint32_t hash() const;
+		bool operator==(const Entry &p_entry) const;
+	};
+
+private:
+	static PipelineManifestRD *singleton;
+
+	static const uint32_t FORMAT_VERSION = 2;
+
+	mutable Mutex mutex;
+	HashMap<uint64_t, LocalVector<Entry>> entries;
+	HashMap<uint64_t, uint32_t> unused_sessions; // Saved sessions since each key was last used, as loaded.
+	HashSet<uint64_t> used_keys; // Keys recorded or looked up in this session.
+	bool dirty = false;
+
+public:
+	static const uint32_t MAX_UNUSED_SESSIONS = 8;
+
+	static PipelineManifestRD *get_singleton() { return singleton; }
+
+	// The key identifies the shader binary and the fixed pipeline state of a PipelineCacheRD.
+	// Both mark the key as used in this session.
+	void record(uint64_t p_key, const Entry &p_entry);
+	Vector<Entry> get_entries(uint64_t p_key);
+	uint32_t get_entry_count() const;
+	bool is_dirty() const;
+	void clear();
+
+	Error load(const String &p_path);
+	Error save(const String &p_path);
+
+	PipelineManifestRD();
+	~PipelineManifestRD();
+};
+
+#endif // PIPELINE_MANIFEST_RD_H
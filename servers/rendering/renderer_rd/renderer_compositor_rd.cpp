@@ -34,6 +34,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
+#include "core/io/file_access.h"
 
 #include "servers/rendering/renderer_rd/forward_clustered/render_forward_clustered.h"
 #include "servers/rendering/renderer_rd/forward_mobile/render_forward_mobile.h"
@@ -174,6 +175,10 @@ void RendererCompositorRD::finalize() {
 	memdelete(texture_storage);
 	memdelete(utilities);
 
+	if (!pipeline_manifest_path.is_empty() && pipeline_manifest->is_dirty()) {
+		pipeline_manifest->save(pipeline_manifest_path);
+	}
+
 	//only need to erase these, the rest are erased by cascade
 	blit.shader.version_free(blit.shader_version);
 	RD::get_singleton()->free(blit.index_buffer);
@@ -281,6 +286,7 @@ RendererCompositorRD *RendererCompositorRD::singleton = nullptr;
 RendererCompositorRD::RendererCompositorRD() {
 	uniform_set_cache = memnew(UniformSetCacheRD);
 	framebuffer_cache = memnew(FramebufferCacheRD);
+	pipeline_manifest = memnew(PipelineManifestRD);
 
 	{
 		String shader_cache_dir = Engine::get_singleton()->get_shader_cache_path();
@@ -311,9 +317,16 @@ RendererCompositorRD::RendererCompositorRD() {
 					bool strip_debug = GLOBAL_GET("rendering/shader_compiler/shader_cache/strip_debug");
 
 					ShaderRD::set_shader_cache_dir(shader_cache_dir);
+					ShaderCompiler::set_shader_cache_dir(shader_cache_dir);
 					ShaderRD::set_shader_cache_save_compressed(compress);
 					ShaderRD::set_shader_cache_save_compressed_zstd(use_zstd);
 					ShaderRD::set_shader_cache_save_debug(!strip_debug);
+
+					// Pipelines recorded by the previous session are compiled ahead of time as their caches are set up.
+					pipeline_manifest_path = shader_cache_dir.path_join("pipeline_manifest.bin");
+					if (FileAccess::exists(pipeline_manifest_path)) {
+						pipeline_manifest->load(pipeline_manifest_path);
+					}
 				}
 			}
 		}
@@ -354,5 +367,7 @@ RendererCompositorRD::~RendererCompositorRD() {
 	singleton = nullptr;
 	memdelete(uniform_set_cache);
 	memdelete(framebuffer_cache);
+	memdelete(pipeline_manifest);
 	ShaderRD::set_shader_cache_dir(String());
+	ShaderCompiler::set_shader_cache_dir(String());
 }
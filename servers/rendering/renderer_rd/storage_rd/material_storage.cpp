@@ -1225,6 +1225,8 @@ MaterialStorage *MaterialStorage::get_singleton() {
 MaterialStorage::MaterialStorage() {
 	singleton = this;
 
+	parallel_shader_compilation = GLOBAL_GET("rendering/shader_compiler/parallel_compilation");
+
 	//default samplers
 	default_samplers = samplers_rd_allocate();
 
@@ -1263,6 +1265,8 @@ MaterialStorage::MaterialStorage() {
 }
 
 MaterialStorage::~MaterialStorage() {
+	_update_queued_shaders();
+
 	memdelete_arr(global_shader_uniforms.buffer_values);
 	memdelete_arr(global_shader_uniforms.buffer_usage);
 	memdelete_arr(global_shader_uniforms.buffer_dirty_regions);
@@ -1545,6 +1549,8 @@ void MaterialStorage::_global_shader_uniform_mark_buffer_dirty(int32_t p_index,
 }
 
 void MaterialStorage::global_shader_parameter_add(const StringName &p_name, RS::GlobalShaderParameterType p_type, const Variant &p_value) {
+	// Shaders compiling in the background look up global parameter types.
+	_update_queued_shaders();
 	ERR_FAIL_COND(global_shader_uniforms.variables.has(p_name));
 	GlobalShaderUniforms::Variable gv;
 	gv.type = p_type;
@@ -1583,6 +1589,7 @@ void MaterialStorage::global_shader_parameter_add(const StringName &p_name, RS::
 }
 
 void MaterialStorage::global_shader_parameter_remove(const StringName &p_name) {
+	_update_queued_shaders();
 	if (!global_shader_uniforms.variables.has(p_name)) {
 		return;
 	}
@@ -1772,6 +1779,7 @@ void MaterialStorage::global_shader_parameters_load_settings(bool p_load_texture
 }
 
 void MaterialStorage::global_shader_parameters_clear() {
+	_update_queued_shaders();
 	global_shader_uniforms.variables.clear(); //not right but for now enough
 }
 
@@ -1926,6 +1934,12 @@ void MaterialStorage::shader_initialize(RID p_rid) {
 void MaterialStorage::shader_free(RID p_rid) {
 	Shader *shader = shader_owner.get_or_null(p_rid);
 	ERR_FAIL_NULL(shader);
+	_shader_wait_compiled(shader);
+	shader_compile_queue.erase_multiple_unordered(shader); // Queued again if its code was set several times.
+	// Its compilation is over, so the callbacks are still called with the others.
+	for (const Callable &callback : shader->compiled_callbacks) {
+		shader_compiled_callbacks.push_back(callback);
+	}
 
 	//make material unreference this
 	while (shader->owners.size()) {
@@ -1942,6 +1956,7 @@ void MaterialStorage::shader_free(RID p_rid) {
 void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL(shader);
+	_shader_wait_compiled(shader);
 
 	shader->code = p_code;
 	String mode_string = ShaderLanguage::get_shader_type(p_code);
@@ -2006,7 +2021,14 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 
 	if (shader->data) {
 		shader->data->set_path_hint(shader->path_hint);
-		shader->data->set_code(p_code);
+		if (parallel_shader_compilation && shader->data->is_set_code_thread_safe()) {
+			// Materials are usually loaded in bulk, so let their shaders compile
+			// alongside each other. They're waited on when first needed.
+			shader->compile_task = WorkerThreadPool::get_singleton()->add_template_task(this, &MaterialStorage::_shader_compile_task, shader, false, "Compile shader: " + shader->path_hint);
+			shader_compile_queue.push_back(shader);
+		} else {
+			shader->data->set_code(p_code);
+		}
 	}
 
 	for (Material *E : shader->owners) {
@@ -2020,6 +2042,8 @@ void MaterialStorage::shader_set_path_hint(RID p_shader, const String &p_path) {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL(shader);
 
+	_shader_wait_compiled(shader);
+
 	shader->path_hint = p_path;
 	if (shader->data) {
 		shader->data->set_path_hint(p_path);
@@ -2035,6 +2059,7 @@ String MaterialStorage::shader_get_code(RID p_shader) const {
 void MaterialStorage::get_shader_parameter_list(RID p_shader, List<PropertyInfo> *p_param_list) const {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL(shader);
+	_shader_wait_compiled(shader);
 	if (shader->data) {
 		return shader->data->get_shader_uniform_list(p_param_list);
 	}
@@ -2043,6 +2068,7 @@ void MaterialStorage::get_shader_parameter_list(RID p_shader, List<PropertyInfo>
 void MaterialStorage::shader_set_default_texture_parameter(RID p_shader, const StringName &p_name, RID p_texture, int p_index) {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL(shader);
+	_shader_wait_compiled(shader);
 
 	if (p_texture.is_valid() && TextureStorage::get_singleton()->owns_texture(p_texture)) {
 		if (!shader->default_texture_parameter.has(p_name)) {
@@ -2080,6 +2106,7 @@ RID MaterialStorage::shader_get_default_texture_parameter(RID p_shader, const St
 Variant MaterialStorage::shader_get_parameter_default(RID p_shader, const StringName &p_param) const {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL_V(shader, Variant());
+	_shader_wait_compiled(shader);
 	if (shader->data) {
 		return shader->data->get_default_parameter(p_param);
 	}
@@ -2094,12 +2121,63 @@ void MaterialStorage::shader_set_data_request_function(ShaderType p_shader_type,
 RS::ShaderNativeSourceCode MaterialStorage::shader_get_native_source_code(RID p_shader) const {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_NULL_V(shader, RS::ShaderNativeSourceCode());
+	_shader_wait_compiled(shader);
 	if (shader->data) {
 		return shader->data->get_native_source_code();
 	}
 	return RS::ShaderNativeSourceCode();
 }
 
+bool MaterialStorage::shader_is_compiled(RID p_shader) const {
+	Shader *shader = shader_owner.get_or_null(p_shader);
+	ERR_FAIL_NULL_V(shader, false);
+	return shader->compile_task == WorkerThreadPool::INVALID_TASK_ID || WorkerThreadPool::get_singleton()->is_task_completed(shader->compile_task);
+}
+
+void MaterialStorage::shader_request_compiled_callback(RID p_shader, const Callable &p_callable) {
+	Shader *shader = shader_owner.get_or_null(p_shader);
+	ERR_FAIL_NULL(shader);
+	if (shader_compile_queue.has(shader)) {
+		shader->compiled_callbacks.push_back(p_callable);
+	} else {
+		shader_compiled_callbacks.push_back(p_callable);
+	}
+}
+
+void MaterialStorage::_shader_compile_task(Shader *p_shader) {
+	p_shader->data->set_code(p_shader->code);
+}
+
+void MaterialStorage::_shader_finish_compile(Shader *p_shader) const {
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(p_shader->compile_task);
+	p_shader->compile_task = WorkerThreadPool::INVALID_TASK_ID;
+}
+
+void MaterialStorage::_update_queued_shaders() {
+	for (Shader *shader : shader_compile_queue) {
+		_shader_wait_compiled(shader);
+		for (const Callable &callback : shader->compiled_callbacks) {
+			shader_compiled_callbacks.push_back(callback);
+		}
+		shader->compiled_callbacks.clear();
+	}
+	shader_compile_queue.clear();
+}
+
+void MaterialStorage::_call_shader_compiled_callbacks() {
+	// Callbacks may set shader code, which queues new callbacks for the next call.
+	LocalVector<Callable> callbacks = shader_compiled_callbacks;
+	shader_compiled_callbacks.clear();
+	for (const Callable &callback : callbacks) {
+		Variant result;
+		Callable::CallError ce;
+		callback.callp(nullptr, 0, result, ce);
+		if (ce.error != Callable::CallError::CALL_OK) {
+			ERR_PRINT("Error calling shader compiled function: " + Variant::get_callable_error_text(callback, nullptr, 0, ce));
+		}
+	}
+}
+
 /* MATERIAL API */
 
 void MaterialStorage::_material_uniform_set_erased(void *p_material) {
@@ -2133,6 +2211,10 @@ void MaterialStorage::_update_queued_materials() {
 		Material *material = material_update_list.first()->self();
 		bool uniforms_changed = false;
 
+		if (material->shader) {
+			_shader_wait_compiled(material->shader);
+		}
+
 		if (material->data) {
 			uniforms_changed = material->data->update_parameters(material->params, material->uniform_dirty, material->texture_dirty);
 		}
@@ -2222,6 +2304,7 @@ void MaterialStorage::material_set_shader(RID p_material, RID p_shader) {
 MaterialStorage::ShaderData *MaterialStorage::material_get_shader_data(RID p_material) {
 	const MaterialStorage::Material *material = MaterialStorage::get_singleton()->get_material(p_material);
 	if (material && material->shader && material->shader->data) {
+		_shader_wait_compiled(material->shader);
 		return material->shader->data;
 	}
 
@@ -2240,6 +2323,7 @@ void MaterialStorage::material_set_param(RID p_material, const StringName &p_par
 	}
 
 	if (material->shader && material->shader->data) { //shader is valid
+		_shader_wait_compiled(material->shader);
 		bool is_texture = material->shader->data->is_parameter_texture(p_param);
 		_material_queue_update(material, !is_texture, is_texture);
 	} else {
@@ -2287,6 +2371,7 @@ bool MaterialStorage::material_is_animated(RID p_material) {
 	Material *material = material_owner.get_or_null(p_material);
 	ERR_FAIL_NULL_V(material, false);
 	if (material->shader && material->shader->data) {
+		_shader_wait_compiled(material->shader);
 		if (material->shader->data->is_animated()) {
 			return true;
 		} else if (material->next_pass.is_valid()) {
@@ -2300,6 +2385,7 @@ bool MaterialStorage::material_casts_shadows(RID p_material) {
 	Material *material = material_owner.get_or_null(p_material);
 	ERR_FAIL_NULL_V(material, true);
 	if (material->shader && material->shader->data) {
+		_shader_wait_compiled(material->shader);
 		if (material->shader->data->casts_shadows()) {
 			return true;
 		} else if (material->next_pass.is_valid()) {
@@ -2314,6 +2400,7 @@ RS::CullMode RendererRD::MaterialStorage::material_get_cull_mode(RID p_material)
 	ERR_FAIL_NULL_V(material, RS::CULL_MODE_DISABLED);
 	ERR_FAIL_NULL_V(material->shader, RS::CULL_MODE_DISABLED);
 	if (material->shader->type == ShaderType::SHADER_TYPE_3D && material->shader->data) {
+		_shader_wait_compiled(material->shader);
 		RendererSceneRenderImplementation::SceneShaderForwardClustered::ShaderData *sd_clustered = dynamic_cast<RendererSceneRenderImplementation::SceneShaderForwardClustered::ShaderData *>(material->shader->data);
 		if (sd_clustered) {
 			return (RS::CullMode)sd_clustered->cull_mode;
@@ -2331,6 +2418,7 @@ void MaterialStorage::material_get_instance_shader_parameters(RID p_material, Li
 	Material *material = material_owner.get_or_null(p_material);
 	ERR_FAIL_NULL(material);
 	if (material->shader && material->shader->data) {
+		_shader_wait_compiled(material->shader);
 		material->shader->data->get_instance_param_list(r_parameters);
 
 		if (material->next_pass.is_valid()) {
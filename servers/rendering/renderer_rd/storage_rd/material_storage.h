@@ -36,6 +36,7 @@
 #include "texture_storage.h"
 
 #include "core/math/projection.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid_owner.h"
 #include "core/templates/self_list.h"
@@ -80,6 +81,8 @@ public:
 		virtual bool is_parameter_texture(const StringName &p_param) const;
 
 		virtual void set_code(const String &p_Code) = 0;
+		// If true, set_code() may be called from a worker thread.
+		virtual bool is_set_code_thread_safe() const { return false; }
 		virtual bool is_animated() const = 0;
 		virtual bool casts_shadows() const = 0;
 		virtual RS::ShaderNativeSourceCode get_native_source_code() const { return RS::ShaderNativeSourceCode(); }
@@ -223,8 +226,24 @@ private:
 		ShaderType type;
 		HashMap<StringName, HashMap<int, RID>> default_texture_parameter;
 		HashSet<Material *> owners;
+		WorkerThreadPool::TaskID compile_task = WorkerThreadPool::INVALID_TASK_ID;
+		LocalVector<Callable> compiled_callbacks;
 	};
 
+	// Shaders whose code is compiled on a worker thread. Anything that reads
+	// the shader data must wait for the compilation to finish first.
+	bool parallel_shader_compilation = false;
+	LocalVector<Shader *> shader_compile_queue;
+	LocalVector<Callable> shader_compiled_callbacks; // Called in update_dirty_resources(), once their shader is compiled.
+
+	void _shader_compile_task(Shader *p_shader);
+	void _shader_finish_compile(Shader *p_shader) const;
+	_FORCE_INLINE_ void _shader_wait_compiled(Shader *p_shader) const {
+		if (unlikely(p_shader->compile_task != WorkerThreadPool::INVALID_TASK_ID)) {
+			_shader_finish_compile(p_shader);
+		}
+	}
+
 	typedef ShaderData *(*ShaderDataRequestFunction)();
 	ShaderDataRequestFunction shader_data_request_func[SHADER_TYPE_MAX];
 
@@ -423,6 +442,11 @@ public:
 	void shader_set_data_request_function(ShaderType p_shader_type, ShaderDataRequestFunction p_function);
 
 	virtual RS::ShaderNativeSourceCode shader_get_native_source_code(RID p_shader) const override;
+	virtual bool shader_is_compiled(RID p_shader) const override;
+	virtual void shader_request_compiled_callback(RID p_shader, const Callable &p_callable) override;
+
+	void _update_queued_shaders();
+	void _call_shader_compiled_callbacks();
 
 	/* MATERIAL API */
 
@@ -465,6 +489,9 @@ public:
 		if (!material || material->shader_type != p_shader_type) {
 			return nullptr;
 		} else {
+			if (material->shader) {
+				_shader_wait_compiled(material->shader);
+			}
 			return material->data;
 		}
 	}
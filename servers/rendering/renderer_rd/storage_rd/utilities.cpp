@@ -251,11 +251,13 @@ String Utilities::get_captured_timestamp_name(uint32_t p_index) const {
 /* MISC */
 
 void Utilities::update_dirty_resources() {
+	MaterialStorage::get_singleton()->_update_queued_shaders();
 	MaterialStorage::get_singleton()->_update_global_shader_uniforms(); //must do before materials, so it can queue them for update
 	MaterialStorage::get_singleton()->_update_queued_materials();
 	MeshStorage::get_singleton()->_update_dirty_multimeshes();
 	MeshStorage::get_singleton()->_update_dirty_skeletons();
 	TextureStorage::get_singleton()->update_decal_atlas();
+	MaterialStorage::get_singleton()->_call_shader_compiled_callbacks();
 }
 
 bool Utilities::has_os_feature(const String &p_feature) const {
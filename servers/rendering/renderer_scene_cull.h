@@ -257,6 +257,48 @@ public:
 		}
 	};
 
+	struct InstanceBoundsBlock {
+		// Bounds of consecutive instances in SoA layout: each row of InstanceBounds
+		// holds one value per instance, so the frustum test runs on all of them
+		// at once in a form the compiler can vectorize.
+
+		enum {
+			SIZE = 4,
+			SHIFT = 2,
+			MASK = SIZE - 1,
+		};
+
+		real_t bounds[6][SIZE];
+
+		_ALWAYS_INLINE_ void set(uint32_t p_lane, const InstanceBounds &p_bounds) {
+			for (int i = 0; i < 6; i++) {
+				bounds[i][p_lane] = p_bounds.bounds[i];
+			}
+		}
+
+		// Returns a mask with a bit set for each instance passing InstanceBounds::in_frustum().
+		_ALWAYS_INLINE_ uint32_t in_frustum_mask(const Frustum &p_frustum) const {
+			uint32_t outside[SIZE] = {};
+
+			for (uint32_t i = 0; i < p_frustum.plane_count; i++) {
+				const Plane &plane = p_frustum.planes_ptr[i];
+				const real_t *x = bounds[p_frustum.plane_signs_ptr[i].signs[0]];
+				const real_t *y = bounds[p_frustum.plane_signs_ptr[i].signs[1]];
+				const real_t *z = bounds[p_frustum.plane_signs_ptr[i].signs[2]];
+
+				for (uint32_t j = 0; j < SIZE; j++) {
+					outside[j] |= uint32_t(plane.normal.x * x[j] + plane.normal.y * y[j] + plane.normal.z * z[j] - plane.d >= 0.0);
+				}
+			}
+
+			uint32_t mask = 0;
+			for (uint32_t j = 0; j < SIZE; j++) {
+				mask |= (outside[j] ^ 1) << j;
+			}
+			return mask;
+		}
+	};
+
 	struct InstanceVisibilityNotifierData;
 
 	struct InstanceData {
@@ -327,6 +369,7 @@ public:
 	};
 
 	PagedArrayPool<InstanceBounds> instance_aabb_page_pool;
+	PagedArrayPool<InstanceBoundsBlock> instance_aabb_block_page_pool;
 	PagedArrayPool<InstanceData> instance_data_page_pool;
 	PagedArrayPool<InstanceVisibilityData> instance_visibility_data_page_pool;
 
@@ -356,9 +399,31 @@ public:
 		LocalVector<RID> dynamic_lights;
 
 		PagedArray<InstanceBounds> instance_aabbs;
+		PagedArray<InstanceBoundsBlock> instance_aabb_blocks; // Same bounds as instance_aabbs, for frustum culling.
 		PagedArray<InstanceData> instance_data;
 		VisibilityArray instance_visibility;
 
+		_FORCE_INLINE_ void instance_aabb_push_back(const InstanceBounds &p_bounds) {
+			uint64_t index = instance_aabbs.size();
+			instance_aabbs.push_back(p_bounds);
+			if ((index & InstanceBoundsBlock::MASK) == 0) {
+				instance_aabb_blocks.push_back(InstanceBoundsBlock());
+			}
+			instance_aabb_blocks[index >> InstanceBoundsBlock::SHIFT].set(index & InstanceBoundsBlock::MASK, p_bounds);
+		}
+
+		_FORCE_INLINE_ void instance_aabb_set(uint64_t p_index, const InstanceBounds &p_bounds) {
+			instance_aabbs[p_index] = p_bounds;
+			instance_aabb_blocks[p_index >> InstanceBoundsBlock::SHIFT].set(p_index & InstanceBoundsBlock::MASK, p_bounds);
+		}
+
+		_FORCE_INLINE_ void instance_aabb_pop_back() {
+			instance_aabbs.pop_back();
+			if ((instance_aabbs.size() & InstanceBoundsBlock::MASK) == 0) {
+				instance_aabb_blocks.pop_back();
+			}
+		}
+
 		Scenario() {
 			indexers[INDEXER_GEOMETRY].set_index(INDEXER_GEOMETRY);
 			indexers[INDEXER_VOLUMES].set_index(INDEXER_VOLUMES);
@@ -34,6 +34,7 @@
 #include "rendering_device.compat.inc"
 
 #include "rendering_device_binds.h"
+#include "rendering_device_graph_capture.h"
 #include "shader_include_db.h"
 
 #include "core/config/project_settings.h"
@@ -2768,6 +2769,19 @@ RenderingDevice::TextureSamples RenderingDevice::framebuffer_format_get_texture_
 	return E->value.pass_samples[p_pass];
 }
 
+bool RenderingDevice::framebuffer_format_get_description(FramebufferFormatID p_format, Vector<AttachmentFormat> &r_attachments, Vector<FramebufferPass> &r_passes, uint32_t &r_view_count) {
+	_THREAD_SAFE_METHOD_
+
+	HashMap<FramebufferFormatID, FramebufferFormat>::Iterator E = framebuffer_formats.find(p_format);
+	ERR_FAIL_COND_V(!E, false);
+
+	const FramebufferFormatKey &key = E->value.E->key();
+	r_attachments = key.attachments;
+	r_passes = key.passes;
+	r_view_count = key.view_count;
+	return true;
+}
+
 RID RenderingDevice::framebuffer_create_empty(const Size2i &p_size, TextureSamples p_samples, FramebufferFormatID p_format_check) {
 	_THREAD_SAFE_METHOD_
 
@@ -3049,6 +3063,14 @@ RenderingDevice::VertexFormatID RenderingDevice::vertex_format_create(const Vect
 	return id;
 }
 
+Vector<RenderingDevice::VertexAttribute> RenderingDevice::vertex_format_get_description(VertexFormatID p_vertex_format) {
+	_THREAD_SAFE_METHOD_
+
+	const VertexDescriptionCache *vertex_format = vertex_formats.getptr(p_vertex_format);
+	ERR_FAIL_NULL_V(vertex_format, Vector<VertexAttribute>());
+	return vertex_format->vertex_formats;
+}
+
 RID RenderingDevice::vertex_array_create(uint32_t p_vertex_count, VertexFormatID p_vertex_format, const Vector<RID> &p_src_buffers, const Vector<uint64_t> &p_offsets) {
 	_THREAD_SAFE_METHOD_
 
@@ -3293,6 +3315,7 @@ RID RenderingDevice::shader_create_from_bytecode_with_samplers(const Vector<uint
 
 	*((ShaderDescription *)shader) = shader_desc; // ShaderDescription bundle.
 	shader->name = name;
+	shader->binary_hash = (uint64_t(hash_murmur3_buffer(p_shader_binary.ptr(), p_shader_binary.size())) << 32) | hash_djb2_buffer(p_shader_binary.ptr(), p_shader_binary.size());
 	shader->driver_id = shader_id;
 	shader->layout_hash = driver->shader_get_layout_hash(shader_id);
 
@@ -3368,6 +3391,14 @@ uint64_t RenderingDevice::shader_get_vertex_input_attribute_mask(RID p_shader) {
 	return shader->vertex_input_mask;
 }
 
+uint64_t RenderingDevice::shader_get_binary_hash(RID p_shader) {
+	_THREAD_SAFE_METHOD_
+
+	const Shader *shader = shader_owner.get_or_null(p_shader);
+	ERR_FAIL_NULL_V(shader, 0);
+	return shader->binary_hash;
+}
+
 /******************/
 /**** UNIFORMS ****/
 /******************/
@@ -6758,6 +6789,19 @@ Error RenderingDevice::initialize(RenderingContextDriver *p_context, DisplayServ
 
 	// Create draw graph and start it initialized as well.
 	draw_graph.initialize(driver, device, &_render_pass_create_from_graph, frames.size(), main_queue_family, SECONDARY_COMMAND_BUFFERS_PER_FRAME);
+
+	String graph_capture_path = Engine::get_singleton()->get_rendering_device_graph_capture_path();
+	if (is_main_instance && !graph_capture_path.is_empty()) {
+		draw_graph_capture = memnew(RenderingDeviceGraphCapture);
+		if (draw_graph_capture->open(graph_capture_path) == OK) {
+			draw_graph.set_capture(draw_graph_capture);
+			print_verbose(vformat("Capturing the rendering device graph to '%s'.", graph_capture_path));
+		} else {
+			memdelete(draw_graph_capture);
+			draw_graph_capture = nullptr;
+		}
+	}
+
 	draw_graph.begin();
 
 	for (uint32_t i = 0; i < frames.size(); i++) {
@@ -7097,6 +7141,12 @@ void RenderingDevice::finalize() {
 	_submit_transfer_workers();
 	_wait_for_transfer_workers();
 
+	if (draw_graph_capture != nullptr) {
+		draw_graph.set_capture(nullptr);
+		memdelete(draw_graph_capture);
+		draw_graph_capture = nullptr;
+	}
+
 	// Delete everything the graph has created.
 	draw_graph.finalize();
 
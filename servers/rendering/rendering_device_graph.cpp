@@ -32,6 +32,8 @@
 
 #include "rendering_device_graph.h"
 
+#include "rendering_device_graph_capture.h"
+
 #define PRINT_RENDER_GRAPH 0
 #define FORCE_FULL_ACCESS_BITS 0
 #define PRINT_RESOURCE_TRACKER_TOTAL 0
@@ -921,6 +923,10 @@ void RenderingDeviceGraph::_run_draw_list_command(RDD::CommandBufferID p_command
 }
 
 void RenderingDeviceGraph::_add_draw_list_begin(FramebufferCache *p_framebuffer_cache, RDD::RenderPassID p_render_pass, RDD::FramebufferID p_framebuffer, Rect2i p_region, VectorView<AttachmentOperation> p_attachment_operations, VectorView<RDD::RenderPassClearValue> p_attachment_clear_values, bool p_uses_color, bool p_uses_depth, uint32_t p_breadcrumb, bool p_split_cmd_buffer) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_begin(p_framebuffer_cache, p_render_pass, p_framebuffer, p_region, p_attachment_operations, p_attachment_clear_values, p_uses_color, p_uses_depth, p_breadcrumb, p_split_cmd_buffer);
+	}
+
 	DEV_ASSERT(p_attachment_operations.size() == p_attachment_clear_values.size());
 
 	draw_instruction_list.clear();
@@ -1311,6 +1317,10 @@ void RenderingDeviceGraph::_group_barriers_for_render_commands(RDD::CommandBuffe
 #endif
 
 	driver->command_pipeline_barrier(p_command_buffer, barrier_group.src_stages, barrier_group.dst_stages, memory_barriers, buffer_barriers, texture_barriers);
+	statistics.barrier_group_count++;
+	statistics.memory_barrier_count += memory_barriers.size();
+	statistics.buffer_barrier_count += buffer_barriers.size();
+	statistics.texture_barrier_count += barrier_group.normalization_barriers.size() + barrier_group.transition_barriers.size();
 
 	bool separate_texture_barriers = !barrier_group.normalization_barriers.is_empty() && !barrier_group.transition_barriers.is_empty();
 	if (separate_texture_barriers) {
@@ -1601,9 +1611,17 @@ void RenderingDeviceGraph::begin() {
 #ifdef DEV_ENABLED
 	write_dependency_counters.clear();
 #endif
+
+	if (unlikely(capture != nullptr)) {
+		capture->frame_begin(tracking_frame);
+	}
 }
 
 void RenderingDeviceGraph::add_buffer_clear(RDD::BufferID p_dst, ResourceTracker *p_dst_tracker, uint32_t p_offset, uint32_t p_size) {
+	if (unlikely(capture != nullptr)) {
+		capture->buffer_clear(p_dst, p_dst_tracker, p_offset, p_size);
+	}
+
 	DEV_ASSERT(p_dst_tracker != nullptr);
 
 	int32_t command_index;
@@ -1619,6 +1637,10 @@ void RenderingDeviceGraph::add_buffer_clear(RDD::BufferID p_dst, ResourceTracker
 }
 
 void RenderingDeviceGraph::add_buffer_copy(RDD::BufferID p_src, ResourceTracker *p_src_tracker, RDD::BufferID p_dst, ResourceTracker *p_dst_tracker, RDD::BufferCopyRegion p_region) {
+	if (unlikely(capture != nullptr)) {
+		capture->buffer_copy(p_src, p_src_tracker, p_dst, p_dst_tracker, p_region);
+	}
+
 	// Source tracker is allowed to be null as it could be a read-only buffer.
 	DEV_ASSERT(p_dst_tracker != nullptr);
 
@@ -1636,6 +1658,10 @@ void RenderingDeviceGraph::add_buffer_copy(RDD::BufferID p_src, ResourceTracker
 }
 
 void RenderingDeviceGraph::add_buffer_get_data(RDD::BufferID p_src, ResourceTracker *p_src_tracker, RDD::BufferID p_dst, RDD::BufferCopyRegion p_region) {
+	if (unlikely(capture != nullptr)) {
+		capture->buffer_get_data(p_src, p_src_tracker, p_dst, p_region);
+	}
+
 	// Source tracker is allowed to be null as it could be a read-only buffer.
 	int32_t command_index;
 	RecordedBufferGetDataCommand *command = static_cast<RecordedBufferGetDataCommand *>(_allocate_command(sizeof(RecordedBufferGetDataCommand), command_index));
@@ -1654,6 +1680,10 @@ void RenderingDeviceGraph::add_buffer_get_data(RDD::BufferID p_src, ResourceTrac
 }
 
 void RenderingDeviceGraph::add_buffer_update(RDD::BufferID p_dst, ResourceTracker *p_dst_tracker, VectorView<RecordedBufferCopy> p_buffer_copies) {
+	if (unlikely(capture != nullptr)) {
+		capture->buffer_update(p_dst, p_dst_tracker, p_buffer_copies);
+	}
+
 	DEV_ASSERT(p_dst_tracker != nullptr);
 
 	size_t buffer_copies_size = p_buffer_copies.size() * sizeof(RecordedBufferCopy);
@@ -1675,6 +1705,10 @@ void RenderingDeviceGraph::add_buffer_update(RDD::BufferID p_dst, ResourceTracke
 }
 
 void RenderingDeviceGraph::add_driver_callback(RDD::DriverCallback p_callback, void *p_userdata, VectorView<ResourceTracker *> p_trackers, VectorView<RenderingDeviceGraph::ResourceUsage> p_usages) {
+	if (unlikely(capture != nullptr)) {
+		capture->driver_callback(p_trackers, p_usages);
+	}
+
 	DEV_ASSERT(p_trackers.size() == p_usages.size());
 
 	int32_t command_index;
@@ -1686,6 +1720,10 @@ void RenderingDeviceGraph::add_driver_callback(RDD::DriverCallback p_callback, v
 }
 
 void RenderingDeviceGraph::add_compute_list_begin(RDD::BreadcrumbMarker p_phase, uint32_t p_breadcrumb_data) {
+	if (unlikely(capture != nullptr)) {
+		capture->compute_list_begin(p_phase, p_breadcrumb_data);
+	}
+
 	compute_instruction_list.clear();
 #if defined(DEBUG_ENABLED) || defined(DEV_ENABLED)
 	compute_instruction_list.breadcrumb = p_breadcrumb_data | (p_phase & ((1 << 16) - 1));
@@ -1694,6 +1732,10 @@ void RenderingDeviceGraph::add_compute_list_begin(RDD::BreadcrumbMarker p_phase,
 }
 
 void RenderingDeviceGraph::add_compute_list_bind_pipeline(RDD::PipelineID p_pipeline) {
+	if (unlikely(capture != nullptr)) {
+		capture->compute_list_bind_pipeline(p_pipeline);
+	}
+
 	ComputeListBindPipelineInstruction *instruction = reinterpret_cast<ComputeListBindPipelineInstruction *>(_allocate_compute_list_instruction(sizeof(ComputeListBindPipelineInstruction)));
 	instruction->type = ComputeListInstruction::TYPE_BIND_PIPELINE;
 	instruction->pipeline = p_pipeline;
@@ -1705,6 +1747,10 @@ void RenderingDeviceGraph::add_compute_list_bind_uniform_set(RDD::ShaderID p_sha
 }
 
 void RenderingDeviceGraph::add_compute_list_bind_uniform_sets(RDD::ShaderID p_shader, VectorView<RDD::UniformSetID> p_uniform_sets, uint32_t p_first_set_index, uint32_t p_set_count) {
+	if (unlikely(capture != nullptr)) {
+		capture->compute_list_bind_uniform_sets(p_shader, p_uniform_sets, p_first_set_index, p_set_count);
+	}
+
 	DEV_ASSERT(p_uniform_sets.size() >= p_set_count);
 
 	uint32_t instruction_size = sizeof(ComputeListBindUniformSetsInstruction) + sizeof(RDD::UniformSetID) * p_set_count;
@@ -1721,6 +1767,10 @@ void RenderingDeviceGraph::add_compute_list_bind_uniform_sets(RDD::ShaderID p_sh
 }
 
 void RenderingDeviceGraph::add_compute_list_dispatch(uint32_t p_x_groups, uint32_t p_y_groups, uint32_t p_z_groups) {
+	if (unlikely(capture != nullptr)) {
+		capture->compute_list_dispatch(p_x_groups, p_y_groups, p_z_groups);
+	}
+
 	ComputeListDispatchInstruction *instruction = reinterpret_cast<ComputeListDispatchInstruction *>(_allocate_compute_list_instruction(sizeof(ComputeListDispatchInstruction)));
 	instruction->type = ComputeListInstruction::TYPE_DISPATCH;
 	instruction->x_groups = p_x_groups;
@@ -1729,6 +1779,10 @@ void RenderingDeviceGraph::add_compute_list_dispatch(uint32_t p_x_groups, uint32
 }
 
 void RenderingDeviceGraph::add_compute_list_dispatch_indirect(RDD::BufferID p_buffer, uint32_t p_offset) {
+	if (unlikely(capture != nullptr)) {
+		capture->compute_list_dispatch_indirect(p_buffer, p_offset);
+	}
+
 	ComputeListDispatchIndirectInstruction *instruction = reinterpret_cast<ComputeListDispatchIndirectInstruction *>(_allocate_compute_list_instruction(sizeof(ComputeListDispatchIndirectInstruction)));
 	instruction->type = ComputeListInstruction::TYPE_DISPATCH_INDIRECT;
 	instruction->buffer = p_buffer;
@@ -1737,6 +1791,10 @@ void RenderingDeviceGraph::add_compute_list_dispatch_indirect(RDD::BufferID p_bu
 }
 
 void RenderingDeviceGraph::add_compute_list_set_push_constant(RDD::ShaderID p_shader, const void *p_data, uint32_t p_data_size) {
+	if (unlikely(capture != nullptr)) {
+		capture->compute_list_set_push_constant(p_shader, p_data, p_data_size);
+	}
+
 	uint32_t instruction_size = sizeof(ComputeListSetPushConstantInstruction) + p_data_size;
 	ComputeListSetPushConstantInstruction *instruction = reinterpret_cast<ComputeListSetPushConstantInstruction *>(_allocate_compute_list_instruction(instruction_size));
 	instruction->type = ComputeListInstruction::TYPE_SET_PUSH_CONSTANT;
@@ -1746,6 +1804,10 @@ void RenderingDeviceGraph::add_compute_list_set_push_constant(RDD::ShaderID p_sh
 }
 
 void RenderingDeviceGraph::add_compute_list_uniform_set_prepare_for_use(RDD::ShaderID p_shader, RDD::UniformSetID p_uniform_set, uint32_t set_index) {
+	if (unlikely(capture != nullptr)) {
+		capture->compute_list_uniform_set_prepare_for_use(p_shader, p_uniform_set, set_index);
+	}
+
 	ComputeListUniformSetPrepareForUseInstruction *instruction = reinterpret_cast<ComputeListUniformSetPrepareForUseInstruction *>(_allocate_compute_list_instruction(sizeof(ComputeListUniformSetPrepareForUseInstruction)));
 	instruction->type = ComputeListInstruction::TYPE_UNIFORM_SET_PREPARE_FOR_USE;
 	instruction->shader = p_shader;
@@ -1754,6 +1816,10 @@ void RenderingDeviceGraph::add_compute_list_uniform_set_prepare_for_use(RDD::Sha
 }
 
 void RenderingDeviceGraph::add_compute_list_usage(ResourceTracker *p_tracker, ResourceUsage p_usage) {
+	if (unlikely(capture != nullptr)) {
+		capture->compute_list_usage(p_tracker, p_usage);
+	}
+
 	DEV_ASSERT(p_tracker != nullptr);
 
 	p_tracker->reset_if_outdated(tracking_frame);
@@ -1780,6 +1846,10 @@ void RenderingDeviceGraph::add_compute_list_usages(VectorView<ResourceTracker *>
 }
 
 void RenderingDeviceGraph::add_compute_list_end() {
+	if (unlikely(capture != nullptr)) {
+		capture->compute_list_end();
+	}
+
 	int32_t command_index;
 	uint32_t instruction_data_size = compute_instruction_list.data.size();
 	uint32_t command_size = sizeof(RecordedComputeListCommand) + instruction_data_size;
@@ -1800,6 +1870,10 @@ void RenderingDeviceGraph::add_draw_list_begin(RDD::RenderPassID p_render_pass,
 }
 
 void RenderingDeviceGraph::add_draw_list_bind_index_buffer(RDD::BufferID p_buffer, RDD::IndexBufferFormat p_format, uint32_t p_offset) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_bind_index_buffer(p_buffer, p_format, p_offset);
+	}
+
 	DrawListBindIndexBufferInstruction *instruction = reinterpret_cast<DrawListBindIndexBufferInstruction *>(_allocate_draw_list_instruction(sizeof(DrawListBindIndexBufferInstruction)));
 	instruction->type = DrawListInstruction::TYPE_BIND_INDEX_BUFFER;
 	instruction->buffer = p_buffer;
@@ -1812,6 +1886,10 @@ void RenderingDeviceGraph::add_draw_list_bind_index_buffer(RDD::BufferID p_buffe
 }
 
 void RenderingDeviceGraph::add_draw_list_bind_pipeline(RDD::PipelineID p_pipeline, BitField<RDD::PipelineStageBits> p_pipeline_stage_bits) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_bind_pipeline(p_pipeline, p_pipeline_stage_bits);
+	}
+
 	DrawListBindPipelineInstruction *instruction = reinterpret_cast<DrawListBindPipelineInstruction *>(_allocate_draw_list_instruction(sizeof(DrawListBindPipelineInstruction)));
 	instruction->type = DrawListInstruction::TYPE_BIND_PIPELINE;
 	instruction->pipeline = p_pipeline;
@@ -1823,6 +1901,10 @@ void RenderingDeviceGraph::add_draw_list_bind_uniform_set(RDD::ShaderID p_shader
 }
 
 void RenderingDeviceGraph::add_draw_list_bind_uniform_sets(RDD::ShaderID p_shader, VectorView<RDD::UniformSetID> p_uniform_sets, uint32_t p_first_index, uint32_t p_set_count) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_bind_uniform_sets(p_shader, p_uniform_sets, p_first_index, p_set_count);
+	}
+
 	DEV_ASSERT(p_uniform_sets.size() >= p_set_count);
 
 	uint32_t instruction_size = sizeof(DrawListBindUniformSetsInstruction) + sizeof(RDD::UniformSetID) * p_set_count;
@@ -1838,6 +1920,10 @@ void RenderingDeviceGraph::add_draw_list_bind_uniform_sets(RDD::ShaderID p_shade
 }
 
 void RenderingDeviceGraph::add_draw_list_bind_vertex_buffers(VectorView<RDD::BufferID> p_vertex_buffers, VectorView<uint64_t> p_vertex_buffer_offsets) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_bind_vertex_buffers(p_vertex_buffers, p_vertex_buffer_offsets);
+	}
+
 	DEV_ASSERT(p_vertex_buffers.size() == p_vertex_buffer_offsets.size());
 
 	uint32_t instruction_size = sizeof(DrawListBindVertexBuffersInstruction) + sizeof(RDD::BufferID) * p_vertex_buffers.size() + sizeof(uint64_t) * p_vertex_buffer_offsets.size();
@@ -1858,6 +1944,10 @@ void RenderingDeviceGraph::add_draw_list_bind_vertex_buffers(VectorView<RDD::Buf
 }
 
 void RenderingDeviceGraph::add_draw_list_clear_attachments(VectorView<RDD::AttachmentClear> p_attachments_clear, VectorView<Rect2i> p_attachments_clear_rect) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_clear_attachments(p_attachments_clear, p_attachments_clear_rect);
+	}
+
 	uint32_t instruction_size = sizeof(DrawListClearAttachmentsInstruction) + sizeof(RDD::AttachmentClear) * p_attachments_clear.size() + sizeof(Rect2i) * p_attachments_clear_rect.size();
 	DrawListClearAttachmentsInstruction *instruction = reinterpret_cast<DrawListClearAttachmentsInstruction *>(_allocate_draw_list_instruction(instruction_size));
 	instruction->type = DrawListInstruction::TYPE_CLEAR_ATTACHMENTS;
@@ -1876,6 +1966,10 @@ void RenderingDeviceGraph::add_draw_list_clear_attachments(VectorView<RDD::Attac
 }
 
 void RenderingDeviceGraph::add_draw_list_draw(uint32_t p_vertex_count, uint32_t p_instance_count) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_draw(p_vertex_count, p_instance_count);
+	}
+
 	DrawListDrawInstruction *instruction = reinterpret_cast<DrawListDrawInstruction *>(_allocate_draw_list_instruction(sizeof(DrawListDrawInstruction)));
 	instruction->type = DrawListInstruction::TYPE_DRAW;
 	instruction->vertex_count = p_vertex_count;
@@ -1883,6 +1977,10 @@ void RenderingDeviceGraph::add_draw_list_draw(uint32_t p_vertex_count, uint32_t
 }
 
 void RenderingDeviceGraph::add_draw_list_draw_indexed(uint32_t p_index_count, uint32_t p_instance_count, uint32_t p_first_index) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_draw_indexed(p_index_count, p_instance_count, p_first_index);
+	}
+
 	DrawListDrawIndexedInstruction *instruction = reinterpret_cast<DrawListDrawIndexedInstruction *>(_allocate_draw_list_instruction(sizeof(DrawListDrawIndexedInstruction)));
 	instruction->type = DrawListInstruction::TYPE_DRAW_INDEXED;
 	instruction->index_count = p_index_count;
@@ -1891,6 +1989,10 @@ void RenderingDeviceGraph::add_draw_list_draw_indexed(uint32_t p_index_count, ui
 }
 
 void RenderingDeviceGraph::add_draw_list_draw_indirect(RDD::BufferID p_buffer, uint32_t p_offset, uint32_t p_draw_count, uint32_t p_stride) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_draw_indirect(p_buffer, p_offset, p_draw_count, p_stride);
+	}
+
 	DrawListDrawIndirectInstruction *instruction = reinterpret_cast<DrawListDrawIndirectInstruction *>(_allocate_draw_list_instruction(sizeof(DrawListDrawIndirectInstruction)));
 	instruction->type = DrawListInstruction::TYPE_DRAW_INDIRECT;
 	instruction->buffer = p_buffer;
@@ -1901,6 +2003,10 @@ void RenderingDeviceGraph::add_draw_list_draw_indirect(RDD::BufferID p_buffer, u
 }
 
 void RenderingDeviceGraph::add_draw_list_draw_indexed_indirect(RDD::BufferID p_buffer, uint32_t p_offset, uint32_t p_draw_count, uint32_t p_stride) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_draw_indexed_indirect(p_buffer, p_offset, p_draw_count, p_stride);
+	}
+
 	DrawListDrawIndexedIndirectInstruction *instruction = reinterpret_cast<DrawListDrawIndexedIndirectInstruction *>(_allocate_draw_list_instruction(sizeof(DrawListDrawIndexedIndirectInstruction)));
 	instruction->type = DrawListInstruction::TYPE_DRAW_INDEXED_INDIRECT;
 	instruction->buffer = p_buffer;
@@ -1911,30 +2017,50 @@ void RenderingDeviceGraph::add_draw_list_draw_indexed_indirect(RDD::BufferID p_b
 }
 
 void RenderingDeviceGraph::add_draw_list_execute_commands(RDD::CommandBufferID p_command_buffer) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_execute_commands(p_command_buffer);
+	}
+
 	DrawListExecuteCommandsInstruction *instruction = reinterpret_cast<DrawListExecuteCommandsInstruction *>(_allocate_draw_list_instruction(sizeof(DrawListExecuteCommandsInstruction)));
 	instruction->type = DrawListInstruction::TYPE_EXECUTE_COMMANDS;
 	instruction->command_buffer = p_command_buffer;
 }
 
 void RenderingDeviceGraph::add_draw_list_next_subpass(RDD::CommandBufferType p_command_buffer_type) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_next_subpass(p_command_buffer_type);
+	}
+
 	DrawListNextSubpassInstruction *instruction = reinterpret_cast<DrawListNextSubpassInstruction *>(_allocate_draw_list_instruction(sizeof(DrawListNextSubpassInstruction)));
 	instruction->type = DrawListInstruction::TYPE_NEXT_SUBPASS;
 	instruction->command_buffer_type = p_command_buffer_type;
 }
 
 void RenderingDeviceGraph::add_draw_list_set_blend_constants(const Color &p_color) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_set_blend_constants(p_color);
+	}
+
 	DrawListSetBlendConstantsInstruction *instruction = reinterpret_cast<DrawListSetBlendConstantsInstruction *>(_allocate_draw_list_instruction(sizeof(DrawListSetBlendConstantsInstruction)));
 	instruction->type = DrawListInstruction::TYPE_SET_BLEND_CONSTANTS;
 	instruction->color = p_color;
 }
 
 void RenderingDeviceGraph::add_draw_list_set_line_width(float p_width) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_set_line_width(p_width);
+	}
+
 	DrawListSetLineWidthInstruction *instruction = reinterpret_cast<DrawListSetLineWidthInstruction *>(_allocate_draw_list_instruction(sizeof(DrawListSetLineWidthInstruction)));
 	instruction->type = DrawListInstruction::TYPE_SET_LINE_WIDTH;
 	instruction->width = p_width;
 }
 
 void RenderingDeviceGraph::add_draw_list_set_push_constant(RDD::ShaderID p_shader, const void *p_data, uint32_t p_data_size) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_set_push_constant(p_shader, p_data, p_data_size);
+	}
+
 	uint32_t instruction_size = sizeof(DrawListSetPushConstantInstruction) + p_data_size;
 	DrawListSetPushConstantInstruction *instruction = reinterpret_cast<DrawListSetPushConstantInstruction *>(_allocate_draw_list_instruction(instruction_size));
 	instruction->type = DrawListInstruction::TYPE_SET_PUSH_CONSTANT;
@@ -1944,18 +2070,30 @@ void RenderingDeviceGraph::add_draw_list_set_push_constant(RDD::ShaderID p_shade
 }
 
 void RenderingDeviceGraph::add_draw_list_set_scissor(Rect2i p_rect) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_set_scissor(p_rect);
+	}
+
 	DrawListSetScissorInstruction *instruction = reinterpret_cast<DrawListSetScissorInstruction *>(_allocate_draw_list_instruction(sizeof(DrawListSetScissorInstruction)));
 	instruction->type = DrawListInstruction::TYPE_SET_SCISSOR;
 	instruction->rect = p_rect;
 }
 
 void RenderingDeviceGraph::add_draw_list_set_viewport(Rect2i p_rect) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_set_viewport(p_rect);
+	}
+
 	DrawListSetViewportInstruction *instruction = reinterpret_cast<DrawListSetViewportInstruction *>(_allocate_draw_list_instruction(sizeof(DrawListSetViewportInstruction)));
 	instruction->type = DrawListInstruction::TYPE_SET_VIEWPORT;
 	instruction->rect = p_rect;
 }
 
 void RenderingDeviceGraph::add_draw_list_uniform_set_prepare_for_use(RDD::ShaderID p_shader, RDD::UniformSetID p_uniform_set, uint32_t set_index) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_uniform_set_prepare_for_use(p_shader, p_uniform_set, set_index);
+	}
+
 	DrawListUniformSetPrepareForUseInstruction *instruction = reinterpret_cast<DrawListUniformSetPrepareForUseInstruction *>(_allocate_draw_list_instruction(sizeof(DrawListUniformSetPrepareForUseInstruction)));
 	instruction->type = DrawListInstruction::TYPE_UNIFORM_SET_PREPARE_FOR_USE;
 	instruction->shader = p_shader;
@@ -1964,6 +2102,10 @@ void RenderingDeviceGraph::add_draw_list_uniform_set_prepare_for_use(RDD::Shader
 }
 
 void RenderingDeviceGraph::add_draw_list_usage(ResourceTracker *p_tracker, ResourceUsage p_usage) {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_usage(p_tracker, p_usage);
+	}
+
 	p_tracker->reset_if_outdated(tracking_frame);
 
 	if (p_tracker->draw_list_index != draw_instruction_list.index) {
@@ -1988,6 +2130,10 @@ void RenderingDeviceGraph::add_draw_list_usages(VectorView<ResourceTracker *> p_
 }
 
 void RenderingDeviceGraph::add_draw_list_end() {
+	if (unlikely(capture != nullptr)) {
+		capture->draw_list_end();
+	}
+
 	FramebufferCache *framebuffer_cache = draw_instruction_list.framebuffer_cache;
 	int32_t command_index;
 	uint32_t clear_values_size = sizeof(RDD::RenderPassClearValue) * draw_instruction_list.attachment_clear_values.size();
@@ -2052,6 +2198,10 @@ void RenderingDeviceGraph::add_draw_list_end() {
 }
 
 void RenderingDeviceGraph::add_texture_clear(RDD::TextureID p_dst, ResourceTracker *p_dst_tracker, const Color &p_color, const RDD::TextureSubresourceRange &p_range) {
+	if (unlikely(capture != nullptr)) {
+		capture->texture_clear(p_dst, p_dst_tracker, p_color, p_range);
+	}
+
 	DEV_ASSERT(p_dst_tracker != nullptr);
 
 	int32_t command_index;
@@ -2081,6 +2231,10 @@ void RenderingDeviceGraph::add_texture_clear(RDD::TextureID p_dst, ResourceTrack
 }
 
 void RenderingDeviceGraph::add_texture_copy(RDD::TextureID p_src, ResourceTracker *p_src_tracker, RDD::TextureID p_dst, ResourceTracker *p_dst_tracker, VectorView<RDD::TextureCopyRegion> p_texture_copy_regions) {
+	if (unlikely(capture != nullptr)) {
+		capture->texture_copy(p_src, p_src_tracker, p_dst, p_dst_tracker, p_texture_copy_regions);
+	}
+
 	DEV_ASSERT(p_src_tracker != nullptr);
 	DEV_ASSERT(p_dst_tracker != nullptr);
 
@@ -2104,6 +2258,10 @@ void RenderingDeviceGraph::add_texture_copy(RDD::TextureID p_src, ResourceTracke
 }
 
 void RenderingDeviceGraph::add_texture_get_data(RDD::TextureID p_src, ResourceTracker *p_src_tracker, RDD::BufferID p_dst, VectorView<RDD::BufferTextureCopyRegion> p_buffer_texture_copy_regions, ResourceTracker *p_dst_tracker) {
+	if (unlikely(capture != nullptr)) {
+		capture->texture_get_data(p_src, p_src_tracker, p_dst, p_buffer_texture_copy_regions, p_dst_tracker);
+	}
+
 	DEV_ASSERT(p_src_tracker != nullptr);
 
 	int32_t command_index;
@@ -2132,6 +2290,10 @@ void RenderingDeviceGraph::add_texture_get_data(RDD::TextureID p_src, ResourceTr
 }
 
 void RenderingDeviceGraph::add_texture_resolve(RDD::TextureID p_src, ResourceTracker *p_src_tracker, RDD::TextureID p_dst, ResourceTracker *p_dst_tracker, uint32_t p_src_layer, uint32_t p_src_mipmap, uint32_t p_dst_layer, uint32_t p_dst_mipmap) {
+	if (unlikely(capture != nullptr)) {
+		capture->texture_resolve(p_src, p_src_tracker, p_dst, p_dst_tracker, p_src_layer, p_src_mipmap, p_dst_layer, p_dst_mipmap);
+	}
+
 	DEV_ASSERT(p_src_tracker != nullptr);
 	DEV_ASSERT(p_dst_tracker != nullptr);
 
@@ -2152,6 +2314,10 @@ void RenderingDeviceGraph::add_texture_resolve(RDD::TextureID p_src, ResourceTra
 }
 
 void RenderingDeviceGraph::add_texture_update(RDD::TextureID p_dst, ResourceTracker *p_dst_tracker, VectorView<RecordedBufferToTextureCopy> p_buffer_copies, VectorView<ResourceTracker *> p_buffer_trackers) {
+	if (unlikely(capture != nullptr)) {
+		capture->texture_update(p_dst, p_dst_tracker, p_buffer_copies, p_buffer_trackers);
+	}
+
 	DEV_ASSERT(p_dst_tracker != nullptr);
 
 	int32_t command_index;
@@ -2189,6 +2355,10 @@ void RenderingDeviceGraph::add_texture_update(RDD::TextureID p_dst, ResourceTrac
 }
 
 void RenderingDeviceGraph::add_capture_timestamp(RDD::QueryPoolID p_query_pool, uint32_t p_index) {
+	if (unlikely(capture != nullptr)) {
+		capture->capture_timestamp(p_query_pool, p_index);
+	}
+
 	int32_t command_index;
 	RecordedCaptureTimestampCommand *command = static_cast<RecordedCaptureTimestampCommand *>(_allocate_command(sizeof(RecordedCaptureTimestampCommand), command_index));
 	command->type = RecordedCommand::TYPE_CAPTURE_TIMESTAMP;
@@ -2199,6 +2369,10 @@ void RenderingDeviceGraph::add_capture_timestamp(RDD::QueryPoolID p_query_pool,
 }
 
 void RenderingDeviceGraph::add_synchronization() {
+	if (unlikely(capture != nullptr)) {
+		capture->synchronization();
+	}
+
 	// Synchronization is only acknowledged if commands have been recorded on the graph already.
 	if (command_count > 0) {
 		command_synchronization_pending = true;
@@ -2206,6 +2380,10 @@ void RenderingDeviceGraph::add_synchronization() {
 }
 
 void RenderingDeviceGraph::begin_label(const String &p_label_name, const Color &p_color) {
+	if (unlikely(capture != nullptr)) {
+		capture->begin_label(p_label_name, p_color);
+	}
+
 	uint32_t command_label_offset = command_label_chars.size();
 	PackedByteArray command_label_utf8 = p_label_name.to_utf8_buffer();
 	int command_label_utf8_size = command_label_utf8.size();
@@ -2219,10 +2397,21 @@ void RenderingDeviceGraph::begin_label(const String &p_label_name, const Color &
 }
 
 void RenderingDeviceGraph::end_label() {
+	if (unlikely(capture != nullptr)) {
+		capture->end_label();
+	}
+
 	command_label_index = -1;
 }
 
 void RenderingDeviceGraph::end(bool p_reorder_commands, bool p_full_barriers, RDD::CommandBufferID &r_command_buffer, CommandBufferPool &r_command_buffer_pool) {
+	statistics = Statistics();
+	statistics.command_count = command_count;
+
+	if (unlikely(capture != nullptr)) {
+		capture->frame_end();
+	}
+
 	if (command_count == 0) {
 		// No commands have been logged, do nothing.
 		return;
@@ -2358,6 +2547,14 @@ void RenderingDeviceGraph::end(bool p_reorder_commands, bool p_full_barriers, RD
 			_print_render_commands(commands_sorted.ptr(), command_count);
 #endif
 
+			for (uint32_t i = 0; i < command_count; i++) {
+				if (commands_sorted[i].index != i) {
+					statistics.reordered_command_count++;
+				}
+			}
+
+			statistics.level_count = commands_sorted[command_count - 1].level + 1;
+
 #if PRINT_COMMAND_RECORDING
 			print_line(vformat("Recording %d commands", command_count));
 #endif
@@ -2387,6 +2584,7 @@ void RenderingDeviceGraph::end(bool p_reorder_commands, bool p_full_barriers, RD
 			print_line("COMMANDS", command_count, "LEVELS", current_level + 1);
 #endif
 		} else {
+			statistics.level_count = command_count;
 			for (uint32_t i = 0; i < command_count; i++) {
 				_group_barriers_for_render_commands(r_command_buffer, &commands_sorted[i], 1, p_full_barriers);
 				_run_render_commands(i, &commands_sorted[i], 1, r_command_buffer, r_command_buffer_pool, current_label_index, current_label_level);
@@ -2408,6 +2606,10 @@ void RenderingDeviceGraph::end(bool p_reorder_commands, bool p_full_barriers, RD
 static uint32_t resource_tracker_total = 0;
 #endif
 
+void RenderingDeviceGraph::set_capture(RenderingDeviceGraphCapture *p_capture) {
+	capture = p_capture;
+}
+
 RenderingDeviceGraph::ResourceTracker *RenderingDeviceGraph::resource_tracker_create() {
 #if PRINT_RESOURCE_TRACKER_TOTAL
 	print_line("Resource trackers:", ++resource_tracker_total);
@@ -37,6 +37,8 @@
 #include "rendering_device_commons.h"
 #include "rendering_device_driver.h"
 
+class RenderingDeviceGraphCapture;
+
 // Buffer barriers have not shown any significant improvement or shown to be
 // even detrimental to performance. However, there are currently some known
 // cases where using them can solve problems that using singular memory
@@ -237,6 +239,17 @@ public:
 		ATTACHMENT_OPERATION_IGNORE,
 	};
 
+	// Counters gathered by the last call to end().
+	struct Statistics {
+		uint32_t command_count = 0;
+		uint32_t level_count = 0;
+		uint32_t reordered_command_count = 0;
+		uint32_t barrier_group_count = 0;
+		uint32_t memory_barrier_count = 0;
+		uint32_t texture_barrier_count = 0;
+		uint32_t buffer_barrier_count = 0;
+	};
+
 private:
 	struct InstructionList {
 		LocalVector<uint8_t> data;
@@ -727,6 +740,8 @@ private:
 	WorkaroundsState workarounds_state;
 	TightLocalVector<Frame> frames;
 	uint32_t frame = 0;
+	Statistics statistics;
+	RenderingDeviceGraphCapture *capture = nullptr;
 
 #ifdef DEV_ENABLED
 	RBMap<ResourceTracker *, uint32_t> write_dependency_counters;
@@ -820,6 +835,9 @@ public:
 	void begin_label(const String &p_label_name, const Color &p_color);
 	void end_label();
 	void end(bool p_reorder_commands, bool p_full_barriers, RDD::CommandBufferID &r_command_buffer, CommandBufferPool &r_command_buffer_pool);
+	const Statistics &get_statistics() const { return statistics; }
+	void set_capture(RenderingDeviceGraphCapture *p_capture);
+	RenderingDeviceGraphCapture *get_capture() const { return capture; }
 	static ResourceTracker *resource_tracker_create();
 	static void resource_tracker_free(ResourceTracker *p_tracker);
 	static FramebufferCache *framebuffer_cache_create();
@@ -0,0 +1,1035 @@
+/**************************************************************************/
+/*  rendering_device_graph_capture.cpp                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "rendering_device_graph_capture.h"
+
+static const char *capture_file_header = "RDGC";
+
+bool RenderingDeviceGraphCapture::TrackerDescription::operator==(const TrackerDescription &p_other) const {
+	return parent == p_other.parent &&
+			buffer_driver_id == p_other.buffer_driver_id &&
+			texture_driver_id == p_other.texture_driver_id &&
+			int64_t(texture_subresources.aspect) == int64_t(p_other.texture_subresources.aspect) &&
+			texture_subresources.base_mipmap == p_other.texture_subresources.base_mipmap &&
+			texture_subresources.mipmap_count == p_other.texture_subresources.mipmap_count &&
+			texture_subresources.base_layer == p_other.texture_subresources.base_layer &&
+			texture_subresources.layer_count == p_other.texture_subresources.layer_count &&
+			texture_size == p_other.texture_size &&
+			texture_usage == p_other.texture_usage &&
+			texture_slice_rect == p_other.texture_slice_rect &&
+			is_discardable == p_other.is_discardable;
+}
+
+uint32_t RenderingDeviceGraphCapture::_tracker_id(RDG::ResourceTracker *p_tracker) {
+	if (p_tracker == nullptr) {
+		return INVALID_ID;
+	}
+
+	// Parents must always be described before their slices.
+	uint32_t parent_id = _tracker_id(p_tracker->parent);
+
+	TrackerDescription description;
+	description.parent = parent_id;
+	description.buffer_driver_id = p_tracker->buffer_driver_id.id;
+	description.texture_driver_id = p_tracker->texture_driver_id.id;
+	description.texture_subresources = p_tracker->texture_subresources;
+	description.texture_size = p_tracker->texture_size;
+	description.texture_usage = p_tracker->texture_usage;
+	description.texture_slice_rect = p_tracker->parent != nullptr ? p_tracker->texture_slice_or_dirty_rect : Rect2i();
+	description.is_discardable = p_tracker->is_discardable;
+
+	uint32_t id;
+	HashMap<RDG::ResourceTracker *, uint32_t>::Iterator it = tracker_ids.find(p_tracker);
+	if (it != tracker_ids.end()) {
+		id = it->value;
+		if (tracker_descriptions[id] == description) {
+			return id;
+		}
+	} else {
+		id = tracker_descriptions.size();
+		tracker_ids[p_tracker] = id;
+		tracker_descriptions.push_back(description);
+	}
+
+	tracker_descriptions[id] = description;
+
+	_push_op(OP_DEFINE_TRACKER);
+	_push<uint32_t>(id);
+	_push<uint32_t>(description.parent);
+	_push<uint64_t>(description.buffer_driver_id);
+	_push<uint64_t>(description.texture_driver_id);
+	_push(description.texture_subresources);
+	_push(description.texture_size);
+	_push<uint32_t>(description.texture_usage);
+	_push(description.texture_slice_rect);
+	_push<uint8_t>(description.is_discardable);
+
+	// The usage the resource is in at the moment it's first seen is required to generate the same initial barriers.
+	_push<uint32_t>(p_tracker->usage);
+	_push<int64_t>(p_tracker->usage_access);
+	_push<int64_t>(p_tracker->command_frame == tracking_frame ? p_tracker->previous_frame_stages : p_tracker->current_frame_stages);
+
+	return id;
+}
+
+uint32_t RenderingDeviceGraphCapture::_framebuffer_cache_id(RDG::FramebufferCache *p_framebuffer_cache) {
+	if (p_framebuffer_cache == nullptr) {
+		return INVALID_ID;
+	}
+
+	HashMap<RDG::FramebufferCache *, uint32_t>::Iterator it = framebuffer_cache_ids.find(p_framebuffer_cache);
+	if (it != framebuffer_cache_ids.end()) {
+		return it->value;
+	}
+
+	thread_local LocalVector<uint32_t> attachment_tracker_ids;
+	attachment_tracker_ids.clear();
+	for (RDG::ResourceTracker *tracker : p_framebuffer_cache->trackers) {
+		attachment_tracker_ids.push_back(_tracker_id(tracker));
+	}
+
+	uint32_t id = framebuffer_cache_ids.size();
+	framebuffer_cache_ids[p_framebuffer_cache] = id;
+
+	_push_op(OP_DEFINE_FRAMEBUFFER_CACHE);
+	_push<uint32_t>(id);
+	_push<uint32_t>(p_framebuffer_cache->width);
+	_push<uint32_t>(p_framebuffer_cache->height);
+	_push<uint32_t>(p_framebuffer_cache->textures.size());
+	for (RDD::TextureID texture : p_framebuffer_cache->textures) {
+		_push<uint64_t>(texture.id);
+	}
+
+	_push_array(VectorView<uint32_t>(attachment_tracker_ids));
+
+	return id;
+}
+
+Error RenderingDeviceGraphCapture::open(const String &p_path) {
+	close();
+
+	Error err;
+	file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(file.is_null(), err, vformat("Unable to open the rendering device graph capture file at '%s'.", p_path));
+
+	file->store_buffer((const uint8_t *)capture_file_header, 4);
+	file->store_32(FORMAT_VERSION);
+	return OK;
+}
+
+void RenderingDeviceGraphCapture::close() {
+	if (file.is_valid()) {
+		file->flush();
+		file.unref();
+	}
+
+	frame_data.clear();
+	tracker_ids.clear();
+	tracker_descriptions.clear();
+	framebuffer_cache_ids.clear();
+	frames_captured = 0;
+}
+
+void RenderingDeviceGraphCapture::frame_begin(int64_t p_tracking_frame) {
+	frame_data.clear();
+	tracking_frame = p_tracking_frame;
+
+	// Definitions are per frame, so each frame can be replayed on its own.
+	tracker_ids.clear();
+	tracker_descriptions.clear();
+	framebuffer_cache_ids.clear();
+}
+
+void RenderingDeviceGraphCapture::frame_end() {
+	if (file.is_null()) {
+		return;
+	}
+
+	file->store_32(frame_data.size());
+	file->store_buffer(frame_data.ptr(), frame_data.size());
+	frames_captured++;
+}
+
+void RenderingDeviceGraphCapture::buffer_clear(RDD::BufferID p_dst, RDG::ResourceTracker *p_dst_tracker, uint32_t p_offset, uint32_t p_size) {
+	uint32_t dst_tracker = _tracker_id(p_dst_tracker);
+	_push_op(OP_BUFFER_CLEAR);
+	_push<uint64_t>(p_dst.id);
+	_push<uint32_t>(dst_tracker);
+	_push<uint32_t>(p_offset);
+	_push<uint32_t>(p_size);
+}
+
+void RenderingDeviceGraphCapture::buffer_copy(RDD::BufferID p_src, RDG::ResourceTracker *p_src_tracker, RDD::BufferID p_dst, RDG::ResourceTracker *p_dst_tracker, const RDD::BufferCopyRegion &p_region) {
+	uint32_t src_tracker = _tracker_id(p_src_tracker);
+	uint32_t dst_tracker = _tracker_id(p_dst_tracker);
+	_push_op(OP_BUFFER_COPY);
+	_push<uint64_t>(p_src.id);
+	_push<uint32_t>(src_tracker);
+	_push<uint64_t>(p_dst.id);
+	_push<uint32_t>(dst_tracker);
+	_push(p_region);
+}
+
+void RenderingDeviceGraphCapture::buffer_get_data(RDD::BufferID p_src, RDG::ResourceTracker *p_src_tracker, RDD::BufferID p_dst, const RDD::BufferCopyRegion &p_region) {
+	uint32_t src_tracker = _tracker_id(p_src_tracker);
+	_push_op(OP_BUFFER_GET_DATA);
+	_push<uint64_t>(p_src.id);
+	_push<uint32_t>(src_tracker);
+	_push<uint64_t>(p_dst.id);
+	_push(p_region);
+}
+
+void RenderingDeviceGraphCapture::buffer_update(RDD::BufferID p_dst, RDG::ResourceTracker *p_dst_tracker, VectorView<RDG::RecordedBufferCopy> p_buffer_copies) {
+	uint32_t dst_tracker = _tracker_id(p_dst_tracker);
+	_push_op(OP_BUFFER_UPDATE);
+	_push<uint64_t>(p_dst.id);
+	_push<uint32_t>(dst_tracker);
+	_push_array(p_buffer_copies);
+}
+
+void RenderingDeviceGraphCapture::driver_callback(VectorView<RDG::ResourceTracker *> p_trackers, VectorView<RDG::ResourceUsage> p_usages) {
+	thread_local LocalVector<uint32_t> ids;
+	ids.clear();
+	for (uint32_t i = 0; i < p_trackers.size(); i++) {
+		ids.push_back(_tracker_id(p_trackers[i]));
+	}
+
+	_push_op(OP_DRIVER_CALLBACK);
+	_push_array(VectorView<uint32_t>(ids));
+	_push_array(p_usages);
+}
+
+void RenderingDeviceGraphCapture::compute_list_begin(RDD::BreadcrumbMarker p_phase, uint32_t p_breadcrumb_data) {
+	_push_op(OP_COMPUTE_LIST_BEGIN);
+	_push<uint32_t>(p_phase);
+	_push<uint32_t>(p_breadcrumb_data);
+}
+
+void RenderingDeviceGraphCapture::compute_list_bind_pipeline(RDD::PipelineID p_pipeline) {
+	_push_op(OP_COMPUTE_LIST_BIND_PIPELINE);
+	_push<uint64_t>(p_pipeline.id);
+}
+
+void RenderingDeviceGraphCapture::compute_list_bind_uniform_sets(RDD::ShaderID p_shader, VectorView<RDD::UniformSetID> p_uniform_sets, uint32_t p_first_set_index, uint32_t p_set_count) {
+	_push_op(OP_COMPUTE_LIST_BIND_UNIFORM_SETS);
+	_push<uint64_t>(p_shader.id);
+	_push<uint32_t>(p_first_set_index);
+	_push<uint32_t>(p_set_count);
+	for (uint32_t i = 0; i < p_set_count; i++) {
+		_push<uint64_t>(p_uniform_sets[i].id);
+	}
+}
+
+void RenderingDeviceGraphCapture::compute_list_dispatch(uint32_t p_x_groups, uint32_t p_y_groups, uint32_t p_z_groups) {
+	_push_op(OP_COMPUTE_LIST_DISPATCH);
+	_push<uint32_t>(p_x_groups);
+	_push<uint32_t>(p_y_groups);
+	_push<uint32_t>(p_z_groups);
+}
+
+void RenderingDeviceGraphCapture::compute_list_dispatch_indirect(RDD::BufferID p_buffer, uint32_t p_offset) {
+	_push_op(OP_COMPUTE_LIST_DISPATCH_INDIRECT);
+	_push<uint64_t>(p_buffer.id);
+	_push<uint32_t>(p_offset);
+}
+
+void RenderingDeviceGraphCapture::compute_list_set_push_constant(RDD::ShaderID p_shader, const void *p_data, uint32_t p_data_size) {
+	_push_op(OP_COMPUTE_LIST_SET_PUSH_CONSTANT);
+	_push<uint64_t>(p_shader.id);
+	_push<uint32_t>(p_data_size);
+	_push_data(p_data, p_data_size);
+}
+
+void RenderingDeviceGraphCapture::compute_list_uniform_set_prepare_for_use(RDD::ShaderID p_shader, RDD::UniformSetID p_uniform_set, uint32_t p_set_index) {
+	_push_op(OP_COMPUTE_LIST_UNIFORM_SET_PREPARE_FOR_USE);
+	_push<uint64_t>(p_shader.id);
+	_push<uint64_t>(p_uniform_set.id);
+	_push<uint32_t>(p_set_index);
+}
+
+void RenderingDeviceGraphCapture::compute_list_usage(RDG::ResourceTracker *p_tracker, RDG::ResourceUsage p_usage) {
+	uint32_t tracker = _tracker_id(p_tracker);
+	_push_op(OP_COMPUTE_LIST_USAGE);
+	_push<uint32_t>(tracker);
+	_push<uint32_t>(p_usage);
+}
+
+void RenderingDeviceGraphCapture::compute_list_end() {
+	_push_op(OP_COMPUTE_LIST_END);
+}
+
+void RenderingDeviceGraphCapture::draw_list_begin(RDG::FramebufferCache *p_framebuffer_cache, RDD::RenderPassID p_render_pass, RDD::FramebufferID p_framebuffer, Rect2i p_region, VectorView<RDG::AttachmentOperation> p_attachment_operations, VectorView<RDD::RenderPassClearValue> p_attachment_clear_values, bool p_uses_color, bool p_uses_depth, uint32_t p_breadcrumb, bool p_split_cmd_buffer) {
+	uint32_t framebuffer_cache = _framebuffer_cache_id(p_framebuffer_cache);
+	_push_op(OP_DRAW_LIST_BEGIN);
+	_push<uint32_t>(framebuffer_cache);
+	_push<uint64_t>(p_render_pass.id);
+	_push<uint64_t>(p_framebuffer.id);
+	_push(p_region);
+	_push_array(p_attachment_operations);
+	_push_array(p_attachment_clear_values);
+	_push<uint8_t>(p_uses_color);
+	_push<uint8_t>(p_uses_depth);
+	_push<uint32_t>(p_breadcrumb);
+	_push<uint8_t>(p_split_cmd_buffer);
+}
+
+void RenderingDeviceGraphCapture::draw_list_bind_index_buffer(RDD::BufferID p_buffer, RDD::IndexBufferFormat p_format, uint32_t p_offset) {
+	_push_op(OP_DRAW_LIST_BIND_INDEX_BUFFER);
+	_push<uint64_t>(p_buffer.id);
+	_push<uint32_t>(p_format);
+	_push<uint32_t>(p_offset);
+}
+
+void RenderingDeviceGraphCapture::draw_list_bind_pipeline(RDD::PipelineID p_pipeline, BitField<RDD::PipelineStageBits> p_pipeline_stage_bits) {
+	_push_op(OP_DRAW_LIST_BIND_PIPELINE);
+	_push<uint64_t>(p_pipeline.id);
+	_push<int64_t>(p_pipeline_stage_bits);
+}
+
+void RenderingDeviceGraphCapture::draw_list_bind_uniform_sets(RDD::ShaderID p_shader, VectorView<RDD::UniformSetID> p_uniform_sets, uint32_t p_first_index, uint32_t p_set_count) {
+	_push_op(OP_DRAW_LIST_BIND_UNIFORM_SETS);
+	_push<uint64_t>(p_shader.id);
+	_push<uint32_t>(p_first_index);
+	_push<uint32_t>(p_set_count);
+	for (uint32_t i = 0; i < p_set_count; i++) {
+		_push<uint64_t>(p_uniform_sets[i].id);
+	}
+}
+
+void RenderingDeviceGraphCapture::draw_list_bind_vertex_buffers(VectorView<RDD::BufferID> p_vertex_buffers, VectorView<uint64_t> p_vertex_buffer_offsets) {
+	_push_op(OP_DRAW_LIST_BIND_VERTEX_BUFFERS);
+	_push<uint32_t>(p_vertex_buffers.size());
+	for (uint32_t i = 0; i < p_vertex_buffers.size(); i++) {
+		_push<uint64_t>(p_vertex_buffers[i].id);
+	}
+
+	_push_array(p_vertex_buffer_offsets);
+}
+
+void RenderingDeviceGraphCapture::draw_list_clear_attachments(VectorView<RDD::AttachmentClear> p_attachments_clear, VectorView<Rect2i> p_attachments_clear_rect) {
+	_push_op(OP_DRAW_LIST_CLEAR_ATTACHMENTS);
+	_push_array(p_attachments_clear);
+	_push_array(p_attachments_clear_rect);
+}
+
+void RenderingDeviceGraphCapture::draw_list_draw(uint32_t p_vertex_count, uint32_t p_instance_count) {
+	_push_op(OP_DRAW_LIST_DRAW);
+	_push<uint32_t>(p_vertex_count);
+	_push<uint32_t>(p_instance_count);
+}
+
+void RenderingDeviceGraphCapture::draw_list_draw_indexed(uint32_t p_index_count, uint32_t p_instance_count, uint32_t p_first_index) {
+	_push_op(OP_DRAW_LIST_DRAW_INDEXED);
+	_push<uint32_t>(p_index_count);
+	_push<uint32_t>(p_instance_count);
+	_push<uint32_t>(p_first_index);
+}
+
+void RenderingDeviceGraphCapture::draw_list_draw_indirect(RDD::BufferID p_buffer, uint32_t p_offset, uint32_t p_draw_count, uint32_t p_stride) {
+	_push_op(OP_DRAW_LIST_DRAW_INDIRECT);
+	_push<uint64_t>(p_buffer.id);
+	_push<uint32_t>(p_offset);
+	_push<uint32_t>(p_draw_count);
+	_push<uint32_t>(p_stride);
+}
+
+void RenderingDeviceGraphCapture::draw_list_draw_indexed_indirect(RDD::BufferID p_buffer, uint32_t p_offset, uint32_t p_draw_count, uint32_t p_stride) {
+	_push_op(OP_DRAW_LIST_DRAW_INDEXED_INDIRECT);
+	_push<uint64_t>(p_buffer.id);
+	_push<uint32_t>(p_offset);
+	_push<uint32_t>(p_draw_count);
+	_push<uint32_t>(p_stride);
+}
+
+void RenderingDeviceGraphCapture::draw_list_execute_commands(RDD::CommandBufferID p_command_buffer) {
+	_push_op(OP_DRAW_LIST_EXECUTE_COMMANDS);
+	_push<uint64_t>(p_command_buffer.id);
+}
+
+void RenderingDeviceGraphCapture::draw_list_next_subpass(RDD::CommandBufferType p_command_buffer_type) {
+	_push_op(OP_DRAW_LIST_NEXT_SUBPASS);
+	_push<uint32_t>(p_command_buffer_type);
+}
+
+void RenderingDeviceGraphCapture::draw_list_set_blend_constants(const Color &p_color) {
+	_push_op(OP_DRAW_LIST_SET_BLEND_CONSTANTS);
+	_push(p_color);
+}
+
+void RenderingDeviceGraphCapture::draw_list_set_line_width(float p_width) {
+	_push_op(OP_DRAW_LIST_SET_LINE_WIDTH);
+	_push(p_width);
+}
+
+void RenderingDeviceGraphCapture::draw_list_set_push_constant(RDD::ShaderID p_shader, const void *p_data, uint32_t p_data_size) {
+	_push_op(OP_DRAW_LIST_SET_PUSH_CONSTANT);
+	_push<uint64_t>(p_shader.id);
+	_push<uint32_t>(p_data_size);
+	_push_data(p_data, p_data_size);
+}
+
+void RenderingDeviceGraphCapture::draw_list_set_scissor(Rect2i p_rect) {
+	_push_op(OP_DRAW_LIST_SET_SCISSOR);
+	_push(p_rect);
+}
+
+void RenderingDeviceGraphCapture::draw_list_set_viewport(Rect2i p_rect) {
+	_push_op(OP_DRAW_LIST_SET_VIEWPORT);
+	_push(p_rect);
+}
+
+void RenderingDeviceGraphCapture::draw_list_uniform_set_prepare_for_use(RDD::ShaderID p_shader, RDD::UniformSetID p_uniform_set, uint32_t p_set_index) {
+	_push_op(OP_DRAW_LIST_UNIFORM_SET_PREPARE_FOR_USE);
+	_push<uint64_t>(p_shader.id);
+	_push<uint64_t>(p_uniform_set.id);
+	_push<uint32_t>(p_set_index);
+}
+
+void RenderingDeviceGraphCapture::draw_list_usage(RDG::ResourceTracker *p_tracker, RDG::ResourceUsage p_usage) {
+	uint32_t tracker = _tracker_id(p_tracker);
+	_push_op(OP_DRAW_LIST_USAGE);
+	_push<uint32_t>(tracker);
+	_push<uint32_t>(p_usage);
+}
+
+void RenderingDeviceGraphCapture::draw_list_end() {
+	_push_op(OP_DRAW_LIST_END);
+}
+
+void RenderingDeviceGraphCapture::texture_clear(RDD::TextureID p_dst, RDG::ResourceTracker *p_dst_tracker, const Color &p_color, const RDD::TextureSubresourceRange &p_range) {
+	uint32_t dst_tracker = _tracker_id(p_dst_tracker);
+	_push_op(OP_TEXTURE_CLEAR);
+	_push<uint64_t>(p_dst.id);
+	_push<uint32_t>(dst_tracker);
+	_push(p_color);
+	_push(p_range);
+}
+
+void RenderingDeviceGraphCapture::texture_copy(RDD::TextureID p_src, RDG::ResourceTracker *p_src_tracker, RDD::TextureID p_dst, RDG::ResourceTracker *p_dst_tracker, VectorView<RDD::TextureCopyRegion> p_texture_copy_regions) {
+	uint32_t src_tracker = _tracker_id(p_src_tracker);
+	uint32_t dst_tracker = _tracker_id(p_dst_tracker);
+	_push_op(OP_TEXTURE_COPY);
+	_push<uint64_t>(p_src.id);
+	_push<uint32_t>(src_tracker);
+	_push<uint64_t>(p_dst.id);
+	_push<uint32_t>(dst_tracker);
+	_push_array(p_texture_copy_regions);
+}
+
+void RenderingDeviceGraphCapture::texture_get_data(RDD::TextureID p_src, RDG::ResourceTracker *p_src_tracker, RDD::BufferID p_dst, VectorView<RDD::BufferTextureCopyRegion> p_buffer_texture_copy_regions, RDG::ResourceTracker *p_dst_tracker) {
+	uint32_t src_tracker = _tracker_id(p_src_tracker);
+	uint32_t dst_tracker = _tracker_id(p_dst_tracker);
+	_push_op(OP_TEXTURE_GET_DATA);
+	_push<uint64_t>(p_src.id);
+	_push<uint32_t>(src_tracker);
+	_push<uint64_t>(p_dst.id);
+	_push<uint32_t>(dst_tracker);
+	_push_array(p_buffer_texture_copy_regions);
+}
+
+void RenderingDeviceGraphCapture::texture_resolve(RDD::TextureID p_src, RDG::ResourceTracker *p_src_tracker, RDD::TextureID p_dst, RDG::ResourceTracker *p_dst_tracker, uint32_t p_src_layer, uint32_t p_src_mipmap, uint32_t p_dst_layer, uint32_t p_dst_mipmap) {
+	uint32_t src_tracker = _tracker_id(p_src_tracker);
+	uint32_t dst_tracker = _tracker_id(p_dst_tracker);
+	_push_op(OP_TEXTURE_RESOLVE);
+	_push<uint64_t>(p_src.id);
+	_push<uint32_t>(src_tracker);
+	_push<uint64_t>(p_dst.id);
+	_push<uint32_t>(dst_tracker);
+	_push<uint32_t>(p_src_layer);
+	_push<uint32_t>(p_src_mipmap);
+	_push<uint32_t>(p_dst_layer);
+	_push<uint32_t>(p_dst_mipmap);
+}
+
+void RenderingDeviceGraphCapture::texture_update(RDD::TextureID p_dst, RDG::ResourceTracker *p_dst_tracker, VectorView<RDG::RecordedBufferToTextureCopy> p_buffer_copies, VectorView<RDG::ResourceTracker *> p_buffer_trackers) {
+	thread_local LocalVector<uint32_t> buffer_tracker_ids;
+	buffer_tracker_ids.clear();
+	for (uint32_t i = 0; i < p_buffer_trackers.size(); i++) {
+		buffer_tracker_ids.push_back(_tracker_id(p_buffer_trackers[i]));
+	}
+
+	uint32_t dst_tracker = _tracker_id(p_dst_tracker);
+	_push_op(OP_TEXTURE_UPDATE);
+	_push<uint64_t>(p_dst.id);
+	_push<uint32_t>(dst_tracker);
+	_push_array(p_buffer_copies);
+	_push_array(VectorView<uint32_t>(buffer_tracker_ids));
+}
+
+void RenderingDeviceGraphCapture::capture_timestamp(RDD::QueryPoolID p_query_pool, uint32_t p_index) {
+	_push_op(OP_CAPTURE_TIMESTAMP);
+	_push<uint64_t>(p_query_pool.id);
+	_push<uint32_t>(p_index);
+}
+
+void RenderingDeviceGraphCapture::synchronization() {
+	_push_op(OP_SYNCHRONIZATION);
+}
+
+void RenderingDeviceGraphCapture::begin_label(const String &p_label_name, const Color &p_color) {
+	CharString label_utf8 = p_label_name.utf8();
+	_push_op(OP_BEGIN_LABEL);
+	_push<uint32_t>(label_utf8.length());
+	_push_data(label_utf8.get_data(), label_utf8.length());
+	_push(p_color);
+}
+
+void RenderingDeviceGraphCapture::end_label() {
+	_push_op(OP_END_LABEL);
+}
+
+RenderingDeviceGraphCapture::~RenderingDeviceGraphCapture() {
+	close();
+}
+
+/****************/
+/**** REPLAY ****/
+/****************/
+
+namespace {
+
+// Sequential reader over the data of a captured frame. Reading past the end of
+// the data flags the reader as failed and returns zeroed values instead.
+struct CaptureReader {
+	const uint8_t *ptr = nullptr;
+	uint32_t size = 0;
+	uint32_t offset = 0;
+	bool failed = false;
+
+	const uint8_t *read_data(uint32_t p_size) {
+		if (failed || p_size > size - offset) {
+			failed = true;
+			return nullptr;
+		}
+
+		const uint8_t *data = &ptr[offset];
+		offset += p_size;
+		return data;
+	}
+
+	template <typename T>
+	T read() {
+		T value = T();
+		const uint8_t *data = read_data(sizeof(T));
+		if (data != nullptr) {
+			memcpy((void *)&value, data, sizeof(T));
+		}
+
+		return value;
+	}
+
+	template <typename T>
+	void read_array(LocalVector<T> &r_array) {
+		uint32_t count = read<uint32_t>();
+		const uint8_t *data = read_data(count * sizeof(T));
+		if (data != nullptr) {
+			r_array.resize(count);
+			memcpy((void *)r_array.ptr(), data, count * sizeof(T));
+		} else {
+			r_array.clear();
+		}
+	}
+
+	template <typename T>
+	void read_ids(LocalVector<T> &r_ids, uint32_t p_count) {
+		r_ids.resize(p_count);
+		for (uint32_t i = 0; i < p_count && !failed; i++) {
+			r_ids[i] = T(read<uint64_t>());
+		}
+	}
+
+	bool is_at_end() const {
+		return offset >= size;
+	}
+};
+
+} // namespace
+
+RDG::ResourceTracker *RenderingDeviceGraphReplay::_get_tracker(uint32_t p_id) const {
+	if (p_id == RenderingDeviceGraphCapture::INVALID_ID) {
+		return nullptr;
+	}
+
+	ERR_FAIL_UNSIGNED_INDEX_V(p_id, trackers.size(), nullptr);
+	return trackers[p_id];
+}
+
+RDG::FramebufferCache *RenderingDeviceGraphReplay::_get_framebuffer_cache(uint32_t p_id) const {
+	if (p_id == RenderingDeviceGraphCapture::INVALID_ID) {
+		return nullptr;
+	}
+
+	ERR_FAIL_UNSIGNED_INDEX_V(p_id, frame_framebuffer_caches.size(), nullptr);
+	return frame_framebuffer_caches[p_id];
+}
+
+bool RenderingDeviceGraphReplay::_textures_equal(const LocalVector<RDD::TextureID> &p_a, const LocalVector<RDD::TextureID> &p_b) {
+	if (p_a.size() != p_b.size()) {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < p_a.size(); i++) {
+		if (p_a[i] != p_b[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void RenderingDeviceGraphReplay::_free_trackers() {
+	// Parents are always described before their slices, so freeing in reverse order frees the slices first.
+	for (int64_t i = int64_t(trackers.size()) - 1; i >= 0; i--) {
+		RDG::resource_tracker_free(trackers[i]);
+	}
+
+	trackers.clear();
+}
+
+Error RenderingDeviceGraphReplay::load(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Unable to open the rendering device graph capture file at '%s'.", p_path));
+
+	char header[5] = { 0, 0, 0, 0, 0 };
+	f->get_buffer((uint8_t *)header, 4);
+	ERR_FAIL_COND_V_MSG(header != String(capture_file_header), ERR_FILE_UNRECOGNIZED, vformat("'%s' is not a rendering device graph capture.", p_path));
+
+	uint32_t file_version = f->get_32();
+	ERR_FAIL_COND_V_MSG(file_version != RenderingDeviceGraphCapture::FORMAT_VERSION, ERR_FILE_UNRECOGNIZED, vformat("Unsupported rendering device graph capture version %d.", file_version));
+
+	frames.clear();
+	while (f->get_position() < f->get_length()) {
+		uint32_t frame_size = f->get_32();
+		Vector<uint8_t> frame_data;
+		frame_data.resize(frame_size);
+		uint64_t read_size = f->get_buffer(frame_data.ptrw(), frame_size);
+		ERR_FAIL_COND_V_MSG(read_size != frame_size, ERR_FILE_CORRUPT, "Truncated frame found in the rendering device graph capture.");
+		frames.push_back(frame_data);
+	}
+
+	return OK;
+}
+
+Error RenderingDeviceGraphReplay::replay_frame(uint32_t p_frame, RenderingDeviceGraph &p_graph) {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_frame, frames.size(), ERR_INVALID_PARAMETER);
+
+	typedef RenderingDeviceGraphCapture Capture;
+
+	CaptureReader reader;
+	reader.ptr = frames[p_frame].ptr();
+	reader.size = frames[p_frame].size();
+
+	// Trackers are described again on every frame, so the ones from the previous frame can be discarded.
+	_free_trackers();
+	frame_framebuffer_caches.clear();
+
+	// Scratch storage reused across operations.
+	LocalVector<uint32_t> ids;
+	LocalVector<RDG::ResourceTracker *> op_trackers;
+	LocalVector<RDG::ResourceUsage> op_usages;
+	LocalVector<RDD::UniformSetID> uniform_sets;
+	LocalVector<RDD::BufferID> buffers;
+	LocalVector<uint64_t> offsets;
+	LocalVector<RDG::RecordedBufferCopy> buffer_copies;
+	LocalVector<RDG::RecordedBufferToTextureCopy> buffer_to_texture_copies;
+	LocalVector<RDD::TextureCopyRegion> texture_copy_regions;
+	LocalVector<RDD::BufferTextureCopyRegion> buffer_texture_copy_regions;
+	LocalVector<RDG::AttachmentOperation> attachment_operations;
+	LocalVector<RDD::RenderPassClearValue> clear_values;
+	LocalVector<RDD::AttachmentClear> attachment_clears;
+	LocalVector<Rect2i> rects;
+
+	while (!reader.is_at_end() && !reader.failed) {
+		Capture::Op op = Capture::Op(reader.read<uint32_t>());
+		switch (op) {
+			case Capture::OP_DEFINE_TRACKER: {
+				uint32_t id = reader.read<uint32_t>();
+				uint32_t parent = reader.read<uint32_t>();
+				ERR_FAIL_COND_V(id > trackers.size(), ERR_FILE_CORRUPT);
+				if (id == trackers.size()) {
+					trackers.push_back(RDG::resource_tracker_create());
+				}
+
+				RDG::ResourceTracker *tracker = trackers[id];
+				tracker->parent = _get_tracker(parent);
+				tracker->buffer_driver_id = RDD::BufferID(reader.read<uint64_t>());
+				tracker->texture_driver_id = RDD::TextureID(reader.read<uint64_t>());
+				tracker->texture_subresources = reader.read<RDD::TextureSubresourceRange>();
+				tracker->texture_size = reader.read<Size2i>();
+				tracker->texture_usage = reader.read<uint32_t>();
+				Rect2i slice_rect = reader.read<Rect2i>();
+				tracker->is_discardable = reader.read<uint8_t>();
+				RDG::ResourceUsage usage = RDG::ResourceUsage(reader.read<uint32_t>());
+				BitField<RDD::BarrierAccessBits> usage_access = reader.read<int64_t>();
+				BitField<RDD::PipelineStageBits> previous_frame_stages = reader.read<int64_t>();
+				if (tracker->parent != nullptr) {
+					tracker->texture_slice_or_dirty_rect = slice_rect;
+				}
+
+				tracker->usage = usage;
+				tracker->usage_access = usage_access;
+
+				// These become the previous frame stages when the tracker is first used by the graph.
+				tracker->command_frame = -1;
+				tracker->current_frame_stages = previous_frame_stages;
+			} break;
+			case Capture::OP_DEFINE_FRAMEBUFFER_CACHE: {
+				uint32_t id = reader.read<uint32_t>();
+				ERR_FAIL_COND_V(id != frame_framebuffer_caches.size(), ERR_FILE_CORRUPT);
+				uint32_t width = reader.read<uint32_t>();
+				uint32_t height = reader.read<uint32_t>();
+				LocalVector<RDD::TextureID> textures;
+				reader.read_ids(textures, reader.read<uint32_t>());
+				reader.read_array(ids);
+				ERR_FAIL_COND_V(reader.failed, ERR_FILE_CORRUPT);
+
+				// Reuse the caches from previous frames, so the framebuffers they create aren't leaked.
+				RDG::FramebufferCache *cache = nullptr;
+				for (RDG::FramebufferCache *existing_cache : framebuffer_caches) {
+					if (existing_cache->width == width && existing_cache->height == height && _textures_equal(existing_cache->textures, textures)) {
+						cache = existing_cache;
+						break;
+					}
+				}
+
+				if (cache == nullptr) {
+					cache = RDG::framebuffer_cache_create();
+					cache->width = width;
+					cache->height = height;
+					cache->textures = textures;
+					framebuffer_caches.push_back(cache);
+				}
+
+				cache->trackers.clear();
+				for (uint32_t tracker_id : ids) {
+					cache->trackers.push_back(_get_tracker(tracker_id));
+				}
+
+				frame_framebuffer_caches.push_back(cache);
+			} break;
+			case Capture::OP_BUFFER_CLEAR: {
+				RDD::BufferID dst(reader.read<uint64_t>());
+				RDG::ResourceTracker *dst_tracker = _get_tracker(reader.read<uint32_t>());
+				uint32_t offset = reader.read<uint32_t>();
+				uint32_t size = reader.read<uint32_t>();
+				ERR_FAIL_COND_V(reader.failed || dst_tracker == nullptr, ERR_FILE_CORRUPT);
+				p_graph.add_buffer_clear(dst, dst_tracker, offset, size);
+			} break;
+			case Capture::OP_BUFFER_COPY: {
+				RDD::BufferID src(reader.read<uint64_t>());
+				RDG::ResourceTracker *src_tracker = _get_tracker(reader.read<uint32_t>());
+				RDD::BufferID dst(reader.read<uint64_t>());
+				RDG::ResourceTracker *dst_tracker = _get_tracker(reader.read<uint32_t>());
+				RDD::BufferCopyRegion region = reader.read<RDD::BufferCopyRegion>();
+				ERR_FAIL_COND_V(reader.failed || dst_tracker == nullptr, ERR_FILE_CORRUPT);
+				p_graph.add_buffer_copy(src, src_tracker, dst, dst_tracker, region);
+			} break;
+			case Capture::OP_BUFFER_GET_DATA: {
+				RDD::BufferID src(reader.read<uint64_t>());
+				RDG::ResourceTracker *src_tracker = _get_tracker(reader.read<uint32_t>());
+				RDD::BufferID dst(reader.read<uint64_t>());
+				RDD::BufferCopyRegion region = reader.read<RDD::BufferCopyRegion>();
+				ERR_FAIL_COND_V(reader.failed, ERR_FILE_CORRUPT);
+				p_graph.add_buffer_get_data(src, src_tracker, dst, region);
+			} break;
+			case Capture::OP_BUFFER_UPDATE: {
+				RDD::BufferID dst(reader.read<uint64_t>());
+				RDG::ResourceTracker *dst_tracker = _get_tracker(reader.read<uint32_t>());
+				reader.read_array(buffer_copies);
+				ERR_FAIL_COND_V(reader.failed || dst_tracker == nullptr, ERR_FILE_CORRUPT);
+				p_graph.add_buffer_update(dst, dst_tracker, buffer_copies);
+			} break;
+			case Capture::OP_DRIVER_CALLBACK: {
+				reader.read_array(ids);
+				reader.read_array(op_usages);
+				ERR_FAIL_COND_V(reader.failed || ids.size() != op_usages.size(), ERR_FILE_CORRUPT);
+				op_trackers.resize(ids.size());
+				for (uint32_t i = 0; i < ids.size(); i++) {
+					op_trackers[i] = _get_tracker(ids[i]);
+				}
+
+				p_graph.add_driver_callback(&RenderingDeviceGraphReplay::_driver_callback, nullptr, op_trackers, op_usages);
+			} break;
+			case Capture::OP_COMPUTE_LIST_BEGIN: {
+				RDD::BreadcrumbMarker phase = RDD::BreadcrumbMarker(reader.read<uint32_t>());
+				uint32_t breadcrumb_data = reader.read<uint32_t>();
+				p_graph.add_compute_list_begin(phase, breadcrumb_data);
+			} break;
+			case Capture::OP_COMPUTE_LIST_BIND_PIPELINE: {
+				p_graph.add_compute_list_bind_pipeline(RDD::PipelineID(reader.read<uint64_t>()));
+			} break;
+			case Capture::OP_COMPUTE_LIST_BIND_UNIFORM_SETS: {
+				RDD::ShaderID shader(reader.read<uint64_t>());
+				uint32_t first_set_index = reader.read<uint32_t>();
+				uint32_t set_count = reader.read<uint32_t>();
+				reader.read_ids(uniform_sets, set_count);
+				ERR_FAIL_COND_V(reader.failed, ERR_FILE_CORRUPT);
+				p_graph.add_compute_list_bind_uniform_sets(shader, uniform_sets, first_set_index, set_count);
+			} break;
+			case Capture::OP_COMPUTE_LIST_DISPATCH: {
+				uint32_t x_groups = reader.read<uint32_t>();
+				uint32_t y_groups = reader.read<uint32_t>();
+				uint32_t z_groups = reader.read<uint32_t>();
+				p_graph.add_compute_list_dispatch(x_groups, y_groups, z_groups);
+			} break;
+			case Capture::OP_COMPUTE_LIST_DISPATCH_INDIRECT: {
+				RDD::BufferID buffer(reader.read<uint64_t>());
+				uint32_t offset = reader.read<uint32_t>();
+				p_graph.add_compute_list_dispatch_indirect(buffer, offset);
+			} break;
+			case Capture::OP_COMPUTE_LIST_SET_PUSH_CONSTANT: {
+				RDD::ShaderID shader(reader.read<uint64_t>());
+				uint32_t data_size = reader.read<uint32_t>();
+				const uint8_t *data = reader.read_data(data_size);
+				ERR_FAIL_COND_V(reader.failed, ERR_FILE_CORRUPT);
+				p_graph.add_compute_list_set_push_constant(shader, data, data_size);
+			} break;
+			case Capture::OP_COMPUTE_LIST_UNIFORM_SET_PREPARE_FOR_USE: {
+				RDD::ShaderID shader(reader.read<uint64_t>());
+				RDD::UniformSetID uniform_set(reader.read<uint64_t>());
+				uint32_t set_index = reader.read<uint32_t>();
+				p_graph.add_compute_list_uniform_set_prepare_for_use(shader, uniform_set, set_index);
+			} break;
+			case Capture::OP_COMPUTE_LIST_USAGE: {
+				RDG::ResourceTracker *tracker = _get_tracker(reader.read<uint32_t>());
+				RDG::ResourceUsage usage = RDG::ResourceUsage(reader.read<uint32_t>());
+				ERR_FAIL_COND_V(reader.failed || tracker == nullptr, ERR_FILE_CORRUPT);
+				p_graph.add_compute_list_usage(tracker, usage);
+			} break;
+			case Capture::OP_COMPUTE_LIST_END: {
+				p_graph.add_compute_list_end();
+			} break;
+			case Capture::OP_DRAW_LIST_BEGIN: {
+				RDG::FramebufferCache *framebuffer_cache = _get_framebuffer_cache(reader.read<uint32_t>());
+				RDD::RenderPassID render_pass(reader.read<uint64_t>());
+				RDD::FramebufferID framebuffer(reader.read<uint64_t>());
+				Rect2i region = reader.read<Rect2i>();
+				reader.read_array(attachment_operations);
+				reader.read_array(clear_values);
+				bool uses_color = reader.read<uint8_t>();
+				bool uses_depth = reader.read<uint8_t>();
+				uint32_t breadcrumb = reader.read<uint32_t>();
+				bool split_cmd_buffer = reader.read<uint8_t>();
+				ERR_FAIL_COND_V(reader.failed, ERR_FILE_CORRUPT);
+				if (framebuffer_cache != nullptr) {
+					p_graph.add_draw_list_begin(framebuffer_cache, region, attachment_operations, clear_values, uses_color, uses_depth, breadcrumb, split_cmd_buffer);
+				} else {
+					p_graph.add_draw_list_begin(render_pass, framebuffer, region, attachment_operations, clear_values, uses_color, uses_depth, breadcrumb, split_cmd_buffer);
+				}
+			} break;
+			case Capture::OP_DRAW_LIST_BIND_INDEX_BUFFER: {
+				RDD::BufferID buffer(reader.read<uint64_t>());
+				RDD::IndexBufferFormat format = RDD::IndexBufferFormat(reader.read<uint32_t>());
+				uint32_t offset = reader.read<uint32_t>();
+				p_graph.add_draw_list_bind_index_buffer(buffer, format, offset);
+			} break;
+			case Capture::OP_DRAW_LIST_BIND_PIPELINE: {
+				RDD::PipelineID pipeline(reader.read<uint64_t>());
+				BitField<RDD::PipelineStageBits> stage_bits = reader.read<int64_t>();
+				p_graph.add_draw_list_bind_pipeline(pipeline, stage_bits);
+			} break;
+			case Capture::OP_DRAW_LIST_BIND_UNIFORM_SETS: {
+				RDD::ShaderID shader(reader.read<uint64_t>());
+				uint32_t first_index = reader.read<uint32_t>();
+				uint32_t set_count = reader.read<uint32_t>();
+				reader.read_ids(uniform_sets, set_count);
+				ERR_FAIL_COND_V(reader.failed, ERR_FILE_CORRUPT);
+				p_graph.add_draw_list_bind_uniform_sets(shader, uniform_sets, first_index, set_count);
+			} break;
+			case Capture::OP_DRAW_LIST_BIND_VERTEX_BUFFERS: {
+				reader.read_ids(buffers, reader.read<uint32_t>());
+				reader.read_array(offsets);
+				ERR_FAIL_COND_V(reader.failed || buffers.size() != offsets.size(), ERR_FILE_CORRUPT);
+				p_graph.add_draw_list_bind_vertex_buffers(buffers, offsets);
+			} break;
+			case Capture::OP_DRAW_LIST_CLEAR_ATTACHMENTS: {
+				reader.read_array(attachment_clears);
+				reader.read_array(rects);
+				ERR_FAIL_COND_V(reader.failed, ERR_FILE_CORRUPT);
+				p_graph.add_draw_list_clear_attachments(attachment_clears, rects);
+			} break;
+			case Capture::OP_DRAW_LIST_DRAW: {
+				uint32_t vertex_count = reader.read<uint32_t>();
+				uint32_t instance_count = reader.read<uint32_t>();
+				p_graph.add_draw_list_draw(vertex_count, instance_count);
+			} break;
+			case Capture::OP_DRAW_LIST_DRAW_INDEXED: {
+				uint32_t index_count = reader.read<uint32_t>();
+				uint32_t instance_count = reader.read<uint32_t>();
+				uint32_t first_index = reader.read<uint32_t>();
+				p_graph.add_draw_list_draw_indexed(index_count, instance_count, first_index);
+			} break;
+			case Capture::OP_DRAW_LIST_DRAW_INDIRECT:
+			case Capture::OP_DRAW_LIST_DRAW_INDEXED_INDIRECT: {
+				RDD::BufferID buffer(reader.read<uint64_t>());
+				uint32_t offset = reader.read<uint32_t>();
+				uint32_t draw_count = reader.read<uint32_t>();
+				uint32_t stride = reader.read<uint32_t>();
+				if (op == Capture::OP_DRAW_LIST_DRAW_INDIRECT) {
+					p_graph.add_draw_list_draw_indirect(buffer, offset, draw_count, stride);
+				} else {
+					p_graph.add_draw_list_draw_indexed_indirect(buffer, offset, draw_count, stride);
+				}
+			} break;
+			case Capture::OP_DRAW_LIST_EXECUTE_COMMANDS: {
+				p_graph.add_draw_list_execute_commands(RDD::CommandBufferID(reader.read<uint64_t>()));
+			} break;
+			case Capture::OP_DRAW_LIST_NEXT_SUBPASS: {
+				p_graph.add_draw_list_next_subpass(RDD::CommandBufferType(reader.read<uint32_t>()));
+			} break;
+			case Capture::OP_DRAW_LIST_SET_BLEND_CONSTANTS: {
+				p_graph.add_draw_list_set_blend_constants(reader.read<Color>());
+			} break;
+			case Capture::OP_DRAW_LIST_SET_LINE_WIDTH: {
+				p_graph.add_draw_list_set_line_width(reader.read<float>());
+			} break;
+			case Capture::OP_DRAW_LIST_SET_PUSH_CONSTANT: {
+				RDD::ShaderID shader(reader.read<uint64_t>());
+				uint32_t data_size = reader.read<uint32_t>();
+				const uint8_t *data = reader.read_data(data_size);
+				ERR_FAIL_COND_V(reader.failed, ERR_FILE_CORRUPT);
+				p_graph.add_draw_list_set_push_constant(shader, data, data_size);
+			} break;
+			case Capture::OP_DRAW_LIST_SET_SCISSOR: {
+				p_graph.add_draw_list_set_scissor(reader.read<Rect2i>());
+			} break;
+			case Capture::OP_DRAW_LIST_SET_VIEWPORT: {
+				p_graph.add_draw_list_set_viewport(reader.read<Rect2i>());
+			} break;
+			case Capture::OP_DRAW_LIST_UNIFORM_SET_PREPARE_FOR_USE: {
+				RDD::ShaderID shader(reader.read<uint64_t>());
+				RDD::UniformSetID uniform_set(reader.read<uint64_t>());
+				uint32_t set_index = reader.read<uint32_t>();
+				p_graph.add_draw_list_uniform_set_prepare_for_use(shader, uniform_set, set_index);
+			} break;
+			case Capture::OP_DRAW_LIST_USAGE: {
+				RDG::ResourceTracker *tracker = _get_tracker(reader.read<uint32_t>());
+				RDG::ResourceUsage usage = RDG::ResourceUsage(reader.read<uint32_t>());
+				ERR_FAIL_COND_V(reader.failed || tracker == nullptr, ERR_FILE_CORRUPT);
+				p_graph.add_draw_list_usage(tracker, usage);
+			} break;
+			case Capture::OP_DRAW_LIST_END: {
+				p_graph.add_draw_list_end();
+			} break;
+			case Capture::OP_TEXTURE_CLEAR: {
+				RDD::TextureID dst(reader.read<uint64_t>());
+				RDG::ResourceTracker *dst_tracker = _get_tracker(reader.read<uint32_t>());
+				Color color = reader.read<Color>();
+				RDD::TextureSubresourceRange range = reader.read<RDD::TextureSubresourceRange>();
+				ERR_FAIL_COND_V(reader.failed || dst_tracker == nullptr, ERR_FILE_CORRUPT);
+				p_graph.add_texture_clear(dst, dst_tracker, color, range);
+			} break;
+			case Capture::OP_TEXTURE_COPY: {
+				RDD::TextureID src(reader.read<uint64_t>());
+				RDG::ResourceTracker *src_tracker = _get_tracker(reader.read<uint32_t>());
+				RDD::TextureID dst(reader.read<uint64_t>());
+				RDG::ResourceTracker *dst_tracker = _get_tracker(reader.read<uint32_t>());
+				reader.read_array(texture_copy_regions);
+				ERR_FAIL_COND_V(reader.failed || src_tracker == nullptr || dst_tracker == nullptr, ERR_FILE_CORRUPT);
+				p_graph.add_texture_copy(src, src_tracker, dst, dst_tracker, texture_copy_regions);
+			} break;
+			case Capture::OP_TEXTURE_GET_DATA: {
+				RDD::TextureID src(reader.read<uint64_t>());
+				RDG::ResourceTracker *src_tracker = _get_tracker(reader.read<uint32_t>());
+				RDD::BufferID dst(reader.read<uint64_t>());
+				RDG::ResourceTracker *dst_tracker = _get_tracker(reader.read<uint32_t>());
+				reader.read_array(buffer_texture_copy_regions);
+				ERR_FAIL_COND_V(reader.failed || src_tracker == nullptr, ERR_FILE_CORRUPT);
+				p_graph.add_texture_get_data(src, src_tracker, dst, buffer_texture_copy_regions, dst_tracker);
+			} break;
+			case Capture::OP_TEXTURE_RESOLVE: {
+				RDD::TextureID src(reader.read<uint64_t>());
+				RDG::ResourceTracker *src_tracker = _get_tracker(reader.read<uint32_t>());
+				RDD::TextureID dst(reader.read<uint64_t>());
+				RDG::ResourceTracker *dst_tracker = _get_tracker(reader.read<uint32_t>());
+				uint32_t src_layer = reader.read<uint32_t>();
+				uint32_t src_mipmap = reader.read<uint32_t>();
+				uint32_t dst_layer = reader.read<uint32_t>();
+				uint32_t dst_mipmap = reader.read<uint32_t>();
+				ERR_FAIL_COND_V(reader.failed || src_tracker == nullptr || dst_tracker == nullptr, ERR_FILE_CORRUPT);
+				p_graph.add_texture_resolve(src, src_tracker, dst, dst_tracker, src_layer, src_mipmap, dst_layer, dst_mipmap);
+			} break;
+			case Capture::OP_TEXTURE_UPDATE: {
+				RDD::TextureID dst(reader.read<uint64_t>());
+				RDG::ResourceTracker *dst_tracker = _get_tracker(reader.read<uint32_t>());
+				reader.read_array(buffer_to_texture_copies);
+				reader.read_array(ids);
+				ERR_FAIL_COND_V(reader.failed || dst_tracker == nullptr, ERR_FILE_CORRUPT);
+				op_trackers.resize(ids.size());
+				for (uint32_t i = 0; i < ids.size(); i++) {
+					op_trackers[i] = _get_tracker(ids[i]);
+				}
+
+				p_graph.add_texture_update(dst, dst_tracker, buffer_to_texture_copies, op_trackers);
+			} break;
+			case Capture::OP_CAPTURE_TIMESTAMP: {
+				RDD::QueryPoolID pool(reader.read<uint64_t>());
+				uint32_t index = reader.read<uint32_t>();
+				p_graph.add_capture_timestamp(pool, index);
+			} break;
+			case Capture::OP_SYNCHRONIZATION: {
+				p_graph.add_synchronization();
+			} break;
+			case Capture::OP_BEGIN_LABEL: {
+				uint32_t length = reader.read<uint32_t>();
+				const uint8_t *label = reader.read_data(length);
+				Color color = reader.read<Color>();
+				ERR_FAIL_COND_V(reader.failed, ERR_FILE_CORRUPT);
+				p_graph.begin_label(String::utf8((const char *)label, length), color);
+			} break;
+			case Capture::OP_END_LABEL: {
+				p_graph.end_label();
+			} break;
+			default: {
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("Unknown operation %d found in the rendering device graph capture.", op));
+			}
+		}
+	}
+
+	ERR_FAIL_COND_V_MSG(reader.failed, ERR_FILE_CORRUPT, "Truncated operation found in the rendering device graph capture.");
+	return OK;
+}
+
+void RenderingDeviceGraphReplay::clear(RDD *p_driver) {
+	for (RDG::FramebufferCache *cache : framebuffer_caches) {
+		RDG::framebuffer_cache_free(p_driver, cache);
+	}
+
+	framebuffer_caches.clear();
+	frame_framebuffer_caches.clear();
+	_free_trackers();
+}
+
+RenderingDeviceGraphReplay::~RenderingDeviceGraphReplay() {
+	DEV_ASSERT(trackers.is_empty() && framebuffer_caches.is_empty() && "Replay resources must be freed with clear() before destroying the replay.");
+}
@@ -0,0 +1,239 @@
+/**************************************************************************/
+/*  rendering_device_graph_capture.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RENDERING_DEVICE_GRAPH_CAPTURE_H
+#define RENDERING_DEVICE_GRAPH_CAPTURE_H
+
+#include "core/io/file_access.h"
+#include "rendering_device_graph.h"
+
+// Records the commands submitted to a RenderingDeviceGraph so they can be
+// replayed later without a GPU (e.g. against a mock driver) to measure the
+// CPU cost of the dependency analysis, reordering and barrier generation.
+//
+// The file starts with a header (magic + version) followed by one chunk per
+// frame (size + data). Frame data is a stream of operations which mirror the
+// public API of the graph. Resource trackers and framebuffer caches are
+// replaced by identifiers and described the first time they're used (or when
+// their description changes). Driver IDs are stored as-is, as the replay only
+// needs them to be opaque values. Structures are stored with their native
+// layout, so captures are only meant to be replayed by the same build.
+
+class RenderingDeviceGraphCapture {
+public:
+	enum Op : uint32_t {
+		OP_DEFINE_TRACKER,
+		OP_DEFINE_FRAMEBUFFER_CACHE,
+		OP_BUFFER_CLEAR,
+		OP_BUFFER_COPY,
+		OP_BUFFER_GET_DATA,
+		OP_BUFFER_UPDATE,
+		OP_DRIVER_CALLBACK,
+		OP_COMPUTE_LIST_BEGIN,
+		OP_COMPUTE_LIST_BIND_PIPELINE,
+		OP_COMPUTE_LIST_BIND_UNIFORM_SETS,
+		OP_COMPUTE_LIST_DISPATCH,
+		OP_COMPUTE_LIST_DISPATCH_INDIRECT,
+		OP_COMPUTE_LIST_SET_PUSH_CONSTANT,
+		OP_COMPUTE_LIST_UNIFORM_SET_PREPARE_FOR_USE,
+		OP_COMPUTE_LIST_USAGE,
+		OP_COMPUTE_LIST_END,
+		OP_DRAW_LIST_BEGIN,
+		OP_DRAW_LIST_BIND_INDEX_BUFFER,
+		OP_DRAW_LIST_BIND_PIPELINE,
+		OP_DRAW_LIST_BIND_UNIFORM_SETS,
+		OP_DRAW_LIST_BIND_VERTEX_BUFFERS,
+		OP_DRAW_LIST_CLEAR_ATTACHMENTS,
+		OP_DRAW_LIST_DRAW,
+		OP_DRAW_LIST_DRAW_INDEXED,
+		OP_DRAW_LIST_DRAW_INDIRECT,
+		OP_DRAW_LIST_DRAW_INDEXED_INDIRECT,
+		OP_DRAW_LIST_EXECUTE_COMMANDS,
+		OP_DRAW_LIST_NEXT_SUBPASS,
+		OP_DRAW_LIST_SET_BLEND_CONSTANTS,
+		OP_DRAW_LIST_SET_LINE_WIDTH,
+		OP_DRAW_LIST_SET_PUSH_CONSTANT,
+		OP_DRAW_LIST_SET_SCISSOR,
+		OP_DRAW_LIST_SET_VIEWPORT,
+		OP_DRAW_LIST_UNIFORM_SET_PREPARE_FOR_USE,
+		OP_DRAW_LIST_USAGE,
+		OP_DRAW_LIST_END,
+		OP_TEXTURE_CLEAR,
+		OP_TEXTURE_COPY,
+		OP_TEXTURE_GET_DATA,
+		OP_TEXTURE_RESOLVE,
+		OP_TEXTURE_UPDATE,
+		OP_CAPTURE_TIMESTAMP,
+		OP_SYNCHRONIZATION,
+		OP_BEGIN_LABEL,
+		OP_END_LABEL,
+		OP_MAX
+	};
+
+	static const uint32_t FORMAT_VERSION = 1;
+	static const uint32_t INVALID_ID = UINT32_MAX;
+
+private:
+	struct TrackerDescription {
+		uint32_t parent = INVALID_ID;
+		uint64_t buffer_driver_id = 0;
+		uint64_t texture_driver_id = 0;
+		RDD::TextureSubresourceRange texture_subresources;
+		Size2i texture_size;
+		uint32_t texture_usage = 0;
+		Rect2i texture_slice_rect;
+		bool is_discardable = false;
+
+		bool operator==(const TrackerDescription &p_other) const;
+		bool operator!=(const TrackerDescription &p_other) const { return !(*this == p_other); }
+	};
+
+	Ref<FileAccess> file;
+	LocalVector<uint8_t> frame_data;
+	HashMap<RDG::ResourceTracker *, uint32_t> tracker_ids;
+	LocalVector<TrackerDescription> tracker_descriptions;
+	HashMap<RDG::FramebufferCache *, uint32_t> framebuffer_cache_ids;
+	uint32_t frames_captured = 0;
+	int64_t tracking_frame = 0;
+
+	_FORCE_INLINE_ void _push_data(const void *p_data, uint32_t p_size) {
+		uint32_t offset = frame_data.size();
+		frame_data.resize(offset + p_size);
+		memcpy(&frame_data[offset], p_data, p_size);
+	}
+
+	template <typename T>
+	_FORCE_INLINE_ void _push(const T &p_value) {
+		_push_data(&p_value, sizeof(T));
+	}
+
+	template <typename T>
+	_FORCE_INLINE_ void _push_array(VectorView<T> p_values) {
+		_push<uint32_t>(p_values.size());
+		_push_data(p_values.ptr(), sizeof(T) * p_values.size());
+	}
+
+	_FORCE_INLINE_ void _push_op(Op p_op) {
+		_push<uint32_t>(p_op);
+	}
+
+	uint32_t _tracker_id(RDG::ResourceTracker *p_tracker);
+	uint32_t _framebuffer_cache_id(RDG::FramebufferCache *p_framebuffer_cache);
+
+public:
+	Error open(const String &p_path);
+	void close();
+	bool is_open() const { return file.is_valid(); }
+	uint32_t get_frames_captured() const { return frames_captured; }
+
+	// Called by RenderingDeviceGraph.
+	void frame_begin(int64_t p_tracking_frame);
+	void frame_end();
+	void buffer_clear(RDD::BufferID p_dst, RDG::ResourceTracker *p_dst_tracker, uint32_t p_offset, uint32_t p_size);
+	void buffer_copy(RDD::BufferID p_src, RDG::ResourceTracker *p_src_tracker, RDD::BufferID p_dst, RDG::ResourceTracker *p_dst_tracker, const RDD::BufferCopyRegion &p_region);
+	void buffer_get_data(RDD::BufferID p_src, RDG::ResourceTracker *p_src_tracker, RDD::BufferID p_dst, const RDD::BufferCopyRegion &p_region);
+	void buffer_update(RDD::BufferID p_dst, RDG::ResourceTracker *p_dst_tracker, VectorView<RDG::RecordedBufferCopy> p_buffer_copies);
+	void driver_callback(VectorView<RDG::ResourceTracker *> p_trackers, VectorView<RDG::ResourceUsage> p_usages);
+	void compute_list_begin(RDD::BreadcrumbMarker p_phase, uint32_t p_breadcrumb_data);
+	void compute_list_bind_pipeline(RDD::PipelineID p_pipeline);
+	void compute_list_bind_uniform_sets(RDD::ShaderID p_shader, VectorView<RDD::UniformSetID> p_uniform_sets, uint32_t p_first_set_index, uint32_t p_set_count);
+	void compute_list_dispatch(uint32_t p_x_groups, uint32_t p_y_groups, uint32_t p_z_groups);
+	void compute_list_dispatch_indirect(RDD::BufferID p_buffer, uint32_t p_offset);
+	void compute_list_set_push_constant(RDD::ShaderID p_shader, const void *p_data, uint32_t p_data_size);
+	void compute_list_uniform_set_prepare_for_use(RDD::ShaderID p_shader, RDD::UniformSetID p_uniform_set, uint32_t p_set_index);
+	void compute_list_usage(RDG::ResourceTracker *p_tracker, RDG::ResourceUsage p_usage);
+	void compute_list_end();
+	void draw_list_begin(RDG::FramebufferCache *p_framebuffer_cache, RDD::RenderPassID p_render_pass, RDD::FramebufferID p_framebuffer, Rect2i p_region, VectorView<RDG::AttachmentOperation> p_attachment_operations, VectorView<RDD::RenderPassClearValue> p_attachment_clear_values, bool p_uses_color, bool p_uses_depth, uint32_t p_breadcrumb, bool p_split_cmd_buffer);
+	void draw_list_bind_index_buffer(RDD::BufferID p_buffer, RDD::IndexBufferFormat p_format, uint32_t p_offset);
+	void draw_list_bind_pipeline(RDD::PipelineID p_pipeline, BitField<RDD::PipelineStageBits> p_pipeline_stage_bits);
+	void draw_list_bind_uniform_sets(RDD::ShaderID p_shader, VectorView<RDD::UniformSetID> p_uniform_sets, uint32_t p_first_index, uint32_t p_set_count);
+	void draw_list_bind_vertex_buffers(VectorView<RDD::BufferID> p_vertex_buffers, VectorView<uint64_t> p_vertex_buffer_offsets);
+	void draw_list_clear_attachments(VectorView<RDD::AttachmentClear> p_attachments_clear, VectorView<Rect2i> p_attachments_clear_rect);
+	void draw_list_draw(uint32_t p_vertex_count, uint32_t p_instance_count);
+	void draw_list_draw_indexed(uint32_t p_index_count, uint32_t p_instance_count, uint32_t p_first_index);
+	void draw_list_draw_indirect(RDD::BufferID p_buffer, uint32_t p_offset, uint32_t p_draw_count, uint32_t p_stride);
+	void draw_list_draw_indexed_indirect(RDD::BufferID p_buffer, uint32_t p_offset, uint32_t p_draw_count, uint32_t p_stride);
+	void draw_list_execute_commands(RDD::CommandBufferID p_command_buffer);
+	void draw_list_next_subpass(RDD::CommandBufferType p_command_buffer_type);
+	void draw_list_set_blend_constants(const Color &p_color);
+	void draw_list_set_line_width(float p_width);
+	void draw_list_set_push_constant(RDD::ShaderID p_shader, const void *p_data, uint32_t p_data_size);
+	void draw_list_set_scissor(Rect2i p_rect);
+	void draw_list_set_viewport(Rect2i p_rect);
+	void draw_list_uniform_set_prepare_for_use(RDD::ShaderID p_shader, RDD::UniformSetID p_uniform_set, uint32_t p_set_index);
+	void draw_list_usage(RDG::ResourceTracker *p_tracker, RDG::ResourceUsage p_usage);
+	void draw_list_end();
+	void texture_clear(RDD::TextureID p_dst, RDG::ResourceTracker *p_dst_tracker, const Color &p_color, const RDD::TextureSubresourceRange &p_range);
+	void texture_copy(RDD::TextureID p_src, RDG::ResourceTracker *p_src_tracker, RDD::TextureID p_dst, RDG::ResourceTracker *p_dst_tracker, VectorView<RDD::TextureCopyRegion> p_texture_copy_regions);
+	void texture_get_data(RDD::TextureID p_src, RDG::ResourceTracker *p_src_tracker, RDD::BufferID p_dst, VectorView<RDD::BufferTextureCopyRegion> p_buffer_texture_copy_regions, RDG::ResourceTracker *p_dst_tracker);
+	void texture_resolve(RDD::TextureID p_src, RDG::ResourceTracker *p_src_tracker, RDD::TextureID p_dst, RDG::ResourceTracker *p_dst_tracker, uint32_t p_src_layer, uint32_t p_src_mipmap, uint32_t p_dst_layer, uint32_t p_dst_mipmap);
+	void texture_update(RDD::TextureID p_dst, RDG::ResourceTracker *p_dst_tracker, VectorView<RDG::RecordedBufferToTextureCopy> p_buffer_copies, VectorView<RDG::ResourceTracker *> p_buffer_trackers);
+	void capture_timestamp(RDD::QueryPoolID p_query_pool, uint32_t p_index);
+	void synchronization();
+	void begin_label(const String &p_label_name, const Color &p_color);
+	void end_label();
+
+	~RenderingDeviceGraphCapture();
+};
+
+// Loads a capture and replays its frames on a graph. The replay owns the
+// resource trackers and framebuffer caches it creates on behalf of the
+// captured ones, which must be released with clear() using the same driver
+// the graph was initialized with.
+
+class RenderingDeviceGraphReplay {
+	LocalVector<Vector<uint8_t>> frames;
+	LocalVector<RDG::ResourceTracker *> trackers;
+	LocalVector<RDG::FramebufferCache *> framebuffer_caches;
+	LocalVector<RDG::FramebufferCache *> frame_framebuffer_caches;
+
+	static void _driver_callback(RDD *p_driver, RDD::CommandBufferID p_command_buffer, void *p_userdata) {}
+
+	static bool _textures_equal(const LocalVector<RDD::TextureID> &p_a, const LocalVector<RDD::TextureID> &p_b);
+	void _free_trackers();
+	RDG::ResourceTracker *_get_tracker(uint32_t p_id) const;
+	RDG::FramebufferCache *_get_framebuffer_cache(uint32_t p_id) const;
+
+public:
+	Error load(const String &p_path);
+	uint32_t get_frame_count() const { return frames.size(); }
+
+	// Issues the recorded commands of the frame on the graph. The caller is
+	// responsible for calling begin() and end() on the graph around it.
+	Error replay_frame(uint32_t p_frame, RenderingDeviceGraph &p_graph);
+
+	void clear(RDD *p_driver);
+
+	~RenderingDeviceGraphReplay();
+};
+
+#endif // RENDERING_DEVICE_GRAPH_CAPTURE_H
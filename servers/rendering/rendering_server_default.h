@@ -277,6 +277,8 @@ public:
 	FUNC2RC(Variant, shader_get_parameter_default, RID, const StringName &)
 
 	FUNC1RC(ShaderNativeSourceCode, shader_get_native_source_code, RID)
+	FUNC1RC(bool, shader_is_compiled, RID)
+	FUNC2(shader_request_compiled_callback, RID, const Callable &)
 
 	/* COMMON MATERIAL API */
 
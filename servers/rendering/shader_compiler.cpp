@@ -32,6 +32,11 @@
 
 #include "shader_compiler.h"
 
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/thread.h"
+#include "core/string/string_builder.h"
+#include "core/version.h"
 #include "servers/rendering/rendering_server_globals.h"
 #include "servers/rendering/shader_types.h"
 
@@ -1477,7 +1482,7 @@ ShaderLanguage::DataType ShaderCompiler::_get_global_shader_uniform_type(const S
 	return (ShaderLanguage::DataType)RS::global_shader_uniform_type_get_shader_datatype(gvt);
 }
 
-Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+Error ShaderCompiler::_compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
 	SL::ShaderCompileInfo info;
 	info.functions = ShaderTypes::get_singleton()->get_functions(p_mode);
 	info.render_modes = ShaderTypes::get_singleton()->get_modes(p_mode);
@@ -1585,9 +1590,465 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 	return OK;
 }
 
+static const char *shader_compiler_cache_header = "GDSG";
+static const uint32_t shader_compiler_cache_version = 1;
+
+static void _hash_sorted_map(StringBuilder &r_builder, const char *p_section, const HashMap<StringName, String> &p_map) {
+	Vector<StringName> keys;
+	for (const KeyValue<StringName, String> &E : p_map) {
+		keys.push_back(E.key);
+	}
+	keys.sort_custom<StringName::AlphCompare>();
+
+	r_builder.append(p_section);
+	for (const StringName &key : keys) {
+		r_builder.append(String(key));
+		r_builder.append("=");
+		r_builder.append(p_map[key]);
+		r_builder.append(";");
+	}
+}
+
+String ShaderCompiler::_get_cache_key(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions &p_actions, bool p_low_end) const {
+	StringBuilder hash_build;
+	hash_build.append("[engine]");
+	hash_build.append(VERSION_FULL_BUILD);
+	hash_build.append(VERSION_HASH);
+	hash_build.append("[mode]");
+	hash_build.append(itos(p_mode));
+	// The generated code for samplers differs on low-end renderers.
+	hash_build.append("[low_end]");
+	hash_build.append(itos(p_low_end));
+	hash_build.append("[actions]");
+	hash_build.append(actions_sha256);
+
+	// Only the keys of the identifier actions matter, the pointers they hold differ on every call.
+	Vector<String> entry_points;
+	hash_build.append("[entry_points]");
+	for (const KeyValue<StringName, Stage> &E : p_actions.entry_point_stages) {
+		entry_points.push_back(String(E.key) + ":" + itos(E.value));
+	}
+	entry_points.sort();
+	for (const String &entry_point : entry_points) {
+		hash_build.append(entry_point + ";");
+	}
+
+	hash_build.append("[code]");
+	hash_build.append(p_code);
+
+	return hash_build.as_string().sha256_text();
+}
+
+String ShaderCompiler::_get_cache_file_path(const String &p_key) {
+	return shader_cache_dir.path_join("ShaderCompiler").path_join(p_key) + ".cache";
+}
+
+void ShaderCompiler::_apply_render_modes(const Vector<StringName> &p_render_modes, IdentifierActions *p_actions) {
+	// Same as when generating the code for NODE_TYPE_SHADER.
+	for (const StringName &render_mode : p_render_modes) {
+		if (p_actions->render_mode_flags.has(render_mode)) {
+			*p_actions->render_mode_flags[render_mode] = true;
+		}
+
+		if (p_actions->render_mode_values.has(render_mode)) {
+			Pair<int *, int> &p = p_actions->render_mode_values[render_mode];
+			*p.first = p.second;
+		}
+	}
+}
+
+static void _store_uniform(const Ref<FileAccess> &p_file, const SL::ShaderNode::Uniform &p_uniform) {
+	p_file->store_32(p_uniform.order);
+	p_file->store_32(p_uniform.prop_order);
+	p_file->store_32(p_uniform.texture_order);
+	p_file->store_32(p_uniform.texture_binding);
+	p_file->store_32(p_uniform.type);
+	p_file->store_32(p_uniform.precision);
+	p_file->store_32(p_uniform.array_size);
+	p_file->store_32(p_uniform.default_value.size());
+	for (const SL::Scalar &scalar : p_uniform.default_value) {
+		p_file->store_32(scalar.uint);
+	}
+	p_file->store_32(p_uniform.scope);
+	p_file->store_32(p_uniform.hint);
+	p_file->store_8(p_uniform.use_color);
+	p_file->store_32(p_uniform.filter);
+	p_file->store_32(p_uniform.repeat);
+	for (int i = 0; i < 3; i++) {
+		p_file->store_float(p_uniform.hint_range[i]);
+	}
+	p_file->store_32(p_uniform.hint_enum_names.size());
+	for (const String &enum_name : p_uniform.hint_enum_names) {
+		p_file->store_pascal_string(enum_name);
+	}
+	p_file->store_32(p_uniform.instance_index);
+	p_file->store_pascal_string(p_uniform.group);
+	p_file->store_pascal_string(p_uniform.subgroup);
+}
+
+static SL::ShaderNode::Uniform _get_uniform(const Ref<FileAccess> &p_file) {
+	SL::ShaderNode::Uniform uniform;
+	uniform.order = int32_t(p_file->get_32());
+	uniform.prop_order = int32_t(p_file->get_32());
+	uniform.texture_order = int32_t(p_file->get_32());
+	uniform.texture_binding = int32_t(p_file->get_32());
+	uniform.type = SL::DataType(p_file->get_32());
+	uniform.precision = SL::DataPrecision(p_file->get_32());
+	uniform.array_size = int32_t(p_file->get_32());
+	uint32_t default_value_count = p_file->get_32();
+	if (p_file->eof_reached()) {
+		return uniform;
+	}
+	uniform.default_value.resize(default_value_count);
+	for (uint32_t i = 0; i < default_value_count; i++) {
+		uniform.default_value.write[i].uint = p_file->get_32();
+	}
+	uniform.scope = SL::ShaderNode::Uniform::Scope(p_file->get_32());
+	uniform.hint = SL::ShaderNode::Uniform::Hint(p_file->get_32());
+	uniform.use_color = p_file->get_8();
+	uniform.filter = SL::TextureFilter(p_file->get_32());
+	uniform.repeat = SL::TextureRepeat(p_file->get_32());
+	for (int i = 0; i < 3; i++) {
+		uniform.hint_range[i] = p_file->get_float();
+	}
+	uint32_t enum_name_count = p_file->get_32();
+	for (uint32_t i = 0; i < enum_name_count && !p_file->eof_reached(); i++) {
+		uniform.hint_enum_names.push_back(p_file->get_pascal_string());
+	}
+	uniform.instance_index = int32_t(p_file->get_32());
+	uniform.group = p_file->get_pascal_string();
+	uniform.subgroup = p_file->get_pascal_string();
+	return uniform;
+}
+
+static void _store_string_names(const Ref<FileAccess> &p_file, const Vector<StringName> &p_names) {
+	p_file->store_32(p_names.size());
+	for (const StringName &name : p_names) {
+		p_file->store_pascal_string(name);
+	}
+}
+
+static Vector<StringName> _get_string_names(const Ref<FileAccess> &p_file) {
+	Vector<StringName> names;
+	uint32_t count = p_file->get_32();
+	for (uint32_t i = 0; i < count && !p_file->eof_reached(); i++) {
+		names.push_back(p_file->get_pascal_string());
+	}
+	return names;
+}
+
+bool ShaderCompiler::_load_from_cache(const String &p_key, IdentifierActions *p_actions, GeneratedCode &r_gen_code) {
+	Ref<FileAccess> f = FileAccess::open(_get_cache_file_path(p_key), FileAccess::READ);
+	if (f.is_null()) {
+		return false;
+	}
+
+	char header[5] = { 0, 0, 0, 0, 0 };
+	f->get_buffer((uint8_t *)header, 4);
+	if (header != String(shader_compiler_cache_header) || f->get_32() != shader_compiler_cache_version) {
+		return false;
+	}
+
+	CacheSideEffects side_effects;
+	side_effects.render_modes = _get_string_names(f);
+	side_effects.usage_flags = _get_string_names(f);
+	side_effects.write_flags = _get_string_names(f);
+	uint32_t uniform_count = f->get_32();
+	for (uint32_t i = 0; i < uniform_count && !f->eof_reached(); i++) {
+		StringName name = f->get_pascal_string();
+		side_effects.uniforms.push_back(Pair<StringName, SL::ShaderNode::Uniform>(name, _get_uniform(f)));
+	}
+
+	GeneratedCode gen_code;
+	Vector<StringName> defines = _get_string_names(f);
+	for (const StringName &define : defines) {
+		gen_code.defines.push_back(define);
+	}
+	uint32_t texture_count = f->get_32();
+	for (uint32_t i = 0; i < texture_count && !f->eof_reached(); i++) {
+		GeneratedCode::Texture texture;
+		texture.name = f->get_pascal_string();
+		texture.type = SL::DataType(f->get_32());
+		texture.hint = SL::ShaderNode::Uniform::Hint(f->get_32());
+		texture.use_color = f->get_8();
+		texture.filter = SL::TextureFilter(f->get_32());
+		texture.repeat = SL::TextureRepeat(f->get_32());
+		texture.global = f->get_8();
+		texture.array_size = int32_t(f->get_32());
+		gen_code.texture_uniforms.push_back(texture);
+	}
+	uint32_t offset_count = f->get_32();
+	for (uint32_t i = 0; i < offset_count && !f->eof_reached(); i++) {
+		gen_code.uniform_offsets.push_back(f->get_32());
+	}
+	gen_code.uniform_total_size = f->get_32();
+	gen_code.uniforms = f->get_pascal_string();
+	for (int i = 0; i < STAGE_MAX; i++) {
+		gen_code.stage_globals[i] = f->get_pascal_string();
+	}
+	uint32_t code_count = f->get_32();
+	for (uint32_t i = 0; i < code_count && !f->eof_reached(); i++) {
+		String name = f->get_pascal_string();
+		gen_code.code[name] = f->get_pascal_string();
+	}
+	gen_code.uses_global_textures = f->get_8();
+	gen_code.uses_fragment_time = f->get_8();
+	gen_code.uses_vertex_time = f->get_8();
+	gen_code.uses_screen_texture_mipmaps = f->get_8();
+	gen_code.uses_screen_texture = f->get_8();
+	gen_code.uses_depth_texture = f->get_8();
+	gen_code.uses_normal_roughness_texture = f->get_8();
+
+	// Reading past the end of a truncated entry reports EOF, while a complete entry ends at its last value.
+	if (f->get_error() != OK || f->get_position() != f->get_length()) {
+		return false; // Truncated or corrupt entry, compile again to replace it.
+	}
+
+	// Global uniforms may have changed type (or been removed) since the entry was
+	// saved, which the parser would report, so compile again in that case.
+	for (const Pair<StringName, SL::ShaderNode::Uniform> &E : side_effects.uniforms) {
+		if (E.second.scope == SL::ShaderNode::Uniform::SCOPE_GLOBAL && _get_global_shader_uniform_type(E.first) != E.second.type) {
+			return false;
+		}
+	}
+
+	_apply_render_modes(side_effects.render_modes, p_actions);
+	for (const StringName &name : side_effects.usage_flags) {
+		if (p_actions->usage_flag_pointers.has(name)) {
+			*p_actions->usage_flag_pointers[name] = true;
+		}
+	}
+	for (const StringName &name : side_effects.write_flags) {
+		if (p_actions->write_flag_pointers.has(name)) {
+			*p_actions->write_flag_pointers[name] = true;
+		}
+	}
+	if (p_actions->uniforms) {
+		for (const Pair<StringName, SL::ShaderNode::Uniform> &E : side_effects.uniforms) {
+			p_actions->uniforms->insert(E.first, E.second);
+		}
+	}
+
+	r_gen_code = gen_code;
+	return true;
+}
+
+void ShaderCompiler::_save_to_cache(const String &p_key, const CacheSideEffects &p_side_effects, const GeneratedCode &p_gen_code) {
+	// Written to a temporary file first, so an interrupted write or a compiler reading the
+	// entry at the same time never sees a partial entry. Other threads may save the same key.
+	const String path = _get_cache_file_path(p_key);
+	const String temp_path = path + ".tmp" + itos(Thread::get_caller_id());
+	Ref<FileAccess> f = FileAccess::open(temp_path, FileAccess::WRITE);
+	ERR_FAIL_COND(f.is_null());
+	f->store_buffer((const uint8_t *)shader_compiler_cache_header, 4);
+	f->store_32(shader_compiler_cache_version);
+
+	_store_string_names(f, p_side_effects.render_modes);
+	_store_string_names(f, p_side_effects.usage_flags);
+	_store_string_names(f, p_side_effects.write_flags);
+	f->store_32(p_side_effects.uniforms.size());
+	for (const Pair<StringName, SL::ShaderNode::Uniform> &E : p_side_effects.uniforms) {
+		f->store_pascal_string(E.first);
+		_store_uniform(f, E.second);
+	}
+
+	f->store_32(p_gen_code.defines.size());
+	for (const String &define : p_gen_code.defines) {
+		f->store_pascal_string(define);
+	}
+	f->store_32(p_gen_code.texture_uniforms.size());
+	for (const GeneratedCode::Texture &texture : p_gen_code.texture_uniforms) {
+		f->store_pascal_string(texture.name);
+		f->store_32(texture.type);
+		f->store_32(texture.hint);
+		f->store_8(texture.use_color);
+		f->store_32(texture.filter);
+		f->store_32(texture.repeat);
+		f->store_8(texture.global);
+		f->store_32(texture.array_size);
+	}
+	f->store_32(p_gen_code.uniform_offsets.size());
+	for (uint32_t offset : p_gen_code.uniform_offsets) {
+		f->store_32(offset);
+	}
+	f->store_32(p_gen_code.uniform_total_size);
+	f->store_pascal_string(p_gen_code.uniforms);
+	for (int i = 0; i < STAGE_MAX; i++) {
+		f->store_pascal_string(p_gen_code.stage_globals[i]);
+	}
+	f->store_32(p_gen_code.code.size());
+	for (const KeyValue<String, String> &E : p_gen_code.code) {
+		f->store_pascal_string(E.key);
+		f->store_pascal_string(E.value);
+	}
+	f->store_8(p_gen_code.uses_global_textures);
+	f->store_8(p_gen_code.uses_fragment_time);
+	f->store_8(p_gen_code.uses_vertex_time);
+	f->store_8(p_gen_code.uses_screen_texture_mipmaps);
+	f->store_8(p_gen_code.uses_screen_texture);
+	f->store_8(p_gen_code.uses_depth_texture);
+	f->store_8(p_gen_code.uses_normal_roughness_texture);
+
+	const Error err = f->get_error();
+	f.unref(); // Close it before renaming.
+	if (err != OK || DirAccess::rename_absolute(temp_path, path) != OK) {
+		DirAccess::remove_absolute(temp_path);
+	}
+}
+
+Error ShaderCompiler::_compile_and_cache(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, const String &p_key, GeneratedCode &r_gen_code) {
+	// Point the usage and write flags to local storage, so the ones set by the
+	// compilation can be recorded in the cache entry and applied on a hit.
+	IdentifierActions recording_actions;
+	recording_actions.entry_point_stages = p_actions->entry_point_stages;
+	recording_actions.render_mode_values = p_actions->render_mode_values;
+	recording_actions.render_mode_flags = p_actions->render_mode_flags;
+
+	LocalVector<StringName> usage_names;
+	LocalVector<StringName> write_names;
+	LocalVector<bool> usage_values;
+	LocalVector<bool> write_values;
+	usage_values.resize(p_actions->usage_flag_pointers.size());
+	write_values.resize(p_actions->write_flag_pointers.size());
+	for (const KeyValue<StringName, bool *> &E : p_actions->usage_flag_pointers) {
+		usage_values[usage_names.size()] = false;
+		recording_actions.usage_flag_pointers[E.key] = &usage_values[usage_names.size()];
+		usage_names.push_back(E.key);
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions->write_flag_pointers) {
+		write_values[write_names.size()] = false;
+		recording_actions.write_flag_pointers[E.key] = &write_values[write_names.size()];
+		write_names.push_back(E.key);
+	}
+
+	HashMap<StringName, SL::ShaderNode::Uniform> uniforms;
+	recording_actions.uniforms = &uniforms;
+
+	Error err = _compile(p_mode, p_code, &recording_actions, p_path, r_gen_code);
+	if (err != OK) {
+		return err;
+	}
+
+	CacheSideEffects side_effects;
+	side_effects.render_modes = parser.get_shader()->render_modes;
+	for (uint32_t i = 0; i < usage_names.size(); i++) {
+		if (usage_values[i]) {
+			*p_actions->usage_flag_pointers[usage_names[i]] = true;
+			side_effects.usage_flags.push_back(usage_names[i]);
+		}
+	}
+	for (uint32_t i = 0; i < write_names.size(); i++) {
+		if (write_values[i]) {
+			*p_actions->write_flag_pointers[write_names[i]] = true;
+			side_effects.write_flags.push_back(write_names[i]);
+		}
+	}
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : uniforms) {
+		if (p_actions->uniforms) {
+			p_actions->uniforms->insert(E.key, E.value);
+		}
+		side_effects.uniforms.push_back(Pair<StringName, SL::ShaderNode::Uniform>(E.key, E.value));
+	}
+
+	_save_to_cache(p_key, side_effects, r_gen_code);
+	return OK;
+}
+
+ShaderCompiler *ShaderCompiler::_acquire_worker() {
+	MutexLock lock(workers_mutex);
+	if (!busy) {
+		busy = true;
+		return this;
+	}
+
+	if (!idle_workers.is_empty()) {
+		ShaderCompiler *worker = idle_workers[idle_workers.size() - 1];
+		idle_workers.resize(idle_workers.size() - 1);
+		return worker;
+	}
+
+	ShaderCompiler *worker = memnew(ShaderCompiler);
+	worker->initialize(actions);
+	return worker;
+}
+
+void ShaderCompiler::_release_worker(ShaderCompiler *p_worker) {
+	MutexLock lock(workers_mutex);
+	if (p_worker == this) {
+		busy = false;
+	} else {
+		idle_workers.push_back(p_worker);
+	}
+}
+
+Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	String key;
+	if (!shader_cache_dir.is_empty()) {
+		// Cache lookups don't touch the compiler state, no worker needed.
+		key = _get_cache_key(p_mode, p_code, *p_actions, RS::get_singleton()->is_low_end());
+		if (_load_from_cache(key, p_actions, r_gen_code)) {
+			return OK;
+		}
+	}
+
+	ShaderCompiler *worker = _acquire_worker();
+	Error err;
+	if (key.is_empty()) {
+		err = worker->_compile(p_mode, p_code, p_actions, p_path, r_gen_code);
+	} else {
+		err = worker->_compile_and_cache(p_mode, p_code, p_actions, p_path, key, r_gen_code);
+	}
+	_release_worker(worker);
+	return err;
+}
+
+void ShaderCompiler::set_shader_cache_dir(const String &p_dir) {
+	shader_cache_dir = p_dir;
+	if (shader_cache_dir.is_empty()) {
+		return;
+	}
+
+	const String compiler_cache_dir = shader_cache_dir.path_join("ShaderCompiler");
+	if (!DirAccess::exists(compiler_cache_dir)) {
+		Error err = DirAccess::make_dir_recursive_absolute(compiler_cache_dir);
+		if (err != OK) {
+			ERR_PRINT("Can't create the shader compiler cache folder, generated code won't be cached: " + compiler_cache_dir);
+			shader_cache_dir = String();
+		}
+	}
+}
+
+String ShaderCompiler::shader_cache_dir;
+
 void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	actions = p_actions;
 
+	{
+		// Spare compilers were initialized with the old actions.
+		MutexLock lock(workers_mutex);
+		for (ShaderCompiler *worker : idle_workers) {
+			memdelete(worker);
+		}
+		idle_workers.clear();
+	}
+
+	StringBuilder hash_build;
+	_hash_sorted_map(hash_build, "[renames]", actions.renames);
+	_hash_sorted_map(hash_build, "[render_mode_defines]", actions.render_mode_defines);
+	_hash_sorted_map(hash_build, "[usage_defines]", actions.usage_defines);
+	_hash_sorted_map(hash_build, "[custom_samplers]", actions.custom_samplers);
+	hash_build.append("[settings]");
+	hash_build.append(itos(actions.default_filter) + ";" + itos(actions.default_repeat) + ";");
+	hash_build.append(itos(actions.base_texture_binding_index) + ";" + itos(actions.texture_layout_set) + ";");
+	hash_build.append(itos(actions.base_varying_index) + ";" + itos(actions.apply_luminance_multiplier) + ";" + itos(actions.check_multiview_samplers) + ";");
+	hash_build.append("[base_uniform_string]");
+	hash_build.append(actions.base_uniform_string);
+	hash_build.append("[global_buffer_array_variable]");
+	hash_build.append(actions.global_buffer_array_variable);
+	hash_build.append("[instance_uniform_index_variable]");
+	hash_build.append(actions.instance_uniform_index_variable);
+	actions_sha256 = hash_build.as_string().sha256_text();
+
 	time_name = "TIME";
 
 	List<String> func_list;
@@ -1612,3 +2073,9 @@ void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 
 ShaderCompiler::ShaderCompiler() {
 }
+
+ShaderCompiler::~ShaderCompiler() {
+	for (ShaderCompiler *worker : idle_workers) {
+		memdelete(worker);
+	}
+}
@@ -33,11 +33,15 @@
 #ifndef SHADER_COMPILER_H
 #define SHADER_COMPILER_H
 
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "servers/rendering/shader_language.h"
 #include "servers/rendering_server.h"
 
 class ShaderCompiler {
+	friend class TestShaderCompilerInternalsAccessor;
+
 public:
 	enum Stage {
 		STAGE_VERTEX,
@@ -129,11 +133,50 @@ private:
 
 	static ShaderLanguage::DataType _get_global_shader_uniform_type(const StringName &p_name);
 
+	// Generated code cache, stored alongside the ShaderRD/ShaderGLES3 cache.
+	// Entries are keyed on the shader code and everything else that affects
+	// code generation, and they also record the side effects of compiling on
+	// the identifier actions, so a hit can replace parsing entirely.
+	struct CacheSideEffects {
+		Vector<StringName> render_modes;
+		Vector<StringName> usage_flags;
+		Vector<StringName> write_flags;
+		Vector<Pair<StringName, ShaderLanguage::ShaderNode::Uniform>> uniforms;
+	};
+
+	static String shader_cache_dir;
+	String actions_sha256;
+
+	String _get_cache_key(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions &p_actions, bool p_low_end) const;
+	static String _get_cache_file_path(const String &p_key);
+	bool _load_from_cache(const String &p_key, IdentifierActions *p_actions, GeneratedCode &r_gen_code);
+	void _save_to_cache(const String &p_key, const CacheSideEffects &p_side_effects, const GeneratedCode &p_gen_code);
+	static void _apply_render_modes(const Vector<StringName> &p_render_modes, IdentifierActions *p_actions);
+
+	Error _compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
+	Error _compile_and_cache(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, const String &p_key, GeneratedCode &r_gen_code);
+
+	// Parsing and code generation keep their state in the compiler, so
+	// concurrent calls to compile() are handed to spare compilers sharing
+	// the same default actions. Spares are created on demand and reused.
+	Mutex workers_mutex;
+	bool busy = false;
+	LocalVector<ShaderCompiler *> idle_workers;
+
+	ShaderCompiler *_acquire_worker();
+	void _release_worker(ShaderCompiler *p_worker);
+
 public:
+	// Thread-safe, as long as initialize() isn't called concurrently.
 	Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
 
 	void initialize(DefaultIdentifierActions p_actions);
+
+	static void set_shader_cache_dir(const String &p_dir);
+	static String get_shader_cache_dir() { return shader_cache_dir; }
+
 	ShaderCompiler();
+	~ShaderCompiler();
 };
 
 #endif // SHADER_COMPILER_H
@@ -33,6 +33,7 @@
 #include "shader_include_db.h"
 
 HashMap<String, String> ShaderIncludeDB::built_in_includes;
+RWLock ShaderIncludeDB::built_in_includes_lock;
 
 void ShaderIncludeDB::_bind_methods() {
 	ClassDB::bind_static_method("ShaderIncludeDB", D_METHOD("list_built_in_include_files"), &ShaderIncludeDB::list_built_in_include_files);
@@ -41,10 +42,12 @@ void ShaderIncludeDB::_bind_methods() {
 }
 
 void ShaderIncludeDB::register_built_in_include_file(const String &p_filename, const String &p_shader_code) {
+	RWLockWrite write_lock(built_in_includes_lock);
 	built_in_includes[p_filename] = p_shader_code;
 }
 
 PackedStringArray ShaderIncludeDB::list_built_in_include_files() {
+	RWLockRead read_lock(built_in_includes_lock);
 	PackedStringArray ret;
 
 	for (const KeyValue<String, String> &e : built_in_includes) {
@@ -55,10 +58,12 @@ PackedStringArray ShaderIncludeDB::list_built_in_include_files() {
 }
 
 bool ShaderIncludeDB::has_built_in_include_file(const String &p_filename) {
+	RWLockRead read_lock(built_in_includes_lock);
 	return built_in_includes.has(p_filename);
 }
 
 String ShaderIncludeDB::get_built_in_include_file(const String &p_filename) {
+	RWLockRead read_lock(built_in_includes_lock);
 	const String *ptr = built_in_includes.getptr(p_filename);
 
 	return ptr ? *ptr : String();
@@ -34,12 +34,15 @@
 #define SHADER_INCLUDE_DB_H
 
 #include "core/object/class_db.h"
+#include "core/os/rw_lock.h"
 
 class ShaderIncludeDB : public Object {
 	GDCLASS(ShaderIncludeDB, Object)
 
 private:
 	static HashMap<String, String> built_in_includes;
+	// Shaders may be parsed on worker threads while includes are being registered.
+	static RWLock built_in_includes_lock;
 
 protected:
 	static void _bind_methods();
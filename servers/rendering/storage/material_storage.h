@@ -72,6 +72,8 @@ public:
 	virtual Variant shader_get_parameter_default(RID p_material, const StringName &p_param) const = 0;
 
 	virtual RS::ShaderNativeSourceCode shader_get_native_source_code(RID p_shader) const = 0;
+	virtual bool shader_is_compiled(RID p_shader) const = 0;
+	virtual void shader_request_compiled_callback(RID p_shader, const Callable &p_callable) = 0;
 
 	/* MATERIAL API */
 
@@ -249,6 +249,8 @@ public:
 	};
 
 	virtual ShaderNativeSourceCode shader_get_native_source_code(RID p_shader) const = 0;
+	virtual bool shader_is_compiled(RID p_shader) const = 0;
+	virtual void shader_request_compiled_callback(RID p_shader, const Callable &p_callable) = 0;
 
 	/* COMMON MATERIAL API */
 
@@ -34,8 +34,9 @@
 #define TEST_JSON_H
 
 #include "core/io/json.h"
+#include "core/os/os.h"
 
-#include "thirdparty/doctest/doctest.h"
+#include "tests/test_macros.h"
 
 namespace TestJSON {
 
@@ -319,6 +320,76 @@ TEST_CASE("[JSON] Serialization") {
 		}
 	}
 }
+
+static void _count_string_bytes(const Variant &p_value, uint64_t &r_utf32, uint64_t &r_utf8) {
+	switch (p_value.get_type()) {
+		case Variant::STRING: {
+			const String str = p_value;
+			r_utf32 += (str.length() + 1) * sizeof(char32_t);
+			r_utf8 += str.utf8().length() + 1;
+		} break;
+		case Variant::ARRAY: {
+			const Array arr = p_value;
+			for (const Variant &E : arr) {
+				_count_string_bytes(E, r_utf32, r_utf8);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			const Dictionary dict = p_value;
+			for (const Variant &key : dict.keys()) {
+				_count_string_bytes(key, r_utf32, r_utf8);
+				_count_string_bytes(dict[key], r_utf32, r_utf8);
+			}
+		} break;
+		default:
+			break;
+	}
+}
+
+TEST_CASE_BENCHMARK("[JSON][Benchmark] String memory and conversions on a dialog corpus") {
+	// A dialog database as games ship them: mostly ASCII, with some localized lines.
+	Array entries;
+	for (int i = 0; i < 20000; i++) {
+		Dictionary entry;
+		entry["id"] = vformat("dialog_%05d", i);
+		entry["speaker"] = i % 3 ? "Villager" : "Blacksmith";
+		entry["text"] = vformat("Line %d: Have you heard about the old mill by the river? They say it has been abandoned for years.", i);
+		if (i % 10 == 0) {
+			entry["text_fr"] = vformat("Réplique %d : As-tu entendu parler du vieux moulin près de la rivière ?", i);
+		}
+		Array choices;
+		choices.push_back("Tell me more.");
+		choices.push_back("Not interested.");
+		entry["choices"] = choices;
+		entries.push_back(entry);
+	}
+	const String corpus = JSON::stringify(entries, "\t");
+	const CharString corpus_utf8 = corpus.utf8();
+
+	uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+	String parsed;
+	parsed.parse_utf8(corpus_utf8.get_data(), corpus_utf8.length());
+	const uint64_t parse_utf8_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+	CHECK(parsed == corpus);
+
+	begin_usec = OS::get_singleton()->get_ticks_usec();
+	const CharString encoded = corpus.utf8();
+	const uint64_t utf8_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+	CHECK(encoded.length() == corpus_utf8.length());
+
+	JSON json;
+	begin_usec = OS::get_singleton()->get_ticks_usec();
+	REQUIRE(json.parse(parsed) == OK);
+	const uint64_t json_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+
+	uint64_t utf32_bytes = 0;
+	uint64_t utf8_bytes = 0;
+	_count_string_bytes(json.get_data(), utf32_bytes, utf8_bytes);
+
+	MESSAGE(vformat("Corpus: %d characters, %d bytes as String, %d bytes as UTF-8.", corpus.length(), (corpus.length() + 1) * sizeof(char32_t), corpus_utf8.length() + 1));
+	MESSAGE(vformat("parse_utf8: %d usec, utf8(): %d usec, JSON::parse: %d usec.", parse_utf8_usec, utf8_usec, json_usec));
+	MESSAGE(vformat("Parsed strings: %d bytes as String, %d bytes as UTF-8.", utf32_bytes, utf8_bytes));
+}
 } // namespace TestJSON
 
 #endif // TEST_JSON_H
@@ -36,6 +36,7 @@
 #include "core/core_bind.h"
 #include "core/core_constants.h"
 #include "core/object/class_db.h"
+#include "core/object/ref_counted.h"
 
 #include "tests/test_macros.h"
 
@@ -881,7 +882,64 @@ void add_global_enums(Context &r_context) {
 	}
 }
 
+class _TestLookupObject : public RefCounted {
+	GDCLASS(_TestLookupObject, RefCounted);
+
+	int value = 0;
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_value", "value"), &_TestLookupObject::set_value);
+		ClassDB::bind_method(D_METHOD("get_value"), &_TestLookupObject::get_value);
+		ADD_PROPERTY(PropertyInfo(Variant::INT, "value"), "set_value", "get_value");
+		BIND_CONSTANT(LOOKUP_CONSTANT);
+		ADD_SIGNAL(MethodInfo("value_changed"));
+	}
+
+public:
+	enum {
+		LOOKUP_CONSTANT = 42,
+	};
+
+	void set_value(int p_value) { value = p_value; }
+	int get_value() const { return value; }
+};
+
 TEST_SUITE("[ClassDB]") {
+	TEST_CASE("[ClassDB] Member lookups include inherited members") {
+		// Look up members before registering a class, so the lookup tables built here need to be invalidated.
+		MethodBind *reference = ClassDB::get_method("RefCounted", "reference");
+		CHECK(reference != nullptr);
+		CHECK_FALSE(ClassDB::has_method("RefCounted", "get_value"));
+
+		GDREGISTER_CLASS(_TestLookupObject);
+
+		CHECK(ClassDB::get_method("_TestLookupObject", "get_value") != nullptr);
+		CHECK(ClassDB::get_method("_TestLookupObject", "reference") == reference);
+		CHECK(ClassDB::get_method("_TestLookupObject", "missing") == nullptr);
+		CHECK(ClassDB::has_method("_TestLookupObject", "get_class"));
+		CHECK_FALSE(ClassDB::has_method("_TestLookupObject", "get_class", true));
+		CHECK_FALSE(ClassDB::has_method("RefCounted", "get_value"));
+
+		bool valid = false;
+		CHECK(ClassDB::get_property_index("_TestLookupObject", "value", &valid) == -1);
+		CHECK(valid);
+		ClassDB::get_property_index("_TestLookupObject", "get_value", &valid);
+		CHECK_FALSE(valid);
+
+		Ref<_TestLookupObject> object;
+		object.instantiate();
+		object->set("value", 7);
+		CHECK(object->get_value() == 7);
+		CHECK(object->get("value") == Variant(7));
+		CHECK(object->get("LOOKUP_CONSTANT") == Variant(42));
+		CHECK(object->get("get_value") == Variant(Callable(object.ptr(), "get_value")));
+		CHECK(object->get("value_changed") == Variant(Signal(object.ptr(), "value_changed")));
+		CHECK(object->get("script_changed") == Variant(Signal(object.ptr(), "script_changed")));
+		object->get("missing", &valid);
+		CHECK_FALSE(valid);
+	}
+
 	TEST_CASE("[ClassDB] Add exposed classes, builtin types, and global enums") {
 		Context context;
 
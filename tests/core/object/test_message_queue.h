@@ -0,0 +1,194 @@
+/**************************************************************************/
+/*  test_message_queue.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MESSAGE_QUEUE_H
+#define TEST_MESSAGE_QUEUE_H
+
+#include "core/object/message_queue.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "tests/test_macros.h"
+
+namespace TestMessageQueue {
+
+class DeferredTarget : public Object {
+public:
+	LocalVector<int> values;
+	int calls = 0;
+
+	void call() { calls++; }
+	void add_value(int p_value) { values.push_back(p_value); }
+	void add_string(const String &p_string) { values.push_back(p_string.length()); }
+};
+
+struct PushData {
+	DeferredTarget *target = nullptr;
+	int from = 0;
+	int count = 0;
+};
+
+static void push_values(void *p_userdata) {
+	PushData *data = (PushData *)p_userdata;
+	for (int i = 0; i < data->count; i++) {
+		MessageQueue::get_singleton()->push_method(data->target, &DeferredTarget::add_value, data->from + i);
+	}
+}
+
+TEST_CASE("[MessageQueue] Typed deferred calls") {
+	MessageQueue *queue = memnew(MessageQueue);
+	DeferredTarget *target = memnew(DeferredTarget);
+
+	CHECK(queue->push_method(target, &DeferredTarget::call) == OK);
+	CHECK(queue->push_method(target, &DeferredTarget::add_value, 7) == OK);
+	CHECK(queue->push_method(target, &DeferredTarget::add_string, String("redot")) == OK);
+	CHECK(queue->push_callable(callable_mp(target, &DeferredTarget::add_value), 8) == OK);
+	CHECK(queue->has_messages());
+	CHECK(target->calls == 0);
+
+	queue->flush();
+	CHECK_FALSE(queue->has_messages());
+	CHECK(target->calls == 1);
+	REQUIRE(target->values.size() == 3);
+	CHECK(target->values[0] == 7);
+	CHECK(target->values[1] == 5);
+	CHECK(target->values[2] == 8);
+
+	// Calls to freed objects are dropped.
+	queue->push_method(target, &DeferredTarget::call);
+	queue->push_method(target, &DeferredTarget::add_string, String("dropped"));
+	memdelete(target);
+	queue->flush();
+	CHECK_FALSE(queue->has_messages());
+
+	memdelete(queue);
+}
+
+TEST_CASE("[MessageQueue] Deferred calls from worker threads keep push order") {
+	MessageQueue *queue = memnew(MessageQueue);
+	DeferredTarget *target = memnew(DeferredTarget);
+
+	// Several pages worth of calls, so the thread buffers grow and get consumed.
+	const int count = CallQueue::PAGE_SIZE_BYTES / 16;
+
+	queue->push_method(target, &DeferredTarget::add_value, -1);
+
+	PushData data[2];
+	Thread threads[2];
+	for (int i = 0; i < 2; i++) {
+		data[i].target = target;
+		data[i].from = i * count;
+		data[i].count = count;
+		threads[i].start(push_values, &data[i]);
+	}
+	for (int i = 0; i < 2; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	queue->push_method(target, &DeferredTarget::add_value, -2);
+	CHECK(queue->has_messages());
+
+	queue->flush();
+	CHECK_FALSE(queue->has_messages());
+
+	REQUIRE(target->values.size() == uint32_t(count * 2 + 2));
+	CHECK(target->values[0] == -1);
+	CHECK(target->values[count * 2 + 1] == -2);
+
+	// Each thread's calls are in order, and all of them came before the last push.
+	int next[2] = { 0, count };
+	bool ordered = true;
+	for (uint32_t i = 1; i < target->values.size() - 1; i++) {
+		int value = target->values[i];
+		int thread = value / count;
+		ordered = ordered && value == next[thread];
+		next[thread]++;
+	}
+	CHECK(ordered);
+	CHECK(next[0] == count);
+	CHECK(next[1] == count * 2);
+
+	memdelete(target);
+	memdelete(queue);
+}
+
+TEST_CASE_BENCHMARK("[MessageQueue][Benchmark] Deferred calls") {
+	MessageQueue *queue = memnew(MessageQueue);
+	DeferredTarget *target = memnew(DeferredTarget);
+	const int count = 2000;
+	const int rounds = 100;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < rounds; r++) {
+		for (int i = 0; i < count; i++) {
+			callable_mp(target, &DeferredTarget::add_value).call_deferred(i);
+		}
+		queue->flush();
+		target->values.clear();
+	}
+	const uint64_t callable_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < rounds; r++) {
+		for (int i = 0; i < count; i++) {
+			queue->push_method(target, &DeferredTarget::add_value, i);
+		}
+		queue->flush();
+		target->values.clear();
+	}
+	const uint64_t method_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	PushData data[4];
+	Thread threads[4];
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int r = 0; r < rounds; r++) {
+		for (int i = 0; i < 4; i++) {
+			data[i].target = target;
+			data[i].count = count / 4;
+			threads[i].start(push_values, &data[i]);
+		}
+		for (int i = 0; i < 4; i++) {
+			threads[i].wait_to_finish();
+		}
+		queue->flush();
+		target->values.clear();
+	}
+	const uint64_t threaded_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("call_deferred(): %d usec, push_method(): %d usec, push_method() from 4 threads: %d usec (%d calls).", callable_usec, method_usec, threaded_usec, count * rounds));
+
+	memdelete(target);
+	memdelete(queue);
+}
+
+} // namespace TestMessageQueue
+
+#endif // TEST_MESSAGE_QUEUE_H
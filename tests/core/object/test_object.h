@@ -468,6 +468,80 @@ TEST_CASE("[Object] Signals") {
 	}
 }
 
+class SignalReceiver : public Object {
+public:
+	Object *emitter = nullptr;
+	int calls = 0;
+	int value = 0;
+	String text;
+
+	void receive(int p_value, const String &p_text) {
+		calls++;
+		value = p_value;
+		text = p_text;
+	}
+	void receive_float(float p_value, const String &p_text) {
+		calls++;
+		value = p_value;
+		text = p_text;
+	}
+	void receive_and_reconnect(int p_value, const String &p_text) {
+		calls++;
+		// Connecting from a callback must not affect the ongoing emission.
+		emitter->connect("my_signal", callable_mp(this, &SignalReceiver::receive));
+		emitter->disconnect("my_signal", callable_mp(this, &SignalReceiver::receive_and_reconnect));
+	}
+};
+
+TEST_CASE("[Object] Signal emission") {
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("my_signal", PropertyInfo(Variant::INT, "value"), PropertyInfo(Variant::STRING, "text")));
+
+	SignalReceiver receiver;
+	receiver.emitter = &emitter;
+
+	SUBCASE("Typed emission calls method pointers directly") {
+		emitter.connect("my_signal", callable_mp(&receiver, &SignalReceiver::receive));
+		CHECK(emitter.emit_signal_typed("my_signal", 3, String("typed")) == OK);
+		CHECK(receiver.calls == 1);
+		CHECK(receiver.value == 3);
+		CHECK(receiver.text == "typed");
+
+		CHECK(emitter.emit_signal("my_signal", 4, "boxed") == OK);
+		CHECK(receiver.calls == 2);
+		CHECK(receiver.value == 4);
+		CHECK(receiver.text == "boxed");
+	}
+
+	SUBCASE("Typed emission converts to Variants when the parameters don't match") {
+		emitter.connect("my_signal", callable_mp(&receiver, &SignalReceiver::receive_float));
+		emitter.connect("my_signal", callable_mp(&receiver, &SignalReceiver::receive).bind(7, "bound").unbind(2));
+		CHECK(emitter.emit_signal_typed("my_signal", 5, String("converted")) == OK);
+		CHECK(receiver.calls == 2);
+	}
+
+	SUBCASE("Connections changed during emission apply to the next emission") {
+		emitter.connect("my_signal", callable_mp(&receiver, &SignalReceiver::receive_and_reconnect));
+		emitter.emit_signal_typed("my_signal", 1, String("first"));
+		CHECK(receiver.calls == 1);
+		CHECK(receiver.text.is_empty());
+
+		emitter.emit_signal_typed("my_signal", 2, String("second"));
+		CHECK(receiver.calls == 2);
+		CHECK(receiver.value == 2);
+		CHECK(receiver.text == "second");
+	}
+
+	SUBCASE("One-shot connections are only called once") {
+		emitter.connect("my_signal", callable_mp(&receiver, &SignalReceiver::receive), Object::CONNECT_ONE_SHOT);
+		emitter.emit_signal_typed("my_signal", 1, String("once"));
+		emitter.emit_signal_typed("my_signal", 2, String("twice"));
+		CHECK(receiver.calls == 1);
+		CHECK(receiver.value == 1);
+		CHECK_FALSE(emitter.has_connections("my_signal"));
+	}
+}
+
 class NotificationObject1 : public Object {
 	GDCLASS(NotificationObject1, Object);
 
@@ -0,0 +1,192 @@
+/**************************************************************************/
+/*  test_frame_allocator.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FRAME_ALLOCATOR_H
+#define TEST_FRAME_ALLOCATOR_H
+
+#include "core/os/frame_allocator.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameAllocator {
+
+TEST_CASE("[FrameAllocator] Arena is rewound once everything is freed") {
+	uint8_t *a = (uint8_t *)FrameAllocator::alloc(100);
+	uint8_t *b = (uint8_t *)FrameAllocator::alloc(100);
+	REQUIRE(a != nullptr);
+	REQUIRE(b != nullptr);
+	CHECK(uintptr_t(a) % 16 == 0);
+	CHECK(uintptr_t(b) % 16 == 0);
+	CHECK(b > a);
+
+	// Out of order, so the space isn't reusable until both are freed.
+	FrameAllocator::free(a);
+	uint8_t *c = (uint8_t *)FrameAllocator::alloc(16);
+	CHECK(c > b);
+	FrameAllocator::free(c);
+	FrameAllocator::free(b);
+
+	uint8_t *d = (uint8_t *)FrameAllocator::alloc(100);
+	CHECK(d == a);
+	FrameAllocator::free(d);
+}
+
+TEST_CASE("[FrameAllocator] Reallocation") {
+	uint8_t *a = (uint8_t *)FrameAllocator::alloc(32);
+	for (int i = 0; i < 32; i++) {
+		a[i] = i;
+	}
+	// The last allocation grows in place.
+	CHECK(FrameAllocator::realloc(a, 1000) == a);
+
+	uint8_t *b = (uint8_t *)FrameAllocator::alloc(16);
+	uint8_t *moved = (uint8_t *)FrameAllocator::realloc(a, 2000);
+	CHECK(moved != a);
+	bool contents_kept = true;
+	for (int i = 0; i < 32; i++) {
+		contents_kept = contents_kept && moved[i] == i;
+	}
+	CHECK(contents_kept);
+
+	// Bigger than a block.
+	uint8_t *large = (uint8_t *)FrameAllocator::realloc(moved, FrameAllocator::BLOCK_SIZE * 3);
+	REQUIRE(large != nullptr);
+	contents_kept = true;
+	for (int i = 0; i < 32; i++) {
+		contents_kept = contents_kept && large[i] == i;
+	}
+	CHECK(contents_kept);
+	large[FrameAllocator::BLOCK_SIZE * 3 - 1] = 1;
+
+	FrameAllocator::free(b);
+	FrameAllocator::free(large);
+}
+
+TEST_CASE("[FrameAllocator] Spikes are consolidated and released") {
+	// Needs several blocks while they're all alive.
+	const int count = 8;
+	void *blocks[count];
+	for (int i = 0; i < count; i++) {
+		blocks[i] = FrameAllocator::alloc(FrameAllocator::BLOCK_SIZE);
+	}
+	for (int i = 0; i < count; i++) {
+		FrameAllocator::free(blocks[i]);
+	}
+
+	// Next use replaces them with a single block that fits everything.
+	FrameAllocator::free(FrameAllocator::alloc(16));
+	FrameAllocator::Stats stats = FrameAllocator::get_thread_stats();
+	CHECK(stats.reserved >= FrameAllocator::BLOCK_SIZE * count);
+	uint64_t block_allocations = stats.block_allocations;
+	for (int i = 0; i < count; i++) {
+		blocks[i] = FrameAllocator::alloc(FrameAllocator::BLOCK_SIZE);
+	}
+	for (int i = 0; i < count; i++) {
+		FrameAllocator::free(blocks[i]);
+	}
+	CHECK(FrameAllocator::get_thread_stats().block_allocations == block_allocations);
+
+	// A frame using much less gives the memory back.
+	FrameAllocator::end_frame();
+	FrameAllocator::free(FrameAllocator::alloc(16));
+	FrameAllocator::end_frame();
+	FrameAllocator::free(FrameAllocator::alloc(16));
+	CHECK(FrameAllocator::get_thread_stats().reserved < FrameAllocator::BLOCK_SIZE * count);
+}
+
+// Scratch arrays built once per frame, like cull results.
+template <typename V>
+static uint32_t build_scratch(uint32_t p_count) {
+	V scratch;
+	for (uint32_t i = 0; i < p_count; i++) {
+		scratch.push_back(i);
+	}
+	V other;
+	other.resize(p_count / 2);
+	return scratch.size() + other.size();
+}
+
+TEST_CASE("[FrameAllocator] FrameLocalVector doesn't allocate once warmed up") {
+	FrameLocalVector<int> vector = { 1, 2, 3 };
+	vector.push_back(4);
+	CHECK(vector.size() == 4);
+	CHECK(vector[3] == 4);
+	Vector<int> converted = vector;
+	CHECK(converted.size() == 4);
+	CHECK(converted[0] == 1);
+	vector.reset();
+
+	build_scratch<FrameLocalVector<uint32_t>>(1000);
+	FrameAllocator::end_frame();
+
+#ifdef DEBUG_ENABLED
+	const uint64_t local_vector_begin = Memory::get_thread_alloc_count();
+	build_scratch<LocalVector<uint32_t>>(1000);
+	const uint64_t local_vector_allocations = Memory::get_thread_alloc_count() - local_vector_begin;
+
+	const uint64_t frame_vector_begin = Memory::get_thread_alloc_count();
+	build_scratch<FrameLocalVector<uint32_t>>(1000);
+	const uint64_t frame_vector_allocations = Memory::get_thread_alloc_count() - frame_vector_begin;
+
+	MESSAGE(vformat("Allocations for 1000 elements: LocalVector %d, FrameLocalVector %d.", local_vector_allocations, frame_vector_allocations));
+	CHECK(local_vector_allocations > 0);
+	CHECK(frame_vector_allocations == 0);
+#endif
+}
+
+TEST_CASE_BENCHMARK("[FrameAllocator][Benchmark] Scratch vectors") {
+	const uint32_t iterations = 100000;
+	const uint32_t element_counts[] = { 8, 64, 1024 };
+
+	for (uint32_t element_count : element_counts) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		uint32_t checksum = 0;
+		for (uint32_t i = 0; i < iterations; i++) {
+			checksum += build_scratch<LocalVector<uint32_t>>(element_count);
+		}
+		uint64_t local_vector_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < iterations; i++) {
+			checksum += build_scratch<FrameLocalVector<uint32_t>>(element_count);
+		}
+		uint64_t frame_vector_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		CHECK(checksum > 0);
+		MESSAGE(vformat("%d elements: LocalVector %.1f ns, FrameLocalVector %.1f ns per build.", element_count, double(local_vector_usec) * 1000.0 / iterations, double(frame_vector_usec) * 1000.0 / iterations));
+	}
+}
+
+} // namespace TestFrameAllocator
+
+#endif // TEST_FRAME_ALLOCATOR_H
@@ -0,0 +1,282 @@
+/**************************************************************************/
+/*  test_thread_cache_allocator.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_THREAD_CACHE_ALLOCATOR_H
+#define TEST_THREAD_CACHE_ALLOCATOR_H
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/os/thread_cache_allocator.h"
+
+#include "tests/test_macros.h"
+
+namespace TestThreadCacheAllocator {
+
+TEST_CASE("[ThreadCacheAllocator] Size classes") {
+	for (size_t size = 1; size <= ThreadCacheAllocator::MAX_SMALL_SIZE; size++) {
+		uint32_t size_class = ThreadCacheAllocator::get_size_class(size);
+		REQUIRE(size_class < ThreadCacheAllocator::SIZE_CLASS_COUNT);
+		REQUIRE(ThreadCacheAllocator::get_size_class_size(size_class) >= size);
+		if (size_class > 0) {
+			// Smallest class that fits.
+			REQUIRE(ThreadCacheAllocator::get_size_class_size(size_class - 1) < size);
+		}
+		// Blocks must keep the alignment of max_align_t.
+		REQUIRE(ThreadCacheAllocator::get_size_class_size(size_class) % 16 == 0);
+	}
+	CHECK(ThreadCacheAllocator::get_size_class_size(ThreadCacheAllocator::SIZE_CLASS_COUNT - 1) == ThreadCacheAllocator::MAX_SMALL_SIZE);
+}
+
+TEST_CASE("[ThreadCacheAllocator] Allocation, reallocation and free") {
+	uint8_t *small = (uint8_t *)ThreadCacheAllocator::alloc(40);
+	REQUIRE(small != nullptr);
+	CHECK(uintptr_t(small) % 16 == 0);
+	CHECK(ThreadCacheAllocator::get_block_size(small) == 48);
+	for (int i = 0; i < 40; i++) {
+		small[i] = i;
+	}
+
+	// Grows in place while it fits the block.
+	CHECK(ThreadCacheAllocator::realloc(small, 48) == small);
+
+	uint8_t *grown = (uint8_t *)ThreadCacheAllocator::realloc(small, 1000);
+	REQUIRE(grown != nullptr);
+	CHECK(ThreadCacheAllocator::get_block_size(grown) >= 1000);
+	bool contents_kept = true;
+	for (int i = 0; i < 40; i++) {
+		contents_kept = contents_kept && grown[i] == i;
+	}
+	CHECK(contents_kept);
+
+	// Past MAX_SMALL_SIZE it's handed to the system allocator.
+	uint8_t *large = (uint8_t *)ThreadCacheAllocator::realloc(grown, ThreadCacheAllocator::MAX_SMALL_SIZE * 4);
+	REQUIRE(large != nullptr);
+	CHECK(ThreadCacheAllocator::get_block_size(large) == 0);
+	contents_kept = true;
+	for (int i = 0; i < 40; i++) {
+		contents_kept = contents_kept && large[i] == i;
+	}
+	CHECK(contents_kept);
+
+	uint8_t *shrunk = (uint8_t *)ThreadCacheAllocator::realloc(large, 64);
+	REQUIRE(shrunk != nullptr);
+	CHECK(ThreadCacheAllocator::get_block_size(shrunk) == 64);
+	contents_kept = true;
+	for (int i = 0; i < 40; i++) {
+		contents_kept = contents_kept && shrunk[i] == i;
+	}
+	CHECK(contents_kept);
+
+	ThreadCacheAllocator::free(shrunk);
+	ThreadCacheAllocator::free(nullptr);
+
+	// Freed blocks are reused by the same thread.
+	void *a = ThreadCacheAllocator::alloc(100);
+	ThreadCacheAllocator::free(a);
+	void *b = ThreadCacheAllocator::alloc(100);
+	CHECK(a == b);
+	ThreadCacheAllocator::free(b);
+}
+
+struct CrossThreadData {
+	void **blocks = nullptr;
+	uint32_t count = 0;
+};
+
+static void free_blocks(void *p_userdata) {
+	CrossThreadData *data = (CrossThreadData *)p_userdata;
+	for (uint32_t i = 0; i < data->count; i++) {
+		ThreadCacheAllocator::free(data->blocks[i]);
+	}
+	ThreadCacheAllocator::flush_thread_cache();
+}
+
+TEST_CASE("[ThreadCacheAllocator] Blocks freed on another thread are reused") {
+	const uint32_t count = 4096;
+	void *blocks[count];
+	for (uint32_t i = 0; i < count; i++) {
+		blocks[i] = ThreadCacheAllocator::alloc(i % 512 + 1);
+		REQUIRE(blocks[i] != nullptr);
+		memset(blocks[i], 0xAB, i % 512 + 1);
+	}
+	ThreadCacheAllocator::flush_thread_cache();
+	const ThreadCacheAllocator::Stats before = ThreadCacheAllocator::get_stats();
+
+	CrossThreadData data;
+	data.blocks = blocks;
+	data.count = count;
+	Thread thread;
+	thread.start(free_blocks, &data);
+	thread.wait_to_finish();
+
+	const ThreadCacheAllocator::Stats after = ThreadCacheAllocator::get_stats();
+	CHECK(after.central_free > before.central_free);
+
+	// Allocating again doesn't need more chunks.
+	for (uint32_t i = 0; i < count; i++) {
+		blocks[i] = ThreadCacheAllocator::alloc(i % 512 + 1);
+	}
+	CHECK(ThreadCacheAllocator::get_stats().chunk_count == after.chunk_count);
+	for (uint32_t i = 0; i < count; i++) {
+		ThreadCacheAllocator::free(blocks[i]);
+	}
+}
+
+struct BenchmarkAllocator {
+	const char *name;
+	void *(*alloc)(size_t);
+	void (*free)(void *);
+};
+
+static void *_system_alloc(size_t p_bytes) {
+	return malloc(p_bytes);
+}
+
+static void _system_free(void *p_memory) {
+	free(p_memory);
+}
+
+static void *_memory_alloc(size_t p_bytes) {
+	return Memory::alloc_static(p_bytes);
+}
+
+static void _memory_free(void *p_memory) {
+	Memory::free_static(p_memory);
+}
+
+static const BenchmarkAllocator benchmark_allocators[] = {
+	{ "system", _system_alloc, _system_free },
+	{ "ThreadCacheAllocator", ThreadCacheAllocator::alloc, ThreadCacheAllocator::free },
+	{ "Memory::alloc_static", _memory_alloc, _memory_free },
+};
+
+struct BenchmarkChurn {
+	const BenchmarkAllocator *allocator = nullptr;
+	uint32_t iterations = 0;
+};
+
+// Allocation pattern of short lived strings and arrays: sizes are mostly small
+// and blocks are freed in a different order than they were allocated.
+static void churn(void *p_userdata) {
+	const BenchmarkChurn *data = (const BenchmarkChurn *)p_userdata;
+	const uint32_t live_count = 256;
+	void *live[live_count] = {};
+	uint32_t seed = 12345;
+	for (uint32_t i = 0; i < data->iterations; i++) {
+		seed = seed * 1664525 + 1013904223;
+		uint32_t slot = (seed >> 8) % live_count;
+		if (live[slot]) {
+			data->allocator->free(live[slot]);
+		}
+		size_t size = (seed >> 20) % 8 == 0 ? 512 + (seed >> 16) % 2048 : 8 + (seed >> 24) % 120;
+		live[slot] = data->allocator->alloc(size);
+		*(uint8_t *)live[slot] = 1;
+	}
+	for (uint32_t i = 0; i < live_count; i++) {
+		if (live[i]) {
+			data->allocator->free(live[i]);
+		}
+	}
+}
+
+TEST_CASE_BENCHMARK("[ThreadCacheAllocator][Benchmark] Allocation churn") {
+	const uint32_t iterations = 4000000;
+	const uint32_t thread_count = MAX(2, MIN(OS::get_singleton()->get_processor_count(), 8));
+
+	for (const BenchmarkAllocator &allocator : benchmark_allocators) {
+		BenchmarkChurn data;
+		data.allocator = &allocator;
+		data.iterations = iterations;
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		churn(&data);
+		uint64_t single_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		Thread threads[8];
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < thread_count; i++) {
+			threads[i].start(churn, &data);
+		}
+		for (uint32_t i = 0; i < thread_count; i++) {
+			threads[i].wait_to_finish();
+		}
+		uint64_t multi_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE(vformat("%s: 1 thread %.1f ns/op, %d threads %.1f ns/op.", allocator.name, double(single_usec) * 1000.0 / iterations, thread_count, double(multi_usec) * 1000.0 / iterations));
+	}
+}
+
+struct BenchmarkFree {
+	const BenchmarkAllocator *allocator = nullptr;
+	void **blocks = nullptr;
+	uint32_t count = 0;
+};
+
+static void free_all(void *p_userdata) {
+	const BenchmarkFree *data = (const BenchmarkFree *)p_userdata;
+	for (uint32_t i = 0; i < data->count; i++) {
+		data->allocator->free(data->blocks[i]);
+	}
+}
+
+TEST_CASE_BENCHMARK("[ThreadCacheAllocator][Benchmark] Free on another thread") {
+	const uint32_t count = 1 << 20;
+	void **blocks = (void **)malloc(sizeof(void *) * count);
+
+	for (const BenchmarkAllocator &allocator : benchmark_allocators) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < count; i++) {
+			blocks[i] = allocator.alloc(16 + (i % 7) * 16);
+		}
+		uint64_t alloc_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		// Producer/consumer pattern, like command queues handing data to a server thread.
+		BenchmarkFree free_data;
+		free_data.allocator = &allocator;
+		free_data.blocks = blocks;
+		free_data.count = count;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		Thread thread;
+		thread.start(free_all, &free_data);
+		thread.wait_to_finish();
+		uint64_t free_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE(vformat("%s: alloc %.1f ns/op, free on another thread %.1f ns/op.", allocator.name, double(alloc_usec) * 1000.0 / count, double(free_usec) * 1000.0 / count));
+	}
+
+	free(blocks);
+}
+
+} // namespace TestThreadCacheAllocator
+
+#endif // TEST_THREAD_CACHE_ALLOCATOR_H
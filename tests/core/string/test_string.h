@@ -33,6 +33,7 @@
 #ifndef TEST_STRING_H
 #define TEST_STRING_H
 
+#include "core/os/os.h"
 #include "core/string/ustring.h"
 
 #include "tests/test_macros.h"
@@ -236,6 +237,94 @@ TEST_CASE("[String] Comparisons (equal)") {
 	CHECK(cs == CharString("Test Compare"));
 }
 
+TEST_CASE("[String] UTF-8 and ASCII conversions of long strings") {
+	// Cover the bulk ASCII paths, including non-ASCII characters at and around vector boundaries.
+	const String ascii = String("The quick brown fox jumps over the lazy dog. ").repeat(8);
+	CHECK(String::utf8(ascii.utf8().get_data()) == ascii);
+	CHECK(String(ascii.ascii().get_data()) == ascii);
+
+	for (int i = 0; i < 40; i++) {
+		String mixed = ascii;
+		mixed[i] = U'é';
+		mixed[ascii.length() - 1 - i] = U'😀';
+		const CharString utf8 = mixed.utf8();
+		CHECK(utf8.length() == ascii.length() + 4);
+		CHECK(String::utf8(utf8.get_data()) == mixed);
+		CHECK(String::utf8(utf8.get_data(), utf8.length()) == mixed);
+	}
+
+	String with_cr;
+	CHECK(with_cr.parse_utf8("0123456789abcdef0123\r\nline", -1, true) == OK);
+	CHECK(with_cr == "0123456789abcdef0123\nline");
+
+	// Input stops at the first NUL byte.
+	const char with_nul[] = "0123456789abcdef0123\0ignored";
+	CHECK(String::utf8(with_nul, sizeof(with_nul) - 1) == "0123456789abcdef0123");
+
+	const char latin1[] = "Caf\xe9 cr\xe8me br\xfbl\xe9" "e, na\xefve fa\xe7" "ade";
+	const String from_latin1 = String(latin1);
+	CHECK(from_latin1 == U"Café crème brûlée, naïve façade");
+	CHECK(from_latin1.ascii(true) == CharString(latin1));
+}
+
+TEST_CASE("[String] CharString inline storage") {
+	const int inline_length = SmallCowData<char>::INLINE_SIZE - 1;
+	const String short_str = String("a").repeat(inline_length);
+	const String long_str = String("b").repeat(inline_length + 1);
+
+	CharString cs = short_str.utf8();
+	CHECK(cs.length() == inline_length);
+	CHECK(String(cs) == short_str);
+
+	// Growing past the inline buffer keeps the contents.
+	cs += 'c';
+	CHECK(cs.length() == inline_length + 1);
+	CHECK(String(cs) == short_str + "c");
+
+	// Shrinking back moves the contents inline again.
+	cs.resize(3);
+	cs[2] = 0;
+	CHECK(cs == CharString("aa"));
+
+	// Copies of both short and long strings are independent.
+	CharString short_copy = short_str.utf8();
+	CharString short_other = short_copy;
+	short_other[0] = 'z';
+	CHECK(short_copy[0] == 'a');
+	CHECK(short_other[0] == 'z');
+
+	CharString long_copy = long_str.utf8();
+	CharString long_other = long_copy;
+	CHECK(long_other.ptr() == long_copy.ptr());
+	long_other[0] = 'z';
+	CHECK(long_copy[0] == 'b');
+	CHECK(long_other[0] == 'z');
+
+	CharString moved = std::move(short_other);
+	CHECK(moved[0] == 'z');
+	CHECK(moved.length() == inline_length);
+
+	Char16String cs16 = String("Node3D").utf16();
+	CHECK(cs16.length() == 6);
+	CHECK(String::utf16(cs16) == "Node3D");
+	cs16 = String("A somewhat longer UTF-16 string").utf16();
+	CHECK(String::utf16(cs16) == "A somewhat longer UTF-16 string");
+
+#ifdef DEBUG_ENABLED
+	const String name = "MeshInstance3D";
+	const uint64_t begin = Memory::get_thread_alloc_count();
+	{
+		CharString utf8 = name.utf8();
+		CharString ascii = name.ascii();
+		Char16String utf16 = name.utf16();
+		CharString copy = utf8;
+		CHECK(copy == ascii);
+		CHECK(utf16.length() == name.length());
+	}
+	CHECK_MESSAGE(Memory::get_thread_alloc_count() == begin, "Converting short strings should not allocate.");
+#endif
+}
+
 TEST_CASE("[String] Comparisons (not equal)") {
 	String s = "Test Compare";
 	CHECK(s != "Peanut");
@@ -421,6 +510,31 @@ TEST_CASE("[String] Find case insensitive") {
 	MULTICHECK_STRING_INT_EQ(s, rfindn, "", 13, -1);
 }
 
+TEST_CASE("[String] Find in long strings") {
+	// Long enough to go through the vectorized paths, with matches around block boundaries.
+	String s = String("abcdefghij").repeat(10);
+	for (int i = 0; i < 39; i++) {
+		String t = s;
+		t[60 + i] = 'X';
+		t[61 + i] = 'y';
+		CHECK(t.find("Xy") == 60 + i);
+		CHECK(t.find(String("Xy")) == 60 + i);
+		CHECK(t.find_char('X') == 60 + i);
+		CHECK(t.findn("xY") == 60 + i);
+		CHECK(t.findn(String("XYZ").substr(0, 2)) == 60 + i);
+		CHECK(t.find("Xy", 61 + i) == -1);
+	}
+	CHECK(s.find("jabcdefghij", 0) == 9);
+	CHECK(s.find("jabcdefghij", 90) == -1);
+	CHECK(s.findn("JABCDEFGHIJ", 10) == 19);
+	CHECK(s.find_char('a', 95) == -1);
+
+	// Non-ASCII characters that lower-case to ASCII must still be found.
+	String kelvin = String("temperature is 300 ").repeat(3) + U"\u212A";
+	CHECK(kelvin.findn("k") == kelvin.length() - 1);
+	CHECK(kelvin.findn(String("K")) == kelvin.length() - 1);
+}
+
 TEST_CASE("[String] Find MK") {
 	Vector<String> keys;
 	keys.push_back("sty");
@@ -1565,6 +1679,16 @@ TEST_CASE("[String] Cyrillic to_lower()") {
 	CHECK(state);
 }
 
+TEST_CASE("[String] Mixed case conversion of long strings") {
+	const String mixed = String(U"Hello, World! Schöne grüne Äpfel. ").repeat(5);
+	CHECK(mixed.to_lower() == String(U"hello, world! schöne grüne äpfel. ").repeat(5));
+	CHECK(mixed.to_upper() == String(U"HELLO, WORLD! SCHÖNE GRÜNE ÄPFEL. ").repeat(5));
+
+	// Characters right outside the letter ranges are left alone.
+	CHECK(String(U"ÀÉÎÕÜ abc XYZ @[`{").to_lower() == U"àéîõü abc xyz @[`{");
+	CHECK(String(U"àéîõü abc XYZ @[`{").to_upper() == U"ÀÉÎÕÜ ABC XYZ @[`{");
+}
+
 TEST_CASE("[String] Count and countn functionality") {
 	String s = String("");
 	MULTICHECK_STRING_EQ(s, count, "Test", 0);
@@ -1704,6 +1828,27 @@ TEST_CASE("[String] hash") {
 
 	CHECK(a.hash64() == b.hash64());
 	CHECK(a.hash64() != c.hash64());
+
+	// All variants compute the same djb2 hash.
+	const String d = "A longer string, so that hashing processes several blocks.";
+	uint32_t djb2 = 5381;
+	for (int i = 0; i < d.length(); i++) {
+		djb2 = ((djb2 << 5) + djb2) + d[i];
+	}
+	CHECK(d.hash() == djb2);
+	CHECK(String::hash(d.get_data(), d.length()) == djb2);
+	CHECK(String::hash(d.utf8().get_data()) == djb2);
+	CHECK(String::hash(d.utf8().get_data(), d.length()) == djb2);
+
+	// Hashing stops at the first NUL character, so it matches StringName.
+	// The NUL is written directly, since the String constructors stop copying at it.
+	const char32_t e_chars[] = U"Test\0West";
+	String e;
+	e.resize(10);
+	memcpy(e.ptrw(), e_chars, sizeof(e_chars));
+	CHECK(e.length() == 9);
+	CHECK(e.hash() == a.hash());
+	CHECK(e.hash() == StringName("Test").hash());
 }
 
 TEST_CASE("[String] uri_encode/unescape") {
@@ -2114,6 +2259,60 @@ TEST_CASE("[Stress][String] Empty via `is_empty()`") {
 		}
 	}
 }
+
+TEST_CASE_BENCHMARK("[String][Benchmark] Allocations in typical workloads") {
+	const int iterations = 10000;
+
+	// Names and paths as they go through the scene loader, which converts them for hashing, file access and printing.
+	const String names[] = { "Player", "CollisionShape3D", "AnimationPlayer", "MeshInstance3D", "Camera3D", "res://scenes/level_01/props/crate.tscn" };
+	const int name_count = sizeof(names) / sizeof(names[0]);
+
+	int inline_conversions = 0;
+	for (int i = 0; i < name_count; i++) {
+		if (names[i].utf8().length() < SmallCowData<char>::INLINE_SIZE) {
+			inline_conversions++;
+		}
+	}
+
+	uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+#ifdef DEBUG_ENABLED
+	uint64_t begin_allocations = Memory::get_thread_alloc_count();
+#endif
+	uint32_t hash = 0;
+	for (int i = 0; i < iterations; i++) {
+		for (int j = 0; j < name_count; j++) {
+			CharString cs = names[j].utf8();
+			hash = hash_murmur3_one_32(cs.length(), hash);
+		}
+	}
+	uint64_t scene_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+#ifdef DEBUG_ENABLED
+	uint64_t scene_allocations = Memory::get_thread_alloc_count() - begin_allocations;
+#else
+	uint64_t scene_allocations = 0;
+#endif
+
+	// Formatting like GDScript's print() and str() do, then converting the result for output.
+	begin_usec = OS::get_singleton()->get_ticks_usec();
+#ifdef DEBUG_ENABLED
+	begin_allocations = Memory::get_thread_alloc_count();
+#endif
+	for (int i = 0; i < iterations; i++) {
+		String formatted = vformat("%s: %d", names[i % name_count].get_slice("/", 0), i);
+		CharString cs = formatted.utf8();
+		hash = hash_murmur3_one_32(cs.length(), hash);
+	}
+	uint64_t format_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+#ifdef DEBUG_ENABLED
+	uint64_t format_allocations = Memory::get_thread_alloc_count() - begin_allocations;
+#else
+	uint64_t format_allocations = 0;
+#endif
+
+	MESSAGE(vformat("Scene names: %d usec, %d allocations, %d of %d conversions per pass kept inline.", scene_usec, scene_allocations, inline_conversions, name_count));
+	MESSAGE(vformat("Formatting: %d usec, %d allocations for %d strings.", format_usec, format_allocations, iterations));
+	CHECK(hash != 0);
+}
 } // namespace TestString
 
 #endif // TEST_STRING_H
@@ -0,0 +1,169 @@
+/**************************************************************************/
+/*  test_string_benchmark.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_BENCHMARK_H
+#define TEST_STRING_BENCHMARK_H
+
+#include "core/os/os.h"
+#include "core/string/ustring.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringBenchmark {
+
+// BBCode as RichTextLabel parses it, mostly ASCII with some accented text.
+static String _make_bbcode_text() {
+	String line = U"[b]Quest updated:[/b] Bring the [color=yellow]old key[/color] to Amélie at the [i]north gate[/i]. ";
+	return line.repeat(200);
+}
+
+// Rows of a CSV translation file.
+static String _make_csv_text() {
+	String text = "keys,en,fr,de\n";
+	for (int i = 0; i < 1000; i++) {
+		text += vformat(U"DIALOG_%d,\"Hello, traveler %d!\",\"Bonjour, voyageur %d !\",\"Hallo, Reisender %d!\"\n", i, i, i, i);
+	}
+	return text;
+}
+
+static void _report(const char *p_name, uint64_t p_begin_usec, int p_iterations, int64_t p_checksum) {
+	const uint64_t usec = OS::get_singleton()->get_ticks_usec() - p_begin_usec;
+	MESSAGE(vformat("%s: %d usec for %d iterations (checksum %d).", p_name, usec, p_iterations, p_checksum));
+}
+
+TEST_CASE_BENCHMARK("[String][Benchmark] Search") {
+	const String text = _make_bbcode_text();
+	const int iterations = 2000;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	int64_t checksum = 0;
+	for (int i = 0; i < iterations; i++) {
+		for (int from = text.find_char('['); from >= 0; from = text.find_char('[', from + 1)) {
+			checksum++;
+		}
+	}
+	_report("find_char('[')", begin, iterations, checksum);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	checksum = 0;
+	const String tag = "[/color]";
+	for (int i = 0; i < iterations; i++) {
+		for (int from = text.find(tag); from >= 0; from = text.find(tag, from + 1)) {
+			checksum++;
+		}
+	}
+	_report("find(String)", begin, iterations, checksum);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	checksum = 0;
+	for (int i = 0; i < iterations; i++) {
+		checksum += text.find("not in the text");
+	}
+	_report("find(const char *) without match", begin, iterations, checksum);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	checksum = 0;
+	for (int i = 0; i < iterations; i++) {
+		for (int from = text.findn("NORTH GATE"); from >= 0; from = text.findn("NORTH GATE", from + 1)) {
+			checksum++;
+		}
+	}
+	_report("findn(const char *)", begin, iterations, checksum);
+}
+
+TEST_CASE_BENCHMARK("[String][Benchmark] Replace and split") {
+	const String bbcode = _make_bbcode_text();
+	const String csv = _make_csv_text();
+	const int iterations = 200;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	int64_t checksum = 0;
+	for (int i = 0; i < iterations; i++) {
+		checksum += bbcode.replace("[b]", "").replace("[/b]", "").length();
+	}
+	_report("replace", begin, iterations, checksum);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	checksum = 0;
+	for (int i = 0; i < iterations; i++) {
+		checksum += bbcode.replacen("[COLOR=YELLOW]", "[color=red]").length();
+	}
+	_report("replacen", begin, iterations, checksum);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	checksum = 0;
+	for (int i = 0; i < iterations; i++) {
+		const Vector<String> lines = csv.split("\n");
+		for (const String &line : lines) {
+			checksum += line.split(",").size();
+		}
+	}
+	_report("split", begin, iterations, checksum);
+}
+
+TEST_CASE_BENCHMARK("[String][Benchmark] Case conversion, hashing and encoding") {
+	const String text = _make_bbcode_text();
+	const CharString text_utf8 = text.utf8();
+	const int iterations = 2000;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	int64_t checksum = 0;
+	for (int i = 0; i < iterations; i++) {
+		checksum += text.to_lower().length();
+	}
+	_report("to_lower", begin, iterations, checksum);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	checksum = 0;
+	for (int i = 0; i < iterations; i++) {
+		checksum += text.hash();
+	}
+	_report("hash", begin, iterations, checksum);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	checksum = 0;
+	for (int i = 0; i < iterations; i++) {
+		checksum += text.utf8().length();
+	}
+	_report("utf8", begin, iterations, checksum);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	checksum = 0;
+	for (int i = 0; i < iterations; i++) {
+		checksum += String::utf8(text_utf8.get_data(), text_utf8.length()).length();
+	}
+	_report("parse_utf8", begin, iterations, checksum);
+}
+
+} // namespace TestStringBenchmark
+
+#endif // TEST_STRING_BENCHMARK_H
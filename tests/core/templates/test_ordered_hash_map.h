@@ -0,0 +1,138 @@
+/**************************************************************************/
+/*  test_ordered_hash_map.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_ORDERED_HASH_MAP_H
+#define TEST_ORDERED_HASH_MAP_H
+
+#include "core/templates/ordered_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestOrderedHashMap {
+
+TEST_CASE("[OrderedHashMap] Insert element") {
+	OrderedHashMap<int, int> map;
+	OrderedHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+
+	map.insert(42, 1234);
+	CHECK(map.size() == 1);
+	CHECK(map[42] == 1234);
+}
+
+TEST_CASE("[OrderedHashMap] Erasing keeps insertion order") {
+	OrderedHashMap<int, int> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(i, i * 2);
+	}
+	// Enough erasing to compact the elements.
+	for (int i = 0; i < 100; i++) {
+		if (i % 3 != 0) {
+			CHECK(map.erase(i));
+		}
+	}
+	CHECK_FALSE(map.erase(1));
+	map.insert(1, 2);
+
+	CHECK(map.size() == 35);
+	int expected = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(E.key == expected);
+		CHECK(E.value == expected * 2);
+		expected = expected == 99 ? 1 : expected + 3;
+	}
+	CHECK(map.get_by_position(0)->key == 0);
+	CHECK(map.get_by_position(33)->key == 99);
+	CHECK(map.get_by_position(34)->key == 1);
+	CHECK(map.get_by_position(35) == nullptr);
+
+	OrderedHashMap<int, int>::Iterator it = map.find(99);
+	++it;
+	CHECK(it->key == 1);
+	++it;
+	CHECK_FALSE(it);
+}
+
+TEST_CASE("[OrderedHashMap] Pointers stay valid while inserting") {
+	OrderedHashMap<int, String> map;
+	String *first = &map[0];
+	*first = "first";
+	for (int i = 1; i < 1000; i++) {
+		map[i] = itos(i);
+	}
+	CHECK(map.getptr(0) == first);
+	CHECK(*first == "first");
+}
+
+TEST_CASE("[OrderedHashMap] Sort") {
+	OrderedHashMap<int, int> map;
+	map.insert(5, 0);
+	map.insert(1, 1);
+	map.insert(4, 2);
+	map.insert(2, 3);
+	map.erase(4);
+	map.sort();
+
+	int keys[] = { 1, 2, 5 };
+	int i = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(E.key == keys[i++]);
+	}
+	CHECK(map[5] == 0);
+	CHECK(map[2] == 3);
+}
+
+TEST_CASE("[OrderedHashMap] Copy and clear") {
+	OrderedHashMap<int, String> map;
+	map.insert(3, "three");
+	map.insert(1, "one");
+
+	OrderedHashMap<int, String> copy = map;
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK_FALSE(map.has(3));
+	CHECK(map.begin() == map.end());
+
+	CHECK(copy.size() == 2);
+	CHECK(copy.begin()->key == 3);
+	CHECK(copy[1] == "one");
+}
+
+} // namespace TestOrderedHashMap
+
+#endif // TEST_ORDERED_HASH_MAP_H
@@ -0,0 +1,85 @@
+/**************************************************************************/
+/*  test_perfect_hash_map.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PERFECT_HASH_MAP_H
+#define TEST_PERFECT_HASH_MAP_H
+
+#include "core/templates/perfect_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPerfectHashMap {
+
+TEST_CASE("[PerfectHashMap] Build and look up") {
+	for (int count : { 0, 1, 2, 3, 10, 100, 1000, 10000 }) {
+		LocalVector<PerfectHashMap<String, int>::Element> elements;
+		for (int i = 0; i < count; i++) {
+			elements.push_back({ itos(i * 31), i });
+		}
+
+		PerfectHashMap<String, int> map;
+		CHECK(map.build(elements.ptr(), elements.size()));
+		CHECK(map.size() == uint32_t(count));
+
+		bool all_found = true;
+		bool none_extra = true;
+		for (int i = 0; i < count; i++) {
+			const int *value = map.getptr(itos(i * 31));
+			all_found = all_found && value && *value == i;
+			none_extra = none_extra && !map.has(itos(i * 31 + 1));
+		}
+		CHECK(all_found);
+		CHECK(none_extra);
+		CHECK_FALSE(map.has("missing"));
+	}
+}
+
+struct CollidingHasher {
+	static uint32_t hash(int p_key) { return p_key < 2 ? 0 : p_key; }
+};
+
+TEST_CASE("[PerfectHashMap] Keys with the same hash") {
+	PerfectHashMap<int, int, CollidingHasher>::Element elements[] = { { 0, 0 }, { 1, 1 }, { 2, 2 } };
+	PerfectHashMap<int, int, CollidingHasher> map;
+	CHECK_FALSE(map.build(elements, 3));
+	CHECK(map.is_empty());
+	CHECK_FALSE(map.has(2));
+
+	CHECK(map.build(elements + 1, 2));
+	CHECK(map.has(1));
+	CHECK(map.has(2));
+	CHECK_FALSE(map.has(0));
+}
+
+} // namespace TestPerfectHashMap
+
+#endif // TEST_PERFECT_HASH_MAP_H
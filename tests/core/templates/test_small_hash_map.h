@@ -0,0 +1,168 @@
+/**************************************************************************/
+/*  test_small_hash_map.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+
+#ifndef TEST_SMALL_HASH_MAP_H
+#define TEST_SMALL_HASH_MAP_H
+
+#include "core/templates/small_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSmallHashMap {
+
+TEST_CASE("[SmallHashMap] Insert and find elements") {
+	SmallHashMap<int, int, 4> map;
+	SmallHashMap<int, int, 4>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+	CHECK_FALSE(map.has(1));
+	CHECK(*map.getptr(42) == 84);
+
+	map.insert(42, 1234);
+	CHECK(map.size() == 1);
+	CHECK(*map.getptr(42) == 1234);
+}
+
+TEST_CASE("[SmallHashMap] Switch between storages") {
+	SmallHashMap<int, int, 4> map;
+	for (int i = 0; i < 4; i++) {
+		map.insert(i, i * 10);
+	}
+	CHECK(map.is_small());
+
+	map.insert(4, 40);
+	CHECK_FALSE(map.is_small());
+	CHECK(map.size() == 5);
+	for (int i = 0; i < 5; i++) {
+		CHECK(*map.getptr(i) == i * 10);
+	}
+
+	map.erase(0);
+	map.erase(3);
+	CHECK_FALSE(map.is_small());
+	map.erase(4);
+	CHECK(map.is_small());
+	CHECK(map.size() == 2);
+	CHECK(*map.getptr(1) == 10);
+	CHECK(*map.getptr(2) == 20);
+}
+
+TEST_CASE("[SmallHashMap] Keep insertion order") {
+	SmallHashMap<int, int, 4> map;
+	const int keys[] = { 7, 3, 9, 1, 5, 8 };
+
+	SUBCASE("In the small array") {
+		for (int i = 0; i < 4; i++) {
+			map.insert(keys[i], i);
+		}
+		map.erase(3);
+
+		const int expected[] = { 7, 9, 1 };
+		int idx = 0;
+		for (const KeyValue<int, int> &E : map) {
+			CHECK(E.key == expected[idx++]);
+		}
+		CHECK(idx == 3);
+	}
+
+	SUBCASE("Through both storages") {
+		for (int i = 0; i < 6; i++) {
+			map.insert(keys[i], i);
+		}
+		map.erase(3);
+		map.erase(5);
+		map.erase(8);
+
+		const int expected[] = { 7, 9, 1 };
+		int idx = 0;
+		for (const KeyValue<int, int> &E : map) {
+			CHECK(E.key == expected[idx++]);
+		}
+		CHECK(idx == 3);
+	}
+
+	SUBCASE("Backwards") {
+		for (int i = 0; i < 6; i++) {
+			map.insert(keys[i], i);
+		}
+		int idx = 5;
+		for (SmallHashMap<int, int, 4>::Iterator I = map.last(); I; --I) {
+			CHECK(I->key == keys[idx--]);
+		}
+		CHECK(idx == -1);
+	}
+}
+
+TEST_CASE("[SmallHashMap] Replace key") {
+	SmallHashMap<int, int, 4> map;
+	map.insert(1, 10);
+	map.insert(2, 20);
+	map.insert(3, 30);
+
+	CHECK(map.replace_key(2, 5));
+	CHECK_FALSE(map.has(2));
+	CHECK(*map.getptr(5) == 20);
+
+	ERR_PRINT_OFF;
+	CHECK_FALSE(map.replace_key(1, 3));
+	CHECK_FALSE(map.replace_key(42, 43));
+	ERR_PRINT_ON;
+
+	const int expected[] = { 1, 5, 3 };
+	int idx = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(E.key == expected[idx++]);
+	}
+}
+
+TEST_CASE("[SmallHashMap] Copy and clear") {
+	SmallHashMap<String, int, 2> map;
+	map.insert("a", 1);
+	map.insert("b", 2);
+	map.insert("c", 3);
+
+	SmallHashMap<String, int, 2> copy = map;
+	CHECK(copy.size() == 3);
+	CHECK(*copy.getptr("c") == 3);
+
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(map.is_small());
+	CHECK(copy.size() == 3);
+}
+
+} // namespace TestSmallHashMap
+
+#endif // TEST_SMALL_HASH_MAP_H
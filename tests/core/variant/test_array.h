@@ -33,6 +33,7 @@
 #ifndef TEST_ARRAY_H
 #define TEST_ARRAY_H
 
+#include "core/os/os.h"
 #include "core/variant/array.h"
 #include "tests/test_macros.h"
 #include "tests/test_tools.h"
@@ -636,6 +637,180 @@ TEST_CASE("[Array] Typed copying") {
 	a6.clear();
 }
 
+TEST_CASE("[Array] Unboxed typed arrays") {
+	Array a;
+	a.set_typed(Variant::FLOAT, StringName(), Variant());
+#ifndef MODULE_MONO_ENABLED
+	CHECK(a.is_unboxed());
+#endif
+
+	a.push_back(1.5);
+	a.push_back(2); // Coerced to float.
+	a.append(3.0);
+	a.insert(0, 0.5);
+	a.push_front(-1.0);
+	CHECK(a.size() == 5);
+
+	Variant value;
+	a.get_value(2, value);
+	CHECK(value.get_type() == Variant::FLOAT);
+	CHECK(value == Variant(1.5));
+	a.get_value(3, value);
+	CHECK(value.get_type() == Variant::FLOAT);
+	CHECK(value == Variant(2.0));
+
+	CHECK(a.pop_front() == Variant(-1.0));
+	CHECK(a.pop_back() == Variant(3.0));
+	CHECK(a.pop_at(0) == Variant(0.5));
+	CHECK(a.front() == Variant(1.5));
+	CHECK(a.back() == Variant(2.0));
+	CHECK(a.find(2.0) == 1);
+	CHECK(a.has(1.5));
+	CHECK(a.count(1.5) == 1);
+
+	a.set(1, 4.0);
+	a.resize(3);
+	a.get_value(1, value);
+	CHECK(value == Variant(4.0));
+	a.get_value(2, value);
+	CHECK(value == Variant(0.0));
+
+	ERR_PRINT_OFF;
+	a.push_back("Not a float");
+	a.set(0, Vector2());
+	ERR_PRINT_ON;
+	CHECK(a.size() == 3);
+	CHECK(a.front() == Variant(1.5));
+
+	Array copy = a.duplicate();
+	copy.set(0, 10.0);
+	CHECK(a.front() == Variant(1.5));
+	CHECK(copy.front() == Variant(10.0));
+	CHECK(copy.is_same_typed(a));
+
+	Array appended;
+	appended.set_typed(Variant::FLOAT, StringName(), Variant());
+	appended.append_array(a);
+	appended.append_array(build_array(7, 8.0));
+	CHECK(appended.size() == 5);
+	CHECK(appended.back() == Variant(8.0));
+
+#ifndef MODULE_MONO_ENABLED
+	CHECK(a.is_unboxed());
+	CHECK(copy.is_unboxed());
+	CHECK(appended.is_unboxed());
+#endif
+
+	// Taking references to the elements boxes them, without changing their values.
+	CHECK(a[0] == Variant(1.5));
+	CHECK(a[1] == Variant(4.0));
+	CHECK_FALSE(a.is_unboxed());
+	a.push_back(5.0);
+	CHECK(a.size() == 4);
+	CHECK(a == build_array(1.5, 4.0, 0.0, 5.0));
+	CHECK(copy.front() == Variant(10.0));
+	copy.erase(10.0);
+	CHECK(copy.size() == 2);
+	CHECK(copy.front() == Variant(4.0));
+
+	// Copies of a boxed array keep its element type, and are unboxed again once cleared.
+	Array boxed_copy = a.duplicate();
+	Array boxed_slice = a.slice(0, 2);
+	boxed_copy.clear();
+	boxed_slice.clear();
+#ifndef MODULE_MONO_ENABLED
+	CHECK(boxed_copy.is_unboxed());
+	CHECK(boxed_slice.is_unboxed());
+#endif
+
+	a.clear();
+#ifndef MODULE_MONO_ENABLED
+	CHECK(a.is_unboxed());
+#endif
+	CHECK(a.is_empty());
+}
+
+TEST_CASE("[Array] Unboxed typed arrays conversion") {
+	TypedArray<Vector2i> a = build_array(Vector2i(1, 2), Vector2i(3, 4));
+	CHECK(a.size() == 2);
+	CHECK(a[1] == Variant(Vector2i(3, 4)));
+
+	TypedArray<int> ints = build_array(1, 2, 3);
+	TypedArray<double> floats = ints;
+	Variant value;
+	floats.get_value(2, value);
+	CHECK(value.get_type() == Variant::FLOAT);
+	CHECK(value == Variant(3.0));
+
+	Array untyped;
+	untyped.assign(floats);
+	CHECK(untyped == build_array(1.0, 2.0, 3.0));
+
+	// Untyped arrays, and arrays of types that need references, are never unboxed.
+	CHECK_FALSE(untyped.is_unboxed());
+	TypedArray<String> strings = build_array("a", "b");
+	CHECK_FALSE(strings.is_unboxed());
+}
+
+TEST_CASE_BENCHMARK("[Array][Benchmark] Typed float arrays") {
+	const int count = 1000000;
+
+	Array typed;
+	typed.set_typed(Variant::FLOAT, StringName(), Variant());
+	Array untyped;
+	PackedFloat64Array packed;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		typed.push_back(double(i));
+	}
+	const uint64_t typed_push_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		untyped.push_back(double(i));
+	}
+	const uint64_t untyped_push_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		packed.push_back(double(i));
+	}
+	const uint64_t packed_push_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	double typed_sum = 0.0;
+	Variant value;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		typed.set(i, double(i) * 0.5);
+		typed.get_value(i, value);
+		typed_sum += double(value);
+	}
+	const uint64_t typed_access_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	double untyped_sum = 0.0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		untyped.set(i, double(i) * 0.5);
+		untyped.get_value(i, value);
+		untyped_sum += double(value);
+	}
+	const uint64_t untyped_access_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	double packed_sum = 0.0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		packed.set(i, double(i) * 0.5);
+		packed_sum += packed[i];
+	}
+	const uint64_t packed_access_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(typed_sum == packed_sum);
+	CHECK(untyped_sum == packed_sum);
+	MESSAGE(vformat("%d elements, push_back: Array[float] %d usec, Array %d usec, PackedFloat64Array %d usec.", count, typed_push_usec, untyped_push_usec, packed_push_usec));
+	MESSAGE(vformat("%d elements, set and get: Array[float] %d usec, Array %d usec, PackedFloat64Array %d usec.", count, typed_access_usec, untyped_access_usec, packed_access_usec));
+}
+
 static bool _find_custom_callable(const Variant &p_val) {
 	return (int)p_val % 2 == 0;
 }
@@ -33,6 +33,7 @@
 #ifndef TEST_DICTIONARY_H
 #define TEST_DICTIONARY_H
 
+#include "core/os/os.h"
 #include "core/variant/typed_dictionary.h"
 #include "tests/test_macros.h"
 
@@ -559,6 +560,76 @@ TEST_CASE("[Dictionary] Order and find") {
 	CHECK_EQ(d.find_key("does not exist"), Variant());
 }
 
+TEST_CASE("[Dictionary] Order after erasing and sorting") {
+	Dictionary d;
+	for (int i = 0; i < 64; i++) {
+		d[i] = i;
+	}
+	for (int i = 0; i < 64; i += 2) {
+		d.erase(i);
+	}
+	d[0] = "zero";
+
+	CHECK(d.size() == 33);
+	CHECK(d.get_key_at_index(0) == Variant(1));
+	CHECK(d.get_key_at_index(31) == Variant(63));
+	CHECK(d.get_key_at_index(32) == Variant(0));
+	CHECK(d.get_value_at_index(32) == Variant("zero"));
+	CHECK(d.get_key_at_index(33) == Variant());
+
+	const Variant *key = d.next(nullptr);
+	int count = 0;
+	while (key) {
+		count++;
+		key = d.next(key);
+	}
+	CHECK(count == 33);
+
+	d.sort();
+	CHECK(d.get_key_at_index(0) == Variant(0));
+	CHECK(d.get_key_at_index(1) == Variant(1));
+	CHECK(d.get_key_at_index(32) == Variant(63));
+	CHECK(d[63] == Variant(63));
+}
+
+TEST_CASE_BENCHMARK("[Dictionary][Benchmark] Insert, lookup, iterate and erase") {
+	for (int count = 1000; count <= 1000000; count *= 10) {
+		Dictionary d;
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			d[i] = i;
+		}
+		const uint64_t insert_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		int64_t sum = 0;
+		for (int i = 0; i < count; i++) {
+			sum += int64_t(*d.getptr(i));
+		}
+		const uint64_t lookup_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		const Variant *key = d.next(nullptr);
+		while (key) {
+			sum += int64_t(*key);
+			key = d.next(key);
+		}
+		Array values = d.values();
+		const uint64_t iterate_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			d.erase(i);
+		}
+		const uint64_t erase_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		CHECK(d.is_empty());
+		CHECK(values.size() == count);
+		MESSAGE(vformat("%d entries: insert %d usec, lookup %d usec, iterate %d usec, erase %d usec (checksum %d).", count, insert_usec, lookup_usec, iterate_usec, erase_usec, sum));
+	}
+}
+
 TEST_CASE("[Dictionary] Typed copying") {
 	TypedDictionary<int, int> d1;
 	d1[0] = 1;
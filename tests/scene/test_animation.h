@@ -33,6 +33,7 @@
 #ifndef TEST_ANIMATION_H
 #define TEST_ANIMATION_H
 
+#include "core/os/os.h"
 #include "scene/resources/animation.h"
 
 #include "tests/test_macros.h"
@@ -311,6 +312,112 @@ TEST_CASE("[Animation] Create Bezier track") {
 	ERR_PRINT_ON;
 }
 
+// A long motion capture like clip: every bone keyed at 30 FPS.
+static Ref<Animation> make_mocap_animation(int p_bone_count, double p_length) {
+	Ref<Animation> animation;
+	animation.instantiate();
+	animation->set_length(p_length);
+	const int key_count = int(p_length * 30.0) + 1;
+	for (int i = 0; i < p_bone_count; i++) {
+		const NodePath path = NodePath("Skeleton:bone_" + itos(i));
+		const int position_track = animation->add_track(Animation::TYPE_POSITION_3D);
+		animation->track_set_path(position_track, path);
+		const int rotation_track = animation->add_track(Animation::TYPE_ROTATION_3D);
+		animation->track_set_path(rotation_track, path);
+		for (int k = 0; k < key_count; k++) {
+			const double time = k / 30.0;
+			animation->position_track_insert_key(position_track, time, Vector3(Math::sin(time + i), Math::cos(time * 0.5), i * 0.1));
+			animation->rotation_track_insert_key(rotation_track, time, Quaternion(Vector3(0, 1, 0), Math::sin(time * 2.0 + i)));
+		}
+	}
+	return animation;
+}
+
+static void check_sampling_with_cursors(const Ref<Animation> &p_animation, const LocalVector<double> &p_times, bool p_backward) {
+	LocalVector<Animation::TrackCursor> cursors;
+	cursors.resize(p_animation->get_track_count());
+	for (const double time : p_times) {
+		for (int i = 0; i < p_animation->get_track_count(); i++) {
+			if (p_animation->track_get_type(i) == Animation::TYPE_POSITION_3D) {
+				Vector3 expected;
+				Vector3 position;
+				CHECK(p_animation->try_position_track_interpolate(i, time, &expected, p_backward) == OK);
+				CHECK(p_animation->try_position_track_interpolate(i, time, &position, p_backward, &cursors[i]) == OK);
+				CHECK(position.is_equal_approx(expected));
+			} else {
+				Quaternion expected;
+				Quaternion rotation;
+				CHECK(p_animation->try_rotation_track_interpolate(i, time, &expected, p_backward) == OK);
+				CHECK(p_animation->try_rotation_track_interpolate(i, time, &rotation, p_backward, &cursors[i]) == OK);
+				CHECK(rotation.is_equal_approx(expected));
+			}
+		}
+	}
+}
+
+TEST_CASE("[Animation] Sampling with track cursors") {
+	Ref<Animation> animation = make_mocap_animation(2, 4.0);
+
+	LocalVector<double> forward;
+	for (double time = 0.0; time <= 4.0; time += 1.0 / 70.0) {
+		forward.push_back(time);
+	}
+	forward.push_back(2.0); // Jump back.
+	forward.push_back(1.0 / 30.0); // Exactly on a key.
+	forward.push_back(3.9);
+	LocalVector<double> backward;
+	for (double time = 4.0; time >= 0.0; time -= 1.0 / 70.0) {
+		backward.push_back(time);
+	}
+
+	SUBCASE("Uncompressed") {
+		check_sampling_with_cursors(animation, forward, false);
+		check_sampling_with_cursors(animation, backward, true);
+	}
+
+	SUBCASE("Compressed") {
+		// Small pages, so that sampling crosses pages.
+		animation->compress(256);
+		CHECK(animation->track_is_compressed(0));
+		check_sampling_with_cursors(animation, forward, false);
+		check_sampling_with_cursors(animation, backward, false);
+	}
+}
+
+// Samples a long clip forward at 60 FPS, as playback does, with and without track cursors.
+TEST_CASE_BENCHMARK("[Animation][Benchmark] Sample long mocap clip") {
+	const int bone_count = 60;
+	const double length = 120.0;
+	Ref<Animation> animation = make_mocap_animation(bone_count, length);
+
+	for (int compressed = 0; compressed < 2; compressed++) {
+		if (compressed) {
+			animation->compress();
+		}
+		for (int use_cursors = 0; use_cursors < 2; use_cursors++) {
+			LocalVector<Animation::TrackCursor> cursors;
+			cursors.resize(animation->get_track_count());
+			uint64_t samples = 0;
+			uint64_t begin_ticks = OS::get_singleton()->get_ticks_usec();
+			for (double time = 0.0; time < length; time += 1.0 / 60.0) {
+				for (int i = 0; i < animation->get_track_count(); i++) {
+					Animation::TrackCursor *cursor = use_cursors ? &cursors[i] : nullptr;
+					if (animation->track_get_type(i) == Animation::TYPE_POSITION_3D) {
+						Vector3 position;
+						animation->try_position_track_interpolate(i, time, &position, false, cursor);
+					} else {
+						Quaternion rotation;
+						animation->try_rotation_track_interpolate(i, time, &rotation, false, cursor);
+					}
+					samples++;
+				}
+			}
+			uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin_ticks;
+			MESSAGE(vformat("%s, %s: %.1f samples per ms.", compressed ? "Compressed" : "Uncompressed", use_cursors ? "cursors" : "no cursors", samples * 1000.0 / MAX(usec, (uint64_t)1)));
+		}
+	}
+}
+
 } // namespace TestAnimation
 
 #endif // TEST_ANIMATION_H
@@ -0,0 +1,404 @@
+/**************************************************************************/
+/*  test_animation_mixer.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_ANIMATION_MIXER_H
+#define TEST_ANIMATION_MIXER_H
+
+#include "core/math/random_number_generator.h"
+#include "scene/3d/skeleton_3d.h"
+#include "scene/3d/visible_on_screen_notifier_3d.h"
+#include "scene/animation/animation_player.h"
+#include "scene/main/window.h"
+#include "scene/resources/animation_library.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAnimationMixer {
+
+static Ref<Animation> make_skeleton_animation(int p_bone_count) {
+	Ref<Animation> animation;
+	animation.instantiate();
+	animation->set_length(1.0);
+	animation->set_loop_mode(Animation::LOOP_LINEAR);
+	for (int i = 0; i < p_bone_count; i++) {
+		NodePath path = NodePath("Skeleton:bone_" + itos(i));
+		int track = animation->add_track(Animation::TYPE_POSITION_3D);
+		animation->track_set_path(track, path);
+		animation->position_track_insert_key(track, 0.0, Vector3(0, 0, 0));
+		animation->position_track_insert_key(track, 0.5, Vector3(0, 1.0 + i * 0.01, 0));
+		animation->position_track_insert_key(track, 1.0, Vector3(0, 0, 0));
+		track = animation->add_track(Animation::TYPE_ROTATION_3D);
+		animation->track_set_path(track, path);
+		animation->rotation_track_insert_key(track, 0.0, Quaternion());
+		animation->rotation_track_insert_key(track, 0.5, Quaternion(Vector3(0, 1, 0), Math_PI * 0.5 + i * 0.01));
+		animation->rotation_track_insert_key(track, 1.0, Quaternion());
+	}
+	return animation;
+}
+
+// A character made of a skeleton and an animation player playing p_animation in a loop.
+static Node *make_character(const Ref<Animation> &p_animation, int p_bone_count, bool p_parallel) {
+	Node *character = memnew(Node);
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	skeleton->set_name("Skeleton");
+	for (int i = 0; i < p_bone_count; i++) {
+		skeleton->add_bone("bone_" + itos(i));
+		if (i > 0) {
+			skeleton->set_bone_parent(i, i - 1);
+		}
+	}
+	character->add_child(skeleton);
+
+	Ref<AnimationLibrary> library;
+	library.instantiate();
+	library->add_animation("walk", p_animation);
+	AnimationPlayer *player = memnew(AnimationPlayer);
+	player->set_name("AnimationPlayer");
+	player->add_animation_library("", library);
+	player->set_use_parallel_blending(p_parallel);
+	character->add_child(player);
+	return character;
+}
+
+static void play(Node *p_character) {
+	Object::cast_to<AnimationPlayer>(p_character->get_node(NodePath("AnimationPlayer")))->play("walk");
+}
+
+static Skeleton3D *get_skeleton(Node *p_character) {
+	return Object::cast_to<Skeleton3D>(p_character->get_node(NodePath("Skeleton")));
+}
+
+static Quaternion make_random_rotation(RandomNumberGenerator &p_rng) {
+	return Quaternion(Vector3(p_rng.randf_range(-1, 1), p_rng.randf_range(-1, 1), p_rng.randf_range(-1, 1)).normalized(), p_rng.randf_range(-Math_PI, Math_PI));
+}
+
+TEST_CASE("[AnimationPoseBuffer] Blending matches the blending of transform track caches") {
+	const int bone_count = 40;
+	const int animation_count = 5;
+
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(42);
+
+	LocalVector<Vector3> init_loc;
+	LocalVector<Quaternion> init_rot;
+	AnimationPoseBuffer pose;
+	pose.resize(bone_count);
+	for (int i = 0; i < bone_count; i++) {
+		init_loc.push_back(Vector3(rng->randf(), rng->randf(), rng->randf()));
+		init_rot.push_back(make_random_rotation(**rng));
+		pose.set_init(i, init_loc[i], init_rot[i], Vector3(1, 1, 1));
+	}
+	pose.reset();
+
+	LocalVector<Vector3> loc = init_loc;
+	LocalVector<Quaternion> rot = init_rot;
+	for (int a = 0; a < animation_count; a++) {
+		for (int i = 0; i < bone_count; i++) {
+			if (i % (a + 2) == 0) {
+				continue; // Not every animation animates every bone.
+			}
+			const real_t blend = rng->randf_range(0.1, 1.0);
+			const Vector3 sample_loc = Vector3(rng->randf(), rng->randf(), rng->randf());
+			const Quaternion sample_rot = make_random_rotation(**rng);
+			pose.add_position_sample(i, sample_loc, blend);
+			pose.add_rotation_sample(i, sample_rot, blend);
+			loc[i] += (sample_loc - init_loc[i]) * blend;
+			rot[i] = (rot[i] * Quaternion().slerp(init_rot[i].inverse() * sample_rot, blend)).normalized();
+		}
+		pose.accumulate();
+	}
+
+	for (int i = 0; i < bone_count; i++) {
+		CHECK(pose.get_position(i).is_equal_approx(loc[i]));
+		CHECK(pose.get_rotation(i).is_equal_approx(rot[i]));
+		CHECK(pose.get_scale(i).is_equal_approx(Vector3(1, 1, 1)));
+	}
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Parallel blending matches serial blending") {
+	const int bone_count = 8;
+	Ref<Animation> animation = make_skeleton_animation(bone_count);
+
+	Window *root = SceneTree::get_singleton()->get_root();
+	Node *serial = make_character(animation, bone_count, false);
+	Node *parallel_a = make_character(animation, bone_count, true);
+	Node *parallel_b = make_character(animation, bone_count, true);
+	root->add_child(serial);
+	root->add_child(parallel_a);
+	root->add_child(parallel_b);
+	play(serial);
+	play(parallel_a);
+	play(parallel_b);
+
+	for (int frame = 0; frame < 10; frame++) {
+		SceneTree::get_singleton()->process(0.033);
+
+		for (int i = 0; i < bone_count; i++) {
+			const Quaternion rotation = get_skeleton(serial)->get_bone_pose_rotation(i);
+			const Vector3 position = get_skeleton(serial)->get_bone_pose_position(i);
+			CHECK(get_skeleton(parallel_a)->get_bone_pose_rotation(i).is_equal_approx(rotation));
+			CHECK(get_skeleton(parallel_a)->get_bone_pose_position(i).is_equal_approx(position));
+			CHECK(get_skeleton(parallel_b)->get_bone_pose_rotation(i).is_equal_approx(rotation));
+			CHECK(get_skeleton(parallel_b)->get_bone_pose_position(i).is_equal_approx(position));
+		}
+	}
+	CHECK_FALSE(get_skeleton(serial)->get_bone_pose_position(0).is_zero_approx());
+
+	memdelete(serial);
+	memdelete(parallel_a);
+	memdelete(parallel_b);
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Freeing a mixer queued for parallel blending") {
+	const int bone_count = 2;
+	Ref<Animation> animation = make_skeleton_animation(bone_count);
+
+	Window *root = SceneTree::get_singleton()->get_root();
+	Node *character = make_character(animation, bone_count, true);
+	root->add_child(character);
+	play(character);
+
+	// The mixer is queued during the internal process notification and blended once all nodes were processed.
+	character->get_node(NodePath("AnimationPlayer"))->notification(Node::NOTIFICATION_INTERNAL_PROCESS);
+	memdelete(character);
+	SceneTree::get_singleton()->process(0.033);
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Level of detail update divisor") {
+	const int bone_count = 4;
+	Ref<Animation> animation = make_skeleton_animation(bone_count);
+
+	Window *root = SceneTree::get_singleton()->get_root();
+	Node *reference = make_character(animation, bone_count, false);
+	Node *character = make_character(animation, bone_count, false);
+	AnimationMixer *mixer = Object::cast_to<AnimationMixer>(character->get_node(NodePath("AnimationPlayer")));
+	mixer->set_lod_enabled(true);
+	mixer->set_lod_update_divisor(2);
+	root->add_child(reference);
+	root->add_child(character);
+	play(reference);
+	play(character);
+
+	SUBCASE("Skipped frames keep the last pose") {
+		mixer->set_lod_interpolate(false);
+		LocalVector<Vector3> previous;
+		for (int frame = 0; frame < 6; frame++) {
+			SceneTree::get_singleton()->process(0.033);
+			// The first frame always updates, then only every other frame does.
+			const bool updated = frame % 2 == 0;
+			for (int i = 0; i < bone_count; i++) {
+				const Vector3 position = get_skeleton(character)->get_bone_pose_position(i);
+				if (updated) {
+					CHECK(position.is_equal_approx(get_skeleton(reference)->get_bone_pose_position(i)));
+				} else {
+					CHECK(position.is_equal_approx(previous[i]));
+				}
+			}
+			previous.clear();
+			for (int i = 0; i < bone_count; i++) {
+				previous.push_back(get_skeleton(character)->get_bone_pose_position(i));
+			}
+		}
+	}
+
+	SUBCASE("Skipped frames interpolate towards the last pose") {
+		LocalVector<Vector3> target;
+		for (int frame = 0; frame < 6; frame++) {
+			SceneTree::get_singleton()->process(0.033);
+			if (frame > 0 && frame % 2 == 0) {
+				// Half way between the previous update and this one.
+				for (int i = 0; i < bone_count; i++) {
+					const Vector3 half = target[i].lerp(get_skeleton(reference)->get_bone_pose_position(i), 0.5);
+					CHECK(get_skeleton(character)->get_bone_pose_position(i).is_equal_approx(half));
+				}
+			} else if (frame % 2 == 1) {
+				// Reached the pose blended by the last update.
+				for (int i = 0; i < bone_count; i++) {
+					CHECK(get_skeleton(character)->get_bone_pose_position(i).is_equal_approx(target[i]));
+				}
+			}
+			if (frame % 2 == 0) {
+				target.clear();
+				for (int i = 0; i < bone_count; i++) {
+					target.push_back(get_skeleton(reference)->get_bone_pose_position(i));
+				}
+			}
+		}
+	}
+
+	memdelete(reference);
+	memdelete(character);
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Level of detail culls deep bones off-screen") {
+	const int bone_count = 3;
+	Ref<Animation> animation = make_skeleton_animation(bone_count);
+
+	Window *root = SceneTree::get_singleton()->get_root();
+	Node *character = make_character(animation, bone_count, false);
+	VisibleOnScreenNotifier3D *notifier = memnew(VisibleOnScreenNotifier3D);
+	notifier->set_name("Notifier");
+	character->add_child(notifier);
+	AnimationMixer *mixer = Object::cast_to<AnimationMixer>(character->get_node(NodePath("AnimationPlayer")));
+	mixer->set_lod_enabled(true);
+	mixer->set_lod_visibility_notifier(NodePath("../Notifier"));
+	mixer->set_lod_bone_depth_limit(0);
+	mixer->set_lod_interpolate(false);
+	root->add_child(character);
+	play(character);
+
+	SceneTree::get_singleton()->process(0.1);
+	CHECK_FALSE(notifier->is_on_screen());
+	CHECK(mixer->get_lod_level() == 1);
+	// Only the root bone is animated, its children keep their rest pose.
+	CHECK_FALSE(get_skeleton(character)->get_bone_pose_position(0).is_zero_approx());
+	CHECK(get_skeleton(character)->get_bone_pose_position(1).is_zero_approx());
+	CHECK(get_skeleton(character)->get_bone_pose_position(2).is_zero_approx());
+
+	memdelete(character);
+}
+
+// Plays the same animation on a few hundred skeletons, blending them either
+// one after the other in each mixer's notification or together on the
+// WorkerThreadPool.
+TEST_CASE_BENCHMARK("[SceneTree][AnimationMixer][Benchmark] Blend 300 skeletons") {
+	const int character_count = 300;
+	const int bone_count = 64;
+	const int frames = 60;
+
+	Ref<Animation> animation = make_skeleton_animation(bone_count);
+	Window *root = SceneTree::get_singleton()->get_root();
+
+	for (int mode = 0; mode < 2; mode++) {
+		const bool parallel = mode == 1;
+		LocalVector<Node *> characters;
+		for (int i = 0; i < character_count; i++) {
+			Node *character = make_character(animation, bone_count, parallel);
+			root->add_child(character);
+			play(character);
+			characters.push_back(character);
+		}
+		SceneTree::get_singleton()->process(0.0);
+
+		uint64_t begin_ticks = OS::get_singleton()->get_ticks_usec();
+		for (int frame = 0; frame < frames; frame++) {
+			SceneTree::get_singleton()->process(1.0 / 60.0);
+		}
+		uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin_ticks;
+		MESSAGE(vformat("%s: %d skeletons of %d bones, %.3f ms per frame.", parallel ? "Parallel" : "Serial", character_count, bone_count, usec / 1000.0 / frames));
+
+		for (Node *character : characters) {
+			memdelete(character);
+		}
+	}
+}
+
+// Blends 8 animations into the pose of a 200 bone skeleton, comparing the
+// blending of one transform track cache at a time with the pose buffer.
+TEST_CASE_BENCHMARK("[AnimationPoseBuffer][Benchmark] Blend 8 animations over 200 bones") {
+	const int bone_count = 200;
+	const int animation_count = 8;
+	const int iterations = 2000;
+
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(42);
+
+	LocalVector<Vector3> init_loc;
+	LocalVector<Quaternion> init_rot;
+	LocalVector<Vector3> init_scale;
+	LocalVector<Vector3> sample_loc;
+	LocalVector<Quaternion> sample_rot;
+	LocalVector<Vector3> sample_scale;
+	LocalVector<real_t> blends;
+	AnimationPoseBuffer pose;
+	pose.resize(bone_count);
+	for (int i = 0; i < bone_count; i++) {
+		init_loc.push_back(Vector3(rng->randf(), rng->randf(), rng->randf()));
+		init_rot.push_back(make_random_rotation(**rng));
+		init_scale.push_back(Vector3(1, 1, 1));
+		pose.set_init(i, init_loc[i], init_rot[i], init_scale[i]);
+	}
+	for (int i = 0; i < bone_count * animation_count; i++) {
+		sample_loc.push_back(Vector3(rng->randf(), rng->randf(), rng->randf()));
+		sample_rot.push_back(make_random_rotation(**rng));
+		sample_scale.push_back(Vector3(rng->randf_range(0.5, 1.5), rng->randf_range(0.5, 1.5), rng->randf_range(0.5, 1.5)));
+		blends.push_back(1.0 / animation_count);
+	}
+
+	LocalVector<Vector3> loc;
+	LocalVector<Quaternion> rot;
+	LocalVector<Vector3> scale;
+	uint64_t begin_ticks = OS::get_singleton()->get_ticks_usec();
+	for (int n = 0; n < iterations; n++) {
+		loc = init_loc;
+		rot = init_rot;
+		scale = init_scale;
+		for (int a = 0; a < animation_count; a++) {
+			for (int i = 0; i < bone_count; i++) {
+				const int s = a * bone_count + i;
+				loc[i] += (sample_loc[s] - init_loc[i]) * blends[s];
+				rot[i] = (rot[i] * Quaternion().slerp(init_rot[i].inverse() * sample_rot[s], blends[s])).normalized();
+				scale[i] += (sample_scale[s] - init_scale[i]) * blends[s];
+			}
+		}
+	}
+	uint64_t track_usec = OS::get_singleton()->get_ticks_usec() - begin_ticks;
+
+	begin_ticks = OS::get_singleton()->get_ticks_usec();
+	for (int n = 0; n < iterations; n++) {
+		pose.reset();
+		for (int a = 0; a < animation_count; a++) {
+			for (int i = 0; i < bone_count; i++) {
+				const int s = a * bone_count + i;
+				pose.add_position_sample(i, sample_loc[s], blends[s]);
+				pose.add_rotation_sample(i, sample_rot[s], blends[s]);
+				pose.add_scale_sample(i, sample_scale[s], blends[s]);
+			}
+			pose.accumulate();
+		}
+	}
+	uint64_t pose_usec = OS::get_singleton()->get_ticks_usec() - begin_ticks;
+
+	for (int i = 0; i < bone_count; i++) {
+		CHECK(pose.get_position(i).is_equal_approx(loc[i]));
+		CHECK(pose.get_rotation(i).is_equal_approx(rot[i]));
+		CHECK(pose.get_scale(i).is_equal_approx(scale[i]));
+	}
+	MESSAGE(vformat("Track caches: %.3f us per pose.", (double)track_usec / iterations));
+	MESSAGE(vformat("Pose buffer: %.3f us per pose.", (double)pose_usec / iterations));
+}
+
+} // namespace TestAnimationMixer
+
+#endif // TEST_ANIMATION_MIXER_H
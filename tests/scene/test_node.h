@@ -34,9 +34,16 @@
 #define TEST_NODE_H
 
 #include "core/object/class_db.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "scene/2d/node_2d.h"
 #include "scene/main/node.h"
 #include "scene/resources/packed_scene.h"
 
+#ifndef _3D_DISABLED
+#include "scene/3d/node_3d.h"
+#endif // _3D_DISABLED
+
 #include "tests/test_macros.h"
 
 namespace TestNode {
@@ -101,6 +108,101 @@ public:
 	Array get_exported_nodes() const { return exported_nodes; }
 };
 
+// Processes independently from the other nodes, to be processed in parallel.
+class ParallelTestNode : public Node {
+	GDCLASS(ParallelTestNode, Node);
+
+	void _deferred() { deferred_counter++; }
+	void _deferred_thread_group() { deferred_thread_group_counter++; }
+
+protected:
+	void _notification(int p_what) {
+		switch (p_what) {
+			case NOTIFICATION_PHYSICS_PROCESS: {
+				physics_process_counter++;
+				if (stop_physics_process) {
+					// Modifies the process list of the group, not allowed while processing in parallel.
+					set_physics_process(false);
+				}
+				callable_mp(this, &ParallelTestNode::_deferred).call_deferred();
+				call_deferred_thread_group(SNAME("_deferred_thread_group"));
+			} break;
+		}
+	}
+
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("_deferred_thread_group"), &ParallelTestNode::_deferred_thread_group);
+	}
+
+public:
+	int physics_process_counter = 0;
+	int deferred_counter = 0;
+	int deferred_thread_group_counter = 0;
+	bool stop_physics_process = false;
+};
+
+// Moves every physics frame, in parallel, and counts its transform notifications.
+class ParallelMover2DTestNode : public Node2D {
+	GDCLASS(ParallelMover2DTestNode, Node2D);
+
+protected:
+	void _notification(int p_what) {
+		switch (p_what) {
+			case NOTIFICATION_PHYSICS_PROCESS: {
+				translate(Vector2(1, 0));
+			} break;
+			case NOTIFICATION_TRANSFORM_CHANGED: {
+				transform_changed_counter++;
+			} break;
+		}
+	}
+
+public:
+	int transform_changed_counter = 0;
+};
+
+#ifndef _3D_DISABLED
+class ParallelMover3DTestNode : public Node3D {
+	GDCLASS(ParallelMover3DTestNode, Node3D);
+
+protected:
+	void _notification(int p_what) {
+		switch (p_what) {
+			case NOTIFICATION_PHYSICS_PROCESS: {
+				translate(Vector3(1, 0, 0));
+			} break;
+			case NOTIFICATION_TRANSFORM_CHANGED: {
+				transform_changed_counter++;
+			} break;
+		}
+	}
+
+public:
+	int transform_changed_counter = 0;
+};
+#endif // _3D_DISABLED
+
+// Steers towards a target every physics frame, like a crowd agent would.
+class AgentTestNode : public Node {
+	GDCLASS(AgentTestNode, Node);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_PHYSICS_PROCESS) {
+			for (int i = 0; i < 32; i++) {
+				Vector3 desired = (target - position).normalized() * 4.0;
+				velocity = velocity.lerp(desired, 0.1);
+				position += velocity * 0.001;
+			}
+		}
+	}
+
+public:
+	Vector3 position;
+	Vector3 velocity;
+	Vector3 target = Vector3(10, 0, 10);
+};
+
 TEST_CASE("[SceneTree][Node] Testing node operations with a very simple scene tree") {
 	Node *node = memnew(Node);
 
@@ -906,6 +1008,319 @@ TEST_CASE("[SceneTree][Node] Test the process priority") {
 	memdelete(node4);
 }
 
+TEST_CASE("[SceneTree][Node] Test parallel processing") {
+	GDREGISTER_CLASS(ParallelTestNode);
+
+	const int node_count = 500;
+	Node *group = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(group);
+
+	SUBCASE("Main thread group") {
+	}
+
+	SUBCASE("Sub-thread group") {
+		group->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+		group->set_process_thread_messages(Node::FLAG_PROCESS_THREAD_MESSAGES_ALL);
+	}
+
+	LocalVector<ParallelTestNode *> nodes;
+	for (int i = 0; i < node_count; i++) {
+		ParallelTestNode *node = memnew(ParallelTestNode);
+		node->set_process_thread_parallel(true);
+		node->set_physics_process(true);
+		group->add_child(node);
+		nodes.push_back(node);
+	}
+
+	// Processed after the parallel nodes.
+	List<Node *> process_order;
+	TestNode *last = memnew(TestNode);
+	last->callback_list = &process_order;
+	last->set_physics_process(true);
+	last->set_physics_process_priority(1);
+	group->add_child(last);
+
+	SceneTree::get_singleton()->physics_process(0);
+	SceneTree::get_singleton()->physics_process(0);
+
+	for (ParallelTestNode *node : nodes) {
+		CHECK_EQ(node->physics_process_counter, 2);
+		CHECK_EQ(node->deferred_counter, 2);
+		CHECK_EQ(node->deferred_thread_group_counter, 2);
+	}
+	CHECK_EQ(last->physics_process_counter, 2);
+	CHECK_EQ(process_order.size(), 2);
+
+	memdelete(group);
+}
+
+TEST_CASE("[SceneTree][Node] Test parallel processing in more sub-thread groups than worker threads") {
+	GDREGISTER_CLASS(ParallelTestNode);
+
+	// Each group is processed by a pool thread, which must not wait for parallel tasks of its own.
+	const int group_count = WorkerThreadPool::get_singleton()->get_thread_count() + 2;
+	const int node_count = 100;
+	Node *root = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(root);
+
+	LocalVector<ParallelTestNode *> nodes;
+	for (int i = 0; i < group_count; i++) {
+		Node *group = memnew(Node);
+		group->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+		group->set_process_thread_messages(Node::FLAG_PROCESS_THREAD_MESSAGES_ALL);
+		root->add_child(group);
+		for (int j = 0; j < node_count; j++) {
+			ParallelTestNode *node = memnew(ParallelTestNode);
+			node->set_process_thread_parallel(true);
+			node->set_physics_process(true);
+			group->add_child(node);
+			nodes.push_back(node);
+		}
+	}
+
+	SceneTree::get_singleton()->physics_process(0);
+	SceneTree::get_singleton()->physics_process(0);
+
+	for (ParallelTestNode *node : nodes) {
+		CHECK_EQ(node->physics_process_counter, 2);
+		CHECK_EQ(node->deferred_counter, 2);
+		CHECK_EQ(node->deferred_thread_group_counter, 2);
+	}
+
+	SUBCASE("Process lists can't be modified while processing in parallel") {
+		for (ParallelTestNode *node : nodes) {
+			node->stop_physics_process = true;
+		}
+
+		ERR_PRINT_OFF;
+		SceneTree::get_singleton()->physics_process(0);
+		ERR_PRINT_ON;
+
+		for (ParallelTestNode *node : nodes) {
+			CHECK_EQ(node->physics_process_counter, 3);
+			CHECK(node->is_physics_processing());
+		}
+	}
+
+	memdelete(root);
+}
+
+TEST_CASE("[SceneTree][Node] Test transform notifications of nodes processed in parallel") {
+	GDREGISTER_CLASS(ParallelMover2DTestNode);
+
+	const int node_count = 500;
+	Node *group = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(group);
+
+	LocalVector<ParallelMover2DTestNode *> nodes_2d;
+	for (int i = 0; i < node_count; i++) {
+		ParallelMover2DTestNode *node = memnew(ParallelMover2DTestNode);
+		node->set_notify_transform(true);
+		node->set_process_thread_parallel(true);
+		node->set_physics_process(true);
+		group->add_child(node);
+		nodes_2d.push_back(node);
+	}
+
+#ifndef _3D_DISABLED
+	GDREGISTER_CLASS(ParallelMover3DTestNode);
+
+	LocalVector<ParallelMover3DTestNode *> nodes_3d;
+	for (int i = 0; i < node_count; i++) {
+		ParallelMover3DTestNode *node = memnew(ParallelMover3DTestNode);
+		node->set_notify_transform(true);
+		node->set_process_thread_parallel(true);
+		node->set_physics_process(true);
+		group->add_child(node);
+		nodes_3d.push_back(node);
+	}
+#endif // _3D_DISABLED
+
+	SceneTree::get_singleton()->flush_transform_notifications();
+	for (ParallelMover2DTestNode *node : nodes_2d) {
+		node->transform_changed_counter = 0;
+	}
+#ifndef _3D_DISABLED
+	for (ParallelMover3DTestNode *node : nodes_3d) {
+		node->transform_changed_counter = 0;
+	}
+#endif // _3D_DISABLED
+
+	// Workers defer adding to the transform change list, which is flushed at the end of the frame.
+	SceneTree::get_singleton()->physics_process(0);
+	SceneTree::get_singleton()->physics_process(0);
+
+	for (ParallelMover2DTestNode *node : nodes_2d) {
+		CHECK_EQ(node->transform_changed_counter, 2);
+		CHECK_EQ(node->get_position(), Vector2(2, 0));
+	}
+#ifndef _3D_DISABLED
+	for (ParallelMover3DTestNode *node : nodes_3d) {
+		CHECK_EQ(node->transform_changed_counter, 2);
+		CHECK_EQ(node->get_position(), Vector3(2, 0, 0));
+	}
+#endif // _3D_DISABLED
+
+	memdelete(group);
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][Node][Benchmark] Physics process 10000 agents") {
+	GDREGISTER_CLASS(AgentTestNode);
+
+	const int node_count = 10000;
+	const int frame_count = 60;
+	Node *group = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(group);
+	LocalVector<AgentTestNode *> nodes;
+	for (int i = 0; i < node_count; i++) {
+		AgentTestNode *node = memnew(AgentTestNode);
+		node->set_physics_process(true);
+		group->add_child(node);
+		nodes.push_back(node);
+	}
+
+	for (bool parallel : { false, true }) {
+		for (AgentTestNode *node : nodes) {
+			node->set_process_thread_parallel(parallel);
+		}
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int frame = 0; frame < frame_count; frame++) {
+			SceneTree::get_singleton()->physics_process(0.016);
+		}
+		MESSAGE(vformat("%s: %d usec per frame.", parallel ? "Parallel" : "Serial", (OS::get_singleton()->get_ticks_usec() - begin) / frame_count));
+	}
+
+	memdelete(group);
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][Node][Benchmark] Bullet spawning churn") {
+	const int frame_count = 60;
+	Node *root = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(root);
+
+	// Each emitter owns a few bullets, the common case of a small child count.
+	SUBCASE("Bullets under their emitters") {
+		const int emitter_count = 500;
+		const int bullets_per_emitter = 6;
+
+		LocalVector<StringName> bullet_names;
+		for (int i = 0; i < bullets_per_emitter; i++) {
+			bullet_names.push_back(vformat("Bullet%d", i));
+		}
+		LocalVector<Node *> emitters;
+		for (int i = 0; i < emitter_count; i++) {
+			Node *emitter = memnew(Node);
+			root->add_child(emitter);
+			emitters.push_back(emitter);
+		}
+
+		uint64_t add_usec = 0;
+		uint64_t get_usec = 0;
+		uint64_t remove_usec = 0;
+		uint64_t free_usec = 0;
+		int found = 0;
+		LocalVector<Node *> bullets;
+		for (int frame = 0; frame < frame_count; frame++) {
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (Node *emitter : emitters) {
+				for (const StringName &name : bullet_names) {
+					Node *bullet = memnew(Node);
+					bullet->set_name(name);
+					emitter->add_child(bullet);
+					bullets.push_back(bullet);
+				}
+			}
+			add_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (Node *emitter : emitters) {
+				for (const StringName &name : bullet_names) {
+					found += emitter->get_node_or_null(NodePath(name)) != nullptr;
+				}
+			}
+			get_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+			// Half of the bullets are removed right away, the others are queued for deletion.
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (uint32_t i = 0; i < bullets.size(); i += 2) {
+				bullets[i]->get_parent()->remove_child(bullets[i]);
+				memdelete(bullets[i]);
+			}
+			remove_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (uint32_t i = 1; i < bullets.size(); i += 2) {
+				bullets[i]->queue_free();
+			}
+			SceneTree::get_singleton()->process(0.016);
+			free_usec += OS::get_singleton()->get_ticks_usec() - begin;
+			bullets.clear();
+		}
+		CHECK_EQ(found, frame_count * emitter_count * bullets_per_emitter);
+		for (Node *emitter : emitters) {
+			CHECK_EQ(emitter->get_child_count(), 0);
+		}
+		MESSAGE(vformat("Per frame: add_child %d usec, get_node %d usec, remove_child %d usec, queue_free %d usec.", add_usec / frame_count, get_usec / frame_count, remove_usec / frame_count, free_usec / frame_count));
+	}
+
+	// All the bullets share a single container, the oldest ones being removed first.
+	SUBCASE("Bullets under a shared container") {
+		const int bullet_count = 3000;
+		const int spawned_per_frame = 200;
+
+		LocalVector<StringName> bullet_names;
+		for (int i = 0; i < bullet_count; i++) {
+			bullet_names.push_back(vformat("Bullet%d", i));
+		}
+
+		uint64_t add_usec = 0;
+		uint64_t get_usec = 0;
+		uint64_t free_usec = 0;
+		int next_bullet = 0;
+		int found = 0;
+		LocalVector<Node *> bullets;
+		bullets.resize(bullet_count);
+		for (Node *&bullet : bullets) {
+			bullet = nullptr;
+		}
+		for (int frame = 0; frame < frame_count; frame++) {
+			// Recycle the slots of the oldest bullets.
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < spawned_per_frame; i++) {
+				int slot = (next_bullet + i) % bullet_count;
+				if (bullets[slot]) {
+					bullets[slot]->queue_free();
+				}
+			}
+			SceneTree::get_singleton()->process(0.016);
+			free_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < spawned_per_frame; i++) {
+				int slot = (next_bullet + i) % bullet_count;
+				Node *bullet = memnew(Node);
+				bullet->set_name(bullet_names[slot]);
+				root->add_child(bullet);
+				bullets[slot] = bullet;
+			}
+			add_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < spawned_per_frame; i++) {
+				found += root->get_node_or_null(NodePath(bullet_names[(next_bullet + i) % bullet_count])) != nullptr;
+			}
+			get_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+			next_bullet = (next_bullet + spawned_per_frame) % bullet_count;
+		}
+		CHECK_EQ(found, frame_count * spawned_per_frame);
+		CHECK_EQ(root->get_child_count(), MIN(bullet_count, frame_count * spawned_per_frame));
+		MESSAGE(vformat("Per frame: add_child %d usec, get_node %d usec, queue_free %d usec.", add_usec / frame_count, get_usec / frame_count, free_usec / frame_count));
+	}
+
+	memdelete(root);
+}
+
 } // namespace TestNode
 
 #endif // TEST_NODE_H
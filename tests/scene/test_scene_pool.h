@@ -0,0 +1,242 @@
+/**************************************************************************/
+/*  test_scene_pool.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+
+#ifndef TEST_SCENE_POOL_H
+#define TEST_SCENE_POOL_H
+
+#include "core/os/os.h"
+#include "scene/2d/node_2d.h"
+#include "scene/main/window.h"
+#include "scene/resources/scene_pool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestScenePool {
+
+// Releases a node while the parent propagates a notification, which blocks removing its children.
+class ReleasingTestNode : public Node {
+	GDCLASS(ReleasingTestNode, Node);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_RELEASE && pool.is_valid()) {
+			pool->release(node);
+		}
+	}
+
+public:
+	enum {
+		NOTIFICATION_RELEASE = 10000,
+	};
+
+	Ref<ScenePool> pool;
+	Node *node = nullptr;
+};
+
+// A Node2D root with a Node2D child, both with a few stored properties.
+static Ref<PackedScene> create_test_scene() {
+	Node2D *root = memnew(Node2D);
+	root->set_name("Bullet");
+	root->set_rotation(1.0);
+	Node2D *child = memnew(Node2D);
+	child->set_name("Sprite");
+	child->set_position(Vector2(4, 2));
+	root->add_child(child);
+	child->set_owner(root);
+
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(root);
+	memdelete(root);
+	return packed_scene;
+}
+
+TEST_CASE("[SceneTree][ScenePool] Acquire and release instances") {
+	Ref<ScenePool> pool;
+	pool.instantiate();
+	pool->set_scene(create_test_scene());
+	pool->set_capacity(2);
+
+	SUBCASE("Filled pools only hit") {
+		pool->fill();
+		CHECK_EQ(pool->get_available_count(), 2);
+
+		Node *a = pool->acquire();
+		Node *b = pool->acquire();
+		CHECK_EQ(pool->get_hit_count(), 2);
+		CHECK_EQ(pool->get_miss_count(), 0);
+
+		Node *c = pool->acquire();
+		CHECK_EQ(pool->get_miss_count(), 1);
+		CHECK_EQ(pool->get_available_count(), 0);
+
+		// The pool keeps up to its capacity, the other instances are freed.
+		pool->release(a);
+		pool->release(b);
+		ObjectID c_id = c->get_instance_id();
+		pool->release(c);
+		CHECK_EQ(pool->get_available_count(), 2);
+		CHECK(ObjectDB::get_instance(c_id) == nullptr);
+
+		pool->reset_metrics();
+		CHECK_EQ(pool->get_hit_count(), 0);
+		CHECK_EQ(pool->get_miss_count(), 0);
+	}
+
+	SUBCASE("Released instances are reset") {
+		Node2D *bullet = Object::cast_to<Node2D>(pool->acquire());
+		REQUIRE(bullet);
+		SceneTree::get_singleton()->get_root()->add_child(bullet);
+
+		Node2D *sprite = Object::cast_to<Node2D>(bullet->get_node(NodePath("Sprite")));
+		bullet->set_position(Vector2(100, 50));
+		bullet->set_rotation(0.0);
+		bullet->set_visible(false);
+		sprite->set_position(Vector2(-1, -1));
+
+		pool->release(bullet);
+		CHECK_FALSE(bullet->is_inside_tree());
+		CHECK_EQ(bullet->get_parent(), nullptr);
+
+		Node2D *recycled = Object::cast_to<Node2D>(pool->acquire());
+		CHECK_EQ(recycled, bullet);
+		CHECK_EQ(pool->get_hit_count(), 1);
+		CHECK_EQ(recycled->get_position(), Vector2());
+		CHECK(Math::is_equal_approx(recycled->get_rotation(), (real_t)1.0));
+		CHECK(recycled->is_visible());
+		CHECK_EQ(sprite->get_position(), Vector2(4, 2));
+
+		memdelete(recycled);
+	}
+
+	SUBCASE("Only acquired instances can be released") {
+		Node *foreign = memnew(Node);
+		ERR_PRINT_OFF;
+		pool->release(foreign);
+		ERR_PRINT_ON;
+		CHECK_EQ(pool->get_available_count(), 0);
+		memdelete(foreign);
+	}
+
+	SUBCASE("Instances queued for deletion can't be released") {
+		Node *bullet = pool->acquire();
+		SceneTree::get_singleton()->get_root()->add_child(bullet);
+		ObjectID bullet_id = bullet->get_instance_id();
+		bullet->queue_free();
+
+		ERR_PRINT_OFF;
+		pool->release(bullet);
+		ERR_PRINT_ON;
+		CHECK_EQ(pool->get_available_count(), 0);
+
+		SceneTree::get_singleton()->process(0);
+		CHECK(ObjectDB::get_instance(bullet_id) == nullptr);
+	}
+
+	SUBCASE("Instances that can't be removed from their parent stay acquired") {
+		GDREGISTER_CLASS(ReleasingTestNode);
+
+		Node *parent = memnew(Node);
+		SceneTree::get_singleton()->get_root()->add_child(parent);
+		ReleasingTestNode *releaser = memnew(ReleasingTestNode);
+		parent->add_child(releaser);
+		Node *bullet = pool->acquire();
+		parent->add_child(bullet);
+
+		releaser->pool = pool;
+		releaser->node = bullet;
+		ERR_PRINT_OFF;
+		parent->propagate_notification(ReleasingTestNode::NOTIFICATION_RELEASE);
+		ERR_PRINT_ON;
+		releaser->pool.unref();
+		CHECK_EQ(bullet->get_parent(), parent);
+		CHECK_EQ(pool->get_available_count(), 0);
+
+		// Released once the parent isn't busy anymore.
+		pool->release(bullet);
+		CHECK_EQ(bullet->get_parent(), nullptr);
+		CHECK_EQ(pool->get_available_count(), 1);
+
+		memdelete(parent);
+	}
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][ScenePool][Benchmark] Spawn and remove 1000 bullets per frame") {
+	const int bullet_count = 1000;
+	const int frame_count = 30;
+	Ref<PackedScene> scene = create_test_scene();
+	Node *root = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(root);
+	LocalVector<Node *> bullets;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < frame_count; frame++) {
+		for (int i = 0; i < bullet_count; i++) {
+			Node *bullet = scene->instantiate();
+			root->add_child(bullet);
+			bullets.push_back(bullet);
+		}
+		for (Node *bullet : bullets) {
+			bullet->queue_free();
+		}
+		bullets.clear();
+		SceneTree::get_singleton()->process(0.016);
+	}
+	MESSAGE(vformat("Instantiate: %d usec per frame.", (OS::get_singleton()->get_ticks_usec() - begin) / frame_count));
+
+	Ref<ScenePool> pool;
+	pool.instantiate();
+	pool->set_scene(scene);
+	pool->set_capacity(bullet_count);
+	pool->fill();
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < frame_count; frame++) {
+		for (int i = 0; i < bullet_count; i++) {
+			Node *bullet = pool->acquire();
+			root->add_child(bullet);
+			bullets.push_back(bullet);
+		}
+		for (Node *bullet : bullets) {
+			pool->release(bullet);
+		}
+		bullets.clear();
+		SceneTree::get_singleton()->process(0.016);
+	}
+	MESSAGE(vformat("ScenePool: %d usec per frame, %d hits, %d misses.", (OS::get_singleton()->get_ticks_usec() - begin) / frame_count, pool->get_hit_count(), pool->get_miss_count()));
+	CHECK_EQ(pool->get_miss_count(), 0);
+
+	memdelete(root);
+}
+
+} // namespace TestScenePool
+
+#endif // TEST_SCENE_POOL_H
@@ -35,7 +35,18 @@
 
 #include "tests/test_macros.h"
 
+#include "core/math/random_number_generator.h"
+#include "core/os/os.h"
 #include "scene/3d/skeleton_3d.h"
+#include "scene/main/window.h"
+
+class TestSkeleton3DInternalsAccessor {
+public:
+	static int get_dirty_skeleton_count() {
+		MutexLock lock(Skeleton3D::dirty_skeletons_mutex);
+		return Skeleton3D::dirty_skeletons.size();
+	}
+};
 
 namespace TestSkeleton3D {
 
@@ -75,6 +86,168 @@ TEST_CASE("[Skeleton3D] Test per-bone meta") {
 	skeleton->set_bone_meta(0, "non-existing-key", Variant());
 	memdelete(skeleton);
 }
+
+// A tree of bones where every bone has up to p_branching children.
+static Skeleton3D *make_bone_tree(int p_bone_count, int p_branching) {
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	for (int i = 0; i < p_bone_count; i++) {
+		skeleton->add_bone("bone_" + itos(i));
+		if (i > 0) {
+			skeleton->set_bone_parent(i, (i - 1) / p_branching);
+		}
+		skeleton->set_bone_rest(i, Transform3D(Basis(), Vector3(0, 0.1, 0)));
+		skeleton->reset_bone_pose(i);
+	}
+	return skeleton;
+}
+
+static void randomize_bone_poses(Skeleton3D *p_skeleton, RandomNumberGenerator &p_rng, int p_from = 0) {
+	for (int i = p_from; i < p_skeleton->get_bone_count(); i++) {
+		p_skeleton->set_bone_pose_position(i, Vector3(p_rng.randf(), p_rng.randf(), p_rng.randf()));
+		p_skeleton->set_bone_pose_rotation(i, Quaternion(Vector3(p_rng.randf_range(-1, 1), p_rng.randf_range(-1, 1), 1).normalized(), p_rng.randf_range(-Math_PI, Math_PI)));
+	}
+}
+
+// Global poses computed bone by bone from the local poses.
+static void check_global_poses(Skeleton3D *p_skeleton) {
+	for (int i = 0; i < p_skeleton->get_bone_count(); i++) {
+		Transform3D expected;
+		for (int bone = i; bone >= 0; bone = p_skeleton->get_bone_parent(bone)) {
+			expected = p_skeleton->get_bone_pose(bone) * expected;
+		}
+		CHECK(p_skeleton->get_bone_global_pose(i).is_equal_approx(expected));
+	}
+}
+
+TEST_CASE("[SceneTree][Skeleton3D] Global poses of dirty subtrees") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(7);
+
+	Skeleton3D *skeleton = make_bone_tree(40, 3);
+	SceneTree::get_singleton()->get_root()->add_child(skeleton);
+	randomize_bone_poses(skeleton, **rng);
+	check_global_poses(skeleton);
+
+	SUBCASE("Posing a leaf") {
+		skeleton->set_bone_pose_position(39, Vector3(1, 2, 3));
+		check_global_poses(skeleton);
+	}
+
+	SUBCASE("Posing a branch") {
+		skeleton->set_bone_pose_rotation(2, Quaternion(Vector3(0, 1, 0), 1.0));
+		skeleton->set_bone_pose_position(30, Vector3(3, 2, 1));
+		skeleton->force_update_bone_children_transforms(2);
+		check_global_poses(skeleton);
+	}
+
+	SUBCASE("Posing after an update") {
+		SceneTree::get_singleton()->process(0.016);
+		randomize_bone_poses(skeleton, **rng, 20);
+		SceneTree::get_singleton()->process(0.016);
+		check_global_poses(skeleton);
+	}
+
+	memdelete(skeleton);
+}
+
+TEST_CASE("[SceneTree][Skeleton3D] Batched update of many skeletons") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(11);
+
+	// Enough bones in total to update the skeletons on the WorkerThreadPool.
+	LocalVector<Skeleton3D *> skeletons;
+	for (int i = 0; i < 16; i++) {
+		Skeleton3D *skeleton = make_bone_tree(64, 2);
+		SceneTree::get_singleton()->get_root()->add_child(skeleton);
+		skeletons.push_back(skeleton);
+	}
+
+	for (int frame = 0; frame < 3; frame++) {
+		for (Skeleton3D *skeleton : skeletons) {
+			randomize_bone_poses(skeleton, **rng, frame * 16);
+		}
+		SceneTree::get_singleton()->process(0.016);
+		for (Skeleton3D *skeleton : skeletons) {
+			check_global_poses(skeleton);
+		}
+	}
+
+	for (Skeleton3D *skeleton : skeletons) {
+		memdelete(skeleton);
+	}
+}
+
+TEST_CASE("[SceneTree][Skeleton3D] Skeletons in sub-thread groups don't grow the dirty queue") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(13);
+
+	Node *group = memnew(Node);
+	group->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+	group->set_process_thread_messages(Node::FLAG_PROCESS_THREAD_MESSAGES_ALL);
+	SceneTree::get_singleton()->get_root()->add_child(group);
+
+	LocalVector<Skeleton3D *> skeletons;
+	for (int i = 0; i < 4; i++) {
+		Skeleton3D *skeleton = make_bone_tree(64, 2);
+		group->add_child(skeleton);
+		skeletons.push_back(skeleton);
+	}
+
+	for (int frame = 0; frame < 3; frame++) {
+		for (Skeleton3D *skeleton : skeletons) {
+			randomize_bone_poses(skeleton, **rng);
+		}
+		CHECK(TestSkeleton3DInternalsAccessor::get_dirty_skeleton_count() > 0);
+
+		// No skeleton is updated on the main thread, the queue is flushed once all nodes are processed.
+		SceneTree::get_singleton()->process(0.016);
+		CHECK_EQ(TestSkeleton3DInternalsAccessor::get_dirty_skeleton_count(), 0);
+		for (Skeleton3D *skeleton : skeletons) {
+			check_global_poses(skeleton);
+		}
+	}
+
+	memdelete(group);
+}
+
+// Poses a crowd of skeletons every frame, as an AnimationMixer would.
+TEST_CASE_BENCHMARK("[SceneTree][Skeleton3D][Benchmark] Update a crowd of 500 skeletons") {
+	const int skeleton_count = 500;
+	const int bone_count = 60;
+	const int frame_count = 60;
+
+	LocalVector<Skeleton3D *> skeletons;
+	for (int i = 0; i < skeleton_count; i++) {
+		Skeleton3D *skeleton = make_bone_tree(bone_count, 3);
+		SceneTree::get_singleton()->get_root()->add_child(skeleton);
+		skeletons.push_back(skeleton);
+	}
+
+	uint64_t pose_usec = 0;
+	uint64_t update_usec = 0;
+	for (int frame = 0; frame < frame_count; frame++) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		const Quaternion rotation = Quaternion(Vector3(0, 1, 0), frame * 0.01);
+		for (Skeleton3D *skeleton : skeletons) {
+			for (int i = 0; i < bone_count; i++) {
+				skeleton->set_bone_pose_rotation(i, rotation);
+			}
+		}
+		uint64_t posed = OS::get_singleton()->get_ticks_usec();
+		SceneTree::get_singleton()->process(0.016);
+		pose_usec += posed - begin;
+		update_usec += OS::get_singleton()->get_ticks_usec() - posed;
+	}
+	MESSAGE(vformat("Posing: %d usec per frame, updating: %d usec per frame.", pose_usec / frame_count, update_usec / frame_count));
+
+	for (Skeleton3D *skeleton : skeletons) {
+		memdelete(skeleton);
+	}
+}
+
 } // namespace TestSkeleton3D
 
 #endif // TEST_SKELETON_3D_H
@@ -0,0 +1,260 @@
+/**************************************************************************/
+/*  test_tile_map_layer.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+
+#ifndef TEST_TILE_MAP_LAYER_H
+#define TEST_TILE_MAP_LAYER_H
+
+#include "core/io/dir_access.h"
+#include "scene/2d/tile_map_layer.h"
+#include "scene/main/window.h"
+#include "scene/resources/image_texture.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_tools.h"
+#include "tests/test_utils.h"
+
+class TestTileMapLayerInternalsAccessor {
+public:
+	// The cell coords of each rendering quadrant, in drawing order.
+	static LocalVector<LocalVector<Vector2i>> get_rendering_quadrant_cells(const TileMapLayer *p_layer) {
+		LocalVector<LocalVector<Vector2i>> quadrants;
+		for (const KeyValue<Vector2i, Ref<RenderingQuadrant>> &kv : p_layer->rendering_quadrant_map) {
+			LocalVector<Vector2i> cells;
+			for (const SelfList<CellData> *cell = kv.value->cells.first(); cell; cell = cell->next()) {
+				cells.push_back(cell->self()->coords);
+			}
+			quadrants.push_back(cells);
+		}
+		return quadrants;
+	}
+};
+
+namespace TestTileMapLayer {
+
+static Ref<TileSet> create_test_tile_set(int &r_source_id) {
+	Ref<Image> image = Image::create_empty(64, 64, false, Image::FORMAT_RGBA8);
+	Ref<TileSetAtlasSource> atlas_source;
+	atlas_source.instantiate();
+	atlas_source->set_texture(ImageTexture::create_from_image(image));
+	atlas_source->set_texture_region_size(Vector2i(16, 16));
+	atlas_source->create_tile(Vector2i(0, 0));
+	atlas_source->create_tile(Vector2i(1, 0));
+
+	Ref<TileSet> tile_set;
+	tile_set.instantiate();
+	r_source_id = tile_set->add_source(atlas_source);
+	return tile_set;
+}
+
+TEST_CASE("[SceneTree][TileMapLayer] Set cells in batch") {
+	int source_id = TileSet::INVALID_SOURCE;
+	TileMapLayer *layer = memnew(TileMapLayer);
+	layer->set_tile_set(create_test_tile_set(source_id));
+	SceneTree::get_singleton()->get_root()->add_child(layer);
+
+	SUBCASE("Cells are set like with set_cell") {
+		PackedVector2Array coords = { Vector2(0, 0), Vector2(1, 0), Vector2(-3, 7) };
+		PackedInt32Array source_ids = { source_id, source_id, source_id };
+		PackedVector2Array atlas_coords = { Vector2(0, 0), Vector2(1, 0), Vector2(1, 0) };
+		layer->set_cells_batch(coords, source_ids, atlas_coords);
+
+		CHECK_EQ(layer->get_used_cells().size(), 3);
+		CHECK_EQ(layer->get_cell_source_id(Vector2i(-3, 7)), source_id);
+		CHECK_EQ(layer->get_cell_atlas_coords(Vector2i(1, 0)), Vector2i(1, 0));
+		CHECK_EQ(layer->get_cell_alternative_tile(Vector2i(0, 0)), 0);
+
+		// Invalid identifiers erase the cells.
+		PackedVector2Array erased_coords = { Vector2(0, 0), Vector2(-3, 7) };
+		PackedInt32Array erased_source_ids = { TileSet::INVALID_SOURCE, TileSet::INVALID_SOURCE };
+		PackedVector2Array erased_atlas_coords = { Vector2(-1, -1), Vector2(-1, -1) };
+		PackedInt32Array erased_alternative_tiles = { -1, -1 };
+		layer->set_cells_batch(erased_coords, erased_source_ids, erased_atlas_coords, erased_alternative_tiles);
+
+		CHECK_EQ(layer->get_used_cells().size(), 1);
+		CHECK_EQ(layer->get_cell_source_id(Vector2i(0, 0)), TileSet::INVALID_SOURCE);
+		CHECK_EQ(layer->get_cell_source_id(Vector2i(1, 0)), source_id);
+	}
+
+	SUBCASE("Mismatched array sizes are rejected") {
+		PackedVector2Array coords = { Vector2(0, 0), Vector2(1, 0) };
+		PackedInt32Array source_ids = { source_id };
+		PackedVector2Array atlas_coords = { Vector2(0, 0), Vector2(0, 0) };
+
+		ERR_PRINT_OFF;
+		layer->set_cells_batch(coords, source_ids, atlas_coords);
+		ERR_PRINT_ON;
+
+		CHECK(layer->get_used_cells().is_empty());
+	}
+
+	SUBCASE("Many quadrants are rebuilt") {
+		// 64x64 cells with the default quadrant size of 16 make enough dirty quadrants to prepare them on worker threads.
+		PackedVector2Array coords;
+		PackedInt32Array source_ids;
+		PackedVector2Array atlas_coords;
+		for (int y = 0; y < 64; y++) {
+			for (int x = 0; x < 64; x++) {
+				coords.push_back(Vector2(x, y));
+				source_ids.push_back(source_id);
+				atlas_coords.push_back(Vector2((x + y) % 2, 0));
+			}
+		}
+		layer->set_cells_batch(coords, source_ids, atlas_coords);
+		layer->update_internals();
+		CHECK_EQ(layer->get_used_cells().size(), 64 * 64);
+
+		// Dirty a single quadrant, then the whole layer again.
+		layer->erase_cell(Vector2i(5, 5));
+		layer->update_internals();
+		CHECK_EQ(layer->get_used_cells().size(), 64 * 64 - 1);
+
+		// Y-sorted, each row is a quadrant and its cells are drawn from right to left.
+		ErrorDetector ed;
+		layer->set_y_sort_enabled(true);
+		layer->set_x_draw_order_reversed(true);
+		layer->update_internals();
+		CHECK_FALSE(ed.has_error);
+		CHECK_EQ(layer->get_used_rect(), Rect2i(0, 0, 64, 64));
+
+		const LocalVector<LocalVector<Vector2i>> quadrants = TestTileMapLayerInternalsAccessor::get_rendering_quadrant_cells(layer);
+		CHECK_EQ(quadrants.size(), 64u);
+		for (const LocalVector<Vector2i> &cells : quadrants) {
+			REQUIRE_FALSE(cells.is_empty());
+			bool sorted = true;
+			for (uint32_t i = 1; i < cells.size(); i++) {
+				sorted = sorted && cells[i].y == cells[0].y && cells[i].x < cells[i - 1].x;
+			}
+			CHECK(sorted);
+		}
+	}
+
+	memdelete(layer);
+}
+
+TEST_CASE("[SceneTree][TileMapLayer] Stream chunks around focus points") {
+	int source_id = TileSet::INVALID_SOURCE;
+	TileMapLayer *layer = memnew(TileMapLayer);
+	layer->set_tile_set(create_test_tile_set(source_id));
+	SceneTree::get_singleton()->get_root()->add_child(layer);
+
+	// 256x32 cells, saved as 16x2 chunks of 16x16 cells.
+	for (int y = 0; y < 32; y++) {
+		for (int x = 0; x < 256; x++) {
+			layer->set_cell(Vector2i(x, y), source_id, Vector2i(x % 2, 0));
+		}
+	}
+	const String path = TestUtils::get_temp_path("tile_map_layer_streaming.rtms");
+	REQUIRE_EQ(layer->save_streaming_file(path, 16), OK);
+
+	REQUIRE_EQ(layer->start_streaming(path), OK);
+	CHECK(layer->is_streaming());
+	CHECK(layer->get_used_cells().is_empty());
+
+	// Loads the chunks (0, 0), (1, 0), (0, 1) and (1, 1), the others in range do not exist.
+	layer->set_streaming_radius(1);
+	layer->set_streaming_focus_points({ layer->map_to_local(Vector2i(0, 0)) });
+	layer->flush_streaming();
+	CHECK_EQ(layer->get_streaming_loaded_chunk_count(), 4);
+	CHECK_EQ(layer->get_used_cells().size(), 4 * 16 * 16);
+	CHECK_EQ(layer->get_cell_atlas_coords(Vector2i(5, 5)), Vector2i(1, 0));
+	CHECK_EQ(layer->get_cell_source_id(Vector2i(200, 5)), TileSet::INVALID_SOURCE);
+
+	SUBCASE("Chunks out of range are unloaded") {
+		layer->set_streaming_focus_points({ layer->map_to_local(Vector2i(200, 5)) });
+		layer->flush_streaming();
+		CHECK_EQ(layer->get_streaming_loaded_chunk_count(), 6);
+		CHECK_EQ(layer->get_cell_source_id(Vector2i(200, 5)), source_id);
+		CHECK_EQ(layer->get_cell_source_id(Vector2i(5, 5)), TileSet::INVALID_SOURCE);
+	}
+
+	SUBCASE("Chunks are kept one chunk further than they are loaded") {
+		layer->set_streaming_focus_points({ layer->map_to_local(Vector2i(32, 0)) });
+		layer->flush_streaming();
+		CHECK_EQ(layer->get_cell_source_id(Vector2i(5, 5)), source_id);
+	}
+
+	SUBCASE("Modified chunks keep their changes once unloaded") {
+		layer->erase_cell(Vector2i(5, 5));
+		layer->set_cell(Vector2i(-40, -40), source_id, Vector2i(0, 0));
+
+		layer->set_streaming_focus_points({ layer->map_to_local(Vector2i(200, 5)) });
+		layer->flush_streaming();
+		CHECK_EQ(layer->get_cell_source_id(Vector2i(-40, -40)), TileSet::INVALID_SOURCE);
+
+		layer->set_streaming_focus_points({ layer->map_to_local(Vector2i(0, 0)), layer->map_to_local(Vector2i(-40, -40)) });
+		layer->flush_streaming();
+		CHECK_EQ(layer->get_cell_source_id(Vector2i(5, 5)), TileSet::INVALID_SOURCE);
+		CHECK_EQ(layer->get_cell_source_id(Vector2i(6, 5)), source_id);
+		CHECK_EQ(layer->get_cell_source_id(Vector2i(-40, -40)), source_id);
+	}
+
+	SUBCASE("Modifying a chunk that is not loaded loads it first") {
+		// Chunk (12, 0) is not loaded.
+		layer->erase_cell(Vector2i(200, 5));
+		layer->set_cell(Vector2i(201, 5), source_id, Vector2i(0, 0));
+		CHECK_EQ(layer->get_cell_source_id(Vector2i(200, 5)), TileSet::INVALID_SOURCE);
+		CHECK_EQ(layer->get_cell_atlas_coords(Vector2i(201, 5)), Vector2i(0, 0));
+		CHECK_EQ(layer->get_cell_atlas_coords(Vector2i(203, 5)), Vector2i(1, 0));
+
+		// Unloaded by the next update, then loaded again with the changes.
+		layer->flush_streaming();
+		CHECK_EQ(layer->get_cell_source_id(Vector2i(203, 5)), TileSet::INVALID_SOURCE);
+		layer->set_streaming_focus_points({ layer->map_to_local(Vector2i(200, 5)) });
+		layer->flush_streaming();
+		CHECK_EQ(layer->get_cell_source_id(Vector2i(200, 5)), TileSet::INVALID_SOURCE);
+		CHECK_EQ(layer->get_cell_atlas_coords(Vector2i(201, 5)), Vector2i(0, 0));
+		CHECK_EQ(layer->get_cell_atlas_coords(Vector2i(203, 5)), Vector2i(1, 0));
+	}
+
+	layer->stop_streaming();
+	CHECK_FALSE(layer->is_streaming());
+
+	memdelete(layer);
+	DirAccess::remove_file_or_error(path);
+}
+
+TEST_CASE("[SceneTree][TileMapLayer] Cells that don't fit a streaming file") {
+	int source_id = TileSet::INVALID_SOURCE;
+	TileMapLayer *layer = memnew(TileMapLayer);
+	layer->set_tile_set(create_test_tile_set(source_id));
+
+	layer->set_cell(Vector2i(0, 0), source_id, Vector2i(-2, 0));
+	const String path = TestUtils::get_temp_path("tile_map_layer_streaming_invalid.rtms");
+	ERR_PRINT_OFF;
+	CHECK_EQ(layer->save_streaming_file(path, 16), ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+
+	memdelete(layer);
+}
+
+} // namespace TestTileMapLayer
+
+#endif // TEST_TILE_MAP_LAYER_H
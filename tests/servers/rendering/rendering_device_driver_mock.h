@@ -0,0 +1,431 @@
+/**************************************************************************/
+/*  display_server_mock.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RENDERING_DEVICE_DRIVER_MOCK_H
+#define RENDERING_DEVICE_DRIVER_MOCK_H
+
+#include "servers/rendering/rendering_device_driver.h"
+
+// Driver for unittests that doesn't talk to any graphics API. Objects are
+// handed out as unique opaque IDs and commands are discarded, but pipeline
+// barriers are counted so tests can check what was issued.
+class RenderingDeviceDriverMock : public RenderingDeviceDriver {
+	uint64_t id_counter = 0;
+	MultiviewCapabilities multiview_capabilities;
+	Capabilities capabilities;
+
+public:
+	uint32_t pipeline_barrier_count = 0;
+	uint32_t memory_barrier_count = 0;
+	uint32_t buffer_barrier_count = 0;
+	uint32_t texture_barrier_count = 0;
+
+	void reset_barrier_counts() {
+		pipeline_barrier_count = 0;
+		memory_barrier_count = 0;
+		buffer_barrier_count = 0;
+		texture_barrier_count = 0;
+	}
+
+	virtual Error initialize(uint32_t p_device_index, uint32_t p_frame_count) override {
+		return OK;
+	}
+
+	virtual BufferID buffer_create(uint64_t p_size, BitField<BufferUsageBits> p_usage, MemoryAllocationType p_allocation_type) override {
+		return BufferID(++id_counter);
+	}
+
+	virtual bool buffer_set_texel_format(BufferID p_buffer, DataFormat p_format) override {
+		return true;
+	}
+
+	virtual void buffer_free(BufferID p_buffer) override {}
+
+	virtual uint64_t buffer_get_allocation_size(BufferID p_buffer) override {
+		return 0;
+	}
+
+	virtual uint8_t *buffer_map(BufferID p_buffer) override {
+		return nullptr;
+	}
+
+	virtual void buffer_unmap(BufferID p_buffer) override {}
+
+	virtual uint64_t buffer_get_device_address(BufferID p_buffer) override {
+		return 0;
+	}
+
+	virtual TextureID texture_create(const TextureFormat &p_format, const TextureView &p_view) override {
+		return TextureID(++id_counter);
+	}
+
+	virtual TextureID texture_create_from_extension(uint64_t p_native_texture, TextureType p_type, DataFormat p_format, uint32_t p_array_layers, bool p_depth_stencil) override {
+		return TextureID(++id_counter);
+	}
+
+	virtual TextureID texture_create_shared(TextureID p_original_texture, const TextureView &p_view) override {
+		return TextureID(++id_counter);
+	}
+
+	virtual TextureID texture_create_shared_from_slice(TextureID p_original_texture, const TextureView &p_view, TextureSliceType p_slice_type, uint32_t p_layer, uint32_t p_layers, uint32_t p_mipmap, uint32_t p_mipmaps) override {
+		return TextureID(++id_counter);
+	}
+
+	virtual void texture_free(TextureID p_texture) override {}
+
+	virtual uint64_t texture_get_allocation_size(TextureID p_texture) override {
+		return 0;
+	}
+
+	virtual void texture_get_copyable_layout(TextureID p_texture, const TextureSubresource &p_subresource, TextureCopyableLayout *r_layout) override {
+		*r_layout = TextureCopyableLayout();
+	}
+
+	virtual uint8_t *texture_map(TextureID p_texture, const TextureSubresource &p_subresource) override {
+		return nullptr;
+	}
+
+	virtual void texture_unmap(TextureID p_texture) override {}
+
+	virtual BitField<TextureUsageBits> texture_get_usages_supported_by_format(DataFormat p_format, bool p_cpu_readable) override {
+		return BitField<TextureUsageBits>();
+	}
+
+	virtual bool texture_can_make_shared_with_format(TextureID p_texture, DataFormat p_format, bool &r_raw_reinterpretation) override {
+		return true;
+	}
+
+	virtual SamplerID sampler_create(const SamplerState &p_state) override {
+		return SamplerID(++id_counter);
+	}
+
+	virtual void sampler_free(SamplerID p_sampler) override {}
+
+	virtual bool sampler_is_format_supported_for_filter(DataFormat p_format, SamplerFilter p_filter) override {
+		return true;
+	}
+
+	virtual VertexFormatID vertex_format_create(VectorView<VertexAttribute> p_vertex_attribs) override {
+		return VertexFormatID(++id_counter);
+	}
+
+	virtual void vertex_format_free(VertexFormatID p_vertex_format) override {}
+
+	virtual void command_pipeline_barrier(CommandBufferID p_cmd_buffer, BitField<PipelineStageBits> p_src_stages, BitField<PipelineStageBits> p_dst_stages, VectorView<MemoryBarrier> p_memory_barriers, VectorView<BufferBarrier> p_buffer_barriers, VectorView<TextureBarrier> p_texture_barriers) override {
+		pipeline_barrier_count++;
+		memory_barrier_count += p_memory_barriers.size();
+		buffer_barrier_count += p_buffer_barriers.size();
+		texture_barrier_count += p_texture_barriers.size();
+	}
+
+	virtual FenceID fence_create() override {
+		return FenceID(++id_counter);
+	}
+
+	virtual Error fence_wait(FenceID p_fence) override {
+		return OK;
+	}
+
+	virtual void fence_free(FenceID p_fence) override {}
+
+	virtual SemaphoreID semaphore_create() override {
+		return SemaphoreID(++id_counter);
+	}
+
+	virtual void semaphore_free(SemaphoreID p_semaphore) override {}
+
+	virtual CommandQueueFamilyID command_queue_family_get(BitField<CommandQueueFamilyBits> p_cmd_queue_family_bits, RenderingContextDriver::SurfaceID p_surface) override {
+		return CommandQueueFamilyID(++id_counter);
+	}
+
+	virtual CommandQueueID command_queue_create(CommandQueueFamilyID p_cmd_queue_family, bool p_identify_as_main_queue) override {
+		return CommandQueueID(++id_counter);
+	}
+
+	virtual Error command_queue_execute_and_present(CommandQueueID p_cmd_queue, VectorView<SemaphoreID> p_wait_semaphores, VectorView<CommandBufferID> p_cmd_buffers, VectorView<SemaphoreID> p_cmd_semaphores, FenceID p_cmd_fence, VectorView<SwapChainID> p_swap_chains) override {
+		return OK;
+	}
+
+	virtual void command_queue_free(CommandQueueID p_cmd_queue) override {}
+
+	virtual CommandPoolID command_pool_create(CommandQueueFamilyID p_cmd_queue_family, CommandBufferType p_cmd_buffer_type) override {
+		return CommandPoolID(++id_counter);
+	}
+
+	virtual bool command_pool_reset(CommandPoolID p_cmd_pool) override {
+		return true;
+	}
+
+	virtual void command_pool_free(CommandPoolID p_cmd_pool) override {}
+
+	virtual CommandBufferID command_buffer_create(CommandPoolID p_cmd_pool) override {
+		return CommandBufferID(++id_counter);
+	}
+
+	virtual bool command_buffer_begin(CommandBufferID p_cmd_buffer) override {
+		return true;
+	}
+
+	virtual bool command_buffer_begin_secondary(CommandBufferID p_cmd_buffer, RenderPassID p_render_pass, uint32_t p_subpass, FramebufferID p_framebuffer) override {
+		return true;
+	}
+
+	virtual void command_buffer_end(CommandBufferID p_cmd_buffer) override {}
+
+	virtual void command_buffer_execute_secondary(CommandBufferID p_cmd_buffer, VectorView<CommandBufferID> p_secondary_cmd_buffers) override {}
+
+	virtual SwapChainID swap_chain_create(RenderingContextDriver::SurfaceID p_surface) override {
+		return SwapChainID(++id_counter);
+	}
+
+	virtual Error swap_chain_resize(CommandQueueID p_cmd_queue, SwapChainID p_swap_chain, uint32_t p_desired_framebuffer_count) override {
+		return OK;
+	}
+
+	virtual FramebufferID swap_chain_acquire_framebuffer(CommandQueueID p_cmd_queue, SwapChainID p_swap_chain, bool &r_resize_required) override {
+		return FramebufferID(++id_counter);
+	}
+
+	virtual RenderPassID swap_chain_get_render_pass(SwapChainID p_swap_chain) override {
+		return RenderPassID(++id_counter);
+	}
+
+	virtual DataFormat swap_chain_get_format(SwapChainID p_swap_chain) override {
+		return DATA_FORMAT_R8G8B8A8_UNORM;
+	}
+
+	virtual void swap_chain_free(SwapChainID p_swap_chain) override {}
+
+	virtual FramebufferID framebuffer_create(RenderPassID p_render_pass, VectorView<TextureID> p_attachments, uint32_t p_width, uint32_t p_height) override {
+		return FramebufferID(++id_counter);
+	}
+
+	virtual void framebuffer_free(FramebufferID p_framebuffer) override {}
+
+	virtual String shader_get_binary_cache_key() override {
+		return String();
+	}
+
+	virtual Vector<uint8_t> shader_compile_binary_from_spirv(VectorView<ShaderStageSPIRVData> p_spirv, const String &p_shader_name) override {
+		return Vector<uint8_t>();
+	}
+
+	virtual ShaderID shader_create_from_bytecode(const Vector<uint8_t> &p_shader_binary, ShaderDescription &r_shader_desc, String &r_name, const Vector<ImmutableSampler> &p_immutable_samplers) override {
+		return ShaderID(++id_counter);
+	}
+
+	virtual void shader_free(ShaderID p_shader) override {}
+
+	virtual void shader_destroy_modules(ShaderID p_shader) override {}
+
+	virtual UniformSetID uniform_set_create(VectorView<BoundUniform> p_uniforms, ShaderID p_shader, uint32_t p_set_index, int p_linear_pool_index) override {
+		return UniformSetID(++id_counter);
+	}
+
+	virtual void uniform_set_free(UniformSetID p_uniform_set) override {}
+
+	virtual void command_uniform_set_prepare_for_use(CommandBufferID p_cmd_buffer, UniformSetID p_uniform_set, ShaderID p_shader, uint32_t p_set_index) override {}
+
+	virtual void command_clear_buffer(CommandBufferID p_cmd_buffer, BufferID p_buffer, uint64_t p_offset, uint64_t p_size) override {}
+
+	virtual void command_copy_buffer(CommandBufferID p_cmd_buffer, BufferID p_src_buffer, BufferID p_dst_buffer, VectorView<BufferCopyRegion> p_regions) override {}
+
+	virtual void command_copy_texture(CommandBufferID p_cmd_buffer, TextureID p_src_texture, TextureLayout p_src_texture_layout, TextureID p_dst_texture, TextureLayout p_dst_texture_layout, VectorView<TextureCopyRegion> p_regions) override {}
+
+	virtual void command_resolve_texture(CommandBufferID p_cmd_buffer, TextureID p_src_texture, TextureLayout p_src_texture_layout, uint32_t p_src_layer, uint32_t p_src_mipmap, TextureID p_dst_texture, TextureLayout p_dst_texture_layout, uint32_t p_dst_layer, uint32_t p_dst_mipmap) override {}
+
+	virtual void command_clear_color_texture(CommandBufferID p_cmd_buffer, TextureID p_texture, TextureLayout p_texture_layout, const Color &p_color, const TextureSubresourceRange &p_subresources) override {}
+
+	virtual void command_copy_buffer_to_texture(CommandBufferID p_cmd_buffer, BufferID p_src_buffer, TextureID p_dst_texture, TextureLayout p_dst_texture_layout, VectorView<BufferTextureCopyRegion> p_regions) override {}
+
+	virtual void command_copy_texture_to_buffer(CommandBufferID p_cmd_buffer, TextureID p_src_texture, TextureLayout p_src_texture_layout, BufferID p_dst_buffer, VectorView<BufferTextureCopyRegion> p_regions) override {}
+
+	virtual void pipeline_free(PipelineID p_pipeline) override {}
+
+	virtual void command_bind_push_constants(CommandBufferID p_cmd_buffer, ShaderID p_shader, uint32_t p_first_index, VectorView<uint32_t> p_data) override {}
+
+	virtual bool pipeline_cache_create(const Vector<uint8_t> &p_data) override {
+		return true;
+	}
+
+	virtual void pipeline_cache_free() override {}
+
+	virtual size_t pipeline_cache_query_size() override {
+		return 0;
+	}
+
+	virtual Vector<uint8_t> pipeline_cache_serialize() override {
+		return Vector<uint8_t>();
+	}
+
+	virtual RenderPassID render_pass_create(VectorView<Attachment> p_attachments, VectorView<Subpass> p_subpasses, VectorView<SubpassDependency> p_subpass_dependencies, uint32_t p_view_count) override {
+		return RenderPassID(++id_counter);
+	}
+
+	virtual void render_pass_free(RenderPassID p_render_pass) override {}
+
+	virtual void command_begin_render_pass(CommandBufferID p_cmd_buffer, RenderPassID p_render_pass, FramebufferID p_framebuffer, CommandBufferType p_cmd_buffer_type, const Rect2i &p_rect, VectorView<RenderPassClearValue> p_clear_values) override {}
+
+	virtual void command_end_render_pass(CommandBufferID p_cmd_buffer) override {}
+
+	virtual void command_next_render_subpass(CommandBufferID p_cmd_buffer, CommandBufferType p_cmd_buffer_type) override {}
+
+	virtual void command_render_set_viewport(CommandBufferID p_cmd_buffer, VectorView<Rect2i> p_viewports) override {}
+
+	virtual void command_render_set_scissor(CommandBufferID p_cmd_buffer, VectorView<Rect2i> p_scissors) override {}
+
+	virtual void command_render_clear_attachments(CommandBufferID p_cmd_buffer, VectorView<AttachmentClear> p_attachment_clears, VectorView<Rect2i> p_rects) override {}
+
+	virtual void command_bind_render_pipeline(CommandBufferID p_cmd_buffer, PipelineID p_pipeline) override {}
+
+	virtual void command_bind_render_uniform_set(CommandBufferID p_cmd_buffer, UniformSetID p_uniform_set, ShaderID p_shader, uint32_t p_set_index) override {}
+
+	virtual void command_bind_render_uniform_sets(CommandBufferID p_cmd_buffer, VectorView<UniformSetID> p_uniform_sets, ShaderID p_shader, uint32_t p_first_set_index, uint32_t p_set_count) override {}
+
+	virtual void command_render_draw(CommandBufferID p_cmd_buffer, uint32_t p_vertex_count, uint32_t p_instance_count, uint32_t p_base_vertex, uint32_t p_first_instance) override {}
+
+	virtual void command_render_draw_indexed(CommandBufferID p_cmd_buffer, uint32_t p_index_count, uint32_t p_instance_count, uint32_t p_first_index, int32_t p_vertex_offset, uint32_t p_first_instance) override {}
+
+	virtual void command_render_draw_indexed_indirect(CommandBufferID p_cmd_buffer, BufferID p_indirect_buffer, uint64_t p_offset, uint32_t p_draw_count, uint32_t p_stride) override {}
+
+	virtual void command_render_draw_indexed_indirect_count(CommandBufferID p_cmd_buffer, BufferID p_indirect_buffer, uint64_t p_offset, BufferID p_count_buffer, uint64_t p_count_buffer_offset, uint32_t p_max_draw_count, uint32_t p_stride) override {}
+
+	virtual void command_render_draw_indirect(CommandBufferID p_cmd_buffer, BufferID p_indirect_buffer, uint64_t p_offset, uint32_t p_draw_count, uint32_t p_stride) override {}
+
+	virtual void command_render_draw_indirect_count(CommandBufferID p_cmd_buffer, BufferID p_indirect_buffer, uint64_t p_offset, BufferID p_count_buffer, uint64_t p_count_buffer_offset, uint32_t p_max_draw_count, uint32_t p_stride) override {}
+
+	virtual void command_render_bind_vertex_buffers(CommandBufferID p_cmd_buffer, uint32_t p_binding_count, const BufferID *p_buffers, const uint64_t *p_offsets) override {}
+
+	virtual void command_render_bind_index_buffer(CommandBufferID p_cmd_buffer, BufferID p_buffer, IndexBufferFormat p_format, uint64_t p_offset) override {}
+
+	virtual void command_render_set_blend_constants(CommandBufferID p_cmd_buffer, const Color &p_constants) override {}
+
+	virtual void command_render_set_line_width(CommandBufferID p_cmd_buffer, float p_width) override {}
+
+	virtual PipelineID render_pipeline_create(ShaderID p_shader, VertexFormatID p_vertex_format, RenderPrimitive p_render_primitive, PipelineRasterizationState p_rasterization_state, PipelineMultisampleState p_multisample_state, PipelineDepthStencilState p_depth_stencil_state, PipelineColorBlendState p_blend_state, VectorView<int32_t> p_color_attachments, BitField<PipelineDynamicStateFlags> p_dynamic_state, RenderPassID p_render_pass, uint32_t p_render_subpass, VectorView<PipelineSpecializationConstant> p_specialization_constants) override {
+		return PipelineID(++id_counter);
+	}
+
+	virtual void command_bind_compute_pipeline(CommandBufferID p_cmd_buffer, PipelineID p_pipeline) override {}
+
+	virtual void command_bind_compute_uniform_set(CommandBufferID p_cmd_buffer, UniformSetID p_uniform_set, ShaderID p_shader, uint32_t p_set_index) override {}
+
+	virtual void command_bind_compute_uniform_sets(CommandBufferID p_cmd_buffer, VectorView<UniformSetID> p_uniform_sets, ShaderID p_shader, uint32_t p_first_set_index, uint32_t p_set_count) override {}
+
+	virtual void command_compute_dispatch(CommandBufferID p_cmd_buffer, uint32_t p_x_groups, uint32_t p_y_groups, uint32_t p_z_groups) override {}
+
+	virtual void command_compute_dispatch_indirect(CommandBufferID p_cmd_buffer, BufferID p_indirect_buffer, uint64_t p_offset) override {}
+
+	virtual PipelineID compute_pipeline_create(ShaderID p_shader, VectorView<PipelineSpecializationConstant> p_specialization_constants) override {
+		return PipelineID(++id_counter);
+	}
+
+	virtual QueryPoolID timestamp_query_pool_create(uint32_t p_query_count) override {
+		return QueryPoolID(++id_counter);
+	}
+
+	virtual void timestamp_query_pool_free(QueryPoolID p_pool_id) override {}
+
+	virtual void timestamp_query_pool_get_results(QueryPoolID p_pool_id, uint32_t p_query_count, uint64_t *r_results) override {}
+
+	virtual uint64_t timestamp_query_result_to_time(uint64_t p_result) override {
+		return 0;
+	}
+
+	virtual void command_timestamp_query_pool_reset(CommandBufferID p_cmd_buffer, QueryPoolID p_pool_id, uint32_t p_query_count) override {}
+
+	virtual void command_timestamp_write(CommandBufferID p_cmd_buffer, QueryPoolID p_pool_id, uint32_t p_index) override {}
+
+	virtual void command_begin_label(CommandBufferID p_cmd_buffer, const char *p_label_name, const Color &p_color) override {}
+
+	virtual void command_end_label(CommandBufferID p_cmd_buffer) override {}
+
+	virtual void command_insert_breadcrumb(CommandBufferID p_cmd_buffer, uint32_t p_data) override {}
+
+	virtual void begin_segment(uint32_t p_frame_index, uint32_t p_frames_drawn) override {}
+
+	virtual void end_segment() override {}
+
+	virtual void set_object_name(ObjectType p_type, ID p_driver_id, const String &p_name) override {}
+
+	virtual uint64_t get_resource_native_handle(DriverResource p_type, ID p_driver_id) override {
+		return 0;
+	}
+
+	virtual uint64_t get_total_memory_used() override {
+		return 0;
+	}
+
+	virtual uint64_t get_lazily_memory_used() override {
+		return 0;
+	}
+
+	virtual uint64_t limit_get(Limit p_limit) override {
+		return 0;
+	}
+
+	virtual bool has_feature(Features p_feature) override {
+		return true;
+	}
+
+	virtual const MultiviewCapabilities &get_multiview_capabilities() override {
+		return multiview_capabilities;
+	}
+
+	virtual String get_api_name() const override {
+		return String();
+	}
+
+	virtual String get_api_version() const override {
+		return String();
+	}
+
+	virtual String get_pipeline_cache_uuid() const override {
+		return String();
+	}
+
+	virtual const Capabilities &get_capabilities() const override {
+		return capabilities;
+	}
+
+	virtual uint64_t api_trait_get(ApiTrait p_trait) override {
+		switch (p_trait) {
+			case API_TRAIT_HONORS_PIPELINE_BARRIERS:
+			case API_TRAIT_CLEARS_WITH_COPY_ENGINE:
+				return true;
+			default:
+				return RenderingDeviceDriver::api_trait_get(p_trait);
+		}
+	}
+};
+
+#endif // RENDERING_DEVICE_DRIVER_MOCK_H
@@ -0,0 +1,217 @@
+/**************************************************************************/
+/*  test_pipeline_manifest_rd.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PIPELINE_MANIFEST_RD_H
+#define TEST_PIPELINE_MANIFEST_RD_H
+
+#include "core/io/file_access.h"
+#include "servers/rendering/renderer_rd/pipeline_manifest_rd.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestPipelineManifestRD {
+
+static PipelineManifestRD::Entry make_entry(uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	PipelineManifestRD::Entry entry;
+	entry.has_vertex_format = true;
+	RD::VertexAttribute attribute;
+	attribute.location = 0;
+	attribute.format = RD::DATA_FORMAT_R32G32B32_SFLOAT;
+	attribute.stride = 12;
+	entry.vertex_attributes.push_back(attribute);
+	attribute.location = 1;
+	attribute.format = RD::DATA_FORMAT_R16G16_UNORM;
+	attribute.stride = 4;
+	entry.vertex_attributes.push_back(attribute);
+
+	RD::AttachmentFormat color;
+	color.format = RD::DATA_FORMAT_R16G16B16A16_SFLOAT;
+	color.usage_flags = RD::TEXTURE_USAGE_COLOR_ATTACHMENT_BIT;
+	entry.attachments.push_back(color);
+	RD::AttachmentFormat depth;
+	depth.format = RD::DATA_FORMAT_D32_SFLOAT;
+	depth.usage_flags = RD::TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+	entry.attachments.push_back(depth);
+
+	RD::FramebufferPass pass;
+	pass.color_attachments.push_back(0);
+	pass.depth_attachment = 1;
+	entry.passes.push_back(pass);
+
+	entry.render_pass = p_render_pass;
+	entry.bool_specializations = p_bool_specializations;
+	return entry;
+}
+
+TEST_CASE("[PipelineManifestRD] Variants are recorded once per key") {
+	PipelineManifestRD manifest;
+	CHECK_FALSE(manifest.is_dirty());
+
+	manifest.record(1, make_entry(0, 0));
+	manifest.record(1, make_entry(0, 0));
+	manifest.record(1, make_entry(0, 5));
+	manifest.record(2, make_entry(0, 0));
+	CHECK(manifest.is_dirty());
+	CHECK(manifest.get_entry_count() == 3);
+	CHECK(manifest.get_entries(1).size() == 2);
+	CHECK(manifest.get_entries(2).size() == 1);
+	CHECK(manifest.get_entries(3).is_empty());
+
+	PipelineManifestRD::Entry wireframe = make_entry(0, 0);
+	wireframe.wireframe = true;
+	CHECK_FALSE(wireframe == make_entry(0, 0));
+	CHECK(wireframe.hash() != make_entry(0, 0).hash());
+	manifest.record(2, wireframe);
+	CHECK(manifest.get_entries(2).size() == 2);
+
+	manifest.clear();
+	CHECK(manifest.get_entry_count() == 0);
+	CHECK_FALSE(manifest.is_dirty());
+}
+
+TEST_CASE("[PipelineManifestRD] Save and load round trip") {
+	const String path = TestUtils::get_temp_path("pipeline_manifest.bin");
+
+	PipelineManifestRD::Entry empty_framebuffer;
+	empty_framebuffer.passes.push_back(RD::FramebufferPass());
+	empty_framebuffer.samples = RD::TEXTURE_SAMPLES_4;
+
+	{
+		PipelineManifestRD manifest;
+		manifest.record(0x1234567890abcdefULL, make_entry(0, 0));
+		manifest.record(0x1234567890abcdefULL, make_entry(1, 3));
+		manifest.record(42, empty_framebuffer);
+		REQUIRE(manifest.save(path) == OK);
+		CHECK_FALSE(manifest.is_dirty());
+	}
+
+	PipelineManifestRD manifest;
+	REQUIRE(manifest.load(path) == OK);
+	CHECK_FALSE(manifest.is_dirty());
+	CHECK(manifest.get_entry_count() == 3);
+
+	Vector<PipelineManifestRD::Entry> entries = manifest.get_entries(0x1234567890abcdefULL);
+	REQUIRE(entries.size() == 2);
+	CHECK(entries[0] == make_entry(0, 0));
+	CHECK(entries[1] == make_entry(1, 3));
+
+	entries = manifest.get_entries(42);
+	REQUIRE(entries.size() == 1);
+	CHECK(entries[0] == empty_framebuffer);
+	CHECK_FALSE(entries[0].has_vertex_format);
+	CHECK(entries[0].samples == RD::TEXTURE_SAMPLES_4);
+
+	// Loading a variant that is already known doesn't need a save.
+	manifest.record(42, empty_framebuffer);
+	CHECK_FALSE(manifest.is_dirty());
+}
+
+TEST_CASE("[PipelineManifestRD] Keys unused for too many sessions are pruned") {
+	const String path = TestUtils::get_temp_path("pipeline_manifest_pruned.bin");
+	{
+		PipelineManifestRD manifest;
+		manifest.record(1, make_entry(0, 0));
+		manifest.record(2, make_entry(0, 0));
+		REQUIRE(manifest.save(path) == OK);
+	}
+
+	// Each session only uses key 1, as if the shader behind key 2 was edited.
+	for (uint32_t i = 0; i < PipelineManifestRD::MAX_UNUSED_SESSIONS; i++) {
+		PipelineManifestRD manifest;
+		REQUIRE(manifest.load(path) == OK);
+		CHECK(manifest.get_entries(1).size() == 1);
+		REQUIRE(manifest.save(path) == OK);
+	}
+
+	{
+		PipelineManifestRD manifest;
+		REQUIRE(manifest.load(path) == OK);
+		CHECK(manifest.get_entry_count() == 2);
+		CHECK(manifest.get_entries(1).size() == 1);
+		REQUIRE(manifest.save(path) == OK);
+		CHECK(manifest.get_entry_count() == 1);
+	}
+
+	PipelineManifestRD manifest;
+	REQUIRE(manifest.load(path) == OK);
+	CHECK(manifest.get_entry_count() == 1);
+	CHECK(manifest.get_entries(1).size() == 1);
+	CHECK(manifest.get_entries(2).is_empty());
+}
+
+TEST_CASE("[PipelineManifestRD] Keys used again stay in the manifest") {
+	const String path = TestUtils::get_temp_path("pipeline_manifest_reused.bin");
+	{
+		PipelineManifestRD manifest;
+		manifest.record(1, make_entry(0, 0));
+		REQUIRE(manifest.save(path) == OK);
+	}
+
+	for (uint32_t i = 0; i < PipelineManifestRD::MAX_UNUSED_SESSIONS * 2; i++) {
+		PipelineManifestRD manifest;
+		REQUIRE(manifest.load(path) == OK);
+		if (i == PipelineManifestRD::MAX_UNUSED_SESSIONS - 1) {
+			// Looking the key up resets its age.
+			CHECK(manifest.get_entries(1).size() == 1);
+		}
+		REQUIRE(manifest.save(path) == OK);
+	}
+
+	PipelineManifestRD manifest;
+	REQUIRE(manifest.load(path) == OK);
+	CHECK(manifest.get_entry_count() == 1);
+}
+
+TEST_CASE("[PipelineManifestRD] Invalid files are rejected") {
+	const String path = TestUtils::get_temp_path("pipeline_manifest_invalid.bin");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("not a manifest");
+	}
+
+	PipelineManifestRD manifest;
+	manifest.record(1, make_entry(0, 0));
+
+	ERR_PRINT_OFF;
+	CHECK(manifest.load(path) != OK);
+	CHECK(manifest.load(TestUtils::get_temp_path("pipeline_manifest_missing.bin")) != OK);
+	ERR_PRINT_ON;
+
+	// A failed load keeps what was recorded.
+	CHECK(manifest.get_entry_count() == 1);
+}
+
+} // namespace TestPipelineManifestRD
+
+#endif // TEST_PIPELINE_MANIFEST_RD_H
@@ -0,0 +1,194 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_CULL_H
+#define TEST_RENDERER_SCENE_CULL_H
+
+#include "core/math/random_number_generator.h"
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+static RendererSceneCull::Frustum make_frustum() {
+	Projection projection;
+	projection.set_perspective(75.0, 16.0 / 9.0, 0.05, 500.0);
+	Transform3D camera_transform;
+	camera_transform.origin = Vector3(0, 2, 10);
+	return RendererSceneCull::Frustum(projection.get_projection_planes(camera_transform));
+}
+
+static AABB make_random_aabb(RandomNumberGenerator &p_rng) {
+	Vector3 position(p_rng.randf_range(-600, 600), p_rng.randf_range(-50, 50), p_rng.randf_range(-600, 600));
+	Vector3 size(p_rng.randf_range(0.1, 20), p_rng.randf_range(0.1, 20), p_rng.randf_range(0.1, 20));
+	return AABB(position, size);
+}
+
+TEST_CASE("[RendererSceneCull] Frustum test of bounds blocks matches the per instance test") {
+	RendererSceneCull::Frustum frustum = make_frustum();
+
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(1234);
+
+	uint32_t inside_count = 0;
+	for (uint32_t i = 0; i < 1024; i++) {
+		RendererSceneCull::InstanceBounds bounds[RendererSceneCull::InstanceBoundsBlock::SIZE];
+		RendererSceneCull::InstanceBoundsBlock block;
+		uint32_t expected_mask = 0;
+		for (uint32_t j = 0; j < RendererSceneCull::InstanceBoundsBlock::SIZE; j++) {
+			bounds[j] = RendererSceneCull::InstanceBounds(make_random_aabb(**rng));
+			block.set(j, bounds[j]);
+			if (bounds[j].in_frustum(frustum)) {
+				expected_mask |= 1 << j;
+				inside_count++;
+			}
+		}
+		CHECK(block.in_frustum_mask(frustum) == expected_mask);
+	}
+
+	// Make sure both outcomes were exercised.
+	CHECK(inside_count > 0);
+	CHECK(inside_count < 1024 * RendererSceneCull::InstanceBoundsBlock::SIZE);
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull] Bounds blocks stay in sync with instance bounds") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+
+	RID scenario = rs->scenario_create();
+	RID mesh = rs->mesh_create();
+	Vector<RID> instances;
+	for (int i = 0; i < 11; i++) {
+		RID instance = rs->instance_create2(mesh, scenario);
+		rs->instance_set_custom_aabb(instance, AABB(Vector3(i, 0, 0), Vector3(1, 1, 1)));
+		instances.push_back(instance);
+	}
+	scene_cull->update_dirty_instances();
+
+	// Remove from the middle and the end so swapping with the last instance is covered.
+	rs->free(instances[3]);
+	rs->free(instances[10]);
+	rs->free(instances[0]);
+
+	const RendererSceneCull::Scenario *s = scene_cull->scenario_owner.get_or_null(scenario);
+	REQUIRE(s != nullptr);
+	CHECK(s->instance_aabbs.size() == 8);
+	CHECK(s->instance_aabb_blocks.size() == 2);
+	for (uint64_t i = 0; i < s->instance_aabbs.size(); i++) {
+		const RendererSceneCull::InstanceBoundsBlock &block = s->instance_aabb_blocks[i >> RendererSceneCull::InstanceBoundsBlock::SHIFT];
+		for (int j = 0; j < 6; j++) {
+			CHECK(block.bounds[j][i & RendererSceneCull::InstanceBoundsBlock::MASK] == s->instance_aabbs[i].bounds[j]);
+		}
+	}
+
+	for (int i = 1; i < 10; i++) {
+		if (i != 3) {
+			rs->free(instances[i]);
+		}
+	}
+	CHECK(s->instance_aabbs.size() == 0);
+	CHECK(s->instance_aabb_blocks.size() == 0);
+
+	rs->free(mesh);
+	rs->free(scenario);
+}
+
+// Frustum culls a scenario of one million instances created through the dummy
+// renderer, comparing the per instance test with the bounds blocks used by
+// RendererSceneCull::_scene_cull().
+TEST_CASE_BENCHMARK("[SceneTree][RendererSceneCull][Benchmark] Frustum cull 1M instances") {
+	// A multiple of the block size, so the last block has no unused lanes.
+	const uint32_t instance_count = 1000000;
+	const uint32_t iterations = 20;
+
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(1234);
+
+	RID scenario = rs->scenario_create();
+	RID mesh = rs->mesh_create();
+	LocalVector<RID> instances;
+	instances.reserve(instance_count);
+	for (uint32_t i = 0; i < instance_count; i++) {
+		RID instance = rs->instance_create2(mesh, scenario);
+		rs->instance_set_custom_aabb(instance, make_random_aabb(**rng));
+		instances.push_back(instance);
+	}
+	scene_cull->update_dirty_instances();
+
+	const RendererSceneCull::Scenario *s = scene_cull->scenario_owner.get_or_null(scenario);
+	REQUIRE(s != nullptr);
+	REQUIRE(s->instance_aabbs.size() == instance_count);
+	RendererSceneCull::Frustum frustum = make_frustum();
+
+	uint64_t per_instance_visible = 0;
+	uint64_t begin_ticks = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < iterations; i++) {
+		for (uint64_t j = 0; j < s->instance_aabbs.size(); j++) {
+			per_instance_visible += s->instance_aabbs[j].in_frustum(frustum);
+		}
+	}
+	uint64_t per_instance_usec = OS::get_singleton()->get_ticks_usec() - begin_ticks;
+
+	uint64_t block_visible = 0;
+	begin_ticks = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < iterations; i++) {
+		for (uint64_t j = 0; j < s->instance_aabb_blocks.size(); j++) {
+			uint32_t mask = s->instance_aabb_blocks[j].in_frustum_mask(frustum);
+			for (uint32_t k = 0; k < RendererSceneCull::InstanceBoundsBlock::SIZE; k++) {
+				block_visible += (mask >> k) & 1;
+			}
+		}
+	}
+	uint64_t block_usec = OS::get_singleton()->get_ticks_usec() - begin_ticks;
+
+	CHECK(per_instance_visible == block_visible);
+	MESSAGE(vformat("%d instances, %d visible.", instance_count, per_instance_visible / iterations));
+	MESSAGE(vformat("Per instance: %.3f ms per cull.", per_instance_usec / 1000.0 / iterations));
+	MESSAGE(vformat("Blocks of %d: %.3f ms per cull.", RendererSceneCull::InstanceBoundsBlock::SIZE, block_usec / 1000.0 / iterations));
+
+	for (const RID &instance : instances) {
+		rs->free(instance);
+	}
+	rs->free(mesh);
+	rs->free(scenario);
+}
+
+} // namespace TestRendererSceneCull
+
+#endif // TEST_RENDERER_SCENE_CULL_H
@@ -0,0 +1,309 @@
+/**************************************************************************/
+/*  test_rendering_device_graph.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#ifndef TEST_RENDERING_DEVICE_GRAPH_H
+#define TEST_RENDERING_DEVICE_GRAPH_H
+
+#include "servers/rendering/rendering_device_graph.h"
+#include "servers/rendering/rendering_device_graph_capture.h"
+
+#include "tests/servers/rendering/rendering_device_driver_mock.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestRenderingDeviceGraph {
+
+RDD::RenderPassID render_pass_create(RenderingDeviceDriver *p_driver, VectorView<RDD::AttachmentLoadOp> p_load_ops, VectorView<RDD::AttachmentStoreOp> p_store_ops, void *p_user_data) {
+	return p_driver->render_pass_create(VectorView<RDD::Attachment>(), VectorView<RDD::Subpass>(), VectorView<RDD::SubpassDependency>(), 1);
+}
+
+// Graph running on top of the mock driver.
+struct MockGraph {
+	RenderingDeviceDriverMock driver;
+	RDG graph;
+	RDG::CommandBufferPool command_buffer_pool;
+	RDD::CommandBufferID command_buffer;
+
+	MockGraph() {
+		graph.initialize(&driver, RenderingContextDriver::Device(), &render_pass_create, 1, RDD::CommandQueueFamilyID(), 0);
+		command_buffer_pool.pool = driver.command_pool_create(RDD::CommandQueueFamilyID(), RDD::COMMAND_BUFFER_TYPE_PRIMARY);
+		command_buffer = driver.command_buffer_create(command_buffer_pool.pool);
+	}
+
+	void end() {
+		driver.reset_barrier_counts();
+		graph.end(true, false, command_buffer, command_buffer_pool);
+	}
+
+	~MockGraph() {
+		graph.finalize();
+	}
+};
+
+// Resources used by a frame which resembles the passes of a renderer: buffers
+// are updated, processed by compute, textures are rendered to and then copied.
+struct SyntheticScene {
+	LocalVector<RDG::ResourceTracker *> buffers;
+	LocalVector<RDG::ResourceTracker *> textures;
+	LocalVector<RDG::FramebufferCache *> framebuffer_caches;
+
+	SyntheticScene(uint32_t p_pass_count) {
+		uint64_t next_id = 1;
+		for (uint32_t i = 0; i < p_pass_count; i++) {
+			RDG::ResourceTracker *buffer = RDG::resource_tracker_create();
+			buffer->reference_count = 1;
+			buffer->buffer_driver_id = RDD::BufferID(next_id++);
+			buffers.push_back(buffer);
+
+			RDG::ResourceTracker *texture = RDG::resource_tracker_create();
+			texture->reference_count = 1;
+			texture->texture_driver_id = RDD::TextureID(next_id++);
+			texture->texture_size = Size2i(256, 256);
+			texture->texture_usage = RDD::TEXTURE_USAGE_COLOR_ATTACHMENT_BIT | RDD::TEXTURE_USAGE_STORAGE_BIT | RDD::TEXTURE_USAGE_CAN_COPY_FROM_BIT | RDD::TEXTURE_USAGE_CAN_COPY_TO_BIT;
+			texture->texture_subresources.aspect = RDD::TEXTURE_ASPECT_COLOR_BIT;
+			texture->texture_subresources.mipmap_count = 1;
+			texture->texture_subresources.layer_count = 1;
+			textures.push_back(texture);
+
+			RDG::FramebufferCache *framebuffer_cache = RDG::framebuffer_cache_create();
+			framebuffer_cache->width = 256;
+			framebuffer_cache->height = 256;
+			framebuffer_cache->textures.push_back(texture->texture_driver_id);
+			framebuffer_cache->trackers.push_back(texture);
+			framebuffer_caches.push_back(framebuffer_cache);
+		}
+	}
+
+	void record_frame(RDG &p_graph, uint32_t p_draws_per_pass) {
+		const uint32_t pass_count = buffers.size();
+		for (uint32_t i = 0; i < pass_count; i++) {
+			RDG::RecordedBufferCopy buffer_copy;
+			buffer_copy.source = RDD::BufferID(1000 + i);
+			buffer_copy.region.size = 64;
+			p_graph.add_buffer_update(buffers[i]->buffer_driver_id, buffers[i], buffer_copy);
+
+			p_graph.begin_label("Compute " + itos(i), Color(1, 0, 0));
+			p_graph.add_compute_list_begin();
+			p_graph.add_compute_list_bind_pipeline(RDD::PipelineID(2000));
+			p_graph.add_compute_list_usage(buffers[i], RDG::RESOURCE_USAGE_STORAGE_BUFFER_READ_WRITE);
+			p_graph.add_compute_list_usage(textures[i], RDG::RESOURCE_USAGE_STORAGE_IMAGE_READ_WRITE);
+			p_graph.add_compute_list_dispatch(8, 8, 1);
+			p_graph.add_compute_list_end();
+			p_graph.end_label();
+
+			RDD::RenderPassClearValue clear_value;
+			RDG::AttachmentOperation operation = RDG::ATTACHMENT_OPERATION_CLEAR;
+			p_graph.add_draw_list_begin(framebuffer_caches[i], Rect2i(0, 0, 256, 256), operation, clear_value, true, false);
+			p_graph.add_draw_list_usage(textures[i], RDG::RESOURCE_USAGE_ATTACHMENT_COLOR_READ_WRITE);
+			p_graph.add_draw_list_bind_pipeline(RDD::PipelineID(3000), RDD::PIPELINE_STAGE_VERTEX_SHADER_BIT | RDD::PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+			p_graph.add_draw_list_usage(buffers[i], RDG::RESOURCE_USAGE_VERTEX_BUFFER_READ);
+			for (uint32_t j = 0; j < p_draws_per_pass; j++) {
+				uint32_t push_constant = j;
+				p_graph.add_draw_list_set_push_constant(RDD::ShaderID(4000), &push_constant, sizeof(uint32_t));
+				p_graph.add_draw_list_draw(36, 1);
+			}
+
+			p_graph.add_draw_list_end();
+
+			if (i > 0) {
+				RDD::TextureCopyRegion copy_region;
+				copy_region.src_subresources.aspect = RDD::TEXTURE_ASPECT_COLOR_BIT;
+				copy_region.src_subresources.layer_count = 1;
+				copy_region.dst_subresources = copy_region.src_subresources;
+				copy_region.size = Vector3i(256, 256, 1);
+				p_graph.add_texture_copy(textures[i]->texture_driver_id, textures[i], textures[0]->texture_driver_id, textures[0], copy_region);
+			}
+		}
+
+		RDD::BufferCopyRegion readback_region;
+		readback_region.size = 64;
+		p_graph.add_buffer_get_data(buffers[0]->buffer_driver_id, buffers[0], RDD::BufferID(5000), readback_region);
+	}
+
+	void free(RDD *p_driver) {
+		for (RDG::FramebufferCache *framebuffer_cache : framebuffer_caches) {
+			RDG::framebuffer_cache_free(p_driver, framebuffer_cache);
+		}
+
+		for (RDG::ResourceTracker *tracker : buffers) {
+			RDG::resource_tracker_free(tracker);
+		}
+
+		for (RDG::ResourceTracker *tracker : textures) {
+			RDG::resource_tracker_free(tracker);
+		}
+
+		framebuffer_caches.clear();
+		buffers.clear();
+		textures.clear();
+	}
+};
+
+struct FrameResult {
+	RDG::Statistics statistics;
+	uint32_t pipeline_barrier_count = 0;
+	uint32_t texture_barrier_count = 0;
+	uint32_t buffer_barrier_count = 0;
+	uint32_t memory_barrier_count = 0;
+};
+
+FrameResult get_frame_result(const MockGraph &p_mock) {
+	FrameResult result;
+	result.statistics = p_mock.graph.get_statistics();
+	result.pipeline_barrier_count = p_mock.driver.pipeline_barrier_count;
+	result.texture_barrier_count = p_mock.driver.texture_barrier_count;
+	result.buffer_barrier_count = p_mock.driver.buffer_barrier_count;
+	result.memory_barrier_count = p_mock.driver.memory_barrier_count;
+	return result;
+}
+
+TEST_CASE("[RenderingDeviceGraph] Capture round trip") {
+	const String capture_path = TestUtils::get_temp_path("rendering_device_graph.rdgc");
+	const uint32_t frame_count = 3;
+
+	LocalVector<FrameResult> captured_results;
+	{
+		MockGraph mock;
+		SyntheticScene scene(4);
+		RenderingDeviceGraphCapture capture;
+		REQUIRE(capture.open(capture_path) == OK);
+		mock.graph.set_capture(&capture);
+		for (uint32_t i = 0; i < frame_count; i++) {
+			mock.graph.begin();
+			scene.record_frame(mock.graph, 16);
+			mock.end();
+			captured_results.push_back(get_frame_result(mock));
+		}
+
+		mock.graph.set_capture(nullptr);
+		CHECK(capture.get_frames_captured() == frame_count);
+		capture.close();
+		scene.free(&mock.driver);
+	}
+
+	CHECK_MESSAGE(captured_results[0].statistics.command_count > 0, "The synthetic frame should record commands.");
+	CHECK_MESSAGE(captured_results[0].pipeline_barrier_count > 0, "The synthetic frame should require barriers.");
+
+	MockGraph mock;
+	RenderingDeviceGraphReplay replay;
+	REQUIRE(replay.load(capture_path) == OK);
+	REQUIRE(replay.get_frame_count() == frame_count);
+	for (uint32_t i = 0; i < frame_count; i++) {
+		mock.graph.begin();
+		CHECK(replay.replay_frame(i, mock.graph) == OK);
+		mock.end();
+
+		const FrameResult replayed = get_frame_result(mock);
+		const FrameResult &captured = captured_results[i];
+		CHECK(replayed.statistics.command_count == captured.statistics.command_count);
+		CHECK(replayed.statistics.level_count == captured.statistics.level_count);
+		CHECK(replayed.statistics.reordered_command_count == captured.statistics.reordered_command_count);
+		CHECK(replayed.statistics.barrier_group_count == captured.statistics.barrier_group_count);
+		CHECK(replayed.statistics.texture_barrier_count == captured.statistics.texture_barrier_count);
+		CHECK(replayed.pipeline_barrier_count == captured.pipeline_barrier_count);
+		CHECK(replayed.texture_barrier_count == captured.texture_barrier_count);
+		CHECK(replayed.buffer_barrier_count == captured.buffer_barrier_count);
+		CHECK(replayed.memory_barrier_count == captured.memory_barrier_count);
+	}
+
+	replay.clear(&mock.driver);
+}
+
+TEST_CASE("[RenderingDeviceGraph] Replay rejects invalid captures") {
+	const String capture_path = TestUtils::get_temp_path("rendering_device_graph_invalid.rdgc");
+	{
+		Ref<FileAccess> f = FileAccess::open(capture_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("not a capture");
+	}
+
+	RenderingDeviceGraphReplay replay;
+	ERR_PRINT_OFF;
+	CHECK(replay.load(capture_path) == ERR_FILE_UNRECOGNIZED);
+	ERR_PRINT_ON;
+	CHECK(replay.get_frame_count() == 0);
+}
+
+// Measures the CPU time spent by the graph sorting commands and generating
+// barriers. Set the RDG_CAPTURE environment variable to the path of a capture
+// recorded with `--rd-graph-capture` to benchmark a real project instead of
+// the synthetic frame.
+TEST_CASE_BENCHMARK("[RenderingDeviceGraph][Benchmark] Replay") {
+	String capture_path = OS::get_singleton()->get_environment("RDG_CAPTURE");
+	if (capture_path.is_empty()) {
+		capture_path = TestUtils::get_temp_path("rendering_device_graph_benchmark.rdgc");
+		MockGraph mock;
+		SyntheticScene scene(64);
+		RenderingDeviceGraphCapture capture;
+		REQUIRE(capture.open(capture_path) == OK);
+		mock.graph.set_capture(&capture);
+		mock.graph.begin();
+		scene.record_frame(mock.graph, 256);
+		mock.end();
+		mock.graph.set_capture(nullptr);
+		capture.close();
+		scene.free(&mock.driver);
+	}
+
+	MockGraph mock;
+	RenderingDeviceGraphReplay replay;
+	REQUIRE(replay.load(capture_path) == OK);
+	REQUIRE(replay.get_frame_count() > 0);
+
+	const uint32_t iterations = 100;
+	uint64_t record_usec = 0;
+	uint64_t end_usec = 0;
+	for (uint32_t i = 0; i < iterations; i++) {
+		for (uint32_t j = 0; j < replay.get_frame_count(); j++) {
+			uint64_t begin_ticks = OS::get_singleton()->get_ticks_usec();
+			mock.graph.begin();
+			replay.replay_frame(j, mock.graph);
+			uint64_t record_ticks = OS::get_singleton()->get_ticks_usec();
+			mock.end();
+			uint64_t end_ticks = OS::get_singleton()->get_ticks_usec();
+			record_usec += record_ticks - begin_ticks;
+			end_usec += end_ticks - record_ticks;
+		}
+	}
+
+	const RDG::Statistics &statistics = mock.graph.get_statistics();
+	const uint32_t frames = iterations * replay.get_frame_count();
+	MESSAGE(vformat("%d frames, %d commands and %d levels in the last frame.", frames, statistics.command_count, statistics.level_count));
+	MESSAGE(vformat("Recording: %.2f usec/frame, sorting and barriers: %.2f usec/frame.", double(record_usec) / frames, double(end_usec) / frames));
+
+	replay.clear(&mock.driver);
+}
+
+} // namespace TestRenderingDeviceGraph
+
+#endif // TEST_RENDERING_DEVICE_GRAPH_H
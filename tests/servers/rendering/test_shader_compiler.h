@@ -0,0 +1,337 @@
+/**************************************************************************/
+/*  test_shader_compiler.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SHADER_COMPILER_H
+#define TEST_SHADER_COMPILER_H
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "servers/rendering/shader_compiler.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+class TestShaderCompilerInternalsAccessor {
+public:
+	static String get_cache_key(const ShaderCompiler &p_compiler, RS::ShaderMode p_mode, const String &p_code, const ShaderCompiler::IdentifierActions &p_actions, bool p_low_end) {
+		return p_compiler._get_cache_key(p_mode, p_code, p_actions, p_low_end);
+	}
+
+	static String get_cache_file_path(const String &p_key) {
+		return ShaderCompiler::_get_cache_file_path(p_key);
+	}
+};
+
+namespace TestShaderCompiler {
+
+static const char *test_shader_code = R"(
+shader_type canvas_item;
+
+uniform vec4 tint : source_color = vec4(1.0);
+uniform float strength : hint_range(0.0, 1.0) = 0.5;
+
+float luminance(vec3 p_color) {
+	return dot(p_color, vec3(0.299, 0.587, 0.114));
+}
+
+void fragment() {
+	vec4 mixed = mix(COLOR, tint, strength);
+	COLOR = vec4(vec3(luminance(mixed.rgb)), mixed.a);
+}
+)";
+
+struct CompileResult {
+	Error error = FAILED;
+	ShaderCompiler::GeneratedCode gen_code;
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+};
+
+static const char *test_global_uniform_shader_code = R"(
+shader_type canvas_item;
+
+global uniform vec4 test_global_tint;
+
+void fragment() {
+	COLOR *= test_global_tint;
+}
+)";
+
+static ShaderCompiler::IdentifierActions make_test_actions() {
+	ShaderCompiler::IdentifierActions actions;
+	actions.entry_point_stages["vertex"] = ShaderCompiler::STAGE_VERTEX;
+	actions.entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
+	actions.entry_point_stages["light"] = ShaderCompiler::STAGE_FRAGMENT;
+	return actions;
+}
+
+static void compile_test_shader(ShaderCompiler &p_compiler, CompileResult &r_result, const char *p_code = test_shader_code) {
+	ShaderCompiler::IdentifierActions actions = make_test_actions();
+	actions.uniforms = &r_result.uniforms;
+
+	r_result.error = p_compiler.compile(RS::SHADER_CANVAS_ITEM, p_code, &actions, "res://test.gdshader", r_result.gen_code);
+}
+
+static void check_same_code(const CompileResult &p_result, const CompileResult &p_expected) {
+	CHECK(p_result.error == OK);
+	CHECK(p_result.gen_code.code.size() == p_expected.gen_code.code.size());
+	for (const KeyValue<String, String> &E : p_expected.gen_code.code) {
+		CHECK(p_result.gen_code.code.get(E.key) == E.value);
+	}
+	CHECK(p_result.gen_code.defines == p_expected.gen_code.defines);
+	CHECK(p_result.gen_code.uniforms == p_expected.gen_code.uniforms);
+	CHECK(p_result.gen_code.uniform_offsets == p_expected.gen_code.uniform_offsets);
+	CHECK(p_result.gen_code.uniform_total_size == p_expected.gen_code.uniform_total_size);
+	CHECK(p_result.gen_code.texture_uniforms.size() == p_expected.gen_code.texture_uniforms.size());
+	for (int i = 0; i < ShaderCompiler::STAGE_MAX; i++) {
+		CHECK(p_result.gen_code.stage_globals[i] == p_expected.gen_code.stage_globals[i]);
+	}
+	CHECK(p_result.uniforms.size() == p_expected.uniforms.size());
+	for (const KeyValue<StringName, ShaderLanguage::ShaderNode::Uniform> &E : p_expected.uniforms) {
+		REQUIRE(p_result.uniforms.has(E.key));
+		CHECK(p_result.uniforms[E.key].type == E.value.type);
+		CHECK(p_result.uniforms[E.key].order == E.value.order);
+		CHECK(p_result.uniforms[E.key].hint == E.value.hint);
+	}
+}
+
+// Compiles with the code cache in a clean temporary folder, and restores the previous folder afterwards.
+struct TestCodeCache {
+	String previous_dir;
+	String dir;
+
+	TestCodeCache() {
+		previous_dir = ShaderCompiler::get_shader_cache_dir();
+		dir = TestUtils::get_temp_path("shader_compiler_cache");
+		Ref<DirAccess> da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+		if (da->dir_exists(dir)) {
+			da->change_dir(dir);
+			da->erase_contents_recursive();
+		}
+		ShaderCompiler::set_shader_cache_dir(dir);
+	}
+
+	~TestCodeCache() {
+		ShaderCompiler::set_shader_cache_dir(previous_dir);
+	}
+};
+
+struct ConcurrentCompile {
+	ShaderCompiler *compiler = nullptr;
+
+	void compile(uint32_t p_index, CompileResult *p_results) {
+		compile_test_shader(*compiler, p_results[p_index]);
+	}
+};
+
+TEST_CASE("[ShaderCompiler] Concurrent compilation matches sequential compilation") {
+	ShaderCompiler::DefaultIdentifierActions default_actions;
+	default_actions.renames["COLOR"] = "color";
+	default_actions.base_uniform_string = "material.";
+
+	ShaderCompiler compiler;
+	compiler.initialize(default_actions);
+
+	CompileResult expected;
+	compile_test_shader(compiler, expected);
+	REQUIRE(expected.error == OK);
+	REQUIRE(expected.gen_code.code.has("fragment"));
+
+	ConcurrentCompile concurrent;
+	concurrent.compiler = &compiler;
+	LocalVector<CompileResult> results;
+	results.resize(64);
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&concurrent, &ConcurrentCompile::compile, results.ptr(), results.size());
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	for (const CompileResult &result : results) {
+		CHECK(result.error == OK);
+		CHECK(result.gen_code.code.get("fragment") == expected.gen_code.code["fragment"]);
+		CHECK(result.gen_code.uniforms == expected.gen_code.uniforms);
+		CHECK(result.gen_code.uniform_total_size == expected.gen_code.uniform_total_size);
+		CHECK(result.uniforms.size() == expected.uniforms.size());
+	}
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Code cache hits match compiled code") {
+	ShaderCompiler::DefaultIdentifierActions default_actions;
+	default_actions.renames["COLOR"] = "color";
+	default_actions.base_uniform_string = "material.";
+
+	CompileResult expected;
+	{
+		ShaderCompiler compiler;
+		compiler.initialize(default_actions);
+		compile_test_shader(compiler, expected);
+		REQUIRE(expected.error == OK);
+	}
+
+	TestCodeCache cache;
+	ShaderCompiler compiler;
+	compiler.initialize(default_actions);
+	const String key = TestShaderCompilerInternalsAccessor::get_cache_key(compiler, RS::SHADER_CANVAS_ITEM, test_shader_code, make_test_actions(), RS::get_singleton()->is_low_end());
+	const String path = TestShaderCompilerInternalsAccessor::get_cache_file_path(key);
+
+	CompileResult miss;
+	compile_test_shader(compiler, miss);
+	check_same_code(miss, expected);
+	REQUIRE(FileAccess::exists(path));
+
+	const Vector<uint8_t> entry = FileAccess::get_file_as_bytes(path);
+	CompileResult hit;
+	compile_test_shader(compiler, hit);
+	check_same_code(hit, expected);
+	CHECK(FileAccess::get_file_as_bytes(path) == entry);
+
+	// Put the entry of another shader under the key, a hit returns its code instead of compiling.
+	const String other_code = String(test_shader_code).replace("vec4(vec3(luminance(mixed.rgb)), mixed.a)", "mixed");
+	CompileResult other;
+	compile_test_shader(compiler, other, other_code.utf8().get_data());
+	REQUIRE(other.error == OK);
+	REQUIRE(other.gen_code.code.get("fragment") != expected.gen_code.code["fragment"]);
+	const String other_key = TestShaderCompilerInternalsAccessor::get_cache_key(compiler, RS::SHADER_CANVAS_ITEM, other_code, make_test_actions(), RS::get_singleton()->is_low_end());
+	REQUIRE(other_key != key);
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(FileAccess::get_file_as_bytes(TestShaderCompilerInternalsAccessor::get_cache_file_path(other_key)));
+	}
+	CompileResult swapped;
+	compile_test_shader(compiler, swapped);
+	check_same_code(swapped, other);
+}
+
+TEST_CASE("[ShaderCompiler] Code cache keys") {
+	ShaderCompiler::DefaultIdentifierActions default_actions;
+	default_actions.renames["COLOR"] = "color";
+	ShaderCompiler compiler;
+	compiler.initialize(default_actions);
+	const ShaderCompiler::IdentifierActions actions = make_test_actions();
+
+	const String key = TestShaderCompilerInternalsAccessor::get_cache_key(compiler, RS::SHADER_CANVAS_ITEM, test_shader_code, actions, false);
+	CHECK(key == TestShaderCompilerInternalsAccessor::get_cache_key(compiler, RS::SHADER_CANVAS_ITEM, test_shader_code, actions, false));
+
+	SUBCASE("Low-end mode changes the key") {
+		CHECK(key != TestShaderCompilerInternalsAccessor::get_cache_key(compiler, RS::SHADER_CANVAS_ITEM, test_shader_code, actions, true));
+	}
+
+	SUBCASE("Shader code changes the key") {
+		const String edited_code = String(test_shader_code).replace("0.5", "0.25");
+		CHECK(key != TestShaderCompilerInternalsAccessor::get_cache_key(compiler, RS::SHADER_CANVAS_ITEM, edited_code, actions, false));
+		CHECK(key != TestShaderCompilerInternalsAccessor::get_cache_key(compiler, RS::SHADER_CANVAS_ITEM, test_global_uniform_shader_code, actions, false));
+	}
+
+	SUBCASE("Shader mode and default actions change the key") {
+		CHECK(key != TestShaderCompilerInternalsAccessor::get_cache_key(compiler, RS::SHADER_PARTICLES, test_shader_code, actions, false));
+
+		default_actions.renames["COLOR"] = "out_color";
+		ShaderCompiler other_compiler;
+		other_compiler.initialize(default_actions);
+		CHECK(key != TestShaderCompilerInternalsAccessor::get_cache_key(other_compiler, RS::SHADER_CANVAS_ITEM, test_shader_code, actions, false));
+	}
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Code cache entries using changed global uniforms are compiled again") {
+	ShaderCompiler::DefaultIdentifierActions default_actions;
+	default_actions.renames["COLOR"] = "color";
+	default_actions.global_buffer_array_variable = "global_shader_uniforms.data";
+
+	TestCodeCache cache;
+	ShaderCompiler compiler;
+	compiler.initialize(default_actions);
+
+	RS::get_singleton()->global_shader_parameter_add("test_global_tint", RS::GLOBAL_VAR_TYPE_VEC4, Color(1, 1, 1, 1));
+	CompileResult first;
+	compile_test_shader(compiler, first, test_global_uniform_shader_code);
+	CHECK(first.error == OK);
+
+	// The key doesn't depend on the global uniforms, the entry is checked against them instead.
+	RS::get_singleton()->global_shader_parameter_remove("test_global_tint");
+	RS::get_singleton()->global_shader_parameter_add("test_global_tint", RS::GLOBAL_VAR_TYPE_FLOAT, 1.0);
+	CompileResult changed;
+	ERR_PRINT_OFF;
+	compile_test_shader(compiler, changed, test_global_uniform_shader_code);
+	ERR_PRINT_ON;
+	CHECK(changed.error != OK);
+
+	RS::get_singleton()->global_shader_parameter_remove("test_global_tint");
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Invalid code cache entries are rejected") {
+	ShaderCompiler::DefaultIdentifierActions default_actions;
+	default_actions.renames["COLOR"] = "color";
+	default_actions.base_uniform_string = "material.";
+
+	TestCodeCache cache;
+	ShaderCompiler compiler;
+	compiler.initialize(default_actions);
+	const String key = TestShaderCompilerInternalsAccessor::get_cache_key(compiler, RS::SHADER_CANVAS_ITEM, test_shader_code, make_test_actions(), RS::get_singleton()->is_low_end());
+	const String path = TestShaderCompilerInternalsAccessor::get_cache_file_path(key);
+
+	CompileResult expected;
+	compile_test_shader(compiler, expected);
+	REQUIRE(expected.error == OK);
+	const Vector<uint8_t> entry = FileAccess::get_file_as_bytes(path);
+	REQUIRE(entry.size() > 8);
+
+	Vector<uint8_t> invalid_entry;
+	SUBCASE("Truncated entry") {
+		invalid_entry = entry.slice(0, entry.size() / 2);
+	}
+
+	SUBCASE("Bad magic") {
+		invalid_entry = entry;
+		invalid_entry.write[0] = 'X';
+	}
+
+	SUBCASE("Unknown version") {
+		invalid_entry = entry;
+		invalid_entry.write[4] = 0xff;
+	}
+
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(invalid_entry);
+	}
+
+	// Compiled again, and the entry is replaced.
+	CompileResult result;
+	compile_test_shader(compiler, result);
+	check_same_code(result, expected);
+	CHECK(FileAccess::get_file_as_bytes(path) == entry);
+}
+
+} // namespace TestShaderCompiler
+
+#endif // TEST_SHADER_COMPILER_H